@@ -1,8 +1,18 @@
 #version 450 core
 layout (location = 0) in vec3 aPos;
+#ifdef INSTANCED
+//Con instancing las matrices de cada objeto provienen del buffer de instancias (cada mat4 ocupa cuatro locations)
+layout (location = 5) in mat4 aModelMatrix;
+layout (location = 9) in mat4 aModelInverseTransposeMatrix;
+layout(location = 0) uniform mat4 viewProjectionMatrix;
+#define modelMatrix aModelMatrix
+#define modelInverseTransposeMatrix aModelInverseTransposeMatrix
+#define mvpMatrix (viewProjectionMatrix * aModelMatrix)
+#else
 layout(location = 0) uniform mat4 mvpMatrix;
 layout(location = 1) uniform mat4 modelMatrix;
 layout(location = 2) uniform mat4 modelInverseTransposeMatrix;
+#endif
 
 
 void main()
@@ -0,0 +1,195 @@
+#pragma once
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*
+* Harness minimo de microbenchmarks. Cada benchmark recibe un BenchmarkState y ejecuta el codigo a medir dentro de
+* while (state.KeepRunning()) { ... }, el estado repite el cuerpo hasta acumular el tiempo minimo pedido.
+* Los resultados se escriben como JSON para poder comparar ejecuciones entre versiones del motor.
+*/
+
+// Evita que el compilador elimine el calculo de value por no ser usado.
+template <typename T>
+inline void DoNotOptimize(const T& value) noexcept {
+#if defined(_MSC_VER)
+	static const void* volatile sink;
+	sink = &value;
+	_ReadWriteBarrier();
+#else
+	asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+class BenchmarkState {
+public:
+	using Clock = std::chrono::steady_clock;
+	BenchmarkState(double minTimeSeconds, uint64_t maxIterations) :
+		m_minTime(minTimeSeconds), m_maxIterations(maxIterations) {}
+
+	bool KeepRunning() noexcept {
+		const Clock::time_point now = Clock::now();
+		if (!m_started) {
+			m_started = true;
+			m_iterationStart = now;
+			return true;
+		}
+		//Tiempo de la iteracion que acaba de terminar, descontando los intervalos pausados
+		const double iterationTime = Seconds(now - m_iterationStart) - m_pausedInIteration;
+		m_totalTime += iterationTime;
+		m_minIterationTime = std::min(m_minIterationTime, iterationTime);
+		m_maxIterationTime = std::max(m_maxIterationTime, iterationTime);
+		m_iterations++;
+		m_pausedInIteration = 0.0;
+		if (m_skipped || m_totalTime >= m_minTime || m_iterations >= m_maxIterations)
+			return false;
+		m_iterationStart = Clock::now();
+		return true;
+	}
+	void PauseTiming() noexcept { m_pauseStart = Clock::now(); }
+	void ResumeTiming() noexcept { m_pausedInIteration += Seconds(Clock::now() - m_pauseStart); }
+	//Cantidad de elementos (componentes, cuerpos, articulaciones) procesados en cada iteracion
+	void SetItemsPerIteration(uint64_t items) noexcept { m_itemsPerIteration = items; }
+	void SkipWithMessage(const std::string& message) { m_skipped = true; m_message = message; }
+
+	uint64_t GetIterations() const noexcept { return m_iterations; }
+	double GetTotalTime() const noexcept { return m_totalTime; }
+	double GetMinIterationTime() const noexcept { return m_iterations > 0 ? m_minIterationTime : 0.0; }
+	double GetMaxIterationTime() const noexcept { return m_maxIterationTime; }
+	uint64_t GetItemsPerIteration() const noexcept { return m_itemsPerIteration; }
+	bool IsSkipped() const noexcept { return m_skipped; }
+	const std::string& GetMessage() const noexcept { return m_message; }
+private:
+	static double Seconds(Clock::duration duration) noexcept {
+		return std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+	}
+	double m_minTime;
+	uint64_t m_maxIterations;
+	bool m_started = false;
+	bool m_skipped = false;
+	std::string m_message;
+	uint64_t m_iterations = 0;
+	uint64_t m_itemsPerIteration = 0;
+	double m_totalTime = 0.0;
+	double m_minIterationTime = std::numeric_limits<double>::max();
+	double m_maxIterationTime = 0.0;
+	double m_pausedInIteration = 0.0;
+	Clock::time_point m_iterationStart;
+	Clock::time_point m_pauseStart;
+};
+
+class BenchmarkRunner {
+public:
+	using Function = std::function<void(BenchmarkState&)>;
+	struct Result {
+		std::string name;
+		uint64_t iterations = 0;
+		double meanNs = 0.0;
+		double minNs = 0.0;
+		double maxNs = 0.0;
+		double itemsPerSecond = 0.0;
+		bool skipped = false;
+		std::string message;
+	};
+
+	BenchmarkRunner(double minTimeSeconds, uint64_t maxIterations, std::string filter) :
+		m_minTime(minTimeSeconds), m_maxIterations(maxIterations), m_filter(std::move(filter)) {}
+
+	// Ejecuta inmediatamente func si name contiene el filtro. Las escenas de los benchmarks se arman y destruyen
+	// alrededor de cada llamada, por lo que no tiene sentido registrarlos para despues.
+	void Run(const std::string& name, const Function& func) {
+		if (!m_filter.empty() && name.find(m_filter) == std::string::npos)
+			return;
+		BenchmarkState state(m_minTime, m_maxIterations);
+		func(state);
+		Result result;
+		result.name = name;
+		result.iterations = state.GetIterations();
+		result.skipped = state.IsSkipped();
+		result.message = state.GetMessage();
+		if (result.iterations > 0 && !result.skipped) {
+			result.meanNs = 1e9 * state.GetTotalTime() / static_cast<double>(result.iterations);
+			result.minNs = 1e9 * state.GetMinIterationTime();
+			result.maxNs = 1e9 * state.GetMaxIterationTime();
+			if (state.GetItemsPerIteration() > 0 && state.GetTotalTime() > 0.0)
+				result.itemsPerSecond = static_cast<double>(state.GetItemsPerIteration() * result.iterations) / state.GetTotalTime();
+		}
+		if (result.skipped)
+			std::printf("%-48s skipped: %s\n", name.c_str(), result.message.c_str());
+		else
+			std::printf("%-48s %12.1f ns/iter (min %12.1f) %10llu iterations\n", name.c_str(), result.meanNs, result.minNs,
+				static_cast<unsigned long long>(result.iterations));
+		m_results.push_back(std::move(result));
+	}
+
+	bool WriteJson(const std::filesystem::path& path) const {
+		std::ofstream out(path);
+		if (!out.is_open())
+			return false;
+		char dateBuffer[64] = { 0 };
+		const std::time_t now = std::time(nullptr);
+		std::strftime(dateBuffer, sizeof(dateBuffer), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+		out << "{\n";
+		out << "\t\"context\": {\n";
+		out << "\t\t\"date\": \"" << dateBuffer << "\",\n";
+		out << "\t\t\"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+		out << "\t\t\"build_type\": \"release\",\n";
+#else
+		out << "\t\t\"build_type\": \"debug\",\n";
+#endif
+		out << "\t\t\"min_time_seconds\": " << m_minTime << "\n";
+		out << "\t},\n";
+		out << "\t\"benchmarks\": [\n";
+		for (size_t i = 0; i < m_results.size(); i++) {
+			const Result& result = m_results[i];
+			out << "\t\t{\n";
+			out << "\t\t\t\"name\": \"" << Escape(result.name) << "\",\n";
+			if (result.skipped) {
+				out << "\t\t\t\"skipped\": true,\n";
+				out << "\t\t\t\"message\": \"" << Escape(result.message) << "\"\n";
+			}
+			else {
+				out << "\t\t\t\"iterations\": " << result.iterations << ",\n";
+				out << "\t\t\t\"mean_ns\": " << result.meanNs << ",\n";
+				out << "\t\t\t\"min_ns\": " << result.minNs << ",\n";
+				out << "\t\t\t\"max_ns\": " << result.maxNs << ",\n";
+				out << "\t\t\t\"items_per_second\": " << result.itemsPerSecond << "\n";
+			}
+			out << (i + 1 < m_results.size() ? "\t\t},\n" : "\t\t}\n");
+		}
+		out << "\t]\n";
+		out << "}\n";
+		return true;
+	}
+private:
+	static std::string Escape(const std::string& text) {
+		std::string escaped;
+		escaped.reserve(text.size());
+		for (char c : text) {
+			if (c == '"' || c == '\\')
+				escaped.push_back('\\');
+			escaped.push_back(c);
+		}
+		return escaped;
+	}
+	double m_minTime;
+	uint64_t m_maxIterations;
+	std::string m_filter;
+	std::vector<Result> m_results;
+};
+#endif
@@ -0,0 +1,645 @@
+#include "MonaEngine.hpp"
+#include "Rendering/DiffuseFlatMaterial.hpp"
+#include "Benchmark.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <numbers>
+#include <random>
+
+namespace Mona {
+	// World declara a MonaTest como friend, lo que permite medir los sistemas del motor directamente sin pasar por el main loop.
+	class MonaTest {
+	public:
+		template <typename ComponentType>
+		static ComponentManager<ComponentType>& GetComponentManager(World& world) {
+			return world.GetComponentManager<ComponentType>();
+		}
+		static PhysicsCollisionSystem& GetPhysicsCollisionSystem(World& world) {
+			return world.m_physicsCollisionSystem;
+		}
+		static AnimationSystem& GetAnimationSystem(World& world) {
+			return world.m_animationSystem;
+		}
+		static TransformHierarchy& GetTransformHierarchy(World& world) {
+			return world.m_transformHierarchy;
+		}
+		static CullingSystem& GetCullingSystem(World& world) {
+			return world.m_renderer.GetCullingSystem();
+		}
+		static SkeletalMeshGroup& GetSkeletalMeshGroup(World& world) {
+			return *world.m_skeletalMeshGroup;
+		}
+	};
+}
+
+// Mismo terreno usado por Test0_TestConIK
+float gaussian(float x, float y, float s, float sigma, glm::vec2 mu) {
+	return (s / (sigma * std::sqrt(2 * std::numbers::pi))) * std::exp((-1 / (2 * std::pow(sigma, 2))) * (std::pow((x - mu[0]), 2) + std::pow((y - mu[1]), 2)));
+}
+
+float TerrainHeight(float x, float y) {
+	float result = 0;
+	int funcNum = 250;
+	glm::vec2 minXY(-100, -100);
+	glm::vec2 maxXY(100, 100);
+	float minHeight = -15;
+	float maxHeight = 80;
+	float minSigma = 3;
+	float maxSigma = 15;
+	std::srand(130);
+	for (int i = 0; i < funcNum; i++) {
+		float randMax = RAND_MAX;
+		result += gaussian(x, y, Mona::funcUtils::lerp(minHeight, maxHeight, std::rand() / randMax),
+			Mona::funcUtils::lerp(minSigma, maxSigma, std::rand() / randMax),
+			{ Mona::funcUtils::lerp(minXY[0], maxXY[0], std::rand() / randMax),
+			Mona::funcUtils::lerp(minXY[1], maxXY[1], std::rand() / randMax) });
+	}
+	return result;
+}
+
+std::shared_ptr<Mona::Mesh> GenerateTestTerrain(int numInnerVertices) {
+	return Mona::MeshManager::GetInstance().GenerateTerrain(glm::vec2(-100, -100), glm::vec2(100, 100),
+		numInnerVertices, numInnerVertices, TerrainHeight);
+}
+
+Mona::GameObjectHandle<Mona::GameObject> AddTerrain(Mona::World& world) {
+	auto terrain = world.CreateGameObject<Mona::GameObject>();
+	auto materialPtr = std::static_pointer_cast<Mona::DiffuseFlatMaterial>(world.CreateMaterial(Mona::MaterialType::DiffuseFlat));
+	world.AddComponent<Mona::TransformComponent>(terrain);
+	world.AddComponent<Mona::StaticMeshComponent>(terrain, GenerateTestTerrain(100), materialPtr);
+	return terrain;
+}
+
+// El rig de akai es el usado por Test0_TestConIK, si el modelo no esta disponible se usa xbot.
+std::string GetCharacterName() {
+	auto& config = Mona::Config::GetInstance();
+	if (std::filesystem::exists(config.getPathOfApplicationAsset("Models/akai.fbx")))
+		return "akai";
+	return "xbot";
+}
+
+struct CharacterAssets {
+	std::shared_ptr<Mona::Skeleton> skeleton;
+	std::shared_ptr<Mona::SkinnedMesh> skinnedMesh;
+	std::shared_ptr<Mona::AnimationClip> walkingAnimation;
+	std::shared_ptr<Mona::AnimationClip> compressedWalkingAnimation;
+};
+
+bool LoadCharacterAssets(const std::string& characterName, CharacterAssets& outAssets) {
+	auto& config = Mona::Config::GetInstance();
+	const auto modelPath = config.getPathOfApplicationAsset("Models/" + characterName + ".fbx");
+	const auto animationPath = config.getPathOfApplicationAsset("Animations/" + characterName + "/walking0.fbx");
+	if (!std::filesystem::exists(modelPath) || !std::filesystem::exists(animationPath))
+		return false;
+	outAssets.skeleton = Mona::SkeletonManager::GetInstance().LoadSkeleton(modelPath);
+	outAssets.skinnedMesh = Mona::MeshManager::GetInstance().LoadSkinnedMesh(outAssets.skeleton, modelPath, true);
+	outAssets.walkingAnimation = Mona::AnimationClipManager::GetInstance().LoadAnimationClip(animationPath, outAssets.skeleton, false);
+	outAssets.compressedWalkingAnimation = Mona::AnimationClipManager::GetInstance().LoadAnimationClip(animationPath, outAssets.skeleton, false,
+		Mona::CompressedAnimationClip::Settings());
+	return true;
+}
+
+void BenchmarkComponentManager(BenchmarkRunner& runner, Mona::World& world) {
+	constexpr int objectCount = 4096;
+	std::vector<Mona::GameObjectHandle<Mona::GameObject>> objects;
+	objects.reserve(objectCount);
+	for (int i = 0; i < objectCount; i++)
+		objects.push_back(world.CreateGameObject<Mona::GameObject>());
+
+	runner.Run("ECS/AddRemoveTransform/4096", [&](BenchmarkState& state) {
+		std::vector<Mona::TransformHandle> handles(objectCount);
+		while (state.KeepRunning()) {
+			for (int i = 0; i < objectCount; i++)
+				handles[i] = world.AddComponent<Mona::TransformComponent>(objects[i]);
+			for (int i = 0; i < objectCount; i++)
+				world.RemoveComponent(handles[i]);
+		}
+		state.SetItemsPerIteration(2 * objectCount);
+	});
+
+	std::mt19937 generator(7);
+	std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+	std::vector<Mona::TransformHandle> handles(objectCount);
+	for (int i = 0; i < objectCount; i++)
+		handles[i] = world.AddComponent<Mona::TransformComponent>(objects[i],
+			glm::vec3(distribution(generator), distribution(generator), distribution(generator)));
+	auto& transformManager = Mona::MonaTest::GetComponentManager<Mona::TransformComponent>(world);
+
+	runner.Run("ECS/IterateTransform/4096", [&](BenchmarkState& state) {
+		while (state.KeepRunning()) {
+			glm::vec3 sum(0.0f);
+			for (uint32_t i = 0; i < transformManager.GetCount(); i++)
+				sum += transformManager[i].GetLocalTranslation();
+			DoNotOptimize(sum);
+		}
+		state.SetItemsPerIteration(objectCount);
+	});
+
+	runner.Run("ECS/IterateTransformByHandle/4096", [&](BenchmarkState& state) {
+		while (state.KeepRunning()) {
+			glm::vec3 sum(0.0f);
+			for (int i = 0; i < objectCount; i++)
+				sum += handles[i]->GetLocalTranslation();
+			DoNotOptimize(sum);
+		}
+		state.SetItemsPerIteration(objectCount);
+	});
+
+	//Cadenas de profundidad 4, solo las raices se mueven cada iteracion por lo que toda la jerarquia debe propagarse
+	constexpr int chainLength = 4;
+	for (int i = 0; i < objectCount; i++) {
+		if (i % chainLength != 0)
+			world.SetParent(handles[i], handles[i - 1]);
+	}
+	auto& transformHierarchy = Mona::MonaTest::GetTransformHierarchy(world);
+	runner.Run("ECS/TransformHierarchy/4096", [&](BenchmarkState& state) {
+		while (state.KeepRunning()) {
+			for (int i = 0; i < objectCount; i += chainLength)
+				handles[i]->Rotate(glm::vec3(0.0f, 0.0f, 1.0f), 0.01f);
+			transformHierarchy.UpdateWorldMatrices();
+			DoNotOptimize(handles[objectCount - 1]->GetModelMatrix());
+		}
+		state.SetItemsPerIteration(objectCount);
+	});
+
+	for (auto& object : objects)
+		world.DestroyGameObject(object);
+}
+
+void BenchmarkAnimation(BenchmarkRunner& runner, Mona::World& world, const CharacterAssets& assets) {
+	const std::string characterName = GetCharacterName();
+	runner.Run("Animation/AnimationClipSample/" + characterName, [&](BenchmarkState& state) {
+		std::vector<Mona::JointPose> pose(assets.skeleton->JointCount());
+		const float duration = assets.walkingAnimation->GetDuration();
+		float time = 0.0f;
+		while (state.KeepRunning()) {
+			DoNotOptimize(assets.walkingAnimation->Sample(pose, time, true));
+			DoNotOptimize(pose[0]);
+			time = std::fmod(time + 1.0f / 60.0f, duration);
+		}
+		state.SetItemsPerIteration(pose.size());
+	});
+	runner.Run("Animation/AnimationClipSampleCursor/" + characterName, [&](BenchmarkState& state) {
+		std::vector<Mona::JointPose> pose(assets.skeleton->JointCount());
+		Mona::AnimationClip::KeyframeCursor cursor;
+		const float duration = assets.walkingAnimation->GetDuration();
+		float time = 0.0f;
+		while (state.KeepRunning()) {
+			DoNotOptimize(assets.walkingAnimation->Sample(pose, time, true, &cursor));
+			DoNotOptimize(pose[0]);
+			time = std::fmod(time + 1.0f / 60.0f, duration);
+		}
+		state.SetItemsPerIteration(pose.size());
+	});
+	runner.Run("Animation/CompressedClipSample/" + characterName, [&](BenchmarkState& state) {
+		std::vector<Mona::JointPose> pose(assets.skeleton->JointCount());
+		const float duration = assets.compressedWalkingAnimation->GetDuration();
+		float time = 0.0f;
+		while (state.KeepRunning()) {
+			DoNotOptimize(assets.compressedWalkingAnimation->Sample(pose, time, true));
+			DoNotOptimize(pose[0]);
+			time = std::fmod(time + 1.0f / 60.0f, duration);
+		}
+		state.SetItemsPerIteration(pose.size());
+	});
+
+	constexpr int characterCount = 64;
+	auto material = world.CreateMaterial(Mona::MaterialType::DiffuseFlat, true);
+	std::vector<Mona::GameObjectHandle<Mona::GameObject>> characters;
+	for (int i = 0; i < characterCount; i++) {
+		auto character = world.CreateGameObject<Mona::GameObject>();
+		world.AddComponent<Mona::TransformComponent>(character);
+		auto skeletalMesh = world.AddComponent<Mona::SkeletalMeshComponent>(character, assets.skinnedMesh, assets.walkingAnimation, material);
+		//Desfase para que los personajes no muestreen siempre el mismo instante
+		skeletalMesh->GetAnimationController().SetPlayRate(0.5f + 0.01f * i);
+		characters.push_back(character);
+	}
+	auto& skeletalMeshManager = Mona::MonaTest::GetComponentManager<Mona::SkeletalMeshComponent>(world);
+	auto& skeletalMeshGroup = Mona::MonaTest::GetSkeletalMeshGroup(world);
+	auto& transformManager = Mona::MonaTest::GetComponentManager<Mona::TransformComponent>(world);
+	auto& cameraManager = Mona::MonaTest::GetComponentManager<Mona::CameraComponent>(world);
+	const Mona::InnerComponentHandle cameraHandle = world.GetMainCameraComponent().GetInnerHandle();
+	auto& animationSystem = Mona::MonaTest::GetAnimationSystem(world);
+	runner.Run("Animation/UpdateCurrentPose/" + characterName + "/64", [&](BenchmarkState& state) {
+		while (state.KeepRunning()) {
+			animationSystem.UpdateAllPoses(skeletalMeshGroup, transformManager, cameraManager, cameraHandle, 1.0f / 60.0f, world.GetJobSystem());
+		}
+		state.SetItemsPerIteration(characterCount);
+	});
+	//Multitud lejana: pose muestreada cada 4 frames y sin dedos ni cara (sin camara se usa el nivel mas cercano)
+	for (uint32_t i = 0; i < skeletalMeshManager.GetCount(); i++)
+		skeletalMeshManager[i].SetAnimationLODLevels({ { 0.0f, 4, 5 } });
+	runner.Run("Animation/UpdateCurrentPoseLOD/" + characterName + "/64", [&](BenchmarkState& state) {
+		while (state.KeepRunning()) {
+			animationSystem.UpdateAllPoses(skeletalMeshGroup, transformManager, cameraManager, cameraHandle, 1.0f / 60.0f, world.GetJobSystem());
+		}
+		state.SetItemsPerIteration(characterCount);
+	});
+	for (uint32_t i = 0; i < skeletalMeshManager.GetCount(); i++)
+		skeletalMeshManager[i].SetAnimationLODLevels({});
+
+	//Multitud de caminantes en cuatro grupos de velocidad, cada grupo deberia evaluarse una vez por frame
+	constexpr int crowdCount = 1024;
+	std::vector<Mona::GameObjectHandle<Mona::GameObject>> crowd;
+	for (int i = 0; i < crowdCount; i++) {
+		auto walker = world.CreateGameObject<Mona::GameObject>();
+		world.AddComponent<Mona::TransformComponent>(walker);
+		auto skeletalMesh = world.AddComponent<Mona::SkeletalMeshComponent>(walker, assets.skinnedMesh, assets.walkingAnimation, material);
+		skeletalMesh->GetAnimationController().SetPlayRate(0.8f + 0.1f * (i % 4));
+		crowd.push_back(walker);
+	}
+	animationSystem.EnablePoseCache();
+	animationSystem.ResetPoseCacheStats();
+	runner.Run("Animation/UpdateCurrentPoseCached/" + characterName + "/1088", [&](BenchmarkState& state) {
+		while (state.KeepRunning()) {
+			animationSystem.UpdateAllPoses(skeletalMeshGroup, transformManager, cameraManager, cameraHandle, 1.0f / 60.0f, world.GetJobSystem());
+		}
+		state.SetItemsPerIteration(characterCount + crowdCount);
+	});
+	const auto& poseCacheStats = animationSystem.GetPoseCacheStats();
+	MONA_LOG_INFO("Pose cache: {0} hits, {1} misses", poseCacheStats.hits, poseCacheStats.misses);
+	animationSystem.DisablePoseCache();
+	for (auto& walker : crowd)
+		world.DestroyGameObject(walker);
+	runner.Run("Animation/MatrixPalette/" + characterName + "/64", [&](BenchmarkState& state) {
+		std::vector<glm::mat4> matrixPalette(assets.skeleton->JointCount());
+		while (state.KeepRunning()) {
+			for (uint32_t i = 0; i < skeletalMeshManager.GetCount(); i++) {
+				skeletalMeshManager[i].GetAnimationController().GetMatrixPalette(matrixPalette);
+				DoNotOptimize(matrixPalette[0]);
+			}
+		}
+		state.SetItemsPerIteration(characterCount);
+	});
+
+	for (auto& character : characters)
+		world.DestroyGameObject(character);
+}
+
+void BenchmarkIKNavigation(BenchmarkRunner& runner, Mona::World& world, const CharacterAssets& assets, Mona::IKSolverType solverType) {
+	const std::string characterName = GetCharacterName();
+	auto terrain = AddTerrain(world);
+	auto character = world.CreateGameObject<Mona::GameObject>();
+	world.AddComponent<Mona::TransformComponent>(character);
+	auto skeletalMesh = world.AddComponent<Mona::SkeletalMeshComponent>(character, assets.skinnedMesh, assets.walkingAnimation,
+		world.CreateMaterial(Mona::MaterialType::DiffuseFlat, true));
+	skeletalMesh->GetAnimationController().SetPlayRate(0.7f);
+
+	Mona::RigData rigData;
+	rigData.leftLeg.baseJointName = "LeftUpLeg";
+	rigData.leftLeg.endEffectorName = "LeftFoot";
+	rigData.rightLeg.baseJointName = "RightUpLeg";
+	rigData.rightLeg.endEffectorName = "RightFoot";
+	rigData.leftLeg.solverType = solverType;
+	rigData.rightLeg.solverType = solverType;
+	rigData.hipJointName = "Hips";
+	rigData.initialRotationAngle = 0.0f;
+	rigData.initialPosition = glm::vec3(0, -10, 0);
+	rigData.scale = 0.05f;
+	auto ikNavigation = world.AddComponent<Mona::IKNavigationComponent>(character, rigData);
+	ikNavigation->AddAnimation(assets.walkingAnimation, glm::vec3(0, 1, 0), glm::vec3(0, 0, 1), Mona::AnimationType::WALKING);
+	ikNavigation->AddTerrain(terrain);
+	ikNavigation->EnableIK(true);
+	ikNavigation->SetAngularSpeed(0.3f);
+
+	auto& transformManager = Mona::MonaTest::GetComponentManager<Mona::TransformComponent>(world);
+	auto& staticMeshManager = Mona::MonaTest::GetComponentManager<Mona::StaticMeshComponent>(world);
+	auto& skeletalMeshManager = Mona::MonaTest::GetComponentManager<Mona::SkeletalMeshComponent>(world);
+	auto& animationSystem = Mona::MonaTest::GetAnimationSystem(world);
+	Mona::IKRigController& controller = ikNavigation->GetIKRigController();
+	const std::string benchmarkName = solverType == Mona::IKSolverType::TWO_BONE ? "IKNavigation/UpdateIKRigTwoBone/" : "IKNavigation/UpdateIKRig/";
+	auto updateRig = [&](BenchmarkState& state) {
+		while (state.KeepRunning()) {
+			controller.updateIKRig(1.0f / 60.0f, transformManager, staticMeshManager, skeletalMeshManager);
+			//El avance de la animacion es parte del frame pero no de lo que se quiere medir
+			state.PauseTiming();
+			animationSystem.UpdateAllPoses(Mona::MonaTest::GetSkeletalMeshGroup(world), transformManager, Mona::MonaTest::GetComponentManager<Mona::CameraComponent>(world),
+				world.GetMainCameraComponent().GetInnerHandle(), 1.0f / 60.0f, world.GetJobSystem());
+			state.ResumeTiming();
+		}
+		state.SetItemsPerIteration(1);
+	};
+	runner.Run(benchmarkName + characterName, updateRig);
+	//El mismo rig en el nivel de detalle HIP_ONLY, que solo ajusta la altura de la cadera al terreno
+	if (solverType == Mona::IKSolverType::GRADIENT_DESCENT) {
+		Mona::IKNavigationLODSettings lodSettings;
+		lodSettings.reducedDistance = 0.0f;
+		lodSettings.hipOnlyDistance = 0.0f;
+		ikNavigation->SetLODSettings(lodSettings);
+		controller.updateLOD(1.0f);
+		runner.Run("IKNavigation/UpdateIKRigHipOnly/" + characterName, updateRig);
+	}
+
+	world.DestroyGameObject(character);
+	world.DestroyGameObject(terrain);
+}
+
+void BenchmarkTerrainHeight(BenchmarkRunner& runner, Mona::World& world) {
+	constexpr int queryCount = 1024;
+	auto terrain = AddTerrain(world);
+	Mona::EnvironmentData environmentData;
+	environmentData.addTerrain(terrain);
+	std::mt19937 generator(5);
+	std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+	std::vector<glm::vec2> queryPoints(queryCount);
+	for (auto& point : queryPoints)
+		point = glm::vec2(distribution(generator), distribution(generator));
+	auto& transformManager = Mona::MonaTest::GetComponentManager<Mona::TransformComponent>(world);
+	auto& staticMeshManager = Mona::MonaTest::GetComponentManager<Mona::StaticMeshComponent>(world);
+	environmentData.validateTerrains(transformManager, staticMeshManager);
+	runner.Run("IKNavigation/TerrainHeight/1024", [&](BenchmarkState& state) {
+		while (state.KeepRunning()) {
+			float heightSum = 0.0f;
+			for (const auto& point : queryPoints)
+				heightSum += environmentData.getTerrainHeight(point, staticMeshManager);
+			DoNotOptimize(heightSum);
+		}
+		state.SetItemsPerIteration(queryCount);
+	});
+	std::vector<float> heights(queryCount);
+	runner.Run("IKNavigation/TerrainHeightBatched/1024", [&](BenchmarkState& state) {
+		while (state.KeepRunning()) {
+			environmentData.getTerrainHeights(queryPoints, heights, staticMeshManager);
+			DoNotOptimize(heights.data());
+		}
+		state.SetItemsPerIteration(queryCount);
+	});
+
+	world.DestroyGameObject(terrain);
+}
+
+float TileHeight(float x, float y) {
+	return std::sin(x * 0.3f) * std::cos(y * 0.2f);
+}
+
+//Mapa abierto de 20x20 baldosas de terreno que comparten la misma malla
+void BenchmarkTerrainHeightTiled(BenchmarkRunner& runner, Mona::World& world) {
+	constexpr int tilesPerSide = 20;
+	constexpr float tileSize = 20.0f;
+	constexpr int queryCount = 1024;
+	auto tileMesh = Mona::MeshManager::GetInstance().GenerateTerrain(glm::vec2(0.0f), glm::vec2(tileSize), 14, 14, TileHeight);
+	auto materialPtr = world.CreateMaterial(Mona::MaterialType::DiffuseFlat);
+	Mona::EnvironmentData environmentData;
+	std::vector<Mona::GameObjectHandle<Mona::GameObject>> tiles;
+	for (int i = 0; i < tilesPerSide; i++) {
+		for (int j = 0; j < tilesPerSide; j++) {
+			auto tile = world.CreateGameObject<Mona::GameObject>();
+			world.AddComponent<Mona::TransformComponent>(tile, glm::vec3(i * tileSize, j * tileSize, 0.0f));
+			world.AddComponent<Mona::StaticMeshComponent>(tile, tileMesh, materialPtr);
+			environmentData.addTerrain(tile);
+			tiles.push_back(tile);
+		}
+	}
+	auto& transformManager = Mona::MonaTest::GetComponentManager<Mona::TransformComponent>(world);
+	auto& staticMeshManager = Mona::MonaTest::GetComponentManager<Mona::StaticMeshComponent>(world);
+	environmentData.validateTerrains(transformManager, staticMeshManager);
+	std::mt19937 generator(17);
+	std::uniform_real_distribution<float> distribution(0.0f, tilesPerSide * tileSize);
+	std::vector<glm::vec2> queryPoints(queryCount);
+	for (auto& point : queryPoints)
+		point = glm::vec2(distribution(generator), distribution(generator));
+	std::vector<float> heights(queryCount);
+	runner.Run("IKNavigation/TerrainHeightTiled/400", [&](BenchmarkState& state) {
+		while (state.KeepRunning()) {
+			environmentData.getTerrainHeights(queryPoints, heights, staticMeshManager);
+			DoNotOptimize(heights.data());
+		}
+		state.SetItemsPerIteration(queryCount);
+	});
+
+	for (auto& tile : tiles)
+		world.DestroyGameObject(tile);
+}
+
+void BenchmarkCurveEval(BenchmarkRunner& runner) {
+	constexpr int pointCount = 16;
+	constexpr int queryCount = 1024;
+	//Historial de angulos como los que guarda cada articulacion, consultado con tiempos crecientes como en la IK
+	std::vector<glm::vec1> points(pointCount);
+	std::vector<float> tValues(pointCount);
+	Mona::AngleHistory angleHistory;
+	for (int i = 0; i < pointCount; i++) {
+		points[i] = glm::vec1(std::sin(0.3f * i));
+		tValues[i] = i / 30.0f;
+		angleHistory.insertPoint(points[i], tValues[i]);
+	}
+	Mona::LIC<1> curve(points, tValues);
+	std::vector<float> queryTimes(queryCount);
+	for (int i = 0; i < queryCount; i++)
+		queryTimes[i] = tValues.back() * i / (queryCount - 1);
+	runner.Run("IKNavigation/CurveEval/1024", [&](BenchmarkState& state) {
+		while (state.KeepRunning()) {
+			float angleSum = 0.0f;
+			for (float t : queryTimes)
+				angleSum += curve.evalCurve(t)[0];
+			DoNotOptimize(angleSum);
+		}
+		state.SetItemsPerIteration(queryCount);
+	});
+	runner.Run("IKNavigation/AngleHistoryEval/1024", [&](BenchmarkState& state) {
+		while (state.KeepRunning()) {
+			float angleSum = 0.0f;
+			for (float t : queryTimes)
+				angleSum += angleHistory.evalCurve(t)[0];
+			DoNotOptimize(angleSum);
+		}
+		state.SetItemsPerIteration(queryCount);
+	});
+}
+
+void BenchmarkCulling(BenchmarkRunner& runner, Mona::World& world) {
+	constexpr int objectCount = 4096;
+	auto cube = Mona::MeshManager::GetInstance().LoadMesh(Mona::Mesh::PrimitiveType::Cube);
+	auto materialPtr = world.CreateMaterial(Mona::MaterialType::DiffuseFlat);
+	std::mt19937 generator(11);
+	std::uniform_real_distribution<float> distribution(-200.0f, 200.0f);
+	std::vector<Mona::GameObjectHandle<Mona::GameObject>> objects;
+	std::vector<Mona::TransformHandle> transforms;
+	for (int i = 0; i < objectCount; i++) {
+		auto object = world.CreateGameObject<Mona::GameObject>();
+		transforms.push_back(world.AddComponent<Mona::TransformComponent>(object,
+			glm::vec3(distribution(generator), distribution(generator), distribution(generator))));
+		world.AddComponent<Mona::StaticMeshComponent>(object, cube, materialPtr);
+		objects.push_back(object);
+	}
+	auto& transformManager = Mona::MonaTest::GetComponentManager<Mona::TransformComponent>(world);
+	auto& skeletalMeshManager = Mona::MonaTest::GetComponentManager<Mona::SkeletalMeshComponent>(world);
+	auto& cullingSystem = Mona::MonaTest::GetCullingSystem(world);
+	const glm::mat4 projection = glm::perspective(glm::radians(50.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+	const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+	std::vector<Mona::InnerComponentHandle> visibleStaticMeshes;
+	std::vector<Mona::InnerComponentHandle> visibleSkeletalMeshes;
+	//Un decimo de los objetos se mueve cada frame
+	runner.Run("Rendering/FrustumCulling/4096", [&](BenchmarkState& state) {
+		float offset = 0.01f;
+		while (state.KeepRunning()) {
+			for (int i = 0; i < objectCount; i += 10)
+				transforms[i]->Translate(glm::vec3(offset, 0.0f, 0.0f));
+			offset = -offset;
+			cullingSystem.UpdateBounds(transformManager, skeletalMeshManager);
+			cullingSystem.Cull(projection * view, visibleStaticMeshes, visibleSkeletalMeshes);
+			DoNotOptimize(visibleStaticMeshes.size());
+		}
+		state.SetItemsPerIteration(objectCount);
+	});
+
+	for (auto& object : objects)
+		world.DestroyGameObject(object);
+}
+
+void BenchmarkRenderQueue(BenchmarkRunner& runner) {
+	//Cola sintetica: 4096 objetos repartidos en 6 programas, 64 materiales y 256 mallas
+	constexpr int itemCount = 4096;
+	std::mt19937 generator(5);
+	std::vector<Mona::RenderQueue::Item> items(itemCount);
+	std::vector<float> depths(itemCount);
+	for (int i = 0; i < itemCount; i++) {
+		items[i].modelMatrix = glm::mat4(1.0f);
+		items[i].programID = 1 + generator() % 6;
+		items[i].material = reinterpret_cast<Mona::Material*>(static_cast<uintptr_t>(16 * (1 + generator() % 64)));
+		items[i].vertexArrayID = 1 + generator() % 256;
+		items[i].indexCount = 36;
+		items[i].componentIndex = i;
+		items[i].type = Mona::RenderQueue::ItemType::StaticMesh;
+		depths[i] = static_cast<float>(generator() % 1000) / 10.0f;
+	}
+	Mona::RenderQueue renderQueue;
+	runner.Run("Rendering/RenderQueueBuildSort/4096", [&](BenchmarkState& state) {
+		while (state.KeepRunning()) {
+			renderQueue.Begin(100.0f);
+			for (int i = 0; i < itemCount; i++)
+				renderQueue.Push(items[i], depths[i]);
+			renderQueue.Sort();
+			DoNotOptimize(renderQueue.GetSortedKey(0));
+		}
+		state.SetItemsPerIteration(itemCount);
+	});
+	runner.Run("Rendering/RenderQueueBatches/4096", [&](BenchmarkState& state) {
+		while (state.KeepRunning()) {
+			renderQueue.Begin(100.0f);
+			for (int i = 0; i < itemCount; i++)
+				renderQueue.Push(items[i], depths[i]);
+			renderQueue.Sort();
+			renderQueue.BuildBatches(2);
+			DoNotOptimize(renderQueue.GetBatches().size());
+		}
+		state.SetItemsPerIteration(itemCount);
+	});
+}
+
+void BenchmarkPhysics(BenchmarkRunner& runner, Mona::World& world, int bodyCount) {
+	auto ground = world.CreateGameObject<Mona::GameObject>();
+	world.AddComponent<Mona::TransformComponent>(ground, glm::vec3(0.0f, -1.0f, 0.0f));
+	world.AddComponent<Mona::RigidBodyComponent>(ground, Mona::BoxShapeInformation(glm::vec3(200.0f, 1.0f, 200.0f)),
+		Mona::RigidBodyType::StaticBody);
+	std::vector<Mona::GameObjectHandle<Mona::GameObject>> bodies;
+	const int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(bodyCount))));
+	for (int i = 0; i < bodyCount; i++) {
+		auto body = world.CreateGameObject<Mona::GameObject>();
+		const glm::vec3 position(3.0f * (i % side - side / 2), 2.0f + 2.5f * (i % 4), 3.0f * (i / side - side / 2));
+		world.AddComponent<Mona::TransformComponent>(body, position);
+		if (i % 2 == 0)
+			world.AddComponent<Mona::RigidBodyComponent>(body, Mona::BoxShapeInformation(), Mona::RigidBodyType::DynamicBody);
+		else
+			world.AddComponent<Mona::RigidBodyComponent>(body, Mona::SphereShapeInformation(), Mona::RigidBodyType::DynamicBody);
+		bodies.push_back(body);
+	}
+	auto& physicsSystem = Mona::MonaTest::GetPhysicsCollisionSystem(world);
+	runner.Run("Physics/StepSimulation/" + std::to_string(bodyCount), [&](BenchmarkState& state) {
+		while (state.KeepRunning()) {
+			physicsSystem.StepSimulation(1.0f / 60.0f);
+		}
+		state.SetItemsPerIteration(bodyCount);
+	});
+
+	for (auto& body : bodies)
+		world.DestroyGameObject(body);
+	world.DestroyGameObject(ground);
+}
+
+void BenchmarkAssets(BenchmarkRunner& runner) {
+	runner.Run("Assets/TerrainMesh/100x100", [&](BenchmarkState& state) {
+		while (state.KeepRunning()) {
+			DoNotOptimize(GenerateTestTerrain(100));
+		}
+		state.SetItemsPerIteration(102 * 102);
+	});
+}
+
+class BenchmarkApplication : public Mona::Application
+{
+public:
+	BenchmarkApplication(BenchmarkRunner& runner) : m_runner(runner) {}
+	virtual void UserStartUp(Mona::World& world) noexcept override {
+		BenchmarkComponentManager(m_runner, world);
+		CharacterAssets assets;
+		const std::string characterName = GetCharacterName();
+		if (LoadCharacterAssets(characterName, assets)) {
+			BenchmarkAnimation(m_runner, world, assets);
+			BenchmarkIKNavigation(m_runner, world, assets, Mona::IKSolverType::GRADIENT_DESCENT);
+			BenchmarkIKNavigation(m_runner, world, assets, Mona::IKSolverType::TWO_BONE);
+		}
+		else {
+			const std::string message = "missing assets for character " + characterName;
+			auto skip = [&message](BenchmarkState& state) { state.SkipWithMessage(message); };
+			m_runner.Run("Animation/AnimationClipSample/" + characterName, skip);
+			m_runner.Run("Animation/AnimationClipSampleCursor/" + characterName, skip);
+			m_runner.Run("Animation/CompressedClipSample/" + characterName, skip);
+			m_runner.Run("Animation/UpdateCurrentPose/" + characterName + "/64", skip);
+			m_runner.Run("Animation/UpdateCurrentPoseLOD/" + characterName + "/64", skip);
+			m_runner.Run("Animation/UpdateCurrentPoseCached/" + characterName + "/1088", skip);
+			m_runner.Run("Animation/MatrixPalette/" + characterName + "/64", skip);
+			m_runner.Run("IKNavigation/UpdateIKRig/" + characterName, skip);
+			m_runner.Run("IKNavigation/UpdateIKRigTwoBone/" + characterName, skip);
+			m_runner.Run("IKNavigation/UpdateIKRigHipOnly/" + characterName, skip);
+		}
+		BenchmarkTerrainHeight(m_runner, world);
+		BenchmarkTerrainHeightTiled(m_runner, world);
+		BenchmarkCurveEval(m_runner);
+		BenchmarkCulling(m_runner, world);
+		BenchmarkRenderQueue(m_runner);
+		for (int bodyCount : { 64, 256, 1024 })
+			BenchmarkPhysics(m_runner, world, bodyCount);
+		BenchmarkAssets(m_runner);
+		world.EndApplication();
+	}
+	virtual void UserShutDown(Mona::World& world) noexcept override {}
+	virtual void UserUpdate(Mona::World& world, float timeStep) noexcept override {}
+private:
+	BenchmarkRunner& m_runner;
+};
+
+/*
+* Uso: Benchmark_MonaEngine [--out=archivo.json] [--filter=texto] [--min-time=segundos]
+*/
+int main(int argc, char** argv)
+{
+	std::string outPath = "benchmark_results.json";
+	std::string filter;
+	double minTime = 1.0;
+	for (int i = 1; i < argc; i++) {
+		const std::string argument = argv[i];
+		if (argument.rfind("--out=", 0) == 0)
+			outPath = argument.substr(std::strlen("--out="));
+		else if (argument.rfind("--filter=", 0) == 0)
+			filter = argument.substr(std::strlen("--filter="));
+		else if (argument.rfind("--min-time=", 0) == 0)
+			minTime = std::atof(argument.substr(std::strlen("--min-time=")).c_str());
+		else {
+			std::fprintf(stderr, "Unknown argument %s\n", argument.c_str());
+			return EXIT_FAILURE;
+		}
+	}
+	BenchmarkRunner runner(minTime, 1000000000ull, filter);
+	{
+		BenchmarkApplication app(runner);
+		Mona::Engine engine(app, true);
+		engine.StartMainLoop(1);
+	}
+	if (!runner.WriteJson(outPath)) {
+		std::fprintf(stderr, "Failed to write %s\n", outPath.c_str());
+		return EXIT_FAILURE;
+	}
+	std::printf("Results written to %s\n", outPath.c_str());
+	return EXIT_SUCCESS;
+}
@@ -14,13 +14,36 @@
 namespace Mona {
 	AnimationClip::AnimationClip(const std::string& filePath,
 		std::shared_ptr<Skeleton> skeleton,
-		bool removeRootMotion)
+		bool removeRootMotion,
+		const std::optional<CompressedAnimationClip::Settings>& compression)
 	{
 		MONA_ASSERT(skeleton != nullptr, "AnimationClip Error: Skeleton cannot be null");
 		MONA_ASSERT(std::filesystem::is_regular_file(filePath), "There is no asset called: " + filePath);
+		// Se guarda el nombre de la animacion
+		size_t pos = filePath.find_last_of("/\\");
+		std::string fileName = pos != std::string::npos ? filePath.substr(pos + 1) : filePath;
+		m_animationName = funcUtils::splitString(fileName, '.')[0];
 
-		Assimp::Importer importer;
 		unsigned int postProcessFlags = aiProcess_Triangulate;
+		//Solo los clips comprimidos usan la cache, los no comprimidos deben conservar sus tracks editables
+		const bool useCache = compression.has_value() && AssetCache::IsEnabled();
+		AssetCache::Key cacheKey = { AssetCache::AssetType::AnimationClip, postProcessFlags };
+		const std::string cachePath = AssetCache::GetCachePath(filePath, AssetCache::AssetType::AnimationClip);
+		if (useCache) {
+			cacheKey.sourceHash = AssetCache::HashFile(filePath);
+			//El contenido comprimido depende de las articulaciones del esqueleto y de las opciones de compresion
+			uint64_t dependencyHash = AssetCache::HashBytes(&removeRootMotion, sizeof(removeRootMotion));
+			dependencyHash = AssetCache::HashBytes(&compression.value(), sizeof(CompressedAnimationClip::Settings), dependencyHash);
+			for (Skeleton::size_type i = 0; i < skeleton->JointCount(); i++)
+				dependencyHash = AssetCache::HashString(skeleton->GetJointName(i), dependencyHash);
+			cacheKey.dependencyHash = dependencyHash;
+			if (cacheKey.sourceHash != 0 && LoadFromCache(cachePath, cacheKey, *skeleton)) {
+				SetSkeleton(skeleton);
+				return;
+			}
+		}
+
+		Assimp::Importer importer;
 		const aiScene* scene = importer.ReadFile(filePath, postProcessFlags);
 		if (!scene || scene->mNumAnimations == 0)
 		{
@@ -62,10 +85,6 @@ namespace Mona {
 
 			}
 		}
-		// Se guarda el nombre de la animacion
-		size_t pos = filePath.find_last_of("/\\");
-		std::string fileName = pos != std::string::npos ? filePath.substr(pos + 1) : filePath;
-		m_animationName = funcUtils::splitString(fileName, '.')[0];
 		m_trackJointIndices.resize(m_trackJointNames.size());
 
 		SetSkeleton(skeleton);
@@ -73,18 +92,95 @@ namespace Mona {
 			RemoveRootMotion();
 		}
 
-		
+		if (compression) {
+			Compress(compression.value());
+			if (useCache && cacheKey.sourceHash != 0) {
+				AssetCacheWriter writer(cacheKey);
+				writer.Write(static_cast<uint64_t>(m_trackJointNames.size()));
+				for (const std::string& jointName : m_trackJointNames)
+					writer.WriteString(jointName);
+				m_compressedClip->Save(writer);
+				if (!writer.Save(cachePath))
+					MONA_LOG_WARNING("AnimationClip Warning: Failed to write cache file {0}", cachePath);
+			}
+		}
+	}
+
+	bool AnimationClip::LoadFromCache(const std::string& cachePath, const AssetCache::Key& key, const Skeleton& skeleton) {
+		AssetCacheReader reader(cachePath, key);
+		uint64_t trackCount = 0;
+		if (!reader.Read(trackCount) || trackCount > skeleton.JointCount())
+			return false;
+		std::vector<std::string> trackJointNames(trackCount);
+		for (uint64_t i = 0; i < trackCount; i++)
+			reader.ReadString(trackJointNames[i]);
+		std::unique_ptr<CompressedAnimationClip> compressedClip = std::make_unique<CompressedAnimationClip>();
+		if (!compressedClip->Load(reader) || compressedClip->GetTrackCount() != trackCount)
+			return false;
+
+		m_trackJointNames = std::move(trackJointNames);
+		m_trackJointIndices.resize(m_trackJointNames.size());
+		m_duration = compressedClip->GetDuration();
+		m_compressedClip = std::move(compressedClip);
+		return true;
+	}
+
+	void AnimationClip::Compress(const CompressedAnimationClip::Settings& settings) {
+		MONA_ASSERT(settings.sampleRate > 0.0f, "AnimationClip Error: Compression sample rate must be positive");
+		const size_t sourceSize = GetMemoryUsage();
+		const uint32_t frameCount = std::max(2u, static_cast<uint32_t>(std::ceil(m_duration * settings.sampleRate)) + 1);
+		//Se remuestrea con el mismo muestreo usado en reproduccion, el ultimo frame corresponde al final del clip
+		std::vector<JointPose> pose(m_skeletonPtr->JointCount());
+		std::vector<std::vector<JointPose>> frames(frameCount, std::vector<JointPose>(m_animationTracks.size()));
+		KeyframeCursor cursor;
+		for (uint32_t f = 0; f < frameCount; f++) {
+			Sample(pose, m_duration * static_cast<float>(f) / static_cast<float>(frameCount - 1), false, &cursor);
+			for (uint32_t i = 0; i < m_animationTracks.size(); i++) {
+				frames[f][i] = pose[m_trackJointIndices[i]];
+			}
+		}
+		m_compressedClip = std::make_unique<CompressedAnimationClip>(frames, m_trackJointIndices, m_duration, settings);
+		//Los tracks originales ya no se usan
+		std::vector<AnimationTrack>().swap(m_animationTracks);
+		MONA_LOG_INFO("AnimationClip: {0} compressed from {1} to {2} bytes", m_animationName, sourceSize, GetMemoryUsage());
+	}
+
+	size_t AnimationClip::GetMemoryUsage() const {
+		if (m_compressedClip)
+			return m_compressedClip->GetMemoryUsage();
+		size_t size = 0;
+		for (const AnimationTrack& track : m_animationTracks) {
+			size += track.positions.size() * sizeof(glm::vec3) +
+				track.rotations.size() * sizeof(glm::fquat) +
+				track.scales.size() * sizeof(glm::vec3) +
+				(track.positionTimeStamps.size() + track.rotationTimeStamps.size() + track.scaleTimeStamps.size()) * sizeof(float);
+		}
+		return size;
 	}
 
-	float AnimationClip::Sample(std::vector<JointPose>& outPose, float time, bool isLooping) {
+	float AnimationClip::Sample(std::vector<JointPose>& outPose, float time, bool isLooping, KeyframeCursor* cursor, uint32_t maxJointDepth) {
 		//Primero se obtiene el tiempo de muestreo correcto
 		float newTime = GetSamplingTime(time, isLooping);
+		if (m_compressedClip) {
+			//Un clip comprimido esta remuestreado uniformemente, por lo que no necesita cursor
+			m_compressedClip->Sample(outPose, newTime);
+			return newTime;
+		}
+		//Un cursor usado previamente con otro clip se reinicia, el indice 0 indica que no hay muestra previa
+		if (cursor && (cursor->clip != this || cursor->keys.size() != 3 * m_animationTracks.size())) {
+			cursor->clip = this;
+			cursor->keys.assign(3 * m_animationTracks.size(), 0);
+		}
 
 		//Por cada articulaci�n o joint animada
+		const bool isMasked = maxJointDepth != std::numeric_limits<uint32_t>::max();
 		for (uint32_t i = 0; i < m_animationTracks.size(); i++)
 		{
 			const AnimationTrack& animationTrack = m_animationTracks[i];
 			uint32_t jointIndex = m_trackJointIndices[i];
+			//Las articulaciones fuera de la mascara de nivel de detalle conservan su pose anterior
+			if (isMasked && maxJointDepth < m_skeletonPtr->GetJointDepth(jointIndex))
+				continue;
 			std::pair<uint32_t, float> fp;
 			glm::vec3 localPosition;
 			/* Siempre se chequea si hay solo una muestra en el track dado que en ese caso no tiene sentido interpolar.
@@ -94,7 +190,7 @@ namespace Mona {
 			if (animationTrack.positions.size() > 1)
 			{
 				
-				fp = GetTimeFraction(animationTrack.positionTimeStamps, newTime);
+				fp = GetTimeFraction(animationTrack.positionTimeStamps, newTime, cursor ? &cursor->keys[3 * i] : nullptr);
 				const glm::vec3& position = animationTrack.positions[fp.first - 1];
 				const glm::vec3& nextPosition = animationTrack.positions[fp.first % animationTrack.positions.size()];
 				localPosition = glm::mix(position, nextPosition, fp.second);
@@ -106,7 +202,7 @@ namespace Mona {
 			glm::fquat localRotation;
 			if (animationTrack.rotations.size() > 1)
 			{
-				fp = GetTimeFraction(animationTrack.rotationTimeStamps, newTime);
+				fp = GetTimeFraction(animationTrack.rotationTimeStamps, newTime, cursor ? &cursor->keys[3 * i + 1] : nullptr);
 				const glm::fquat& rotation = animationTrack.rotations[fp.first - 1];
 				const glm::fquat& nextRotation = animationTrack.rotations[fp.first % animationTrack.rotations.size()];
 				//Para interpolar rotaciones se usa slerp en vez de mix (linear interpolation)
@@ -118,7 +214,7 @@ namespace Mona {
 
 			glm::vec3 localScale;
 			if (animationTrack.scales.size() > 1) {
-				fp = GetTimeFraction(animationTrack.scaleTimeStamps, newTime);
+				fp = GetTimeFraction(animationTrack.scaleTimeStamps, newTime, cursor ? &cursor->keys[3 * i + 2] : nullptr);
 				const glm::vec3& scale = animationTrack.scales[fp.first - 1];
 				const glm::vec3& nextScale = animationTrack.scales[fp.first % animationTrack.scales.size()];
 				localScale = glm::mix(scale, nextScale, fp.second);
@@ -161,6 +257,7 @@ namespace Mona {
 	}
 
 	void AnimationClip::RemoveJointTranslation(int jointIndex) {
+		MONA_ASSERT(!IsCompressed(), "AnimationClip Error: Compressed clips cannot be edited");
 		//Remueve las translaciones del track de animacion asociado a una articulacion del esqueleto
 		int trackIndex = GetTrackIndex(jointIndex);
 		MONA_ASSERT(trackIndex != -1, "AnimationClip: Joint not present in animation.");
@@ -171,6 +268,7 @@ namespace Mona {
 	}
 
 	void AnimationClip::RemoveJointScaling(int jointIndex) {
+		MONA_ASSERT(!IsCompressed(), "AnimationClip Error: Compressed clips cannot be edited");
 		//Remueve los escalamientos del track de animacion asociado a una articulacion del esqueleto
 		int trackIndex = GetTrackIndex(jointIndex);
 		MONA_ASSERT(trackIndex != -1, "AnimationClip: Joint not present in animation.");
@@ -181,6 +279,7 @@ namespace Mona {
 	}
 
 	void AnimationClip::RemoveJointRotation(int jointIndex) {
+		MONA_ASSERT(!IsCompressed(), "AnimationClip Error: Compressed clips cannot be edited");
 		//Remueve las translaciones del track de animacion asociado a una articulacion del esqueleto
 		int trackIndex = GetTrackIndex(jointIndex);
 		MONA_ASSERT(trackIndex != -1, "AnimationClip: Joint not present in animation.");
@@ -196,23 +295,37 @@ namespace Mona {
 		return std::clamp(time, 0.0f, m_duration);
 	}
 
-	std::pair<uint32_t, float> AnimationClip::GetTimeFraction(const std::vector<float>& timeStamps, float time) const {
-		uint32_t sample = 0;
-		bool outOfRange = false;
-		// Se avanza el indice hasta que el tiempo que se busca es menor al timeStamp actual
-		// con esto se sabe que la muestra esta entre este indice y el anterior.
-		while (!outOfRange && time >= timeStamps[sample]) {
-			sample++;
-			outOfRange = sample >= timeStamps.size();
+	std::pair<uint32_t, float> AnimationClip::GetTimeFraction(const std::vector<float>& timeStamps, float time, uint32_t* cursorKey) const {
+		//Se busca el primer indice cuyo timeStamp es mayor al tiempo buscado, la muestra esta entre este indice y el anterior.
+		const uint32_t sampleCount = static_cast<uint32_t>(timeStamps.size());
+		uint32_t sample = cursorKey ? *cursorKey : 0;
+		bool found = false;
+		if (1 <= sample && sample <= sampleCount && timeStamps[sample - 1] <= time) {
+			//Reproduccion hacia adelante: se avanza desde la muestra anterior, normalmente cero o un paso
+			constexpr uint32_t maxCursorSteps = 4;
+			for (uint32_t step = 0; step < maxCursorSteps && sample < sampleCount && time >= timeStamps[sample]; step++)
+				sample++;
+			found = sample == sampleCount || time < timeStamps[sample];
+		}
+		if (!found) {
+			//Saltos, retrocesos y vueltas de un clip en loop usan busqueda binaria
+			sample = static_cast<uint32_t>(std::upper_bound(timeStamps.begin(), timeStamps.end(), time) - timeStamps.begin());
 		}
+		if (cursorKey)
+			*cursorKey = sample;
+		//Un tiempo anterior a la primera muestra toma el valor de esta
+		if (sample == 0)
+			return { 1, 0.0f };
 
+		const bool outOfRange = sample >= sampleCount;
 		float start = timeStamps[sample - 1];
 		float end = outOfRange ? m_duration : timeStamps[sample];
-		float frac = (time - start) / (end - start);
+		float frac = end > start ? (time - start) / (end - start) : 0.0f;
 		return { sample, frac };
 	}
 
 	glm::vec3 AnimationClip::GetPosition(float time, int joint, bool isLooping) {
+		MONA_ASSERT(!IsCompressed(), "AnimationClip Error: Compressed clips can only be sampled as a whole");
 		//Primero se obtiene el tiempo de muestreo correcto
 		float newTime = GetSamplingTime(time, isLooping);
 		int trackIndex = GetTrackIndex(joint);
@@ -233,6 +346,7 @@ namespace Mona {
 		return localPosition;
 	}
 	glm::fquat AnimationClip::GetRotation(float time, int joint, bool isLooping) {
+		MONA_ASSERT(!IsCompressed(), "AnimationClip Error: Compressed clips can only be sampled as a whole");
 		//Primero se obtiene el tiempo de muestreo correcto
 		float newTime = GetSamplingTime(time, isLooping);
 		int trackIndex = GetTrackIndex(joint);
@@ -253,6 +367,7 @@ namespace Mona {
 		return localRotation;
 	}
 	glm::vec3 AnimationClip::GetScale(float time, int joint, bool isLooping) {
+		MONA_ASSERT(!IsCompressed(), "AnimationClip Error: Compressed clips can only be sampled as a whole");
 		//Primero se obtiene el tiempo de muestreo correcto
 		float newTime = GetSamplingTime(time, isLooping);
 		int trackIndex = GetTrackIndex(joint);
@@ -274,6 +389,7 @@ namespace Mona {
 	}
 
 	void AnimationClip::SetRotation(glm::fquat newRotation, int frameIndex, int joint) {
+		MONA_ASSERT(!IsCompressed(), "AnimationClip Error: Compressed clips cannot be edited");
 		int trackIndex = GetTrackIndex(joint);
 		MONA_ASSERT(trackIndex != -1, "AnimationClip: Joint not present in animation.");
 		AnimationTrack& animationTrack = m_animationTracks[trackIndex];
@@ -291,6 +407,7 @@ namespace Mona {
 	}
 
 	void AnimationClip::DecompressRotations() {
+		MONA_ASSERT(!IsCompressed(), "AnimationClip Error: Compressed clips cannot be edited");
 		int nTracks = m_animationTracks.size();
 		std::vector<bool> conditions(nTracks);
 		std::vector<int> currentTimeIndexes(nTracks);
@@ -341,6 +458,7 @@ namespace Mona {
 
 
 	void AnimationClip::Reorient(glm::vec3 currentFrontVector, glm::vec3 currentUpVector, glm::vec3 targetFrontVector, glm::vec3 targetUpVector) {
+		MONA_ASSERT(!IsCompressed(), "AnimationClip Error: Compressed clips cannot be edited");
 		glm::fquat deltaRotationUp = glmUtils::calcDeltaRotation(currentUpVector, targetUpVector, currentFrontVector);
 		glm::fquat deltaRotationFront = glmUtils::calcDeltaRotation(deltaRotationUp * currentFrontVector, targetFrontVector, targetUpVector);
 		glm::fquat deltaRotation = deltaRotationFront * deltaRotationUp;
@@ -356,6 +474,7 @@ namespace Mona {
 	}
 
 	void AnimationClip::Scale(float scale) {
+		MONA_ASSERT(!IsCompressed(), "AnimationClip Error: Compressed clips cannot be edited");
 		AnimationTrack& rootTrack = m_animationTracks[GetTrackIndex(0)];
 		for (int i = 0; i < rootTrack.scales.size(); i++) {
 			rootTrack.scales[i] = scale * rootTrack.scales[i];
@@ -5,8 +5,12 @@
 #include <string>
 #include <memory>
 #include <utility>
+#include <optional>
+#include <limits>
 #include <glm/glm.hpp>
 #include "JointPose.hpp"
+#include "CompressedAnimationClip.hpp"
+#include "../Core/AssetCache.hpp"
 namespace Mona {
 	class Skeleton;
 	class AnimationClip {
@@ -17,6 +21,7 @@ namespace Mona {
 		friend class IKRigController;
 		friend class AnimationValidator;
 		friend class TrajectoryGenerator;
+		friend class MonaTest;
 		typedef int JointIndex;
 		typedef int FrameIndex;
 		struct AnimationTrack {
@@ -28,13 +33,40 @@ namespace Mona {
 			std::vector<float> scaleTimeStamps;
 
 		};
+		/*
+		* Estado de muestreo por instancia. Guarda, por cada track, el indice de la ultima muestra encontrada para
+		* posiciones, rotaciones y escalas, de modo que al reproducir hacia adelante la busqueda parta desde ahi (costo
+		* amortizado O(1)). Si el cursor se usa con otro clip se reinicia automaticamente.
+		*/
+		struct KeyframeCursor {
+			const AnimationClip* clip = nullptr;
+			std::vector<uint32_t> keys;
+		};
 		float GetDuration() const { return m_duration; }
-		float Sample(std::vector<JointPose>& outPose, float time, bool isLooping);
+		/*
+		* Muestrea la pose local del clip en time. Con cursor nulo, o cuando el tiempo retrocede (saltos o vueltas de un
+		* clip en loop), cada muestra se busca con busqueda binaria. Las articulaciones con profundidad mayor a maxJointDepth
+		* no se muestrean y conservan su valor en outPose, salvo en clips comprimidos, que se decodifican completos.
+		*/
+		float Sample(std::vector<JointPose>& outPose,
+			float time,
+			bool isLooping,
+			KeyframeCursor* cursor = nullptr,
+			uint32_t maxJointDepth = std::numeric_limits<uint32_t>::max());
+		/*
+		* Indica si el clip fue cargado con compresion. Los clips comprimidos liberan sus tracks originales, por lo que solo
+		* pueden muestrearse y no pueden editarse ni usarse con IK.
+		*/
+		bool IsCompressed() const { return m_compressedClip != nullptr; }
+		//Lleva time al rango [0, duracion], dando la vuelta si el clip esta en loop o acotandolo en caso contrario
+		float GetSamplingTime(float time, bool isLooping) const;
+		//Bytes ocupados por las muestras del clip, comprimidas o no
+		size_t GetMemoryUsage() const;
 		std::string GetAnimationName() {
 			return m_animationName;
 		}
 		
-		std::shared_ptr<Skeleton> GetSkeleton() const {
+		const std::shared_ptr<Skeleton>& GetSkeleton() const {
 			return m_skeletonPtr;
 		}
 		void Reorient(glm::vec3 currentFrontVector, glm::vec3 currentUpVector, glm::vec3 targetFrontVector, glm::vec3 targetUpVector);
@@ -43,15 +75,21 @@ namespace Mona {
 		void SetSkeleton(std::shared_ptr<Skeleton> skeletonPtr);
 		AnimationClip(const std::string& filePath,
 			std::shared_ptr<Skeleton> skeleton,
-			bool removeRootMotion = true);
+			bool removeRootMotion = true,
+			const std::optional<CompressedAnimationClip::Settings>& compression = std::nullopt);
+		/*
+		* Remuestrea el clip uniformemente, lo comprime y libera los tracks originales.
+		*/
+		void Compress(const CompressedAnimationClip::Settings& settings);
+		//Carga un clip comprimido desde un archivo de cache, retorna false si este no es valido
+		bool LoadFromCache(const std::string& cachePath, const AssetCache::Key& key, const Skeleton& skeleton);
 		void RemoveRootMotion();
 		void RemoveJointTranslation(int jointIndex);
 		void RemoveJointRotation(int jointIndex);
 		void RemoveJointScaling(int jointIndex);
 		void DecompressRotations();
 
-		float GetSamplingTime(float time, bool isLooping) const;
-		std::pair<uint32_t, float> GetTimeFraction(const std::vector<float>& timeStamps, float time) const;
+		std::pair<uint32_t, float> GetTimeFraction(const std::vector<float>& timeStamps, float time, uint32_t* cursorKey = nullptr) const;
 		glm::vec3 GetPosition(float time, int joint, bool isLooping);
 		glm::fquat GetRotation(float time, int joint, bool isLooping);
 		glm::vec3 GetScale(float time, int joint, bool isLooping);
@@ -64,6 +102,7 @@ namespace Mona {
 		std::shared_ptr<Skeleton> m_skeletonPtr;
 		float m_duration = 1.0f;
 		std::string m_animationName;
+		std::unique_ptr<CompressedAnimationClip> m_compressedClip;
 	};
 }
 #endif
\ No newline at end of file
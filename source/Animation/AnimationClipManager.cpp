@@ -1,24 +1,83 @@
 #include "AnimationClipManager.hpp"
 #include "AnimationClip.hpp"
 #include "Skeleton.hpp"
+#include "../Core/AssetCache.hpp"
 namespace Mona {
+	namespace {
+		/*
+		* Llave de una animacion en los mapas del manager. Un mismo archivo cargado con distintas opciones produce
+		* animaciones distintas, por lo que la llave incluye si se removio el movimiento de la raiz y un hash de las
+		* opciones de compresion.
+		*/
+		std::string GetAnimationClipKey(const std::string& stringPath, bool removeRootMotion,
+			const std::optional<CompressedAnimationClip::Settings>& compression) {
+			std::string key = removeRootMotion ? stringPath : stringPath + "#rootMotion";
+			if (!compression.has_value())
+				return key;
+			uint64_t settingsHash = AssetCache::HashBytes(&compression->sampleRate, sizeof(float));
+			settingsHash = AssetCache::HashBytes(&compression->translationError, sizeof(float), settingsHash);
+			settingsHash = AssetCache::HashBytes(&compression->rotationError, sizeof(float), settingsHash);
+			settingsHash = AssetCache::HashBytes(&compression->scaleError, sizeof(float), settingsHash);
+			return key + "#compressed" + std::to_string(settingsHash);
+		}
+	}
+
 	std::shared_ptr<AnimationClip> AnimationClipManager::LoadAnimationClip(const std::filesystem::path& filePath,
 		std::shared_ptr<Skeleton> skeleton,
-		bool removeRootMotion) noexcept
+		bool removeRootMotion,
+		const std::optional<CompressedAnimationClip::Settings>& compression) noexcept
 	{
-		const std::string& stringPath = filePath.string();
+		const std::string stringPath = filePath.string();
+		const std::string clipKey = GetAnimationClipKey(stringPath, removeRootMotion, compression);
 		//En caso de que ya exista una entrada en el mapa de animaciones con el mismo path, 
 		// entonces se retorna inmediatamente dicha animacin.
-		auto it = m_animationClipMap.find(stringPath);
+		auto it = m_animationClipMap.find(clipKey);
 		if (it != m_animationClipMap.end()) {
 			return it->second;
 		}
+		//Si la animacion esta siendo cargada de forma asincrona se espera a que termine en vez de importarla de nuevo
+		auto pendingIt = m_pendingAnimationClipMap.find(clipKey);
+		if (pendingIt != m_pendingAnimationClipMap.end()) {
+			AssetFuture<AnimationClip> future = pendingIt->second;
+			return future.Wait();
+		}
 
-		AnimationClip* animationPtr = new AnimationClip(stringPath, skeleton, removeRootMotion);
+		AnimationClip* animationPtr = new AnimationClip(stringPath, skeleton, removeRootMotion, compression);
 		std::shared_ptr<AnimationClip> sharedPtr = std::shared_ptr<AnimationClip>(animationPtr);
-		m_animationClipMap.insert({ stringPath, sharedPtr });
+		m_animationClipMap.insert({ clipKey, sharedPtr });
 		return sharedPtr;
 	}
+	AssetFuture<AnimationClip> AnimationClipManager::LoadAnimationClipAsync(const std::filesystem::path& filePath,
+		std::shared_ptr<Skeleton> skeleton,
+		bool removeRootMotion,
+		const std::optional<CompressedAnimationClip::Settings>& compression) noexcept
+	{
+		const std::string stringPath = filePath.string();
+		const std::string clipKey = GetAnimationClipKey(stringPath, removeRootMotion, compression);
+		auto it = m_animationClipMap.find(clipKey);
+		if (it != m_animationClipMap.end()) {
+			return AssetFuture<AnimationClip>(it->second);
+		}
+		auto pendingIt = m_pendingAnimationClipMap.find(clipKey);
+		if (pendingIt != m_pendingAnimationClipMap.end()) {
+			return pendingIt->second;
+		}
+		AssetPromise<AnimationClip> promise;
+		m_pendingAnimationClipMap.insert({ clipKey, promise.GetFuture() });
+		AsyncAssetLoader& loader = AsyncAssetLoader::GetInstance();
+		loader.RunOnLoaderThread([this, &loader, stringPath, clipKey, skeleton, removeRootMotion, compression, promise]() {
+			std::shared_ptr<AnimationClip> sharedPtr =
+				std::shared_ptr<AnimationClip>(new AnimationClip(stringPath, skeleton, removeRootMotion, compression));
+			//Los mapas del manager solo se modifican desde el hilo principal
+			loader.RunOnMainThread([this, clipKey, sharedPtr, promise]() {
+				m_animationClipMap.insert({ clipKey, sharedPtr });
+				m_pendingAnimationClipMap.erase(clipKey);
+				promise.SetValue(sharedPtr);
+			});
+		});
+		return promise.GetFuture();
+	}
+
 	void AnimationClipManager::CleanUnusedAnimationClips() noexcept {
 		/*
 		* Elimina todos los punteros del mapa cuyo conteo de referencias es igual a uno,
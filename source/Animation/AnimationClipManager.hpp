@@ -4,6 +4,9 @@
 #include <memory>
 #include <filesystem>
 #include <unordered_map>
+#include <optional>
+#include "../Core/AssetFuture.hpp"
+#include "CompressedAnimationClip.hpp"
 namespace Mona {
 	class AnimationClip;
 	class Skeleton;
@@ -13,9 +16,23 @@ namespace Mona {
 		using AnimationClipMap = std::unordered_map<std::string, std::shared_ptr<AnimationClip>>;
 		AnimationClipManager(AnimationClipManager const&) = delete;
 		AnimationClipManager& operator=(AnimationClipManager const&) = delete;
+		/*
+		* Carga una animacion. Si se entregan opciones de compresion la animacion se remuestrea y cuantiza, lo que reduce
+		* su memoria y acelera su muestreo, pero impide editarla o usarla con IK. Las versiones comprimida y sin comprimir
+		* de un mismo archivo se guardan por separado, al igual que las cargadas con distintas opciones de compresion o de
+		* movimiento de la raiz.
+		*/
 		std::shared_ptr<AnimationClip> LoadAnimationClip(const std::filesystem::path& filePath,
 			std::shared_ptr<Skeleton> skeleton,
-			bool removeRootMotion = true) noexcept;
+			bool removeRootMotion = true,
+			const std::optional<CompressedAnimationClip::Settings>& compression = std::nullopt) noexcept;
+		/*
+		* Variante asincrona de LoadAnimationClip, la animacion se importa completamente en un hilo de carga.
+		*/
+		AssetFuture<AnimationClip> LoadAnimationClipAsync(const std::filesystem::path& filePath,
+			std::shared_ptr<Skeleton> skeleton,
+			bool removeRootMotion = true,
+			const std::optional<CompressedAnimationClip::Settings>& compression = std::nullopt) noexcept;
 		void CleanUnusedAnimationClips() noexcept;
 		static AnimationClipManager& GetInstance() noexcept {
 			static AnimationClipManager manager;
@@ -25,6 +42,7 @@ namespace Mona {
 		AnimationClipManager() = default;
 		void ShutDown() noexcept;
 		AnimationClipMap m_animationClipMap;
+		std::unordered_map<std::string, AssetFuture<AnimationClip>> m_pendingAnimationClipMap;
 	};
 }
 #endif
\ No newline at end of file
@@ -1,25 +1,19 @@
 #include "AnimationController.hpp"
 #include "AnimationClip.hpp"
 #include "Skeleton.hpp"
+#include <algorithm>
 #include <glm/gtx/matrix_decompose.hpp>
 #include "../Core/Log.hpp"
 namespace Mona {
-	void BlendPoses(std::vector<JointPose>& output,
-		std::vector<JointPose>& firstPose,
-		std::vector<JointPose>& secondPose,
-		float t)
-	{
-		for (uint32_t i = 0; i < output.size(); i++) {
-			output[i] = mix(firstPose[i], secondPose[i], t);
-		}
-	}
-
 	AnimationController::AnimationController(std::shared_ptr<AnimationClip> animation) noexcept : m_animationClipPtr(animation)
 	{
 		
 		MONA_ASSERT(animation != nullptr, "AnimationController Error: Starting animation cannot be null.");
 		auto skeleton = animation->GetSkeleton();
-		m_currentPose.resize(skeleton->JointCount());
+		m_currentPose.Resize(skeleton->JointCount());
+		//La paleta queda valida aun si el renderer dibuja antes de la primera actualizacion
+		m_matrixPalette.resize(skeleton->JointCount());
+		BuildMatrixPaletteSoA(m_currentPose, skeleton->GetSoAData(), m_matrixPalette);
 	}
 	void AnimationController::PlayAnimation(std::shared_ptr<AnimationClip> animation) noexcept {
 		if (animation == nullptr || m_animationClipPtr == animation)
@@ -28,6 +22,7 @@ namespace Mona {
 		m_sampleTime = 0.0f;
 		m_animationClipPtr = animation;
 		m_crossfadeTarget.Clear();
+		RestartUpdateInterval();
 	}
 
 	void AnimationController::FadeTo(std::shared_ptr<AnimationClip> animation,
@@ -43,6 +38,7 @@ namespace Mona {
 			m_animationClipPtr = m_crossfadeTarget.m_targetClip;
 			m_sampleTime = m_crossfadeTarget.m_sampleTime;
 			m_isLooping = m_crossfadeTarget.m_isLooping;
+			std::swap(m_keyframeCursor, m_crossfadeTarget.m_keyframeCursor);
 			m_crossfadeTarget.Clear();
 		}
 
@@ -56,6 +52,14 @@ namespace Mona {
 			fadeDuration,
 			startTime,
 			normalizedTimeClip);
+		RestartUpdateInterval();
+	}
+
+	void AnimationController::RestartUpdateInterval() noexcept {
+		//La pose hacia la que se interpola fue evaluada con la animacion anterior, por lo que se descarta y el proximo
+		//frame evalua una nueva a partir de la pose mostrada
+		m_updateFrame = 0;
+		m_updateInterval = 1;
 	}
 
 	void AnimationController::ClearFadeTo() noexcept {
@@ -64,7 +68,35 @@ namespace Mona {
 		m_crossfadeTarget.Clear();
 	}
 
-	void AnimationController::UpdateCurrentPose(float timeStep) noexcept {
+	void AnimationController::UpdateCurrentPose(float timeStep, const AnimationLODLevel& lod, PoseScratch& scratch) noexcept {
+		//El intervalo solo cambia al completar un ciclo, de modo que la pose calculada por adelantado siempre se alcance
+		if (m_updateFrame == 0) {
+			m_updateInterval = std::max(1u, lod.updateInterval);
+			if (m_updateInterval == 1) {
+				EvaluatePose(timeStep, lod.maxJointDepth, scratch);
+			}
+			else {
+				//Se parte desde la pose mostrada y se evalua la pose del final del intervalo
+				m_previousPose = m_currentPose;
+				EvaluatePose(timeStep * m_updateInterval, lod.maxJointDepth, scratch);
+				m_nextPose = m_currentPose;
+			}
+		}
+		if (1 < m_updateInterval) {
+			//En cada frame del intervalo la pose avanza una fraccion hacia la pose evaluada, llegando a ella en el ultimo
+			m_updateFrame = (m_updateFrame + 1) % m_updateInterval;
+			const float factor = m_updateFrame == 0 ? 1.0f : static_cast<float>(m_updateFrame) / m_updateInterval;
+			BlendPosesSoA(m_currentPose, m_previousPose, m_nextPose, factor);
+		}
+		BuildMatrixPalette();
+	}
+
+	void AnimationController::EvaluatePose(float timeStep, uint32_t maxJointDepth, PoseScratch& scratch) noexcept {
+		AdvanceTime(timeStep);
+		SamplePose(m_sampleTime, m_crossfadeTarget.m_sampleTime, GetCrossfadeFactor(), maxJointDepth, scratch);
+	}
+
+	void AnimationController::AdvanceTime(float timeStep) noexcept {
 		//Se avanza el tiempo pasado en la animacin objetivo
 		//Si ya ha transcurrido el tiempo dado de reproduccion de la animacion objetivo, esta pasa a ser la principal.
 		if (!m_crossfadeTarget.IsNullTarget()) {
@@ -73,22 +105,18 @@ namespace Mona {
 				m_animationClipPtr = m_crossfadeTarget.m_targetClip;
 				m_sampleTime = m_crossfadeTarget.m_sampleTime;
 				m_isLooping = m_crossfadeTarget.m_isLooping;
+				std::swap(m_keyframeCursor, m_crossfadeTarget.m_keyframeCursor);
 				m_crossfadeTarget.Clear();
 
 			}
 		}
 
-		//Limpiamos la pose actual
-		std::fill(m_currentPose.begin(), m_currentPose.end(), JointPose());
-
-		//Muestreamos los clips de animacion obteniendo las poses en espacio local
 		if (!m_crossfadeTarget.IsNullTarget())
 		{
 			float clipDuration = m_animationClipPtr->GetDuration();
 			float playbackFactorClip = 1.0f;
 			float playbackFactorTarget = 1.0f;
-			float factor = m_crossfadeTarget.m_elapsedTime / m_crossfadeTarget.m_fadeDuration;
-			if (factor > 1.0f) factor = 1.0f;
+			float factor = GetCrossfadeFactor();
 			//Si el tipo de blending es KeepSynchronize se debe hacer el trabajo extra
 			// de mantener las animaciones sincronizadas y de interpolar tambien
 			// el playback de estas.
@@ -102,45 +130,91 @@ namespace Mona {
 			else if (m_crossfadeTarget.m_blendType == BlendType::Freeze) {
 				playbackFactorClip = 0.0f;
 			}
-
-			//Muestreo de la animacin principal
-			m_sampleTime = m_animationClipPtr->Sample(m_currentPose,
-				m_sampleTime + timeStep * m_playRate * playbackFactorClip,
-				m_isLooping);
-
-			auto& targetPose = m_crossfadeTarget.m_currentPose;
-			std::fill(targetPose.begin(), targetPose.end(), JointPose());
-			//Muestreo de la animacin objetivo
-			m_crossfadeTarget.m_sampleTime = m_crossfadeTarget.m_targetClip->Sample(targetPose,
+			m_sampleTime = m_animationClipPtr->GetSamplingTime(m_sampleTime + timeStep * m_playRate * playbackFactorClip, m_isLooping);
+			m_crossfadeTarget.m_sampleTime = m_crossfadeTarget.m_targetClip->GetSamplingTime(
 				m_crossfadeTarget.m_sampleTime + timeStep * m_playRate * playbackFactorTarget,
 				m_crossfadeTarget.m_isLooping);
-			//Interpolacion entre ambas poses
-			BlendPoses(m_currentPose, m_currentPose, targetPose, factor);
 		}
 		else
 		{
-			m_sampleTime = m_animationClipPtr->Sample(m_currentPose, m_sampleTime + timeStep * m_playRate, m_isLooping);
+			m_sampleTime = m_animationClipPtr->GetSamplingTime(m_sampleTime + timeStep * m_playRate, m_isLooping);
 		}
+	}
 
+	float AnimationController::GetCrossfadeFactor() const noexcept {
+		if (m_crossfadeTarget.IsNullTarget())
+			return 0.0f;
+		float factor = m_crossfadeTarget.m_elapsedTime / m_crossfadeTarget.m_fadeDuration;
+		return factor > 1.0f ? 1.0f : factor;
+	}
 
-		//Recorrido del esqueleto para pasar de poses en espacio local a global.
-		auto skeleton = m_animationClipPtr->GetSkeleton();
-		for (uint32_t i = 1; i < m_currentPose.size(); i++) {
-			int32_t parentIndex = skeleton->GetParentIndex(i);
-			m_currentPose[i] = m_currentPose[parentIndex] * m_currentPose[i];
+	void AnimationController::SamplePose(float sampleTime,
+		float targetSampleTime,
+		float crossfadeFactor,
+		uint32_t maxJointDepth,
+		PoseScratch& scratch) noexcept {
+		//Se ajustan los buffers temporales del hilo al esqueleto y se limpia la pose de muestreo
+		const Skeleton& skeleton = *m_animationClipPtr->GetSkeleton();
+		const uint32_t jointCount = static_cast<uint32_t>(skeleton.JointCount());
+		std::vector<JointPose>& samplePose = scratch.samplePose;
+		samplePose.resize(jointCount);
+		if (scratch.targetPose.GetJointCount() != jointCount)
+			scratch.targetPose.Resize(jointCount);
+		std::fill(samplePose.begin(), samplePose.end(), JointPose());
+		/*
+		* Con una mascara de articulaciones la animacion principal se muestrea sobre la pose local persistente, donde las
+		* articulaciones omitidas conservan su valor. Esta se muestrea completa al crearse o al cambiar de clip.
+		*/
+		if (!m_localPose.empty() || maxJointDepth != AnimationLODLevel::AllJoints) {
+			if (m_localPoseClip != m_animationClipPtr.get()) {
+				m_localPose.assign(jointCount, JointPose());
+				m_localPoseClip = m_animationClipPtr.get();
+				maxJointDepth = AnimationLODLevel::AllJoints;
+			}
 		}
+		std::vector<JointPose>& mainPose = m_localPose.empty() ? samplePose : m_localPose;
+
+		//Muestreamos los clips de animacion obteniendo las poses en espacio local
+		//Muestreo de la animacin principal
+		m_animationClipPtr->Sample(mainPose, sampleTime, m_isLooping, &m_keyframeCursor, maxJointDepth);
+		m_currentPose.SetFromJointPoses(mainPose);
+		if (!m_crossfadeTarget.IsNullTarget())
+		{
+			std::fill(samplePose.begin(), samplePose.end(), JointPose());
+			//Muestreo de la animacin objetivo
+			m_crossfadeTarget.m_targetClip->Sample(samplePose,
+				targetSampleTime,
+				m_crossfadeTarget.m_isLooping,
+				&m_crossfadeTarget.m_keyframeCursor);
+			scratch.targetPose.SetFromJointPoses(samplePose);
+			//Interpolacion entre ambas poses
+			BlendPosesSoA(m_currentPose, m_currentPose, scratch.targetPose, crossfadeFactor);
+		}
+
+		//Recorrido del esqueleto, nivel por nivel, para pasar de poses en espacio local a global.
+		LocalToModelSoA(m_currentPose, skeleton.GetSoAData());
+	}
+
+	void AnimationController::BuildMatrixPalette() noexcept {
+		//La paleta se calcula aqui, en paralelo por personaje, y el renderer solo la lee
+		BuildMatrixPaletteSoA(m_currentPose, m_animationClipPtr->GetSkeleton()->GetSoAData(), m_matrixPalette);
+	}
+
+	void AnimationController::CopyPose(const AnimationController& source) noexcept {
+		m_currentPose = source.m_currentPose;
+		m_matrixPalette = source.m_matrixPalette;
+		//La pose copiada reemplaza cualquier interpolacion de nivel de detalle en curso
+		m_updateInterval = 1;
+		m_updateFrame = 0;
 	}
 
 	void AnimationController::GetMatrixPalette(std::vector<glm::mat4>& outMatrixPalette) const
 	{
 		
 		auto skeleton = m_animationClipPtr->GetSkeleton();
-		auto& invBindPoseMatrices = skeleton->GetInverseBindPoseMatrices();
 		//Se expresan las poses como matrices y se multiplican por la inverse bind pose antes de enviar
-		// la informacin al renderer.
-		for (uint32_t i = 0; i < skeleton->JointCount(); i++) {
-			outMatrixPalette[i] = JointPoseToMat4(m_currentPose[i]) * invBindPoseMatrices[i];
-		}
+		// la informacin al renderer, cuatro articulaciones a la vez.
+		BuildMatrixPaletteSoA(m_currentPose, skeleton->GetSoAData(), outMatrixPalette);
 	}
 
 	JointPose AnimationController::GetJointModelPose(uint32_t jointIndex) const {
@@ -152,7 +226,7 @@ namespace Mona {
 		glm::vec3 skew;
 		glm::vec4 perspective;
 		glm::decompose(invBindMatrix, scale, rotation, translation, skew, perspective);
-		return m_currentPose[jointIndex] * JointPose(rotation, translation, scale);
+		return m_currentPose.GetJointPose(jointIndex) * JointPose(rotation, translation, scale);
 	}
 
 }
\ No newline at end of file
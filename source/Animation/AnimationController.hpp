@@ -5,6 +5,8 @@
 #include <memory>
 #include "CrossFadeTarget.hpp"
 #include "JointPose.hpp"
+#include "PoseSoA.hpp"
+#include "AnimationLOD.hpp"
 namespace Mona {
 	class AnimationClip;
 	class AnimationController {
@@ -12,6 +14,16 @@ namespace Mona {
 		friend class AnimationSystem;
 		friend class World;
 	public:
+		/*
+		* Buffers temporales de UpdateCurrentPose. No guardan estado entre frames, por lo que AnimationSystem mantiene uno
+		* por hilo en vez de uno por personaje.
+		*/
+		struct PoseScratch {
+			//Pose local donde se muestrean los clips antes de pasarla a formato SoA
+			std::vector<JointPose> samplePose;
+			//Pose SoA de la animacion objetivo durante un crossfade
+			PoseSoA targetPose;
+		};
 		AnimationController(std::shared_ptr<AnimationClip> animation) noexcept;
 		void PlayAnimation(std::shared_ptr<AnimationClip> animation) noexcept;
 		void FadeTo(std::shared_ptr<AnimationClip> animation,
@@ -24,14 +36,52 @@ namespace Mona {
 		void SetPlayRate(float playrate) { m_playRate = playrate; }
 		float GetPlayRate() const { return m_playRate; }
 		void GetMatrixPalette(std::vector<glm::mat4>& outMatrixPalette) const;
+		//Paleta de matrices calculada en la ultima actualizacion de la pose, lista para enviarse al renderer
+		const std::vector<glm::mat4>& GetCurrentMatrixPalette() const { return m_matrixPalette; }
 		std::shared_ptr<AnimationClip> GetCurrentAnimation() const { return m_animationClipPtr;  }
 		JointPose GetJointModelPose(uint32_t jointIndex) const;
+		//Cada cuantos frames se estan muestreando los clips segun el nivel de detalle actual
+		uint32_t GetUpdateInterval() const { return m_updateInterval; }
 	private:
-		void UpdateCurrentPose(float timeStep) noexcept;
+		//Avanza la animacion segun el nivel de detalle dado, calcula la pose en espacio de modelo y su paleta de matrices
+		void UpdateCurrentPose(float timeStep, const AnimationLODLevel& lod, PoseScratch& scratch) noexcept;
+		//Avanza los clips timeStep segundos y deja en m_currentPose la pose muestreada, en espacio de modelo
+		void EvaluatePose(float timeStep, uint32_t maxJointDepth, PoseScratch& scratch) noexcept;
+		//Avanza los tiempos de muestreo y el crossfade sin muestrear los clips
+		void AdvanceTime(float timeStep) noexcept;
+		//Factor de interpolacion hacia la animacion objetivo, 0 si no hay crossfade
+		float GetCrossfadeFactor() const noexcept;
+		//Muestrea los clips en los tiempos dados y deja en m_currentPose la pose en espacio de modelo
+		void SamplePose(float sampleTime,
+			float targetSampleTime,
+			float crossfadeFactor,
+			uint32_t maxJointDepth,
+			PoseScratch& scratch) noexcept;
+		void BuildMatrixPalette() noexcept;
+		//Fuerza a que el proximo UpdateCurrentPose evalue la pose en vez de interpolar, usado al cambiar de animacion
+		void RestartUpdateInterval() noexcept;
+		//Reemplaza la pose y la paleta por las de source, que debe usar el mismo esqueleto
+		void CopyPose(const AnimationController& source) noexcept;
 		float m_sampleTime = 0.0f;
 		float m_playRate = 1.0f;
 		bool m_isLooping = true;
-		std::vector<JointPose> m_currentPose;
+		//Pose actual en espacio de modelo, en formato SoA para los kernels de blending, jerarquia y paleta
+		PoseSoA m_currentPose;
+		std::vector<glm::mat4> m_matrixPalette;
+		//Poses en espacio de modelo entre las que se interpola cuando los clips no se muestrean todos los frames
+		PoseSoA m_previousPose;
+		PoseSoA m_nextPose;
+		uint32_t m_updateInterval = 1;
+		//Frame actual dentro del intervalo de actualizacion, la pose se evalua cuando es 0
+		uint32_t m_updateFrame = 0;
+		/*
+		* Pose local persistente de la animacion principal, usada solo una vez que algun nivel de detalle enmascara
+		* articulaciones, ya que estas deben conservar su ultimo valor muestreado.
+		*/
+		std::vector<JointPose> m_localPose;
+		const AnimationClip* m_localPoseClip = nullptr;
+		//Cursor de muestras de la animacion principal, la animacion objetivo tiene el suyo en m_crossfadeTarget
+		AnimationClip::KeyframeCursor m_keyframeCursor;
 		CrossFadeTarget m_crossfadeTarget;
 		std::shared_ptr<AnimationClip> m_animationClipPtr;
 	};
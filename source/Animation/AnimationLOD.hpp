@@ -0,0 +1,28 @@
+#pragma once
+#ifndef ANIMATIONLOD_HPP
+#define ANIMATIONLOD_HPP
+#include <cstdint>
+#include <limits>
+namespace Mona {
+	/*
+	* Nivel de detalle de la animacion de un SkeletalMeshComponent. AnimationSystem elige, segun la distancia del personaje
+	* a la camara principal, el nivel de mayor minDistance que no la supere.
+	*/
+	struct AnimationLODLevel {
+		//Profundidad usada por maxJointDepth para muestrear todas las articulaciones
+		static constexpr uint32_t AllJoints = std::numeric_limits<uint32_t>::max();
+		//Distancia a la camara principal desde la cual se usa este nivel
+		float minDistance = 0.0f;
+		/*
+		* Cada cuantos frames se muestrean los clips (1 es todos los frames). En los frames intermedios la pose se interpola
+		* entre la ultima evaluacion y la siguiente, que se calcula por adelantado.
+		*/
+		uint32_t updateInterval = 1;
+		/*
+		* Profundidad maxima en la jerarquia del esqueleto (la raiz tiene profundidad 0) de las articulaciones muestreadas.
+		* Las mas profundas, como dedos y huesos de la cara, conservan su ultima pose local muestreada.
+		*/
+		uint32_t maxJointDepth = AllJoints;
+	};
+}
+#endif
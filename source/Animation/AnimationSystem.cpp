@@ -1,13 +1,154 @@
 #include "AnimationSystem.hpp"
+#include <cmath>
+#include <functional>
 #include "../World/ComponentManager.hpp"
+#include "../Core/JobSystem.hpp"
+#include "../World/GameObject.hpp"
 namespace Mona {
-	void AnimationSystem::UpdateAllPoses(ComponentManager<SkeletalMeshComponent>& skeletalMeshDataManager, float timeStep) noexcept {
+	void AnimationSystem::UpdateAllPoses(SkeletalMeshGroup& skeletalMeshGroup,
+		ComponentManager<TransformComponent>& transformDataManager,
+		ComponentManager<CameraComponent>& cameraDataManager,
+		const InnerComponentHandle& cameraHandle,
+		float timeStep,
+		JobSystem& jobSystem) noexcept {
+		//Un juego de buffers temporales por hilo, de modo que ningun personaje los comparta durante la actualizacin.
+		const size_t threadCount = std::max<size_t>(1, jobSystem.GetThreadCount());
+		if (m_threadScratch.size() < threadCount)
+			m_threadScratch.resize(threadCount);
+		//Sin camara principal todos los personajes usan su nivel de detalle mas cercano
+		const bool hasCamera = cameraDataManager.IsValid(cameraHandle);
+		glm::vec3 cameraPosition = glm::vec3(0.0f);
+		if (hasCamera) {
+			GameObject* cameraOwner = cameraDataManager.GetOwner(cameraHandle);
+			cameraPosition = transformDataManager.GetComponentPointer(cameraOwner->GetInnerComponentHandle<TransformComponent>())->GetWorldTranslation();
+		}
 		//Se itera sobre todas las componentes de animacin, los animation controller son los responsables de la logica de
-		//actualizacin.
-		for (uint32_t i = 0; i < skeletalMeshDataManager.GetCount(); i++) {
-			SkeletalMeshComponent& skeletalMesh = skeletalMeshDataManager[i];
+		//actualizacin. Cada controlador solo escribe su propio estado, por lo que se reparten entre los hilos.
+		const uint32_t characterCount = skeletalMeshGroup.GetCount();
+		const bool usePoseCache = IsPoseCacheEnabled();
+		if (usePoseCache) {
+			m_poseCacheKeys.resize(characterCount);
+			m_poseCacheSources.resize(characterCount);
+		}
+		jobSystem.ParallelFor(characterCount, CharactersPerJob, [&](size_t i) {
+			SkeletalMeshComponent& skeletalMesh = skeletalMeshGroup.Get<SkeletalMeshComponent>(static_cast<uint32_t>(i));
+			const auto& levels = skeletalMesh.GetAnimationLODLevels();
+			float distance = 0.0f;
+			if (hasCamera && !levels.empty()) {
+				const TransformComponent& transform = skeletalMeshGroup.Get<TransformComponent>(static_cast<uint32_t>(i));
+				distance = glm::distance(transform.GetWorldTranslation(), cameraPosition);
+			}
+			const AnimationLODLevel& lod = SelectLODLevel(levels, distance);
 			auto& animationController = skeletalMesh.GetAnimationController();
-			animationController.UpdateCurrentPose(timeStep);
+			//Con el cache activo solo se avanza el tiempo, la pose se evalua una vez agrupados los personajes por llave.
+			//Un controlador a mitad de un intervalo ya avanzo su tiempo hasta el final de este, por lo que lo completa
+			//interpolando y solo entra al cache al comenzar el siguiente.
+			if (usePoseCache && animationController.m_updateFrame == 0 && lod.updateInterval == 1 &&
+				lod.maxJointDepth == AnimationLODLevel::AllJoints) {
+				animationController.RestartUpdateInterval();
+				animationController.AdvanceTime(timeStep);
+				m_poseCacheKeys[i] = GetPoseCacheKey(animationController);
+				m_poseCacheSources[i] = static_cast<uint32_t>(i);
+				return;
+			}
+			if (usePoseCache)
+				m_poseCacheSources[i] = NotCached;
+			animationController.UpdateCurrentPose(timeStep, lod, m_threadScratch[JobSystem::GetCurrentThreadIndex()]);
+		});
+		if (!usePoseCache) {
+			UpdateBoundingBoxes(skeletalMeshGroup, jobSystem);
+			return;
+		}
+
+		//El primer personaje con cada llave la evalua y el resto copia su resultado
+		m_poseCacheEntries.clear();
+		m_poseCacheEvaluations.clear();
+		m_poseCacheCopies.clear();
+		for (uint32_t i = 0; i < characterCount; i++) {
+			if (m_poseCacheSources[i] == NotCached)
+				continue;
+			auto result = m_poseCacheEntries.try_emplace(m_poseCacheKeys[i], i);
+			if (result.second) {
+				m_poseCacheEvaluations.push_back(i);
+			}
+			else {
+				m_poseCacheSources[i] = result.first->second;
+				m_poseCacheCopies.push_back(i);
+			}
 		}
+		m_poseCacheStats.frameHits = static_cast<uint32_t>(m_poseCacheCopies.size());
+		m_poseCacheStats.frameMisses = static_cast<uint32_t>(m_poseCacheEvaluations.size());
+		m_poseCacheStats.hits += m_poseCacheStats.frameHits;
+		m_poseCacheStats.misses += m_poseCacheStats.frameMisses;
+
+		//Se muestrea en los tiempos cuantizados de la llave, de modo que el resultado no dependa de que personaje la evalua
+		jobSystem.ParallelFor(m_poseCacheEvaluations.size(), CharactersPerJob, [&](size_t k) {
+			const uint32_t i = m_poseCacheEvaluations[k];
+			const PoseCacheKey& key = m_poseCacheKeys[i];
+			auto& animationController = skeletalMeshGroup.Get<SkeletalMeshComponent>(i).GetAnimationController();
+			animationController.SamplePose(key.sampleTime * m_poseCacheTimeQuantum,
+				key.targetSampleTime * m_poseCacheTimeQuantum,
+				static_cast<float>(key.crossfadeFactor) / PoseCacheBlendSteps,
+				AnimationLODLevel::AllJoints,
+				m_threadScratch[JobSystem::GetCurrentThreadIndex()]);
+			animationController.BuildMatrixPalette();
+		});
+		jobSystem.ParallelFor(m_poseCacheCopies.size(), PoseCopiesPerJob, [&](size_t k) {
+			const uint32_t i = m_poseCacheCopies[k];
+			skeletalMeshGroup.Get<SkeletalMeshComponent>(i).GetAnimationController().CopyPose(
+				skeletalMeshGroup.Get<SkeletalMeshComponent>(m_poseCacheSources[i]).GetAnimationController());
+		});
+		UpdateBoundingBoxes(skeletalMeshGroup, jobSystem);
+	}
+
+	void AnimationSystem::UpdateBoundingBoxes(SkeletalMeshGroup& skeletalMeshGroup, JobSystem& jobSystem) noexcept {
+		jobSystem.ParallelFor(skeletalMeshGroup.GetCount(), PoseCopiesPerJob, [&](size_t i) {
+			skeletalMeshGroup.Get<SkeletalMeshComponent>(static_cast<uint32_t>(i)).UpdateBoundingBox();
+		});
+	}
+
+	void AnimationSystem::EnablePoseCache(float timeQuantum) noexcept {
+		MONA_ASSERT(timeQuantum > 0.0f, "AnimationSystem Error: Pose cache time quantum must be positive.");
+		m_poseCacheTimeQuantum = timeQuantum;
+	}
+
+	AnimationSystem::PoseCacheKey AnimationSystem::GetPoseCacheKey(const AnimationController& animationController) const noexcept {
+		//Se redondea hacia abajo para que el tiempo cuantizado nunca supere la duracion del clip
+		PoseCacheKey key;
+		key.skeleton = animationController.m_animationClipPtr->GetSkeleton().get();
+		key.clip = animationController.m_animationClipPtr.get();
+		key.sampleTime = static_cast<int32_t>(std::floor(animationController.m_sampleTime / m_poseCacheTimeQuantum));
+		key.isLooping = animationController.m_isLooping;
+		const CrossFadeTarget& crossfadeTarget = animationController.m_crossfadeTarget;
+		if (!crossfadeTarget.IsNullTarget()) {
+			key.targetClip = crossfadeTarget.m_targetClip.get();
+			key.targetSampleTime = static_cast<int32_t>(std::floor(crossfadeTarget.m_sampleTime / m_poseCacheTimeQuantum));
+			key.crossfadeFactor = static_cast<int32_t>(std::round(animationController.GetCrossfadeFactor() * PoseCacheBlendSteps));
+			key.isTargetLooping = crossfadeTarget.m_isLooping;
+		}
+		return key;
+	}
+
+	size_t AnimationSystem::PoseCacheKeyHash::operator()(const PoseCacheKey& key) const noexcept {
+		size_t hash = std::hash<const void*>()(key.skeleton);
+		auto combine = [&hash](size_t value) { hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+		combine(std::hash<const void*>()(key.clip));
+		combine(std::hash<const void*>()(key.targetClip));
+		combine(std::hash<int32_t>()(key.sampleTime));
+		combine(std::hash<int32_t>()(key.targetSampleTime));
+		combine(std::hash<int32_t>()(key.crossfadeFactor));
+		combine((key.isLooping ? 1 : 0) | (key.isTargetLooping ? 2 : 0));
+		return hash;
+	}
+
+	const AnimationLODLevel& AnimationSystem::SelectLODLevel(const std::vector<AnimationLODLevel>& levels, float distance) noexcept {
+		static const AnimationLODLevel defaultLevel;
+		if (levels.empty())
+			return defaultLevel;
+		//Los niveles estan ordenados por distancia minima, el primero se usa tambien por debajo de su distancia
+		size_t selected = 0;
+		while (selected + 1 < levels.size() && levels[selected + 1].minDistance <= distance)
+			selected++;
+		return levels[selected];
 	}
 }
\ No newline at end of file
@@ -1,12 +1,97 @@
 #pragma once
 #ifndef ANIMATIONSYSTEM_HPP
 #define ANIMATIONSYSTEM_HPP
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <unordered_map>
+#include <glm/glm.hpp>
 #include "SkeletalMeshComponent.hpp"
+#include "../World/TransformComponent.hpp"
+#include "../World/ComponentGroup.hpp"
+#include "../Rendering/CameraComponent.hpp"
 namespace Mona {
+	class JobSystem;
+	class Skeleton;
+	//Personajes con su transformacion, alineados por indice
+	using SkeletalMeshGroup = ComponentGroup<SkeletalMeshComponent, TransformComponent>;
 	class AnimationSystem {
 	public:
+		//Componentes leidas y escritas por UpdateAllPoses, usadas por World para agendar etapas concurrentes
+		using ReadComponents = ComponentTypeList<TransformComponent, CameraComponent>;
+		using WriteComponents = ComponentTypeList<SkeletalMeshComponent>;
 		AnimationSystem() = default;
-		void UpdateAllPoses(ComponentManager<SkeletalMeshComponent>& skeletalMeshDataManager, float timeStep) noexcept;
+		/*
+		* Actualiza la pose y la paleta de matrices de todos los personajes. Los personajes son independientes entre si,
+		* por lo que se reparten entre los hilos de jobSystem, cada uno con sus propios buffers temporales. El nivel de
+		* detalle de cada personaje se elige segun su distancia a la camara principal (cameraHandle). Los personajes se
+		* recorren a traves de skeletalMeshGroup, que contiene a todas las SkeletalMeshComponent ya que dependen de
+		* TransformComponent. Al final se recalcula la caja de cada personaje en su nueva pose, usada para culling.
+		*/
+		void UpdateAllPoses(SkeletalMeshGroup& skeletalMeshGroup,
+			ComponentManager<TransformComponent>& transformDataManager,
+			ComponentManager<CameraComponent>& cameraDataManager,
+			const InnerComponentHandle& cameraHandle,
+			float timeStep,
+			JobSystem& jobSystem) noexcept;
+
+		//Estadisticas del cache de poses. Un acierto es un personaje que copia la pose de otro en vez de evaluarla.
+		struct PoseCacheStats {
+			uint64_t hits = 0;
+			uint64_t misses = 0;
+			//Valores del ultimo llamado a UpdateAllPoses
+			uint32_t frameHits = 0;
+			uint32_t frameMisses = 0;
+		};
+		/*
+		* Activa el cache de poses compartidas. Los personajes con el mismo esqueleto, los mismos clips y tiempos de muestreo
+		* que caen en el mismo multiplo de timeQuantum (y el mismo avance de crossfade) se evaluan una sola vez por frame, y
+		* el resto copia la pose y la paleta resultantes. Los personajes cuyo nivel de detalle interpola o enmascara
+		* articulaciones quedan fuera del cache.
+		*/
+		void EnablePoseCache(float timeQuantum = 1.0f / 30.0f) noexcept;
+		void DisablePoseCache() noexcept { m_poseCacheTimeQuantum = 0.0f; }
+		bool IsPoseCacheEnabled() const noexcept { return m_poseCacheTimeQuantum > 0.0f; }
+		const PoseCacheStats& GetPoseCacheStats() const noexcept { return m_poseCacheStats; }
+		void ResetPoseCacheStats() noexcept { m_poseCacheStats = PoseCacheStats(); }
+	private:
+		void UpdateBoundingBoxes(SkeletalMeshGroup& skeletalMeshGroup, JobSystem& jobSystem) noexcept;
+		struct PoseCacheKey {
+			const Skeleton* skeleton = nullptr;
+			const AnimationClip* clip = nullptr;
+			const AnimationClip* targetClip = nullptr;
+			//Tiempos de muestreo en multiplos de m_poseCacheTimeQuantum y factor de crossfade en pasos de PoseCacheBlendSteps
+			int32_t sampleTime = 0;
+			int32_t targetSampleTime = 0;
+			int32_t crossfadeFactor = 0;
+			bool isLooping = false;
+			bool isTargetLooping = false;
+			bool operator==(const PoseCacheKey& other) const = default;
+		};
+		struct PoseCacheKeyHash {
+			size_t operator()(const PoseCacheKey& key) const noexcept;
+		};
+		PoseCacheKey GetPoseCacheKey(const AnimationController& animationController) const noexcept;
+		//Nivel de mayor distancia minima que no supera distance, o el nivel por defecto si no hay niveles configurados
+		static const AnimationLODLevel& SelectLODLevel(const std::vector<AnimationLODLevel>& levels, float distance) noexcept;
+		//Cantidad de personajes por trabajo, suficiente para amortizar el costo de encolar
+		static constexpr size_t CharactersPerJob = 4;
+		//Las copias de poses son mucho mas baratas que las evaluaciones, por lo que se agrupan mas por trabajo
+		static constexpr size_t PoseCopiesPerJob = 32;
+		static constexpr int32_t PoseCacheBlendSteps = 16;
+		//Fuente de los personajes fuera del cache en m_poseCacheSources
+		static constexpr uint32_t NotCached = std::numeric_limits<uint32_t>::max();
+		//Buffers temporales indexados por JobSystem::GetCurrentThreadIndex
+		std::vector<AnimationController::PoseScratch> m_threadScratch;
+		//Cuantizacion del tiempo de muestreo, 0 desactiva el cache
+		float m_poseCacheTimeQuantum = 0.0f;
+		//Por personaje: llave de su pose y personaje que la evalua (el mismo si es el primero con esa llave)
+		std::vector<PoseCacheKey> m_poseCacheKeys;
+		std::vector<uint32_t> m_poseCacheSources;
+		std::vector<uint32_t> m_poseCacheEvaluations;
+		std::vector<uint32_t> m_poseCacheCopies;
+		std::unordered_map<PoseCacheKey, uint32_t, PoseCacheKeyHash> m_poseCacheEntries;
+		PoseCacheStats m_poseCacheStats;
 	};
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,294 @@
+#include "CompressedAnimationClip.hpp"
+#include <algorithm>
+#include <cmath>
+#include "../Core/AssetCache.hpp"
+#include "../Core/Log.hpp"
+namespace Mona {
+
+	namespace {
+		//Las tres componentes menores de un cuaternion unitario estan en [-1/sqrt(2), 1/sqrt(2)] y se cuantizan a 15 bits
+		constexpr float RotationRange = 0.70710678f;
+		constexpr float RotationStep = 2.0f * RotationRange / 32767.0f;
+		constexpr uint16_t RotationComponentMask = 0x7FFF;
+
+		inline uint16_t QuantizeRotationComponent(float value) noexcept {
+			const float clamped = std::clamp(value, -RotationRange, RotationRange);
+			return static_cast<uint16_t>(std::lround((clamped + RotationRange) / RotationStep));
+		}
+
+		inline void EncodeRotation(const glm::fquat& rotation, uint16_t& outA, uint16_t& outB, uint16_t& outC) noexcept {
+			const glm::fquat q = glm::normalize(rotation);
+			const float components[4] = { q.x, q.y, q.z, q.w };
+			uint32_t largest = 0;
+			for (uint32_t i = 1; i < 4; i++) {
+				if (std::abs(components[i]) > std::abs(components[largest]))
+					largest = i;
+			}
+			//q y -q representan la misma rotacion, se elige el signo que deja positiva la componente omitida
+			const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+			uint16_t quantized[3];
+			uint32_t j = 0;
+			for (uint32_t i = 0; i < 4; i++) {
+				if (i != largest)
+					quantized[j++] = QuantizeRotationComponent(sign * components[i]);
+			}
+			outA = quantized[0] | static_cast<uint16_t>((largest & 1) << 15);
+			outB = quantized[1] | static_cast<uint16_t>((largest >> 1) << 15);
+			outC = quantized[2];
+		}
+
+		//Decodificacion sin saltos, las selecciones se compilan como mezclas dentro de un ciclo vectorizado
+		inline void DecodeRotation(uint16_t a, uint16_t b, uint16_t c, float& x, float& y, float& z, float& w) noexcept {
+			const uint32_t largest = (a >> 15) | ((b >> 15) << 1);
+			const float fa = (a & RotationComponentMask) * RotationStep - RotationRange;
+			const float fb = (b & RotationComponentMask) * RotationStep - RotationRange;
+			const float fc = (c & RotationComponentMask) * RotationStep - RotationRange;
+			const float fd = std::sqrt(std::max(0.0f, 1.0f - fa * fa - fb * fb - fc * fc));
+			x = largest == 0 ? fd : fa;
+			y = largest == 0 ? fa : (largest == 1 ? fd : fb);
+			z = largest <= 1 ? fb : (largest == 2 ? fd : fc);
+			w = largest == 3 ? fd : fc;
+		}
+
+		//Angulo de la rotacion relativa, con atan2 en vez de acos para conservar precision en angulos pequenos
+		inline float AngleBetween(const glm::fquat& lhs, const glm::fquat& rhs) noexcept {
+			const glm::fquat delta = glm::conjugate(glm::normalize(lhs)) * glm::normalize(rhs);
+			return 2.0f * std::atan2(glm::length(glm::vec3(delta.x, delta.y, delta.z)), std::abs(delta.w));
+		}
+	}
+
+	CompressedAnimationClip::CompressedAnimationClip(const std::vector<std::vector<JointPose>>& frames,
+		const std::vector<int>& trackJointIndices,
+		float duration,
+		const Settings& settings) :
+		m_duration(duration),
+		m_frameCount(static_cast<uint32_t>(frames.size()))
+	{
+		MONA_ASSERT(m_frameCount >= 2, "CompressedAnimationClip Error: At least two frames are required");
+		const size_t trackCount = trackJointIndices.size();
+		m_trackJointIndices.assign(trackJointIndices.begin(), trackJointIndices.end());
+
+		//Rotaciones: un canal es constante si ningun frame se aleja de su valor inicial mas que el error permitido
+		m_restRotations.resize(trackCount);
+		for (uint32_t i = 0; i < trackCount; i++) {
+			const glm::fquat& rest = frames[0][i].m_rotation;
+			m_restRotations[i] = glm::normalize(rest);
+			float maxAngle = 0.0f;
+			for (uint32_t f = 1; f < m_frameCount; f++) {
+				maxAngle = std::max(maxAngle, AngleBetween(rest, frames[f][i].m_rotation));
+			}
+			if (maxAngle > settings.rotationError)
+				m_rotationTracks.push_back(i);
+		}
+		const size_t rotationCount = m_rotationTracks.size();
+		m_rotationData.resize(3 * rotationCount * m_frameCount);
+		for (uint32_t f = 0; f < m_frameCount; f++) {
+			uint16_t* frameData = m_rotationData.data() + 3 * rotationCount * f;
+			for (size_t i = 0; i < rotationCount; i++) {
+				EncodeRotation(frames[f][m_rotationTracks[i]].m_rotation,
+					frameData[i], frameData[rotationCount + i], frameData[2 * rotationCount + i]);
+			}
+		}
+
+		QuantizeTracks(frames, &JointPose::m_translation, settings.translationError, "Translation", m_restTranslations, m_translations);
+		QuantizeTracks(frames, &JointPose::m_scale, settings.scaleError, "Scale", m_restScales, m_scales);
+	}
+
+	void CompressedAnimationClip::QuantizeTracks(const std::vector<std::vector<JointPose>>& frames,
+		glm::vec3 JointPose::* channel,
+		float maxError,
+		const char* channelName,
+		std::vector<glm::vec3>& outRest,
+		QuantizedTracks& outTracks) noexcept
+	{
+		const size_t trackCount = frames[0].size();
+		const size_t frameCount = frames.size();
+		std::vector<glm::vec3> minimums;
+		std::vector<glm::vec3> steps;
+		outRest.resize(trackCount);
+		for (uint32_t i = 0; i < trackCount; i++) {
+			glm::vec3 minimum = frames[0][i].*channel;
+			glm::vec3 maximum = minimum;
+			for (size_t f = 1; f < frameCount; f++) {
+				minimum = glm::min(minimum, frames[f][i].*channel);
+				maximum = glm::max(maximum, frames[f][i].*channel);
+			}
+			//Como valor constante se usa el centro del rango, que minimiza el error maximo
+			outRest[i] = 0.5f * (minimum + maximum);
+			if (glm::length(0.5f * (maximum - minimum)) <= maxError)
+				continue;
+			const glm::vec3 step = (maximum - minimum) / 65535.0f;
+			//El error de cuantizacion es a lo mas medio paso por componente
+			const float quantizationError = glm::length(0.5f * step);
+			if (quantizationError > maxError) {
+				MONA_LOG_WARNING("CompressedAnimationClip Warning: {0} track {1} exceeds the error budget after quantization ({2} > {3})",
+					channelName, i, quantizationError, maxError);
+			}
+			outTracks.tracks.push_back(i);
+			minimums.push_back(minimum);
+			steps.push_back(step);
+		}
+
+		const size_t count = outTracks.tracks.size();
+		outTracks.ranges.resize(6 * count);
+		for (size_t i = 0; i < count; i++) {
+			for (int c = 0; c < 3; c++) {
+				outTracks.ranges[c * count + i] = minimums[i][c];
+				outTracks.ranges[(3 + c) * count + i] = steps[i][c];
+			}
+		}
+		outTracks.data.resize(3 * count * frameCount);
+		for (size_t f = 0; f < frameCount; f++) {
+			uint16_t* frameData = outTracks.data.data() + 3 * count * f;
+			for (size_t i = 0; i < count; i++) {
+				const glm::vec3& value = frames[f][outTracks.tracks[i]].*channel;
+				for (int c = 0; c < 3; c++) {
+					const float step = steps[i][c];
+					const float quantized = step > 0.0f ? std::round((value[c] - minimums[i][c]) / step) : 0.0f;
+					frameData[c * count + i] = static_cast<uint16_t>(std::clamp(quantized, 0.0f, 65535.0f));
+				}
+			}
+		}
+	}
+
+	void CompressedAnimationClip::Sample(std::vector<JointPose>& outPose, float time) const noexcept {
+		//Primero se escriben los valores de reposo, los canales animados se sobrescriben a continuacion
+		for (size_t i = 0; i < m_trackJointIndices.size(); i++) {
+			outPose[m_trackJointIndices[i]] = JointPose(m_restRotations[i], m_restTranslations[i], m_restScales[i]);
+		}
+		if (m_frameCount < 2)
+			return;
+		//Al estar remuestreado uniformemente, el frame se obtiene directamente del tiempo
+		const float framePosition = m_duration > 0.0f ? std::clamp(time / m_duration, 0.0f, 1.0f) * (m_frameCount - 1) : 0.0f;
+		const uint32_t frame = std::min(static_cast<uint32_t>(framePosition), m_frameCount - 2);
+		const float fraction = framePosition - static_cast<float>(frame);
+		DecodeRotations(frame, fraction, outPose);
+		DecodeTracks(m_translations, frame, fraction, &JointPose::m_translation, outPose);
+		DecodeTracks(m_scales, frame, fraction, &JointPose::m_scale, outPose);
+	}
+
+	void CompressedAnimationClip::DecodeRotations(uint32_t frame, float fraction, std::vector<JointPose>& outPose) const noexcept {
+		const size_t count = m_rotationTracks.size();
+		if (count == 0)
+			return;
+		//Memoria de trabajo por hilo, de modo que varios controladores puedan muestrear en paralelo
+		static thread_local std::vector<float> decoded;
+		decoded.resize(4 * count);
+		float* x = decoded.data();
+		float* y = x + count;
+		float* z = y + count;
+		float* w = z + count;
+		const uint16_t* current = m_rotationData.data() + 3 * count * frame;
+		const uint16_t* next = current + 3 * count;
+		for (size_t i = 0; i < count; i++) {
+			float x0, y0, z0, w0, x1, y1, z1, w1;
+			DecodeRotation(current[i], current[count + i], current[2 * count + i], x0, y0, z0, w0);
+			DecodeRotation(next[i], next[count + i], next[2 * count + i], x1, y1, z1, w1);
+			//Interpolacion lineal normalizada (nlerp) por el camino mas corto
+			const float sign = x0 * x1 + y0 * y1 + z0 * z1 + w0 * w1 < 0.0f ? -1.0f : 1.0f;
+			const float rx = x0 + fraction * (sign * x1 - x0);
+			const float ry = y0 + fraction * (sign * y1 - y0);
+			const float rz = z0 + fraction * (sign * z1 - z0);
+			const float rw = w0 + fraction * (sign * w1 - w0);
+			const float inverseLength = 1.0f / std::sqrt(rx * rx + ry * ry + rz * rz + rw * rw);
+			x[i] = rx * inverseLength;
+			y[i] = ry * inverseLength;
+			z[i] = rz * inverseLength;
+			w[i] = rw * inverseLength;
+		}
+		for (size_t i = 0; i < count; i++) {
+			outPose[m_trackJointIndices[m_rotationTracks[i]]].m_rotation = glm::fquat(w[i], x[i], y[i], z[i]);
+		}
+	}
+
+	void CompressedAnimationClip::DecodeTracks(const QuantizedTracks& quantizedTracks,
+		uint32_t frame,
+		float fraction,
+		glm::vec3 JointPose::* channel,
+		std::vector<JointPose>& outPose) const noexcept
+	{
+		const size_t count = quantizedTracks.tracks.size();
+		if (count == 0)
+			return;
+		static thread_local std::vector<float> decoded;
+		decoded.resize(3 * count);
+		const float* minimums = quantizedTracks.ranges.data();
+		const float* steps = minimums + 3 * count;
+		const uint16_t* current = quantizedTracks.data.data() + 3 * count * frame;
+		const uint16_t* next = current + 3 * count;
+		//Las tres componentes de todos los canales forman un solo arreglo contiguo
+		for (size_t i = 0; i < 3 * count; i++) {
+			const float value = minimums[i] + steps[i] * current[i];
+			const float nextValue = minimums[i] + steps[i] * next[i];
+			decoded[i] = value + fraction * (nextValue - value);
+		}
+		for (size_t i = 0; i < count; i++) {
+			outPose[m_trackJointIndices[quantizedTracks.tracks[i]]].*channel =
+				glm::vec3(decoded[i], decoded[count + i], decoded[2 * count + i]);
+		}
+	}
+
+	size_t CompressedAnimationClip::GetMemoryUsage() const noexcept {
+		auto tracksSize = [](const QuantizedTracks& quantizedTracks) {
+			return quantizedTracks.tracks.size() * sizeof(uint32_t) +
+				quantizedTracks.ranges.size() * sizeof(float) +
+				quantizedTracks.data.size() * sizeof(uint16_t);
+		};
+		return m_trackJointIndices.size() * (sizeof(uint32_t) + sizeof(glm::fquat) + 2 * sizeof(glm::vec3)) +
+			m_rotationTracks.size() * sizeof(uint32_t) +
+			m_rotationData.size() * sizeof(uint16_t) +
+			tracksSize(m_translations) +
+			tracksSize(m_scales);
+	}
+
+	void CompressedAnimationClip::Save(AssetCacheWriter& writer) const noexcept {
+		writer.Write(m_duration);
+		writer.Write(m_frameCount);
+		writer.WriteArray(m_trackJointIndices);
+		writer.WriteArray(m_restRotations);
+		writer.WriteArray(m_restTranslations);
+		writer.WriteArray(m_restScales);
+		writer.WriteArray(m_rotationTracks);
+		writer.WriteArray(m_rotationData);
+		for (const QuantizedTracks* quantizedTracks : { &m_translations, &m_scales }) {
+			writer.WriteArray(quantizedTracks->tracks);
+			writer.WriteArray(quantizedTracks->ranges);
+			writer.WriteArray(quantizedTracks->data);
+		}
+	}
+
+	bool CompressedAnimationClip::Load(AssetCacheReader& reader) noexcept {
+		reader.Read(m_duration);
+		reader.Read(m_frameCount);
+		reader.ReadArray(m_trackJointIndices);
+		reader.ReadArray(m_restRotations);
+		reader.ReadArray(m_restTranslations);
+		reader.ReadArray(m_restScales);
+		reader.ReadArray(m_rotationTracks);
+		reader.ReadArray(m_rotationData);
+		for (QuantizedTracks* quantizedTracks : { &m_translations, &m_scales }) {
+			reader.ReadArray(quantizedTracks->tracks);
+			reader.ReadArray(quantizedTracks->ranges);
+			reader.ReadArray(quantizedTracks->data);
+		}
+		if (!reader.IsValid())
+			return false;
+
+		//Se valida la consistencia de los tamanos para no leer fuera de los arreglos al muestrear
+		const size_t trackCount = m_trackJointIndices.size();
+		bool consistent = m_frameCount >= 2 &&
+			m_restRotations.size() == trackCount &&
+			m_restTranslations.size() == trackCount &&
+			m_restScales.size() == trackCount &&
+			m_rotationData.size() == 3 * m_rotationTracks.size() * m_frameCount;
+		for (const QuantizedTracks* quantizedTracks : { &m_translations, &m_scales }) {
+			consistent = consistent &&
+				quantizedTracks->ranges.size() == 6 * quantizedTracks->tracks.size() &&
+				quantizedTracks->data.size() == 3 * quantizedTracks->tracks.size() * m_frameCount &&
+				std::all_of(quantizedTracks->tracks.begin(), quantizedTracks->tracks.end(), [trackCount](uint32_t track) { return track < trackCount; });
+		}
+		consistent = consistent &&
+			std::all_of(m_rotationTracks.begin(), m_rotationTracks.end(), [trackCount](uint32_t track) { return track < trackCount; });
+		return consistent;
+	}
+}
@@ -0,0 +1,91 @@
+#pragma once
+#ifndef COMPRESSEDANIMATIONCLIP_HPP
+#define COMPRESSEDANIMATIONCLIP_HPP
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "JointPose.hpp"
+namespace Mona {
+	class AssetCacheWriter;
+	class AssetCacheReader;
+
+	/*
+	* Representacion comprimida de las muestras de un AnimationClip. El clip se remuestrea a una frecuencia uniforme, por
+	* lo que encontrar los frames a interpolar es una division y no una busqueda. Los canales (rotacion, traslacion y
+	* escala) que no cambian mas alla del presupuesto de error se guardan una sola vez, las rotaciones animadas se cuantizan
+	* con el esquema smallest-three en 48 bits y las traslaciones y escalas animadas se cuantizan a 16 bits por componente
+	* dentro del rango de su track. Cada frame se guarda como estructura de arreglos (todas las x, luego todas las y, etc.)
+	* de modo que el decodificador recorra memoria contigua con ciclos sin saltos, vectorizables por el compilador.
+	*/
+	class CompressedAnimationClip {
+	public:
+		struct Settings {
+			//Frecuencia de remuestreo en frames por segundo
+			float sampleRate = 30.0f;
+			//Error maximo de las traslaciones en unidades del modelo
+			float translationError = 0.001f;
+			//Error angular maximo de las rotaciones en radianes
+			float rotationError = 0.001f;
+			float scaleError = 0.001f;
+		};
+		CompressedAnimationClip() = default;
+		/*
+		* Comprime poses ya remuestreadas: frames[f][t] es la pose local del track t en el frame f, donde el primer frame
+		* corresponde al instante 0 y el ultimo al instante duration.
+		*/
+		CompressedAnimationClip(const std::vector<std::vector<JointPose>>& frames,
+			const std::vector<int>& trackJointIndices,
+			float duration,
+			const Settings& settings);
+		//Muestrea la pose local en time, que debe estar en [0, duration]
+		void Sample(std::vector<JointPose>& outPose, float time) const noexcept;
+		uint32_t GetFrameCount() const noexcept { return m_frameCount; }
+		size_t GetTrackCount() const noexcept { return m_trackJointIndices.size(); }
+		float GetDuration() const noexcept { return m_duration; }
+		//Bytes ocupados por las muestras comprimidas
+		size_t GetMemoryUsage() const noexcept;
+		void Save(AssetCacheWriter& writer) const noexcept;
+		bool Load(AssetCacheReader& reader) noexcept;
+	private:
+		//Canales vec3 animados cuantizados a 16 bits por componente
+		struct QuantizedTracks {
+			//Track de cada canal animado
+			std::vector<uint32_t> tracks;
+			//Por componente, los minimos de todos los canales seguidos de sus tamanos de paso: [minX minY minZ stepX stepY stepZ]
+			std::vector<float> ranges;
+			//Por frame, las componentes de todos los canales: [x y z]
+			std::vector<uint16_t> data;
+		};
+		/*
+		* Separa los canales vec3 constantes, cuyo valor de reposo se escribe en outRest, de los animados, que se cuantizan
+		* en outTracks.
+		*/
+		static void QuantizeTracks(const std::vector<std::vector<JointPose>>& frames,
+			glm::vec3 JointPose::* channel,
+			float maxError,
+			const char* channelName,
+			std::vector<glm::vec3>& outRest,
+			QuantizedTracks& outTracks) noexcept;
+		void DecodeRotations(uint32_t frame, float fraction, std::vector<JointPose>& outPose) const noexcept;
+		void DecodeTracks(const QuantizedTracks& quantizedTracks,
+			uint32_t frame,
+			float fraction,
+			glm::vec3 JointPose::* channel,
+			std::vector<JointPose>& outPose) const noexcept;
+
+		float m_duration = 0.0f;
+		uint32_t m_frameCount = 0;
+		//Articulacion del esqueleto que anima cada track
+		std::vector<uint32_t> m_trackJointIndices;
+		//Valor de reposo de cada track, usado directamente por los canales constantes
+		std::vector<glm::fquat> m_restRotations;
+		std::vector<glm::vec3> m_restTranslations;
+		std::vector<glm::vec3> m_restScales;
+		//Rotaciones animadas, por frame: [a b c] donde el bit mas alto de a y b guarda el indice de la componente omitida
+		std::vector<uint32_t> m_rotationTracks;
+		std::vector<uint16_t> m_rotationData;
+		QuantizedTracks m_translations;
+		QuantizedTracks m_scales;
+	};
+}
+#endif
@@ -0,0 +1,328 @@
+#include "PoseSoA.hpp"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/type_ptr.hpp>
+#include "../Core/Log.hpp"
+//SSE2 es parte de la base de x86-64, MONA_DISABLE_SIMD fuerza la version escalar de los kernels
+#if !defined(MONA_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MONA_POSE_SSE
+#include <emmintrin.h>
+#endif
+namespace Mona {
+
+	namespace {
+		/*
+		* Grupo de PoseSoA::LaneCount floats sobre el que se escriben los kernels. Con SSE cada operacion es una instruccion,
+		* la version escalar usa ciclos de largo fijo que el compilador puede desenrollar o vectorizar por su cuenta.
+		*/
+#ifdef MONA_POSE_SSE
+		struct Lanes {
+			__m128 value;
+			static Lanes Load(const float* source) noexcept { return { _mm_loadu_ps(source) }; }
+			static Lanes Splat(float scalar) noexcept { return { _mm_set1_ps(scalar) }; }
+			static Lanes Gather(const float* source, const uint32_t* indices) noexcept {
+				return { _mm_setr_ps(source[indices[0]], source[indices[1]], source[indices[2]], source[indices[3]]) };
+			}
+			void Store(float* destination) const noexcept { _mm_storeu_ps(destination, value); }
+			void Scatter(float* destination, const uint32_t* indices) const noexcept {
+				alignas(16) float lanes[4];
+				_mm_store_ps(lanes, value);
+				destination[indices[0]] = lanes[0];
+				destination[indices[1]] = lanes[1];
+				destination[indices[2]] = lanes[2];
+				destination[indices[3]] = lanes[3];
+			}
+		};
+		inline Lanes operator+(Lanes lhs, Lanes rhs) noexcept { return { _mm_add_ps(lhs.value, rhs.value) }; }
+		inline Lanes operator-(Lanes lhs, Lanes rhs) noexcept { return { _mm_sub_ps(lhs.value, rhs.value) }; }
+		inline Lanes operator*(Lanes lhs, Lanes rhs) noexcept { return { _mm_mul_ps(lhs.value, rhs.value) }; }
+		inline Lanes operator/(Lanes lhs, Lanes rhs) noexcept { return { _mm_div_ps(lhs.value, rhs.value) }; }
+		inline Lanes Sqrt(Lanes lanes) noexcept { return { _mm_sqrt_ps(lanes.value) }; }
+		//Invierte el signo de value en las lineas donde signSource es negativo
+		inline Lanes FlipSign(Lanes value, Lanes signSource) noexcept {
+			return { _mm_xor_ps(value.value, _mm_and_ps(signSource.value, _mm_set1_ps(-0.0f))) };
+		}
+		inline void Transpose(Lanes& a, Lanes& b, Lanes& c, Lanes& d) noexcept {
+			_MM_TRANSPOSE4_PS(a.value, b.value, c.value, d.value);
+		}
+#else
+		struct Lanes {
+			float value[4];
+			static Lanes Load(const float* source) noexcept { return { source[0], source[1], source[2], source[3] }; }
+			static Lanes Splat(float scalar) noexcept { return { scalar, scalar, scalar, scalar }; }
+			static Lanes Gather(const float* source, const uint32_t* indices) noexcept {
+				return { source[indices[0]], source[indices[1]], source[indices[2]], source[indices[3]] };
+			}
+			void Store(float* destination) const noexcept { std::copy(value, value + 4, destination); }
+			void Scatter(float* destination, const uint32_t* indices) const noexcept {
+				for (int i = 0; i < 4; i++) destination[indices[i]] = value[i];
+			}
+		};
+#define MONA_LANES_OPERATOR(op) \
+		inline Lanes operator op(const Lanes& lhs, const Lanes& rhs) noexcept { \
+			return { lhs.value[0] op rhs.value[0], lhs.value[1] op rhs.value[1], lhs.value[2] op rhs.value[2], lhs.value[3] op rhs.value[3] }; \
+		}
+		MONA_LANES_OPERATOR(+)
+		MONA_LANES_OPERATOR(-)
+		MONA_LANES_OPERATOR(*)
+		MONA_LANES_OPERATOR(/)
+#undef MONA_LANES_OPERATOR
+		inline Lanes Sqrt(const Lanes& lanes) noexcept {
+			return { std::sqrt(lanes.value[0]), std::sqrt(lanes.value[1]), std::sqrt(lanes.value[2]), std::sqrt(lanes.value[3]) };
+		}
+		inline Lanes FlipSign(const Lanes& value, const Lanes& signSource) noexcept {
+			Lanes result;
+			for (int i = 0; i < 4; i++) result.value[i] = signSource.value[i] < 0.0f ? -value.value[i] : value.value[i];
+			return result;
+		}
+		inline void Transpose(Lanes& a, Lanes& b, Lanes& c, Lanes& d) noexcept {
+			Lanes* rows[4] = { &a, &b, &c, &d };
+			for (int i = 0; i < 4; i++) {
+				for (int j = i + 1; j < 4; j++)
+					std::swap(rows[i]->value[j], rows[j]->value[i]);
+			}
+		}
+#endif
+		static_assert(PoseSoA::LaneCount == 4, "PoseSoA Error: Kernels are written for four lanes");
+
+		inline uint32_t PadJointCount(uint32_t jointCount) noexcept {
+			return (jointCount + PoseSoA::LaneCount - 1) / PoseSoA::LaneCount * PoseSoA::LaneCount;
+		}
+	}
+
+	bool PoseSoA::IsSimdEnabled() noexcept {
+#ifdef MONA_POSE_SSE
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void PoseSoA::Resize(uint32_t jointCount) noexcept {
+		m_jointCount = jointCount;
+		m_paddedJointCount = PadJointCount(jointCount);
+		//Todas las articulaciones, incluido el relleno, parten en la pose identidad
+		m_data.assign(ChannelCount * m_paddedJointCount, 0.0f);
+		for (Channel channel : { RotationW, ScaleX, ScaleY, ScaleZ })
+			std::fill_n(GetChannel(channel), m_paddedJointCount, 1.0f);
+	}
+
+	JointPose PoseSoA::GetJointPose(uint32_t jointIndex) const noexcept {
+		auto value = [this, jointIndex](Channel channel) { return GetChannel(channel)[jointIndex]; };
+		return JointPose(glm::fquat(value(RotationW), value(RotationX), value(RotationY), value(RotationZ)),
+			glm::vec3(value(TranslationX), value(TranslationY), value(TranslationZ)),
+			glm::vec3(value(ScaleX), value(ScaleY), value(ScaleZ)));
+	}
+
+	void PoseSoA::SetJointPose(uint32_t jointIndex, const JointPose& pose) noexcept {
+		GetChannel(RotationX)[jointIndex] = pose.m_rotation.x;
+		GetChannel(RotationY)[jointIndex] = pose.m_rotation.y;
+		GetChannel(RotationZ)[jointIndex] = pose.m_rotation.z;
+		GetChannel(RotationW)[jointIndex] = pose.m_rotation.w;
+		GetChannel(TranslationX)[jointIndex] = pose.m_translation.x;
+		GetChannel(TranslationY)[jointIndex] = pose.m_translation.y;
+		GetChannel(TranslationZ)[jointIndex] = pose.m_translation.z;
+		GetChannel(ScaleX)[jointIndex] = pose.m_scale.x;
+		GetChannel(ScaleY)[jointIndex] = pose.m_scale.y;
+		GetChannel(ScaleZ)[jointIndex] = pose.m_scale.z;
+	}
+
+	void PoseSoA::SetFromJointPoses(const std::vector<JointPose>& poses) noexcept {
+		MONA_ASSERT(poses.size() == m_jointCount, "PoseSoA Error: Joint count mismatch");
+		for (uint32_t i = 0; i < m_jointCount; i++) {
+			SetJointPose(i, poses[i]);
+		}
+	}
+
+	void SkeletonSoA::Build(const std::vector<int32_t>& parentIndices, const std::vector<glm::mat4>& inverseBindPoseMatrices) noexcept {
+		const uint32_t jointCount = static_cast<uint32_t>(parentIndices.size());
+		paddedJointCount = PadJointCount(jointCount);
+		std::vector<uint32_t>& depths = jointDepths;
+		depths.assign(jointCount, 0);
+		uint32_t maxDepth = 0;
+		for (uint32_t i = 0; i < jointCount; i++) {
+			//El recorrido DFS con que se importa el esqueleto garantiza que los padres precedan a sus hijos
+			MONA_ASSERT(parentIndices[i] < static_cast<int32_t>(i), "SkeletonSoA Error: Parents must precede their children");
+			depths[i] = parentIndices[i] < 0 ? 0 : depths[parentIndices[i]] + 1;
+			maxDepth = std::max(maxDepth, depths[i]);
+		}
+
+		//Cada nivel se rellena hasta un multiplo de LaneCount repitiendo su ultima articulacion. Repetirla es inocuo ya que
+		// todas las lineas de un grupo se leen antes de escribirse y producen el mismo resultado.
+		jointsByDepth.clear();
+		parentsByDepth.clear();
+		depthOffsets.assign(1, 0);
+		for (uint32_t depth = 1; depth <= maxDepth; depth++) {
+			for (uint32_t i = 0; i < jointCount; i++) {
+				if (depths[i] == depth) {
+					jointsByDepth.push_back(i);
+					parentsByDepth.push_back(static_cast<uint32_t>(parentIndices[i]));
+				}
+			}
+			while (jointsByDepth.size() % PoseSoA::LaneCount != 0) {
+				jointsByDepth.push_back(jointsByDepth.back());
+				parentsByDepth.push_back(parentsByDepth.back());
+			}
+			depthOffsets.push_back(static_cast<uint32_t>(jointsByDepth.size()));
+		}
+
+		inverseBindPoses.assign(16 * paddedJointCount, 0.0f);
+		for (uint32_t i = 0; i < paddedJointCount; i++) {
+			const glm::mat4 matrix = i < jointCount ? inverseBindPoseMatrices[i] : glm::mat4(1.0f);
+			const float* elements = glm::value_ptr(matrix);
+			for (uint32_t element = 0; element < 16; element++)
+				inverseBindPoses[element * paddedJointCount + i] = elements[element];
+		}
+	}
+
+	void BlendPosesSoA(PoseSoA& output, const PoseSoA& firstPose, const PoseSoA& secondPose, float t) noexcept {
+		MONA_ASSERT(firstPose.GetJointCount() == secondPose.GetJointCount() && output.GetJointCount() == firstPose.GetJointCount(),
+			"PoseSoA Error: Blended poses must have the same joint count");
+		const uint32_t count = output.GetPaddedJointCount();
+		const Lanes factor = Lanes::Splat(t);
+		const Lanes one = Lanes::Splat(1.0f);
+		float* outRotation[4];
+		const float* firstRotation[4];
+		const float* secondRotation[4];
+		for (uint32_t c = 0; c < 4; c++) {
+			const PoseSoA::Channel channel = static_cast<PoseSoA::Channel>(PoseSoA::RotationX + c);
+			outRotation[c] = output.GetChannel(channel);
+			firstRotation[c] = firstPose.GetChannel(channel);
+			secondRotation[c] = secondPose.GetChannel(channel);
+		}
+		for (uint32_t i = 0; i < count; i += PoseSoA::LaneCount) {
+			Lanes first[4];
+			Lanes second[4];
+			for (uint32_t c = 0; c < 4; c++) {
+				first[c] = Lanes::Load(firstRotation[c] + i);
+				second[c] = Lanes::Load(secondRotation[c] + i);
+			}
+			//nlerp por el camino mas corto: se invierte el segundo cuaternion si ambos estan en hemisferios opuestos
+			const Lanes dot = first[0] * second[0] + first[1] * second[1] + first[2] * second[2] + first[3] * second[3];
+			Lanes blended[4];
+			for (uint32_t c = 0; c < 4; c++) {
+				blended[c] = first[c] + factor * (FlipSign(second[c], dot) - first[c]);
+			}
+			const Lanes inverseLength = one / Sqrt(blended[0] * blended[0] + blended[1] * blended[1] + blended[2] * blended[2] + blended[3] * blended[3]);
+			for (uint32_t c = 0; c < 4; c++) {
+				(blended[c] * inverseLength).Store(outRotation[c] + i);
+			}
+		}
+		for (uint32_t channel = PoseSoA::TranslationX; channel < PoseSoA::ChannelCount; channel++) {
+			float* outValues = output.GetChannel(static_cast<PoseSoA::Channel>(channel));
+			const float* firstValues = firstPose.GetChannel(static_cast<PoseSoA::Channel>(channel));
+			const float* secondValues = secondPose.GetChannel(static_cast<PoseSoA::Channel>(channel));
+			for (uint32_t i = 0; i < count; i += PoseSoA::LaneCount) {
+				const Lanes first = Lanes::Load(firstValues + i);
+				(first + factor * (Lanes::Load(secondValues + i) - first)).Store(outValues + i);
+			}
+		}
+	}
+
+	void LocalToModelSoA(PoseSoA& pose, const SkeletonSoA& skeleton) noexcept {
+		float* channels[PoseSoA::ChannelCount];
+		for (uint32_t c = 0; c < PoseSoA::ChannelCount; c++) {
+			channels[c] = pose.GetChannel(static_cast<PoseSoA::Channel>(c));
+		}
+		//Los niveles se procesan en orden, dentro de cada nivel las articulaciones son independientes entre si
+		for (uint32_t depth = 0; depth + 1 < skeleton.depthOffsets.size(); depth++) {
+			for (uint32_t k = skeleton.depthOffsets[depth]; k < skeleton.depthOffsets[depth + 1]; k += PoseSoA::LaneCount) {
+				const uint32_t* joints = skeleton.jointsByDepth.data() + k;
+				const uint32_t* parents = skeleton.parentsByDepth.data() + k;
+				Lanes parent[PoseSoA::ChannelCount];
+				Lanes child[PoseSoA::ChannelCount];
+				for (uint32_t c = 0; c < PoseSoA::ChannelCount; c++) {
+					parent[c] = Lanes::Gather(channels[c], parents);
+					child[c] = Lanes::Gather(channels[c], joints);
+				}
+				const Lanes& px = parent[PoseSoA::RotationX];
+				const Lanes& py = parent[PoseSoA::RotationY];
+				const Lanes& pz = parent[PoseSoA::RotationZ];
+				const Lanes& pw = parent[PoseSoA::RotationW];
+				const Lanes& cx = child[PoseSoA::RotationX];
+				const Lanes& cy = child[PoseSoA::RotationY];
+				const Lanes& cz = child[PoseSoA::RotationZ];
+				const Lanes& cw = child[PoseSoA::RotationW];
+				//Misma composicion que operator*(JointPose, JointPose) con el padre a la izquierda
+				Lanes result[PoseSoA::ChannelCount];
+				result[PoseSoA::RotationX] = pw * cx + px * cw + py * cz - pz * cy;
+				result[PoseSoA::RotationY] = pw * cy - px * cz + py * cw + pz * cx;
+				result[PoseSoA::RotationZ] = pw * cz + px * cy - py * cx + pz * cw;
+				result[PoseSoA::RotationW] = pw * cw - px * cx - py * cy - pz * cz;
+				for (uint32_t c = 0; c < 3; c++) {
+					result[PoseSoA::ScaleX + c] = parent[PoseSoA::ScaleX + c] * child[PoseSoA::ScaleX + c];
+				}
+				//Rotacion de v = escalaPadre * traslacionHijo por el cuaternion del padre: v + w * t + q x t, con t = 2 * (q x v)
+				const Lanes vx = parent[PoseSoA::ScaleX] * child[PoseSoA::TranslationX];
+				const Lanes vy = parent[PoseSoA::ScaleY] * child[PoseSoA::TranslationY];
+				const Lanes vz = parent[PoseSoA::ScaleZ] * child[PoseSoA::TranslationZ];
+				const Lanes two = Lanes::Splat(2.0f);
+				const Lanes tx = two * (py * vz - pz * vy);
+				const Lanes ty = two * (pz * vx - px * vz);
+				const Lanes tz = two * (px * vy - py * vx);
+				result[PoseSoA::TranslationX] = parent[PoseSoA::TranslationX] + vx + pw * tx + (py * tz - pz * ty);
+				result[PoseSoA::TranslationY] = parent[PoseSoA::TranslationY] + vy + pw * ty + (pz * tx - px * tz);
+				result[PoseSoA::TranslationZ] = parent[PoseSoA::TranslationZ] + vz + pw * tz + (px * ty - py * tx);
+				for (uint32_t c = 0; c < PoseSoA::ChannelCount; c++) {
+					result[c].Scatter(channels[c], joints);
+				}
+			}
+		}
+	}
+
+	void BuildMatrixPaletteSoA(const PoseSoA& modelPose, const SkeletonSoA& skeleton, std::vector<glm::mat4>& outMatrixPalette) noexcept {
+		const uint32_t jointCount = modelPose.GetJointCount();
+		const uint32_t paddedCount = modelPose.GetPaddedJointCount();
+		MONA_ASSERT(skeleton.paddedJointCount == paddedCount && outMatrixPalette.size() >= jointCount,
+			"PoseSoA Error: Pose, skeleton and palette sizes do not match");
+		const Lanes one = Lanes::Splat(1.0f);
+		const Lanes two = Lanes::Splat(2.0f);
+		for (uint32_t i = 0; i < paddedCount; i += PoseSoA::LaneCount) {
+			const Lanes x = Lanes::Load(modelPose.GetChannel(PoseSoA::RotationX) + i);
+			const Lanes y = Lanes::Load(modelPose.GetChannel(PoseSoA::RotationY) + i);
+			const Lanes z = Lanes::Load(modelPose.GetChannel(PoseSoA::RotationZ) + i);
+			const Lanes w = Lanes::Load(modelPose.GetChannel(PoseSoA::RotationW) + i);
+			const Lanes sx = Lanes::Load(modelPose.GetChannel(PoseSoA::ScaleX) + i);
+			const Lanes sy = Lanes::Load(modelPose.GetChannel(PoseSoA::ScaleY) + i);
+			const Lanes sz = Lanes::Load(modelPose.GetChannel(PoseSoA::ScaleZ) + i);
+			//Matriz traslacion * rotacion * escala, model[columna][fila], igual que JointPoseToMat4
+			Lanes model[4][3];
+			model[0][0] = (one - two * (y * y + z * z)) * sx;
+			model[0][1] = two * (x * y + w * z) * sx;
+			model[0][2] = two * (x * z - w * y) * sx;
+			model[1][0] = two * (x * y - w * z) * sy;
+			model[1][1] = (one - two * (x * x + z * z)) * sy;
+			model[1][2] = two * (y * z + w * x) * sy;
+			model[2][0] = two * (x * z + w * y) * sz;
+			model[2][1] = two * (y * z - w * x) * sz;
+			model[2][2] = (one - two * (x * x + y * y)) * sz;
+			model[3][0] = Lanes::Load(modelPose.GetChannel(PoseSoA::TranslationX) + i);
+			model[3][1] = Lanes::Load(modelPose.GetChannel(PoseSoA::TranslationY) + i);
+			model[3][2] = Lanes::Load(modelPose.GetChannel(PoseSoA::TranslationZ) + i);
+
+			//Cada columna de model * inverseBindPose se transpone para escribir las matrices de cuatro articulaciones
+			glm::mat4 batch[PoseSoA::LaneCount];
+			const bool isFullBatch = i + PoseSoA::LaneCount <= jointCount;
+			glm::mat4* destination = isFullBatch ? &outMatrixPalette[i] : batch;
+			for (uint32_t column = 0; column < 4; column++) {
+				Lanes bind[4];
+				for (uint32_t row = 0; row < 4; row++) {
+					bind[row] = Lanes::Load(skeleton.inverseBindPoses.data() + (4 * column + row) * paddedCount + i);
+				}
+				Lanes result[4];
+				for (uint32_t row = 0; row < 3; row++) {
+					result[row] = model[0][row] * bind[0] + model[1][row] * bind[1] + model[2][row] * bind[2] + model[3][row] * bind[3];
+				}
+				//La ultima fila de model es (0, 0, 0, 1)
+				result[3] = bind[3];
+				Transpose(result[0], result[1], result[2], result[3]);
+				for (uint32_t lane = 0; lane < PoseSoA::LaneCount; lane++) {
+					result[lane].Store(glm::value_ptr(destination[lane]) + 4 * column);
+				}
+			}
+			if (!isFullBatch) {
+				std::copy(batch, batch + (jointCount - i), outMatrixPalette.begin() + i);
+			}
+		}
+	}
+}
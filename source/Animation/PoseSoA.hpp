@@ -0,0 +1,68 @@
+#pragma once
+#ifndef POSESOA_HPP
+#define POSESOA_HPP
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "JointPose.hpp"
+namespace Mona {
+	/*
+	* Pose de un esqueleto como estructura de arreglos: cada componente de rotacion, traslacion y escala de todas las
+	* articulaciones se guarda en un arreglo propio. La cantidad de articulaciones se rellena hasta un multiplo de
+	* LaneCount con poses identidad, de modo que los kernels SIMD procesen LaneCount articulaciones por iteracion sin un
+	* ciclo de resto.
+	*/
+	class PoseSoA {
+	public:
+		static constexpr uint32_t LaneCount = 4;
+		enum Channel : uint32_t {
+			RotationX, RotationY, RotationZ, RotationW,
+			TranslationX, TranslationY, TranslationZ,
+			ScaleX, ScaleY, ScaleZ,
+			ChannelCount
+		};
+		//Indica si los kernels se compilaron con instrucciones SIMD o con su version escalar
+		static bool IsSimdEnabled() noexcept;
+
+		void Resize(uint32_t jointCount) noexcept;
+		uint32_t GetJointCount() const noexcept { return m_jointCount; }
+		uint32_t GetPaddedJointCount() const noexcept { return m_paddedJointCount; }
+		float* GetChannel(Channel channel) noexcept { return m_data.data() + channel * m_paddedJointCount; }
+		const float* GetChannel(Channel channel) const noexcept { return m_data.data() + channel * m_paddedJointCount; }
+		JointPose GetJointPose(uint32_t jointIndex) const noexcept;
+		void SetJointPose(uint32_t jointIndex, const JointPose& pose) noexcept;
+		void SetFromJointPoses(const std::vector<JointPose>& poses) noexcept;
+	private:
+		uint32_t m_jointCount = 0;
+		uint32_t m_paddedJointCount = 0;
+		std::vector<float> m_data;
+	};
+
+	/*
+	* Datos de un esqueleto precalculados para los kernels SoA: las articulaciones no raiz agrupadas por profundidad, de
+	* modo que todas las de un mismo nivel puedan transformarse a espacio de modelo en paralelo, y las inverse bind pose
+	* como 16 arreglos de componentes (uno por elemento de la matriz, en orden de columnas).
+	*/
+	struct SkeletonSoA {
+		void Build(const std::vector<int32_t>& parentIndices, const std::vector<glm::mat4>& inverseBindPoseMatrices) noexcept;
+		std::vector<uint32_t> jointsByDepth;
+		std::vector<uint32_t> parentsByDepth;
+		//Inicio de cada nivel dentro de jointsByDepth, con un elemento extra al final
+		std::vector<uint32_t> depthOffsets;
+		//Profundidad de cada articulacion en la jerarquia, la raiz tiene profundidad 0
+		std::vector<uint32_t> jointDepths;
+		std::vector<float> inverseBindPoses;
+		uint32_t paddedJointCount = 0;
+	};
+
+	/*
+	* Interpola dos poses con nlerp por el camino mas corto para las rotaciones y lerp para traslaciones y escalas.
+	* output puede ser una de las entradas.
+	*/
+	void BlendPosesSoA(PoseSoA& output, const PoseSoA& firstPose, const PoseSoA& secondPose, float t) noexcept;
+	//Transforma una pose en espacio local a espacio de modelo recorriendo la jerarquia nivel por nivel
+	void LocalToModelSoA(PoseSoA& pose, const SkeletonSoA& skeleton) noexcept;
+	//Escribe en outMatrixPalette la matriz de cada articulacion multiplicada por su inverse bind pose
+	void BuildMatrixPaletteSoA(const PoseSoA& modelPose, const SkeletonSoA& skeleton, std::vector<glm::mat4>& outMatrixPalette) noexcept;
+}
+#endif
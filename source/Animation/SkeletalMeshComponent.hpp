@@ -4,9 +4,14 @@
 #include <string_view>
 #include <memory>
 #include <vector>
+#include <algorithm>
 #include "../Core/Log.hpp"
 #include "../World/ComponentTypes.hpp"
+#include "../World/GameObjectTypes.hpp"
+#include "../Rendering/AABB.hpp"
 #include "AnimationController.hpp"
+#include "AnimationLOD.hpp"
+#include "SkinnedMesh.hpp"
 #include "../Rendering/Material.hpp"
 namespace Mona {
 	class TransformComponent;
@@ -14,6 +19,11 @@ namespace Mona {
 	class Material;
 	class AnimationClip;
 	class SkinnedMesh;
+	class GameObject;
+	class CullingSystem;
+	class SkeletalMeshLifetimePolicy;
+	template <typename ComponentType>
+	class ComponentManager;
 	class SkeletalMeshComponent
 	{
 	public:
@@ -21,7 +31,7 @@ namespace Mona {
 		friend class World;
 		friend class AnimationSystem;
 		//using managerType = ComponentManager<SkeletalMeshComponent>;
-		using LifetimePolicyType = DefaultLifetimePolicy<SkeletalMeshComponent>;
+		using LifetimePolicyType = SkeletalMeshLifetimePolicy;
 		using dependencies = DependencyList<TransformComponent>;
 		static constexpr std::string_view componentName = "SkeletalMeshComponent";
 		static constexpr uint8_t componentIndex = GetComponentIndex(EComponentType::SkeletalMeshComponent);
@@ -32,6 +42,7 @@ namespace Mona {
 			MONA_ASSERT(skinnedMesh != nullptr, "SkeletalMeshComponent Error: Mesh pointer cannot be null.");
 			MONA_ASSERT(material != nullptr, "SkeletalMeshComponent Error: Material cannot be null.");
 			MONA_ASSERT(material->IsForSkinning(), "SkeletalMeshComponent Error: Material cannot be used for this type of Mesh");
+			m_boundingBox = skinnedMesh->GetBoundingBox();
 		}
 		
 		std::shared_ptr<Material> GetMaterial() const noexcept {
@@ -50,6 +61,18 @@ namespace Mona {
 			return m_skeleton;
 		}
 
+		/*
+		* Caja en espacio local de la malla en su pose actual, recalculada por AnimationSystem a partir de la paleta de
+		* matrices cada vez que actualiza la pose. Antes de la primera actualizacion corresponde a la pose de enlace.
+		*/
+		const AABB& GetLocalBoundingBox() const noexcept {
+			return m_boundingBox;
+		}
+		//Contador que aumenta cada vez que cambia GetLocalBoundingBox, permite a CullingSystem detectar cambios
+		uint32_t GetBoundingBoxVersion() const noexcept {
+			return m_boundingBoxVersion;
+		}
+
 		const AnimationController& GetAnimationController() const
 		{
 			return m_animationController;
@@ -57,14 +80,52 @@ namespace Mona {
 		AnimationController& GetAnimationController() {
 			return m_animationController;
 		}
-		
+
+		/*
+		* Configura los niveles de detalle de la animacion segun la distancia a la camara principal. Sin niveles, el
+		* comportamiento por defecto, la pose se evalua completa todos los frames.
+		*/
+		void SetAnimationLODLevels(std::vector<AnimationLODLevel> levels) noexcept {
+			for (const auto& level : levels) {
+				MONA_ASSERT(level.updateInterval > 0, "SkeletalMeshComponent Error: LOD update interval must be positive.");
+				MONA_ASSERT(level.minDistance >= 0.0f, "SkeletalMeshComponent Error: LOD distance cannot be negative.");
+			}
+			std::sort(levels.begin(), levels.end(),
+				[](const AnimationLODLevel& a, const AnimationLODLevel& b) { return a.minDistance < b.minDistance; });
+			m_animationLODLevels = std::move(levels);
+		}
+		const std::vector<AnimationLODLevel>& GetAnimationLODLevels() const noexcept {
+			return m_animationLODLevels;
+		}
 		
 	private:
+		void UpdateBoundingBox() noexcept {
+			m_boundingBox = m_skinnedMeshPtr->GetPoseBoundingBox(m_animationController.GetCurrentMatrixPalette());
+			m_boundingBoxVersion++;
+		}
 		
 		std::shared_ptr<Skeleton> m_skeleton;
 		std::shared_ptr<SkinnedMesh> m_skinnedMeshPtr;
 		std::shared_ptr<Material> m_materialPtr;
 		AnimationController m_animationController;
+		std::vector<AnimationLODLevel> m_animationLODLevels;
+		AABB m_boundingBox;
+		uint32_t m_boundingBoxVersion = 0;
+	};
+
+	/*
+	* Registra cada SkeletalMeshComponent en el CullingSystem del Renderer al ser agregada y la remueve de este al ser removida.
+	*/
+	class SkeletalMeshLifetimePolicy {
+	public:
+		SkeletalMeshLifetimePolicy() = default;
+		SkeletalMeshLifetimePolicy(ComponentManager<TransformComponent>* transformDataManagerPtr, CullingSystem* cullingSystemPtr) :
+			m_transformDataManagerPtr(transformDataManagerPtr), m_cullingSystemPtr(cullingSystemPtr) {}
+		void OnAddComponent(GameObject* gameObjectPtr, SkeletalMeshComponent& skeletalMesh, const InnerComponentHandle& handle) noexcept;
+		void OnRemoveComponent(GameObject* gameObjectPtr, SkeletalMeshComponent& skeletalMesh, const InnerComponentHandle& handle) noexcept;
+	private:
+		ComponentManager<TransformComponent>* m_transformDataManagerPtr = nullptr;
+		CullingSystem* m_cullingSystemPtr = nullptr;
 	};
 }
 #endif
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "../Rendering/Renderer.hpp"
 #include "../Core/Log.hpp"
 #include "../Core/AssimpTransformations.hpp"
+#include "../Core/AssetCache.hpp"
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
@@ -10,8 +11,21 @@
 namespace Mona {
 
 	Skeleton::Skeleton(const std::string& filePath) {
-		Assimp::Importer importer;
+		// Se guarda el nombre del modelo
+		size_t pos = filePath.find_last_of("/\\");
+		std::string fileName = pos != std::string::npos ? filePath.substr(pos + 1): filePath;
+		m_modelName = funcUtils::splitString(fileName, '.')[0];
+
 		unsigned int postProcessFlags = aiProcess_Triangulate;
+		AssetCache::Key cacheKey = { AssetCache::AssetType::Skeleton, postProcessFlags };
+		const std::string cachePath = AssetCache::GetCachePath(filePath, AssetCache::AssetType::Skeleton);
+		if (AssetCache::IsEnabled()) {
+			cacheKey.sourceHash = AssetCache::HashFile(filePath);
+			if (cacheKey.sourceHash != 0 && LoadFromCache(cachePath, cacheKey))
+				return;
+		}
+
+		Assimp::Importer importer;
 		const aiScene* scene = importer.ReadFile(filePath, postProcessFlags);
 		if (!scene)
 		{
@@ -93,10 +107,48 @@ namespace Mona {
 
 		}
 
-		// Se guarda el nombre del modelo
-		size_t pos = filePath.find_last_of("/\\");
-		std::string fileName = pos != std::string::npos ? filePath.substr(pos + 1): filePath;
-		m_modelName = funcUtils::splitString(fileName, '.')[0];
+		if (AssetCache::IsEnabled() && cacheKey.sourceHash != 0) {
+			AssetCacheWriter writer(cacheKey);
+			writer.Write(static_cast<uint64_t>(m_jointNames.size()));
+			for (const std::string& jointName : m_jointNames)
+				writer.WriteString(jointName);
+			writer.WriteArray(m_parentIndices);
+			writer.WriteArray(m_invBindPoseMatrices);
+			writer.WriteArray(m_offsets);
+			if (!writer.Save(cachePath))
+				MONA_LOG_WARNING("Skeleton Warning: Failed to write cache file {0}", cachePath);
+		}
+		m_soaData.Build(m_parentIndices, m_invBindPoseMatrices);
+	}
+
+	bool Skeleton::LoadFromCache(const std::string& cachePath, const AssetCache::Key& key) noexcept {
+		AssetCacheReader reader(cachePath, key);
+		uint64_t jointCount = 0;
+		if (!reader.Read(jointCount) || jointCount > Renderer::NUM_MAX_BONES)
+			return false;
+		std::vector<std::string> jointNames(jointCount);
+		for (uint64_t i = 0; i < jointCount; i++)
+			reader.ReadString(jointNames[i]);
+		std::vector<std::int32_t> parentIndices;
+		std::vector<glm::mat4> invBindPoseMatrices;
+		std::vector<glm::mat4> offsets;
+		reader.ReadArray(parentIndices);
+		reader.ReadArray(invBindPoseMatrices);
+		reader.ReadArray(offsets);
+		if (!reader.IsValid() || parentIndices.size() != jointCount || invBindPoseMatrices.size() != jointCount ||
+			offsets.size() != jointCount)
+			return false;
+
+		m_jointMap.clear();
+		m_jointMap.reserve(jointCount);
+		for (uint32_t i = 0; i < jointCount; i++)
+			m_jointMap.insert(std::make_pair(jointNames[i], i));
+		m_jointNames = std::move(jointNames);
+		m_parentIndices = std::move(parentIndices);
+		m_invBindPoseMatrices = std::move(invBindPoseMatrices);
+		m_offsets = std::move(offsets);
+		m_soaData.Build(m_parentIndices, m_invBindPoseMatrices);
+		return true;
 	}
 	
 }
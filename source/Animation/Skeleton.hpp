@@ -6,6 +6,8 @@
 #include <vector>
 #include <unordered_map>
 #include <glm/glm.hpp>
+#include "../Core/AssetCache.hpp"
+#include "PoseSoA.hpp"
 namespace Mona {
 
 
@@ -45,9 +47,19 @@ namespace Mona {
 			return m_parentIndices[index];
 		}
 
+		//Cantidad de ancestros de la articulacion, la raiz tiene profundidad 0
+		std::uint32_t GetJointDepth(size_type index) const {
+			return m_soaData.jointDepths[index];
+		}
+
 		std::string GetModelName() {
 			return m_modelName;
 		}
+
+		//Jerarquia e inverse bind poses en el formato usado por los kernels SoA de poses
+		const SkeletonSoA& GetSoAData() const {
+			return m_soaData;
+		}
 	private:
 		//Skeleton() : m_invBindPoseMatrices(), m_jointNames(), m_parentIndices() {}
 		/*
@@ -64,12 +76,15 @@ namespace Mona {
 		*/
 
 		Skeleton(const std::string &filePath);
+		//Carga la jerarquia y matrices del esqueleto desde un archivo de cache, retorna false si este no es valido
+		bool LoadFromCache(const std::string& cachePath, const AssetCache::Key& key) noexcept;
 		std::unordered_map<std::string, uint32_t> m_jointMap;
 		std::vector<glm::mat4> m_invBindPoseMatrices;
 		std::vector<std::string> m_jointNames;
 		std::vector<std::int32_t> m_parentIndices;
 		std::vector<glm::mat4> m_offsets;
 		std::string m_modelName;
+		SkeletonSoA m_soaData;
 	};
 }
 #endif
\ No newline at end of file
@@ -9,6 +9,12 @@ namespace Mona {
 		if (it != m_skeletonMap.end()) {
 			return it->second;
 		}
+		//Si el esqueleto esta siendo cargado de forma asincrona se espera a que termine en vez de importarlo de nuevo
+		auto pendingIt = m_pendingSkeletonMap.find(stringPath);
+		if (pendingIt != m_pendingSkeletonMap.end()) {
+			AssetFuture<Skeleton> future = pendingIt->second;
+			return future.Wait();
+		}
 
 		Skeleton* skeletonPtr = new Skeleton(stringPath);
 		std::shared_ptr<Skeleton> skeletonSharedPtr = std::shared_ptr<Skeleton>(skeletonPtr);
@@ -16,6 +22,31 @@ namespace Mona {
 		return skeletonSharedPtr;
 	}
 
+	AssetFuture<Skeleton> SkeletonManager::LoadSkeletonAsync(const std::filesystem::path& filePath) noexcept {
+		const std::string stringPath = filePath.string();
+		auto it = m_skeletonMap.find(stringPath);
+		if (it != m_skeletonMap.end()) {
+			return AssetFuture<Skeleton>(it->second);
+		}
+		auto pendingIt = m_pendingSkeletonMap.find(stringPath);
+		if (pendingIt != m_pendingSkeletonMap.end()) {
+			return pendingIt->second;
+		}
+		AssetPromise<Skeleton> promise;
+		m_pendingSkeletonMap.insert({ stringPath, promise.GetFuture() });
+		AsyncAssetLoader& loader = AsyncAssetLoader::GetInstance();
+		loader.RunOnLoaderThread([this, &loader, stringPath, promise]() {
+			std::shared_ptr<Skeleton> skeletonSharedPtr = std::shared_ptr<Skeleton>(new Skeleton(stringPath));
+			//Los mapas del manager solo se modifican desde el hilo principal
+			loader.RunOnMainThread([this, stringPath, skeletonSharedPtr, promise]() {
+				m_skeletonMap.insert({ stringPath, skeletonSharedPtr });
+				m_pendingSkeletonMap.erase(stringPath);
+				promise.SetValue(skeletonSharedPtr);
+			});
+		});
+		return promise.GetFuture();
+	}
+
 	void SkeletonManager::CleanUnusedSkeletons() noexcept {
 		/*
 		* Elimina todos los punteros del mapa cuyo conteo de referencias es igual a uno,
@@ -5,6 +5,7 @@
 #include <string>
 #include <filesystem>
 #include <unordered_map>
+#include "../Core/AssetFuture.hpp"
 namespace Mona {
 	class Skeleton;
 	class SkeletonManager {
@@ -14,6 +15,10 @@ namespace Mona {
 		SkeletonManager(SkeletonManager const&) = delete;
 		SkeletonManager& operator=(SkeletonManager const&) = delete;
 		std::shared_ptr<Skeleton> LoadSkeleton(const std::filesystem::path& filePath) noexcept;
+		/*
+		* Variante asincrona de LoadSkeleton, el esqueleto se importa completamente en un hilo de carga.
+		*/
+		AssetFuture<Skeleton> LoadSkeletonAsync(const std::filesystem::path& filePath) noexcept;
 		void CleanUnusedSkeletons() noexcept;
 		static SkeletonManager& GetInstance() noexcept {
 			static SkeletonManager manager;
@@ -23,6 +28,7 @@ namespace Mona {
 		SkeletonManager() = default;
 		void ShutDown() noexcept;
 		SkeletonMap m_skeletonMap;
+		std::unordered_map<std::string, AssetFuture<Skeleton>> m_pendingSkeletonMap;
 	};
 }
 #endif
\ No newline at end of file
@@ -1,13 +1,16 @@
 #include "SkinnedMesh.hpp"
 
 #include "../Core/Log.hpp"
+#include "../Core/HeadlessMode.hpp"
 #include "../Core/AssimpTransformations.hpp"
+#include "../Core/AssetCache.hpp"
 #include <glm/glm.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <vector>
 #include <stack>
+#include <algorithm>
 #include <glad/glad.h>
 #include "Skeleton.hpp"
 namespace Mona {
@@ -29,6 +32,8 @@ namespace Mona {
 	}
 
 	void SkinnedMesh::ClearData() noexcept {
+		if (HeadlessMode::IsEnabled())
+			return;
 		MONA_ASSERT(m_vertexArrayID, "SkinnedMesh Error: Trying to delete already deleted mesh");
 		MONA_ASSERT(m_vertexBufferID,"SkinnedMesh Error: Trying to delete already deleted mesh");
 		MONA_ASSERT(m_indexBufferID, "SkinnedMesh Error: Trying to delete already deleted mesh");
@@ -38,6 +43,13 @@ namespace Mona {
 		m_vertexArrayID = 0;
 	}
 
+	struct SkinnedMesh::ImportedData {
+		std::vector<SkeletalMeshVertex> vertices;
+		std::vector<unsigned int> faces;
+		AABB boundingBox;
+		std::vector<AABB> jointBoundingBoxes;
+	};
+
 	SkinnedMesh::SkinnedMesh(std::shared_ptr<Skeleton> skeleton,
 		const std::string& filePath,
 		bool flipUvs) : 
@@ -48,21 +60,85 @@ namespace Mona {
 		m_skeletonPtr(skeleton)
 	{
 		MONA_ASSERT(skeleton != nullptr, "SkinnedMesh Error: Skeleton cannot be null");
-		Assimp::Importer importer;
+		const AssetCache::Key cacheKey = GetCacheKey(*skeleton, filePath, flipUvs);
+		const std::string cachePath = AssetCache::GetCachePath(filePath, AssetCache::AssetType::SkinnedMesh);
+		if (cacheKey.sourceHash != 0 && LoadFromCache(cachePath, cacheKey))
+			return;
+		ImportedData data;
+		if (!ImportWithAssimp(*skeleton, filePath, cacheKey, data))
+			return;
+		m_boundingBox = data.boundingBox;
+		m_jointBoundingBoxes = std::move(data.jointBoundingBoxes);
+		SetUpBuffers(data.vertices.data(), data.vertices.size(), data.faces.data(), data.faces.size());
+	}
+
+	SkinnedMesh::SkinnedMesh(std::shared_ptr<Skeleton> skeleton, const ImportedData* data) :
+		m_vertexArrayID(0),
+		m_vertexBufferID(0),
+		m_indexBufferID(0),
+		m_indexBufferCount(0),
+		m_skeletonPtr(skeleton)
+	{
+		MONA_ASSERT(skeleton != nullptr, "SkinnedMesh Error: Skeleton cannot be null");
+		if (!data)
+			return;
+		m_boundingBox = data->boundingBox;
+		m_jointBoundingBoxes = data->jointBoundingBoxes;
+		SetUpBuffers(data->vertices.data(), data->vertices.size(), data->faces.data(), data->faces.size());
+	}
+
+	AssetCache::Key SkinnedMesh::GetCacheKey(const Skeleton& skeleton, const std::string& filePath, bool flipUvs) noexcept {
 		unsigned int postProcessFlags = flipUvs ? aiProcess_FlipUVs : 0;
 		postProcessFlags |= aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_GenUVCoords | aiProcess_CalcTangentSpace;
-		const aiScene* scene = importer.ReadFile(filePath, postProcessFlags);
+		AssetCache::Key cacheKey = { AssetCache::AssetType::SkinnedMesh, postProcessFlags };
+		//Un hash nulo indica que la cache no debe usarse
+		if (!AssetCache::IsEnabled())
+			return cacheKey;
+		cacheKey.sourceHash = AssetCache::HashFile(filePath);
+		//Los indices de huesos guardados en la cache dependen del esqueleto, por lo que sus nombres forman parte de la llave
+		uint64_t skeletonHash = AssetCache::HashBytes(nullptr, 0);
+		for (Skeleton::size_type i = 0; i < skeleton.JointCount(); i++)
+			skeletonHash = AssetCache::HashString(skeleton.GetJointName(i), skeletonHash);
+		cacheKey.dependencyHash = skeletonHash;
+		return cacheKey;
+	}
+
+	std::shared_ptr<SkinnedMesh::ImportedData> SkinnedMesh::Import(const Skeleton& skeleton, const std::string& filePath,
+		bool flipUvs) noexcept
+	{
+		const AssetCache::Key cacheKey = GetCacheKey(skeleton, filePath, flipUvs);
+		std::shared_ptr<ImportedData> data = std::make_shared<ImportedData>();
+		if (cacheKey.sourceHash != 0) {
+			AssetCacheReader reader(AssetCache::GetCachePath(filePath, AssetCache::AssetType::SkinnedMesh), cacheKey);
+			reader.Read(data->boundingBox);
+			reader.ReadArray(data->jointBoundingBoxes);
+			reader.ReadArray(data->vertices);
+			reader.ReadArray(data->faces);
+			if (reader.IsValid())
+				return data;
+			*data = ImportedData();
+		}
+		if (!ImportWithAssimp(skeleton, filePath, cacheKey, *data))
+			return nullptr;
+		return data;
+	}
+
+	bool SkinnedMesh::ImportWithAssimp(const Skeleton& skeleton, const std::string& filePath, const AssetCache::Key& cacheKey,
+		ImportedData& outData) noexcept
+	{
+		Assimp::Importer importer;
+		const aiScene* scene = importer.ReadFile(filePath, cacheKey.importFlags);
 
 
 
 		if (!scene) {
 			MONA_LOG_ERROR("SkinnedMesh Error: Failed to open file with path {0}", filePath);
-			return;
+			return false;
 		}
 
 		//Comienzo del proceso de pasar desde la escena de assimp a un formato interno
-		std::vector<SkeletalMeshVertex> vertices;
-		std::vector<unsigned int> faces;
+		std::vector<SkeletalMeshVertex>& vertices = outData.vertices;
+		std::vector<unsigned int>& faces = outData.faces;
 		size_t numVertices = 0;
 		size_t numFaces = 0;
 		//El primer paso consiste en contar el numero de vertices y caras totales
@@ -108,6 +184,7 @@ namespace Mona {
 
 					SkeletalMeshVertex vertex;
 					vertex.position = AssimpToGlmVec3(position);
+					outData.boundingBox.Expand(vertex.position);
 					vertex.normal = AssimpToGlmVec3(normal);
 					vertex.tangent = AssimpToGlmVec3(tangent);
 					vertex.bitangent = AssimpToGlmVec3(bitangent);
@@ -167,7 +244,7 @@ namespace Mona {
 				for (uint32_t i = 0; i < meshOBJ->mNumBones; i++)
 				{
 					const aiBone* bone = meshOBJ->mBones[i];
-					int32_t signIndex = skeleton->GetJointIndex(bone->mName.C_Str());
+					int32_t signIndex = skeleton.GetJointIndex(bone->mName.C_Str());
 					MONA_ASSERT(signIndex >= 0, "Skinned Error: Given skeleton incompatible with mesh being imported");
 					uint32_t index = static_cast<uint32_t>(signIndex);
 					for (uint32_t k = 0; k < bone->mNumWeights; k++)
@@ -227,17 +304,60 @@ namespace Mona {
 
 			}
 		}
+		//Cajas por articulacion, a partir de las cuales se acota la malla animada con la paleta de matrices de cada frame
+		outData.jointBoundingBoxes.assign(skeleton.JointCount(), AABB());
+		for (const SkeletalMeshVertex& vertex : vertices) {
+			for (int k = 0; k < 4; k++) {
+				if (vertex.boneWeights[k] > 0.0f)
+					outData.jointBoundingBoxes[static_cast<size_t>(vertex.boneIds[k])].Expand(vertex.position);
+			}
+		}
+		if (cacheKey.sourceHash != 0) {
+			const std::string cachePath = AssetCache::GetCachePath(filePath, AssetCache::AssetType::SkinnedMesh);
+			AssetCacheWriter writer(cacheKey);
+			writer.Write(outData.boundingBox);
+			writer.WriteArray(outData.jointBoundingBoxes);
+			writer.WriteArray(vertices);
+			writer.WriteArray(faces);
+			if (!writer.Save(cachePath))
+				MONA_LOG_WARNING("SkinnedMesh Warning: Failed to write cache file {0}", cachePath);
+		}
+		return true;
+	}
+
+	bool SkinnedMesh::LoadFromCache(const std::string& cachePath, const AssetCache::Key& key) noexcept {
+		AssetCacheReader reader(cachePath, key);
+		AABB boundingBox;
+		std::vector<AABB> jointBoundingBoxes;
+		uint64_t vertexCount = 0;
+		uint64_t indexCount = 0;
+		reader.Read(boundingBox);
+		reader.ReadArray(jointBoundingBoxes);
+		const SkeletalMeshVertex* vertices = reader.ReadArray<SkeletalMeshVertex>(vertexCount);
+		const unsigned int* indices = reader.ReadArray<unsigned int>(indexCount);
+		if (!reader.IsValid())
+			return false;
+		m_boundingBox = boundingBox;
+		m_jointBoundingBoxes = std::move(jointBoundingBoxes);
+		//Los datos se suben directamente desde la memoria mapeada, sin copias intermedias
+		SetUpBuffers(vertices, vertexCount, indices, indexCount);
+		return true;
+	}
+
+	void SkinnedMesh::SetUpBuffers(const SkeletalMeshVertex* vertices, uint64_t vertexCount, const unsigned int* indices, uint64_t indexCount) noexcept {
 		//Comienza el paso de los datos en CPU a GPU usando OpenGL
-		m_indexBufferCount = static_cast<uint32_t>(faces.size());
+		m_indexBufferCount = static_cast<uint32_t>(indexCount);
+		if (HeadlessMode::IsEnabled())
+			return;
 		glGenVertexArrays(1, &m_vertexArrayID);
 		glBindVertexArray(m_vertexArrayID);
 
 		glGenBuffers(1, &m_vertexBufferID);
 		glGenBuffers(1, &m_indexBufferID);
 		glBindBuffer(GL_ARRAY_BUFFER, m_vertexBufferID);
-		glBufferData(GL_ARRAY_BUFFER, static_cast<unsigned int>(vertices.size()) * sizeof(SkeletalMeshVertex), vertices.data(), GL_STATIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, static_cast<unsigned int>(vertexCount) * sizeof(SkeletalMeshVertex), vertices, GL_STATIC_DRAW);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBufferID);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<unsigned int>(faces.size()) * sizeof(unsigned int), faces.data(), GL_STATIC_DRAW);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<unsigned int>(indexCount) * sizeof(unsigned int), indices, GL_STATIC_DRAW);
 		glEnableVertexAttribArray(0);
 		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(SkeletalMeshVertex), (void*)offsetof(SkeletalMeshVertex, position));
 		glEnableVertexAttribArray(1);
@@ -1,11 +1,17 @@
 #pragma once
 #ifndef SKINNEDMESH_HPP
 #define SKINNEDMESH_HPP
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../Rendering/AABB.hpp"
+#include "../Core/AssetCache.hpp"
 namespace Mona {
 	class Skeleton;
+	struct SkeletalMeshVertex;
 	class SkinnedMesh {
 		friend class MeshManager;
 	public:
@@ -13,16 +19,58 @@ namespace Mona {
 		uint32_t GetVertexArrayID() const noexcept { return m_vertexArrayID; }
 		uint32_t GetIndexBufferCount() const noexcept { return m_indexBufferCount; }
 		std::shared_ptr<Skeleton> GetSkeleton() const noexcept{ return m_skeletonPtr; }
+		//Caja en espacio local de la malla en su pose de enlace
+		const AABB& GetBoundingBox() const noexcept { return m_boundingBox; }
+		/*
+		* Por articulacion, caja en pose de enlace de los vertices que esta influye. Una articulacion sin vertices tiene una
+		* caja vacia.
+		*/
+		const std::vector<AABB>& GetJointBoundingBoxes() const noexcept { return m_jointBoundingBoxes; }
+		/*
+		* Caja en espacio local de la malla deformada por matrixPalette. Un vertice con piel es una combinacion convexa de
+		* su posicion transformada por las matrices de las articulaciones que lo influyen, por lo que la union de las cajas
+		* de cada articulacion transformadas por su matriz siempre lo contiene.
+		*/
+		AABB GetPoseBoundingBox(const std::vector<glm::mat4>& matrixPalette) const noexcept {
+			return GetPoseBoundingBox(m_jointBoundingBoxes, matrixPalette, m_boundingBox);
+		}
+		//Retorna fallback si ninguna articulacion con vertices tiene matriz en matrixPalette
+		static AABB GetPoseBoundingBox(const std::vector<AABB>& jointBoundingBoxes, const std::vector<glm::mat4>& matrixPalette,
+			const AABB& fallback) noexcept {
+			AABB box;
+			const size_t jointCount = std::min(jointBoundingBoxes.size(), matrixPalette.size());
+			for (size_t i = 0; i < jointCount; i++) {
+				if (jointBoundingBoxes[i].IsValid())
+					box = AABB::Merge(box, jointBoundingBoxes[i].Transform(matrixPalette[i]));
+			}
+			return box.IsValid() ? box : fallback;
+		}
 	private:
+		struct ImportedData;
 		SkinnedMesh(std::shared_ptr<Skeleton> skeleton,
 			const std::string& filePath,
 			bool flipUvs = false);
+		//Sube a la GPU datos obtenidos con Import, un puntero nulo construye una malla vacia
+		SkinnedMesh(std::shared_ptr<Skeleton> skeleton, const ImportedData* data);
+		/*
+		* Lee el archivo (desde la cache o con assimp) y procesa sus vertices sin usar OpenGL, por lo que puede llamarse
+		* desde un hilo de carga. Retorna nullptr si el archivo no pudo importarse.
+		*/
+		static std::shared_ptr<ImportedData> Import(const Skeleton& skeleton, const std::string& filePath, bool flipUvs) noexcept;
+		static AssetCache::Key GetCacheKey(const Skeleton& skeleton, const std::string& filePath, bool flipUvs) noexcept;
+		static bool ImportWithAssimp(const Skeleton& skeleton, const std::string& filePath, const AssetCache::Key& cacheKey,
+			ImportedData& outData) noexcept;
 		void ClearData() noexcept;
+		//Carga los vertices, indices y caja de la malla desde un archivo de cache, retorna false si este no es valido
+		bool LoadFromCache(const std::string& cachePath, const AssetCache::Key& key) noexcept;
+		void SetUpBuffers(const SkeletalMeshVertex* vertices, uint64_t vertexCount, const unsigned int* indices, uint64_t indexCount) noexcept;
 		std::shared_ptr<Skeleton> m_skeletonPtr;
 		uint32_t m_vertexArrayID;
 		uint32_t m_vertexBufferID;
 		uint32_t m_indexBufferID;
 		uint32_t m_indexBufferCount;
+		AABB m_boundingBox;
+		std::vector<AABB> m_jointBoundingBoxes;
 	};
 }
 #endif
\ No newline at end of file
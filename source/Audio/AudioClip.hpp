@@ -2,6 +2,7 @@
 #ifndef AUDIOCLIP_HPP
 #define AUDIOCLIP_HPP
 #include <string>
+#include <memory>
 #include <AL/al.h>
 #include <AL/alc.h>
 namespace Mona {
@@ -53,6 +54,15 @@ namespace Mona {
 		*/
 		AudioClip(const std::string& audioFilePath);
 
+		/*
+		* Datos PCM decodificados de un archivo. Import no usa OpenAL, por lo que puede llamarse desde un hilo de carga, y
+		* retorna nullptr si el archivo no pudo leerse. El constructor que recibe estos datos crea el buffer de OpenAL y
+		* con un puntero nulo construye un clip vacio.
+		*/
+		struct ImportedData;
+		static std::shared_ptr<ImportedData> Import(const std::string& audioFilePath) noexcept;
+		AudioClip(const ImportedData* audioData);
+
 		/*
 		* Metodo que libera los recursos de OpenAL asociados a esta instancia. Esta funcin es llamada al momento
 		* que el motor esta preparandose para ser cerrado.
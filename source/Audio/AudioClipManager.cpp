@@ -7,6 +7,12 @@ namespace Mona {
 		auto it = m_audioClipMap.find(stringPath);
 		if (it != m_audioClipMap.end())
 			return it->second;
+		//Si el AudioClip esta siendo cargado de forma asincrona se espera a que termine en vez de decodificarlo de nuevo
+		auto pendingIt = m_pendingAudioClipMap.find(stringPath);
+		if (pendingIt != m_pendingAudioClipMap.end()) {
+			AssetFuture<AudioClip> future = pendingIt->second;
+			return future.Wait();
+		}
 		//Si no hay un AudioClip con la direccin entregada entonces se procese a cargar una nueva instancia de AudioClip.
 		AudioClip* audioClipPtr = new AudioClip(stringPath);
 		std::shared_ptr<AudioClip> audioClipSharedPtr = std::shared_ptr<AudioClip>(audioClipPtr);
@@ -15,6 +21,30 @@ namespace Mona {
 
 	}
 
+	AssetFuture<AudioClip> AudioClipManager::LoadAudioClipAsync(const std::filesystem::path& filePath) noexcept {
+		const std::string stringPath = filePath.string();
+		auto it = m_audioClipMap.find(stringPath);
+		if (it != m_audioClipMap.end())
+			return AssetFuture<AudioClip>(it->second);
+		auto pendingIt = m_pendingAudioClipMap.find(stringPath);
+		if (pendingIt != m_pendingAudioClipMap.end())
+			return pendingIt->second;
+		AssetPromise<AudioClip> promise;
+		m_pendingAudioClipMap.insert({ stringPath, promise.GetFuture() });
+		AsyncAssetLoader& loader = AsyncAssetLoader::GetInstance();
+		loader.RunOnLoaderThread([this, &loader, stringPath, promise]() {
+			std::shared_ptr<AudioClip::ImportedData> data = AudioClip::Import(stringPath);
+			//El buffer de OpenAL se crea en el hilo principal, que es tambien el unico que modifica los mapas del manager
+			loader.RunOnMainThread([this, stringPath, data, promise]() {
+				std::shared_ptr<AudioClip> audioClipSharedPtr = std::shared_ptr<AudioClip>(new AudioClip(data.get()));
+				m_audioClipMap.insert({ stringPath, audioClipSharedPtr });
+				m_pendingAudioClipMap.erase(stringPath);
+				promise.SetValue(audioClipSharedPtr);
+			});
+		});
+		return promise.GetFuture();
+	}
+
 	void AudioClipManager::CleanUnusedAudioClips() noexcept {
 		//Se recorre el mapa de AudioClips revisando los punteros compartidos que tienen un conteo de referencias igual a uno,
 		//es decir, que solo es este mapa quien los referencia.
@@ -6,6 +6,7 @@
 #include <filesystem>
 #include <string>
 #include "AudioClip.hpp"
+#include "../Core/AssetFuture.hpp"
 namespace Mona {
 	/*
 	* Clase responsable de la creacin y administracin de instancias de AudioClips
@@ -23,6 +24,11 @@ namespace Mona {
 		*/
 		std::shared_ptr<AudioClip> LoadAudioClip(const std::filesystem::path& filePath) noexcept;
 		/*
+		* Variante asincrona de LoadAudioClip. El archivo se decodifica en un hilo de carga y el buffer de OpenAL se crea
+		* en el hilo principal al inicio de algun frame posterior.
+		*/
+		AssetFuture<AudioClip> LoadAudioClipAsync(const std::filesystem::path& filePath) noexcept;
+		/*
 		* Limpia o elimina las instancias de AudioCLips que solo estan siendo referenciadas por esta clase
 		*/
 		void CleanUnusedAudioClips() noexcept;
@@ -40,6 +46,7 @@ namespace Mona {
 		*/
 		void ShutDown() noexcept;
 		AudioClipMap m_audioClipMap;
+		std::unordered_map<std::string, AssetFuture<AudioClip>> m_pendingAudioClipMap;
 	};
 }
 #endif
\ No newline at end of file
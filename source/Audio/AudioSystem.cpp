@@ -2,6 +2,7 @@
 #include <algorithm>
 #include "../Core/Log.hpp"
 #include "../Core/Config.hpp"
+#include "../Core/HeadlessMode.hpp"
 #include "../World/ComponentManager.hpp"
 #include "AudioMacros.hpp"
 #include "AudioSourceComponentLifetimePolicy.hpp"
@@ -11,6 +12,13 @@ namespace Mona {
 		Config& config = Config::GetInstance();
 		const int channels = config.getValueOrDefault<int>("N_OPENAL_SOURCES", 32);
 		MONA_ASSERT(channels > 0, "AudioSystem Error: please request more than zero channels");
+		//En modo headless no se abre ningun dispositivo, el sistema no reproduce audio ni asigna fuentes de OpenAL
+		if (HeadlessMode::IsEnabled()) {
+			m_masterVolume = 1.0f;
+			m_channels = 0;
+			m_firstFreeOpenALSourceIndex = 0;
+			return;
+		}
 		//Creacin de una instancia de ALCdevice y ALCcontext, y posterior chequeo.
 		m_audioDevice = alcOpenDevice(nullptr);
 
@@ -41,6 +49,8 @@ namespace Mona {
 	}
 
 	void AudioSystem::ShutDown() noexcept {
+		if (HeadlessMode::IsEnabled())
+			return;
 		alcMakeContextCurrent(NULL);
 		alcDestroyContext(m_audioContext);
 		alcCloseDevice(m_audioDevice);
@@ -51,14 +61,16 @@ namespace Mona {
 		float timeStep,
 		const ComponentManager<TransformComponent>& transformDataManager,
 		ComponentManager<AudioSourceComponent>& audioDataManager) noexcept {
+		if (HeadlessMode::IsEnabled())
+			return;
 
 		//Actualizacin de la posicin del receptor de OpenAL. Usando una instancia de TransformComponent sealada por el usuario
 		glm::vec3 listenerPosition = glm::vec3(0.0f);
 		if (transformDataManager.IsValid(audioListenerTransformHandle)) {
 			const TransformComponent* listenerTransform = transformDataManager.GetComponentPointer(audioListenerTransformHandle);
-			listenerPosition = listenerTransform->GetLocalTranslation();
-			glm::vec3 frontVector = glm::rotate(audioListenerOffsetRotation, listenerTransform->GetFrontVector());
-			glm::vec3 upVector = glm::rotate(audioListenerOffsetRotation, listenerTransform->GetUpVector());
+			listenerPosition = listenerTransform->GetWorldTranslation();
+			glm::vec3 frontVector = glm::rotate(audioListenerOffsetRotation, listenerTransform->GetWorldFrontVector());
+			glm::vec3 upVector = glm::rotate(audioListenerOffsetRotation, listenerTransform->GetWorldUpVector());
 			UpdateListener(listenerPosition, frontVector, upVector);
 		}
 		else {
@@ -141,6 +153,8 @@ namespace Mona {
 	void AudioSystem::SetMasterVolume(float volume) noexcept {
 		//Para que el cambio de volumen sea global se le cambia esta propiedad al unico receptor
 		m_masterVolume = std::clamp(volume, 0.0f, 1.0f);
+		if (HeadlessMode::IsEnabled())
+			return;
 		ALCALL(alListenerf(AL_GAIN, m_masterVolume));
 	}
 
@@ -151,7 +165,7 @@ namespace Mona {
 		float radius,
 		AudioSourcePriority priority)
 	{
-		if (audioClip == nullptr) return;
+		if (audioClip == nullptr || HeadlessMode::IsEnabled()) return;
 		m_freeAudioSources.emplace_back(audioClip,
 			std::clamp(volume, 0.0f, 1.0f),
 			std::max(0.0f, pitch),
@@ -166,7 +180,7 @@ namespace Mona {
 		float pitch,
 		AudioSourcePriority priority)
 	{
-		if (audioClip == nullptr) return;
+		if (audioClip == nullptr || HeadlessMode::IsEnabled()) return;
 		m_freeAudioSources.emplace_back(audioClip,
 			std::clamp(volume, 0.0f, 1.0f),
 			std::max(0.0f, pitch),
@@ -272,7 +286,7 @@ namespace Mona {
 		while (currentIndex <= backIndex) {
 			AudioSourceComponent& audioSource = audioDataManager[currentIndex];
 			const TransformComponent* transform = transformDataManager.GetComponentPointer(audioSource.m_transformHandle);
-			const glm::vec3& position = transform->GetLocalTranslation();
+			const glm::vec3 position = transform->GetWorldTranslation();
 			float squareRadius = audioSource.m_radius * audioSource.m_radius;
 			float squareDistance = glm::distance2(position, listenerPosition);
 			if (audioSource.m_sourceState == AudioSourceState::Playing &&
@@ -365,7 +379,7 @@ namespace Mona {
 			{
 				//Si la fuente es 3D se actualizan las posiciones
 				const TransformComponent* transform = transformDataManager.GetComponentPointer(audioSource.m_transformHandle);
-				const glm::vec3& position = transform->GetLocalTranslation();
+				const glm::vec3 position = transform->GetWorldTranslation();
 				ALCALL(alSource3f(audioSource.m_openALsource.value().m_sourceID, AL_POSITION, position.x, position.y, position.z));
 			}
 		}
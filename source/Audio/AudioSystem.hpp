@@ -18,6 +18,11 @@ namespace Mona {
 	*/
 	class AudioSystem {
 	public:
+		/*
+		* Componentes leidas y escritas por Update, usadas por World para agendar etapas concurrentes.
+		*/
+		using ReadComponents = ComponentTypeList<TransformComponent>;
+		using WriteComponents = ComponentTypeList<AudioSourceComponent>;
 		/*
 		* Funcin llamada por el motor que inicializa el sistema de audio, el cual es capaz de reproducir channels audios simultaneamente.
 		*/
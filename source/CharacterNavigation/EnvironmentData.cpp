@@ -12,58 +12,220 @@ namespace Mona{
         m_meshHandle = staticMeshObject->GetInnerComponentHandle<StaticMeshComponent>();
     }
 
-    void EnvironmentData::validateTerrains(ComponentManager<StaticMeshComponent>& staticMeshManager) {
+    void EnvironmentData::validateTerrains(ComponentManager<TransformComponent>& transformManager,
+        ComponentManager<StaticMeshComponent>& staticMeshManager) {
         for (int i = 0; i < m_terrains.size(); i++) {
             InnerComponentHandle meshInnerHandle = m_terrains[i].m_meshHandle;
-            const StaticMeshComponent* staticMesh = staticMeshManager.GetComponentPointer(meshInnerHandle);
-            HeightMap* heigtMap = staticMesh->GetHeightMap();
-            if (!(heigtMap->isValid() && staticMeshManager.IsValid(meshInnerHandle))) {
+            if (!(staticMeshManager.IsValid(meshInnerHandle) &&
+                staticMeshManager.GetComponentPointer(meshInnerHandle)->GetHeightMap()->isValid())) {
                 MONA_LOG_ERROR("EnvironmentData: Saved terrain was not valid, so it was removed.");
-                m_terrains.erase(m_terrains.begin() + i);
+                eraseTerrain(i);
                 i--;
+                continue;
+            }
+            // los terrenos nuevos o que cambiaron de transformacion se sacan de la grilla para reubicarlos
+            HeightMap* heigtMap = staticMeshManager.GetComponentPointer(meshInnerHandle)->GetHeightMap();
+            TransformComponent* staticMeshTransform = transformManager.GetComponentPointer(m_terrains[i].m_transformHandle);
+            if (refreshTransformCache(m_terrains[i], *staticMeshTransform, heigtMap) || !m_terrains[i].m_indexed) {
+                unindexTerrain(i);
+                m_cellSizeOutdated = true;
+            }
+        }
+        // si cambia el lado de las celdas se reubican todos los terrenos
+        if (m_cellSizeOutdated && updateCellSize()) {
+            for (int i = 0; i < m_terrains.size(); i++) {
+                unindexTerrain(i);
+            }
+        }
+        m_cellSizeOutdated = false;
+        for (int i = 0; i < m_terrains.size(); i++) {
+            if (!m_terrains[i].m_indexed) {
+                indexTerrain(i);
             }
         }
     }
 
-    bool EnvironmentData::withinGlobalBoundaries(glm::vec2 xyPoint, HeightMap* heightMap, glm::mat4 globalTerrainTransform) {
-        glm::vec2 globalMin = globalTerrainTransform * glm::vec4(heightMap->getMinXY(), 0, 1);
-        glm::vec2 globalMax = globalTerrainTransform * glm::vec4(heightMap->getMaxXY(), 0, 1);
-        return globalMin[0] <= xyPoint[0] && xyPoint[0] <= globalMax[0] &&
-            globalMin[1] <= xyPoint[1] && xyPoint[1] <= globalMax[1];
+    bool EnvironmentData::withinGlobalBoundaries(glm::vec2 xyPoint, const Terrain& terrain) const {
+        return terrain.m_globalMinXY[0] <= xyPoint[0] && xyPoint[0] <= terrain.m_globalMaxXY[0] &&
+            terrain.m_globalMinXY[1] <= xyPoint[1] && xyPoint[1] <= terrain.m_globalMaxXY[1];
     }
 
-    float EnvironmentData::getTerrainHeight(glm::vec2 xyPoint, ComponentManager<TransformComponent>& transformManager,
-        ComponentManager<StaticMeshComponent>& staticMeshManager) {
-        float maxHeight = std::numeric_limits<float>::lowest();
+    bool EnvironmentData::refreshTransformCache(Terrain& terrain, const TransformComponent& transform, HeightMap* heightMap) {
+        if (terrain.m_validTransformCache && terrain.m_transformVersion == transform.GetVersion()) {
+            return false;
+        }
+        MONA_ASSERT(transform.GetLocalRotation() == glm::identity<glm::fquat>(), "EnvironmentData: Terrains cannot be rotated.");
+        terrain.m_globalTransform = transform.GetModelMatrix();
+        terrain.m_inverseGlobalTransform = glm::inverse(terrain.m_globalTransform);
+        terrain.m_globalMinXY = terrain.m_globalTransform * glm::vec4(heightMap->getMinXY(), 0, 1);
+        terrain.m_globalMaxXY = terrain.m_globalTransform * glm::vec4(heightMap->getMaxXY(), 0, 1);
+        terrain.m_transformVersion = transform.GetVersion();
+        terrain.m_validTransformCache = true;
+        return true;
+    }
+
+    uint64_t EnvironmentData::cellKey(int cellX, int cellY) const {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32) | static_cast<uint32_t>(cellY);
+    }
+
+    glm::ivec2 EnvironmentData::cellCoordinates(glm::vec2 xyPoint) const {
+        return glm::ivec2(glm::floor(xyPoint / m_cellSize));
+    }
+
+    bool EnvironmentData::updateCellSize() {
+        if (m_terrains.empty()) {
+            return false;
+        }
+        m_terrainSizes.resize(m_terrains.size());
         for (int i = 0; i < m_terrains.size(); i++) {
-            if (!staticMeshManager.IsValid(m_terrains[i].m_meshHandle)) {
-                m_terrains.erase(m_terrains.begin() + i);
-                i--;
-                MONA_LOG_WARNING("EnvironmentData: Saved terrain was not valid, so it was removed.");
+            glm::vec2 extent = m_terrains[i].m_globalMaxXY - m_terrains[i].m_globalMinXY;
+            m_terrainSizes[i] = std::max(extent[0], extent[1]);
+        }
+        auto median = m_terrainSizes.begin() + m_terrainSizes.size() / 2;
+        std::nth_element(m_terrainSizes.begin(), median, m_terrainSizes.end());
+        float medianSize = std::max(*median, std::numeric_limits<float>::epsilon());
+        if (m_cellSize != 0.0f && medianSize <= 2 * m_cellSize && m_cellSize <= 2 * medianSize) {
+            return false;
+        }
+        m_cellSize = medianSize;
+        return true;
+    }
+
+    void EnvironmentData::indexTerrain(int terrainIndex) {
+        Terrain& terrain = m_terrains[terrainIndex];
+        // las celdas cubren intervalos [k*m_cellSize, (k+1)*m_cellSize), por lo que un limite superior justo en el borde
+        // de una celda no la ocupa y un terreno alineado a la grilla solo usa las celdas que cubre
+        terrain.m_minCell = cellCoordinates(terrain.m_globalMinXY);
+        terrain.m_maxCell = glm::max(glm::ivec2(glm::ceil(terrain.m_globalMaxXY / m_cellSize)) - 1, terrain.m_minCell);
+        glm::ivec2 cellCount = terrain.m_maxCell - terrain.m_minCell + 1;
+        terrain.m_large = MaxCellsPerTerrain < static_cast<int64_t>(cellCount[0]) * cellCount[1];
+        if (terrain.m_large) {
+            m_largeTerrains.push_back(terrainIndex);
+        }
+        else {
+            for (int x = terrain.m_minCell[0]; x <= terrain.m_maxCell[0]; x++) {
+                for (int y = terrain.m_minCell[1]; y <= terrain.m_maxCell[1]; y++) {
+                    m_cells[cellKey(x, y)].push_back(terrainIndex);
+                }
+            }
+        }
+        terrain.m_indexed = true;
+    }
+
+    void EnvironmentData::unindexTerrain(int terrainIndex) {
+        Terrain& terrain = m_terrains[terrainIndex];
+        if (!terrain.m_indexed) {
+            return;
+        }
+        if (terrain.m_large) {
+            m_largeTerrains.erase(std::find(m_largeTerrains.begin(), m_largeTerrains.end(), terrainIndex));
+            terrain.m_large = false;
+        }
+        else {
+            for (int x = terrain.m_minCell[0]; x <= terrain.m_maxCell[0]; x++) {
+                for (int y = terrain.m_minCell[1]; y <= terrain.m_maxCell[1]; y++) {
+                    auto cellIt = m_cells.find(cellKey(x, y));
+                    std::vector<int>& cell = cellIt->second;
+                    cell.erase(std::find(cell.begin(), cell.end(), terrainIndex));
+                    if (cell.empty()) {
+                        m_cells.erase(cellIt);
+                    }
+                }
+            }
+        }
+        terrain.m_indexed = false;
+    }
+
+    void EnvironmentData::eraseTerrain(int terrainIndex) {
+        // se reemplaza por el ultimo terreno, cuyas referencias en la grilla se actualizan al nuevo indice
+        unindexTerrain(terrainIndex);
+        int lastIndex = m_terrains.size() - 1;
+        if (terrainIndex != lastIndex) {
+            Terrain& lastTerrain = m_terrains[lastIndex];
+            if (lastTerrain.m_indexed && lastTerrain.m_large) {
+                *std::find(m_largeTerrains.begin(), m_largeTerrains.end(), lastIndex) = terrainIndex;
+            }
+            else if (lastTerrain.m_indexed) {
+                for (int x = lastTerrain.m_minCell[0]; x <= lastTerrain.m_maxCell[0]; x++) {
+                    for (int y = lastTerrain.m_minCell[1]; y <= lastTerrain.m_maxCell[1]; y++) {
+                        std::vector<int>& cell = m_cells[cellKey(x, y)];
+                        *std::find(cell.begin(), cell.end(), lastIndex) = terrainIndex;
+                    }
+                }
+            }
+            m_terrains[terrainIndex] = lastTerrain;
+        }
+        m_terrains.pop_back();
+        m_cellSizeOutdated = true;
+        if (m_terrains.empty()) {
+            m_cellSize = 0.0f;
+        }
+    }
+
+    float EnvironmentData::getTerrainHeight(glm::vec2 xyPoint, ComponentManager<StaticMeshComponent>& staticMeshManager) const {
+        float height;
+        getTerrainHeights({ &xyPoint, 1 }, { &height, 1 }, staticMeshManager);
+        return height;
+    }
+
+    void EnvironmentData::getTerrainHeights(std::span<const glm::vec2> xyPoints, std::span<float> outHeights,
+        ComponentManager<StaticMeshComponent>& staticMeshManager) const {
+        MONA_ASSERT(xyPoints.size() == outHeights.size(), "EnvironmentData: Output span must have one height per input point.");
+        std::fill(outHeights.begin(), outHeights.end(), std::numeric_limits<float>::lowest());
+        if (m_cells.empty() && m_largeTerrains.empty()) {
+            return;
+        }
+        for (int p = 0; p < xyPoints.size(); p++) {
+            glm::vec2 xyPoint = xyPoints[p];
+            for (int terrainIndex : m_largeTerrains) {
+                sampleTerrain(terrainIndex, xyPoint, outHeights[p], staticMeshManager);
+            }
+            if (m_cells.empty()) {
                 continue;
             }
-            const StaticMeshComponent* staticMesh = staticMeshManager.GetComponentPointer(m_terrains[i].m_meshHandle);
-            HeightMap* heigtMap = staticMesh->GetHeightMap();
-            TransformComponent* staticMeshTransform = transformManager.GetComponentPointer(m_terrains[i].m_transformHandle);
-            MONA_ASSERT(staticMeshTransform->GetLocalRotation() == glm::identity<glm::fquat>(), "EnvironmentData: Terrains cannot be rotated.");
-            glm::mat4 glblTransform = staticMeshTransform->GetModelMatrix();
-
-            if (withinGlobalBoundaries(xyPoint, heigtMap, glblTransform)) {
-                // transformar punto a espacio local del terreno
-
-                glm::vec3 localPoint = glm::inverse(glblTransform) * glm::vec4(xyPoint, 0, 1);
-                float localHeight = heigtMap->getHeight(localPoint[0], localPoint[1]);
-                localPoint[2] = localHeight;
-                glm::vec4 glblPoint = glblTransform * glm::vec4(localPoint, 1);
-                float result = glblPoint[2];
-                if (result > maxHeight) { maxHeight = result; }
-            }           
-            
-        }
-        return maxHeight;
+            // un punto justo en el borde inferior de su celda tambien puede pertenecer a terrenos que terminan en ese borde,
+            // guardados solo en la celda anterior
+            glm::vec2 cellPoint = xyPoint / m_cellSize;
+            glm::ivec2 cell = glm::ivec2(glm::floor(cellPoint));
+            glm::ivec2 firstCell = cell - glm::ivec2(glm::equal(glm::floor(cellPoint), cellPoint));
+            for (int x = firstCell[0]; x <= cell[0]; x++) {
+                for (int y = firstCell[1]; y <= cell[1]; y++) {
+                    auto cellIt = m_cells.find(cellKey(x, y));
+                    if (cellIt == m_cells.end()) {
+                        continue;
+                    }
+                    for (int terrainIndex : cellIt->second) {
+                        sampleTerrain(terrainIndex, xyPoint, outHeights[p], staticMeshManager);
+                    }
+                }
+            }
+        }
+    }
+
+    void EnvironmentData::sampleTerrain(int terrainIndex, glm::vec2 xyPoint, float& outHeight,
+        ComponentManager<StaticMeshComponent>& staticMeshManager) const {
+        const Terrain& terrain = m_terrains[terrainIndex];
+        // los terrenos eliminados despues de la ultima validacion se ignoran hasta la siguiente
+        if (!withinGlobalBoundaries(xyPoint, terrain) || !staticMeshManager.IsValid(terrain.m_meshHandle)) {
+            return;
+        }
+        HeightMap* heigtMap = staticMeshManager.GetComponentPointer(terrain.m_meshHandle)->GetHeightMap();
+        // como el punto tiene z = 0, pasar a espacio local solo usa la parte xy de la inversa, y de la
+        // transformacion global solo se necesita la fila que produce z
+        const glm::mat4& inv = terrain.m_inverseGlobalTransform;
+        const glm::mat4& glbl = terrain.m_globalTransform;
+        float localX = inv[0][0] * xyPoint[0] + inv[1][0] * xyPoint[1] + inv[3][0];
+        float localY = inv[0][1] * xyPoint[0] + inv[1][1] * xyPoint[1] + inv[3][1];
+        // en los bordes del terreno el redondeo de la inversa puede dejar el punto apenas fuera del mapa de alturas
+        localX = std::clamp(localX, heigtMap->getMinXY()[0], heigtMap->getMaxXY()[0]);
+        localY = std::clamp(localY, heigtMap->getMinXY()[1], heigtMap->getMaxXY()[1]);
+        float localHeight = heigtMap->getHeight(localX, localY);
+        float result = glbl[0][2] * localX + glbl[1][2] * localY + glbl[2][2] * localHeight + glbl[3][2];
+        outHeight = std::max(outHeight, result);
     }
 
     void EnvironmentData::addTerrain(const GameObjectHandle<GameObject>& staticMeshObject) {
+        // se indexa en la siguiente validacion, cuando se conoce su transformacion
         Terrain terrain(staticMeshObject);
         m_terrains.push_back(terrain);  
     }
@@ -73,7 +235,7 @@ namespace Mona{
         InnerComponentHandle meshInnerHandle = staticMeshObject->GetInnerComponentHandle<StaticMeshComponent>();
         for (int i = 0; i < m_terrains.size(); i++) {
             if (m_terrains[i].m_meshHandle.m_generation == meshInnerHandle.m_generation && m_terrains[i].m_meshHandle.m_index==meshInnerHandle.m_index) {
-                m_terrains.erase(m_terrains.begin() + i);
+                eraseTerrain(i);
                 return meshInnerHandle.m_index;
             }
         }
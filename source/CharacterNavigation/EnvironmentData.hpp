@@ -2,6 +2,9 @@
 #ifndef ENVIRONMENTDATA_HPP
 #define ENVIRONMENTDATA_HPP
 
+#include <span>
+#include <vector>
+#include <unordered_map>
 #include "../World/GameObjectHandle.hpp"
 #include "../World/TransformComponent.hpp"
 #include "../Rendering/StaticMeshComponent.hpp"
@@ -14,19 +17,67 @@ namespace Mona {
 		Terrain(const GameObjectHandle<GameObject>& staticMeshObject);
 		InnerComponentHandle m_transformHandle;
 		InnerComponentHandle m_meshHandle;
+		// transformacion global del terreno, su inversa y sus limites en xy, validos mientras la version del
+		// TransformComponent coincida con m_transformVersion
+		glm::mat4 m_globalTransform;
+		glm::mat4 m_inverseGlobalTransform;
+		glm::vec2 m_globalMinXY;
+		glm::vec2 m_globalMaxXY;
+		uint32_t m_transformVersion = 0;
+		bool m_validTransformCache = false;
+		// rango de celdas de la grilla espacial que ocupa el terreno (solo si m_indexed y no m_large)
+		glm::ivec2 m_minCell;
+		glm::ivec2 m_maxCell;
+		bool m_indexed = false;
+		// el terreno ocuparia demasiadas celdas, por lo que se guarda fuera de la grilla
+		bool m_large = false;
 	};
 
+	/*
+	* Los terrenos se indexan en una grilla uniforme y dispersa sobre sus limites globales en xy, de modo que una consulta
+	* de altura solo revisa los terrenos de la celda del punto. El indice se mantiene en addTerrain, removeTerrain y
+	* validateTerrains, que ademas elimina los terrenos invalidos y reubica los que cambiaron de transformacion. Las
+	* consultas no modifican el indice, por lo que reflejan el estado del ultimo llamado a validateTerrains.
+	* El lado de las celdas es la mediana del lado de los terrenos, y los pocos terrenos mucho mas grandes que ella se
+	* guardan en una lista aparte revisada en cada consulta, de modo que ningun terreno ocupe un numero excesivo de celdas.
+	*/
 	class EnvironmentData {
 		private:
 			std::vector<Terrain> m_terrains;
-			bool withinGlobalBoundaries(glm::vec2 xyPoint, HeightMap* heightMap, glm::mat4 globalTerrainTransform);
+			// indices de m_terrains por celda, la llave combina las coordenadas enteras (x, y) de la celda
+			std::unordered_map<uint64_t, std::vector<int>> m_cells;
+			// terrenos que ocuparian mas de MaxCellsPerTerrain celdas
+			std::vector<int> m_largeTerrains;
+			static constexpr int MaxCellsPerTerrain = 64;
+			// lado de las celdas, la mediana del lado de los terrenos. Se recalcula, reindexando todos los terrenos, cuando
+			// la mediana actual se aleja en mas de un factor 2 del valor usado
+			float m_cellSize = 0.0f;
+			bool m_cellSizeOutdated = false;
+			// memoria de trabajo para calcular la mediana
+			std::vector<float> m_terrainSizes;
+			bool withinGlobalBoundaries(glm::vec2 xyPoint, const Terrain& terrain) const;
+			bool refreshTransformCache(Terrain& terrain, const TransformComponent& transform, HeightMap* heightMap);
+			uint64_t cellKey(int cellX, int cellY) const;
+			glm::ivec2 cellCoordinates(glm::vec2 xyPoint) const;
+			bool updateCellSize();
+			void indexTerrain(int terrainIndex);
+			void unindexTerrain(int terrainIndex);
+			void eraseTerrain(int terrainIndex);
+			void sampleTerrain(int terrainIndex, glm::vec2 xyPoint, float& outHeight,
+				ComponentManager<StaticMeshComponent>& staticMeshManager) const;
 		public:
 			EnvironmentData() = default;
-			float getTerrainHeight(glm::vec2 xyPoint, ComponentManager<TransformComponent>& transformManager,
-				ComponentManager<StaticMeshComponent>& staticMeshManager);
+			// las consultas usan las transformaciones guardadas en el ultimo validateTerrains, por lo que un terreno agregado
+			// o movido despues de este no se ve (o se ve en su posicion anterior) hasta la siguiente validacion
+			float getTerrainHeight(glm::vec2 xyPoint, ComponentManager<StaticMeshComponent>& staticMeshManager) const;
+			// escribe en outHeights[i] la altura maxima de los terrenos en xyPoints[i] (lowest() si ningun terreno lo cubre)
+			void getTerrainHeights(std::span<const glm::vec2> xyPoints, std::span<float> outHeights,
+				ComponentManager<StaticMeshComponent>& staticMeshManager) const;
+			// el terreno se indexa, y empieza a aparecer en las consultas, en el siguiente validateTerrains
 			void addTerrain(const GameObjectHandle<GameObject>& staticMeshObject);
 			int removeTerrain(const GameObjectHandle<GameObject>& staticMeshObject);
-			void validateTerrains(ComponentManager<StaticMeshComponent>& staticMeshManager);
+			void validateTerrains(ComponentManager<TransformComponent>& transformManager,
+				ComponentManager<StaticMeshComponent>& staticMeshManager);
 	};
 
 }
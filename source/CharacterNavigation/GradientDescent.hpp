@@ -3,98 +3,109 @@
 #define GRADIENTDESCENT_HPP
 
 #include <vector>
-#include <functional>
+#include <array>
+#include <tuple>
+#include <span>
+#include <utility>
+#include <cmath>
 #include "../Core/Log.hpp"
-#include "../Core/FuncUtils.hpp"
 
 namespace Mona {
 
-	template <typename dataT>
-	class FunctionTerm { // representa un termino de la funcion objetivo
-		template <typename dataT>
-		friend class GradientDescent;
-		dataT* m_dataPtr;
-		float m_weight = 1.0f;
-		// funcion que calcula el valor del termino dado un vector con los valores de las variables
-		std::function<float(const std::vector<float>&, dataT*)> m_termFunction;
-		// funcion que calcula el valor de la derivada del termino,
-		// dado un vector con los valores de las variables y el indice de la variable
-		// respecto a la cual se deriva
-		std::function<float(const std::vector<float>&, int, dataT*)> m_termPartialDerivativeFunction;
-		float calcTerm(const std::vector<float>& args) {
-			return m_termFunction(args, m_dataPtr);
-		}
-		float calcTermPartialDerivative(const std::vector<float>& args, int varIndex) {
-			return m_termPartialDerivativeFunction(args, varIndex, m_dataPtr);
-		}
-	public:
-		FunctionTerm(std::function<float(const std::vector<float>&, dataT*)> termFunction,
-			std::function<float(const std::vector<float>&, int, dataT*)> termPartialDerivativeFunction) :
-			m_termFunction(termFunction), m_termPartialDerivativeFunction(termPartialDerivativeFunction) {
-		}
-	};
-	
 	enum class DescentType {
 		REGULAR,
 		MOMENTUM
 	};
-	template <typename dataT>
+
+	/*
+	* Cada termino de la funcion objetivo es un tipo con los metodos
+	*	float calcTerm(std::span<const float> args, dataT* dataPtr)
+	*	float calcTermPartialDerivative(std::span<const float> args, int varIndex, dataT* dataPtr)
+	* que calculan el valor del termino y su derivada respecto a la variable varIndex. El comportamiento posterior a cada
+	* paso es un tipo con el metodo
+	*	void operator()(std::span<float> args, dataT* dataPtr, std::span<float> argsRawDelta)
+	* Al ser parametros de plantilla, y no std::function, las llamadas se resuelven en tiempo de compilacion y pueden
+	* expandirse en linea.
+	*/
+	template <typename dataT, typename PostStepT, typename ...TermTypes>
 	class GradientDescent {
-		std::vector<FunctionTerm<dataT>> m_terms;
-		int m_argNum;
-		dataT* m_dataPtr;
-		std::function<void(std::vector<float>&, dataT*, std::vector<float>&)>  m_postDescentStepCustomBehaviour;
-	public:
-		GradientDescent() = default;
-		GradientDescent(std::vector<FunctionTerm<dataT>> terms, int argNum, dataT* dataPtr,
-			std::function<void(std::vector<float>&, dataT*, std::vector<float>&)>  postDescentStepCustomBehaviour) {
-			MONA_ASSERT(terms.size() > 0, "Must provide at least one function term");
-			m_argNum = argNum;
-			m_terms = terms;
-			m_postDescentStepCustomBehaviour = postDescentStepCustomBehaviour;
-			m_dataPtr = dataPtr;
-			for (int i = 0; i < m_terms.size(); i++) {
-				m_terms[i].m_dataPtr = dataPtr;
+		static_assert(sizeof...(TermTypes) > 0, "Must provide at least one function term");
+		std::tuple<TermTypes...> m_terms;
+		std::array<float, sizeof...(TermTypes)> m_weights;
+		int m_argNum = 0;
+		dataT* m_dataPtr = nullptr;
+		PostStepT m_postDescentStepCustomBehaviour;
+		// buffers reutilizados entre llamados, solo crecen cuando aumenta el numero de argumentos
+		std::vector<float> m_gradient;
+		std::vector<float> m_argsRawDelta;
+
+		template <size_t ...I>
+		void addTermsPartialDerivatives(std::span<const float> args, std::span<float> outGradient, std::index_sequence<I...>) {
+			(addTermPartialDerivatives(std::get<I>(m_terms), m_weights[I], args, outGradient), ...);
+		}
+		template <typename TermT>
+		void addTermPartialDerivatives(TermT& term, float weight, std::span<const float> args, std::span<float> outGradient) {
+			if (weight == 0) {
+				return;
 			}
+			for (int j = 0; j < m_argNum; j++) {
+				outGradient[j] += weight * term.calcTermPartialDerivative(args, j, m_dataPtr);
+			}
+		}
+		template <size_t ...I>
+		float addTermsValues(std::span<const float> args, std::index_sequence<I...>) {
+			float functionValue = 0;
+			((functionValue += m_weights[I] != 0 ? m_weights[I] * std::get<I>(m_terms).calcTerm(args, m_dataPtr) : 0.0f), ...);
+			return functionValue;
+		}
+	public:
+		GradientDescent() {
+			m_weights.fill(1.0f);
+		}
+		// terminos y comportamiento posterior construidos por defecto, suficiente para tipos sin estado
+		GradientDescent(dataT* dataPtr, int argNum) : m_dataPtr(dataPtr) {
+			m_weights.fill(1.0f);
+			setArgNum(argNum);
+		};
+		GradientDescent(dataT* dataPtr, int argNum, PostStepT postDescentStepCustomBehaviour, TermTypes... terms) :
+			m_terms(std::move(terms)...), m_dataPtr(dataPtr), m_postDescentStepCustomBehaviour(std::move(postDescentStepCustomBehaviour)) {
+			m_weights.fill(1.0f);
+			setArgNum(argNum);
 		};
 
-
-		std::vector<float> computeGradient(const std::vector<float>& args) {
+		// escribe en outGradient (de tamano argNum) el gradiente de la funcion objetivo evaluado en args
+		void computeGradient(std::span<const float> args, std::span<float> outGradient) {
 			MONA_ASSERT(args.size() == m_argNum, "GradientDescent: number of args does not match argNum value");
-			std::vector<float> gradient(m_argNum, 0.0f);
-			for (int i = 0; i < m_terms.size(); i++) {
-				for (int j = 0; j < m_argNum; j++) {
-					if (m_terms[i].m_weight != 0) {
-						gradient[j] += m_terms[i].m_weight * m_terms[i].calcTermPartialDerivative(args, j);
-					}					
-				}
+			MONA_ASSERT(outGradient.size() == m_argNum, "GradientDescent: gradient size does not match argNum value");
+			for (int j = 0; j < m_argNum; j++) {
+				outGradient[j] = 0.0f;
 			}
-			return gradient;
+			addTermsPartialDerivatives(args, outGradient, std::index_sequence_for<TermTypes...>());
 		}
 
-		std::vector<float> computeArgsMin(float descentRate, int maxIterations, float targetArgDelta,
-			const std::vector<float>& initialArgs, DescentType descentType=DescentType::REGULAR, bool softenSteps = true) {
-			MONA_ASSERT(initialArgs.size() == m_argNum, "GradientDescent: number of args does not match argNum value");
-			std::vector<float> args = initialArgs;
-			std::vector<float> gradient;
-			std::vector<float> argsRawDelta(args.size());
-			std::vector<bool> continueDescent(args.size(), true);
+		// args contiene los valores iniciales y al retornar contiene los valores que minimizan la funcion
+		void computeArgsMin(float descentRate, int maxIterations, float targetArgDelta,
+			std::span<float> args, DescentType descentType=DescentType::REGULAR, bool softenSteps = true) {
+			MONA_ASSERT(args.size() == m_argNum, "GradientDescent: number of args does not match argNum value");
+			std::span<float> gradient(m_gradient.data(), m_argNum);
+			std::span<float> argsRawDelta(m_argsRawDelta.data(), m_argNum);
+			bool continueDescent = true;
 			int stepNum = 0;
 			// primer computo
-			gradient = computeGradient(args);
-			for (int i = 0; i < args.size(); i++) {
+			computeGradient(args, gradient);
+			for (int i = 0; i < m_argNum; i++) {
 				argsRawDelta[i] = gradient[i];
 				float argDelta = descentRate * argsRawDelta[i];
 				args[i] -= argDelta;
 			}
-			m_postDescentStepCustomBehaviour(args, m_dataPtr, argsRawDelta);		
-			while (stepNum < maxIterations && funcUtils::conditionVector_OR(continueDescent)) {
-				gradient = computeGradient(args);
-				for (int i = 0; i < args.size(); i++) {
+			m_postDescentStepCustomBehaviour(args, m_dataPtr, argsRawDelta);
+			while (stepNum < maxIterations && continueDescent) {
+				computeGradient(args, gradient);
+				for (int i = 0; i < m_argNum; i++) {
 					if (softenSteps) {
-						if (gradient[i] != 0 && argsRawDelta[i]!=0 && abs(argsRawDelta[i]*10) < abs(gradient[i])) {
-							float sign = gradient[i] / abs(gradient[i]);
-							gradient[i] = abs(argsRawDelta[i] * 10)*sign;
+						if (gradient[i] != 0 && argsRawDelta[i]!=0 && std::abs(argsRawDelta[i]*10) < std::abs(gradient[i])) {
+							float sign = gradient[i] / std::abs(gradient[i]);
+							gradient[i] = std::abs(argsRawDelta[i] * 10)*sign;
 						}
 					}
 					if (descentType == DescentType::REGULAR) {
@@ -107,42 +118,41 @@ namespace Mona {
 					args[i] -= argDelta;
 				}
 				m_postDescentStepCustomBehaviour(args, m_dataPtr, argsRawDelta);
-				for (int i = 0; i < args.size(); i++) {
-					continueDescent[i] = targetArgDelta < abs(descentRate*argsRawDelta[i]);
+				// se continua mientras algun argumento siga cambiando mas que targetArgDelta
+				continueDescent = false;
+				for (int i = 0; i < m_argNum; i++) {
+					continueDescent = continueDescent || targetArgDelta < std::abs(descentRate*argsRawDelta[i]);
 				}
 				stepNum += 1;
 			}
-			return args;
 		};
 
 
-		float computeFunctionValue(const std::vector<float>& args) {
+		float computeFunctionValue(std::span<const float> args) {
 			MONA_ASSERT(args.size() == m_argNum, "GradientDescent: number of args does not match argNum value");
-			float functionValue = 0;
-			for (int i = 0; i < m_terms.size(); i++) {
-				if (m_terms[i].m_weight != 0) {
-					functionValue += m_terms[i].m_weight * m_terms[i].calcTerm(args);
-				}				
-			}
-			return functionValue;
+			return addTermsValues(args, std::index_sequence_for<TermTypes...>());
 		};
 
 		void  setArgNum(int argNum) {
 			m_argNum = argNum;
+			if (m_gradient.size() < argNum) {
+				m_gradient.resize(argNum);
+				m_argsRawDelta.resize(argNum);
+			}
 		};
 
 		int getTermNum() {
-			return m_terms.size();
+			return sizeof...(TermTypes);
 		}
 
 		void setTermWeight(int termIndex, float weight){
-			MONA_ASSERT(0 <= termIndex && termIndex < m_terms.size(), "GradientDescent: input termIndex was out of bounds.");
-			m_terms[termIndex].m_weight = weight;
+			MONA_ASSERT(0 <= termIndex && termIndex < getTermNum(), "GradientDescent: input termIndex was out of bounds.");
+			m_weights[termIndex] = weight;
 		}
-	};	
+	};
 };
 
 
 
 
-#endif
\ No newline at end of file
+#endif
@@ -14,6 +14,22 @@ namespace Mona{
 		m_heightFunc = heightFunc;
     }
 
+    HeightMap::HeightMap(const glm::vec2& bottomLeft, const glm::vec2& topRight, int numVerticesX, int numVerticesY,
+        float (*heightFunc)(float, float)) : HeightMap(bottomLeft, topRight, heightFunc) {
+        MONA_ASSERT(2 <= numVerticesX && 2 <= numVerticesY, "HeightMap: Grid must have at least two vertices per axis.");
+        m_numVerticesX = numVerticesX;
+        m_numVerticesY = numVerticesY;
+        m_stepX = (m_maxX - m_minX) / (numVerticesX - 1);
+        m_stepY = (m_maxY - m_minY) / (numVerticesY - 1);
+        m_heights.resize(numVerticesX * numVerticesY);
+        for (int i = 0; i < numVerticesX; i++) {
+            for (int j = 0; j < numVerticesY; j++) {
+                glm::vec2 xy = getVertexXY(i, j);
+                m_heights[i * numVerticesY + j] = heightFunc(xy[0], xy[1]);
+            }
+        }
+    }
+
     bool HeightMap::withinBoundaries(float x, float y) {
         return m_minX <= x && x <= m_maxX && m_minY <= y && y <= m_maxY;
     }
@@ -24,7 +40,21 @@ namespace Mona{
             return std::numeric_limits<float>::lowest();
         }
 
-        return m_heightFunc(x, y);
+        if (!isBaked()) {
+            return m_heightFunc(x, y);
+        }
+        // celda de la grilla que contiene al punto, la ultima fila y columna de vertices solo cierran celdas
+        float cellX = (x - m_minX) / m_stepX;
+        float cellY = (y - m_minY) / m_stepY;
+        int i = std::min(static_cast<int>(cellX), m_numVerticesX - 2);
+        int j = std::min(static_cast<int>(cellY), m_numVerticesY - 2);
+        float tx = cellX - i;
+        float ty = cellY - j;
+        const float* column0 = &m_heights[i * m_numVerticesY + j];
+        const float* column1 = column0 + m_numVerticesY;
+        float h0 = funcUtils::lerp(column0[0], column0[1], ty);
+        float h1 = funcUtils::lerp(column1[0], column1[1], ty);
+        return funcUtils::lerp(h0, h1, tx);
     }
 
 }
\ No newline at end of file
@@ -16,14 +16,28 @@ namespace Mona {
 			float m_maxX;
 			float m_maxY;
 			float (*m_heightFunc)(float, float) = nullptr;
+			// alturas precalculadas en una grilla regular, indexadas como i * m_numVerticesY + j
+			std::vector<float> m_heights;
+			int m_numVerticesX = 0;
+			int m_numVerticesY = 0;
+			float m_stepX = 0;
+			float m_stepY = 0;
 
 		public:
 			HeightMap() = default;
 			HeightMap(const glm::vec2& bottomLeft, const glm::vec2& topRight, float (*heightFunc)(float, float));
+			// evalua heightFunc una sola vez en una grilla de numVerticesX x numVerticesY vertices, las consultas
+			// posteriores interpolan bilinealmente entre los vertices
+			HeightMap(const glm::vec2& bottomLeft, const glm::vec2& topRight, int numVerticesX, int numVerticesY,
+				float (*heightFunc)(float, float));
 			bool withinBoundaries(float x, float y);
 			glm::vec2 getMinXY() { return glm::vec2( m_minX, m_minY ); }
 			glm::vec2 getMaxXY() { return glm::vec2(m_maxX, m_maxY); }
 			float getHeight(float x, float y);
+			// altura del vertice (i, j) de la grilla, i en el eje x y j en el eje y
+			float getVertexHeight(int i, int j) const { return m_heights[i * m_numVerticesY + j]; }
+			glm::vec2 getVertexXY(int i, int j) const { return glm::vec2(m_minX + m_stepX * i, m_minY + m_stepY * j); }
+			bool isBaked() const { return !m_heights.empty(); }
 			bool isValid() { return m_heightFunc != nullptr; }
 	};
 
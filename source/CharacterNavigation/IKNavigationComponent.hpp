@@ -48,6 +48,12 @@ namespace Mona {
 			void SetAngularSpeed(float angularSpeed) {
 				m_ikRigController.setAngularSpeed(angularSpeed);
 			}
+			// umbrales de distancia a la camara principal de los niveles de detalle de la navegacion
+			void SetLODSettings(const IKNavigationLODSettings& lodSettings) {
+				m_ikRigController.setLODSettings(lodSettings);
+			}
+			const IKNavigationLODSettings& GetLODSettings() const { return m_ikRigController.getLODSettings(); }
+			IKNavigationLOD GetLOD() const { return m_ikRigController.getLOD(); }
 			IKRigController& GetIKRigController() { return m_ikRigController; }
 		private:
 			RigData m_rigData;
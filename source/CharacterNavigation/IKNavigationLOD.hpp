@@ -0,0 +1,36 @@
+#pragma once
+#ifndef IKNAVIGATIONLOD_HPP
+#define IKNAVIGATIONLOD_HPP
+#include <limits>
+namespace Mona {
+	/*
+	* Nivel de detalle de la navegacion con IK de un rig, ordenados de mayor a menor detalle:
+	*	FULL: trayectorias, correccion de pasos e IK completos.
+	*	REDUCED: sin correccion de pasos y con menos iteraciones en el descenso de gradiente de la IK.
+	*	HIP_ONLY: sin IK ni trayectorias de los ee. La cadera avanza con la velocidad de la animacion original y solo se
+	*		ajusta su altura a la del terreno.
+	*	ANIMATION_ONLY: solo la animacion original, avanzando en el plano con su velocidad pero sin consultar el terreno.
+	*/
+	enum class IKNavigationLOD {
+		FULL,
+		REDUCED,
+		HIP_ONLY,
+		ANIMATION_ONLY
+	};
+
+	/*
+	* Umbrales de distancia a la camara principal de cada nivel de detalle. Se pasa a un nivel de menor detalle al
+	* superar su umbral, y se vuelve al de mayor detalle solo al bajar de umbral*(1 - hysteresis), para que un rig cerca
+	* de un umbral no cambie de nivel en cada frame. Por defecto todos los rigs usan FULL.
+	*/
+	struct IKNavigationLODSettings {
+		float reducedDistance = std::numeric_limits<float>::max();
+		float hipOnlyDistance = std::numeric_limits<float>::max();
+		float animationOnlyDistance = std::numeric_limits<float>::max();
+		// fraccion de cada umbral usada como margen para volver a un nivel de mayor detalle
+		float hysteresis = 0.1f;
+		// fraccion del limite de iteraciones del descenso de gradiente usada en REDUCED
+		float reducedIterationFactor = 0.25f;
+	};
+}
+#endif
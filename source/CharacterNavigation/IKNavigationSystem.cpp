@@ -1,5 +1,7 @@
 #include "IKNavigationSystem.hpp"
 #include "../World/ComponentManager.hpp"
+#include "../Core/JobSystem.hpp"
+#include "../World/GameObject.hpp"
 #include "IKNavigationLifetimePolicy.hpp"
 
 namespace Mona {
@@ -7,18 +9,60 @@ namespace Mona {
 	void IKNavigationSystem::UpdateAllRigs(ComponentManager<IKNavigationComponent>& ikNavigationManager,
 		ComponentManager<TransformComponent>& transformManager,
 		ComponentManager<StaticMeshComponent>& staticMeshManager, 
-		ComponentManager<SkeletalMeshComponent>& skeletalMeshManager, float timeStep) {
-			
-		for (uint32_t i = 0; i < ikNavigationManager.GetCount(); i++) {
-			IKNavigationComponent& ikNav = ikNavigationManager[i];
-			IKRigController& ikRigController = ikNav.GetIKRigController();
+		ComponentManager<SkeletalMeshComponent>& skeletalMeshManager,
+		ComponentManager<CameraComponent>& cameraManager,
+		const InnerComponentHandle& cameraHandle, float timeStep,
+		JobSystem& jobSystem) {
+		uint32_t rigCount = ikNavigationManager.GetCount();
+		// sin camara principal todos los rigs usan el nivel de mayor detalle
+		bool hasCamera = cameraManager.IsValid(cameraHandle);
+		glm::vec3 cameraPosition(0);
+		if (hasCamera) {
+			GameObject* cameraOwner = cameraManager.GetOwner(cameraHandle);
+			cameraPosition = transformManager.GetComponentPointer(cameraOwner->GetInnerComponentHandle<TransformComponent>())->GetWorldTranslation();
+		}
+
+		// primer recorrido en serie: la validacion de terrenos y la eleccion del nivel de detalle solo escriben el estado de
+		// cada rig, y aqui ademas se cuenta cuantos rigs usan cada clip para decidir cuales pueden actualizarse en paralelo
+		m_clipUsers.clear();
+		for (uint32_t i = 0; i < rigCount; i++) {
+			IKRigController& ikRigController = ikNavigationManager[i].GetIKRigController();
+			ikRigController.validateTerrains(transformManager, staticMeshManager);
+			float cameraDistance = 0;
+			if (hasCamera) {
+				TransformComponent* rigTransform = transformManager.GetComponentPointer(ikRigController.getTransformHandle());
+				cameraDistance = glm::distance(rigTransform->GetWorldTranslation(), cameraPosition);
+			}
+			ikRigController.updateLOD(cameraDistance);
+			for (AnimationIndex j = 0; j < ikRigController.getAnimationNum(); j++) {
+				m_clipUsers[ikRigController.getAnimationClip(j)] += 1;
+			}
+		}
+		m_parallelRigs.clear();
+		m_serialRigs.clear();
+		for (uint32_t i = 0; i < rigCount; i++) {
+			IKRigController& ikRigController = ikNavigationManager[i].GetIKRigController();
+			bool sharesClip = false;
+			for (AnimationIndex j = 0; j < ikRigController.getAnimationNum(); j++) {
+				sharesClip = sharesClip || 1 < m_clipUsers[ikRigController.getAnimationClip(j)];
+			}
+			(sharesClip ? m_serialRigs : m_parallelRigs).push_back(i);
+		}
+
+		jobSystem.ParallelFor(m_parallelRigs.size(), RigsPerJob, [&](size_t k) {
+			IKRigController& ikRigController = ikNavigationManager[m_parallelRigs[k]].GetIKRigController();
+			ikRigController.updateIKRig(timeStep, transformManager, staticMeshManager, skeletalMeshManager);
+		});
+		for (uint32_t i : m_serialRigs) {
+			IKRigController& ikRigController = ikNavigationManager[i].GetIKRigController();
 			ikRigController.updateIKRig(timeStep, transformManager, staticMeshManager, skeletalMeshManager);
 		}
 
+		// se llena en serie y en el orden de las componentes, independiente del orden de ejecucion de los rigs
 		#if NDEBUG
 		#else
-		m_controllersDebug.resize(ikNavigationManager.GetCount());
-		for (uint32_t i = 0; i < ikNavigationManager.GetCount(); i++) {
+		m_controllersDebug.resize(rigCount);
+		for (uint32_t i = 0; i < rigCount; i++) {
 			IKNavigationComponent& ikNav = ikNavigationManager[i];
 			IKRigController& ikRigController = ikNav.GetIKRigController();
 			m_controllersDebug[i] = &ikRigController;
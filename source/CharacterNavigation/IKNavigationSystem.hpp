@@ -2,21 +2,48 @@
 #ifndef IKNAVIGATIONSYSTEM_HPP
 #define IKNAVIGATIONSYSTEM_HPP
 
+#include <vector>
+#include <unordered_map>
 #include "../World/TransformComponent.hpp"
 #include "../Rendering/StaticMeshComponent.hpp"
 #include "../Animation/SkeletalMeshComponent.hpp"
+#include "../Rendering/CameraComponent.hpp"
 #include "IKNavigationComponent.hpp"
 
 namespace Mona {
 	class IKRigController;
+	class AnimationClip;
+	class JobSystem;
 	class IKNavigationSystem {
 		std::vector<IKRigController*> m_controllersDebug;
+		// indices de los rigs que se actualizan en paralelo y de los que comparten algun clip de animacion con otro rig,
+		// que se actualizan en serie ya que la IK modifica las rotaciones del clip
+		std::vector<uint32_t> m_parallelRigs;
+		std::vector<uint32_t> m_serialRigs;
+		std::unordered_map<const AnimationClip*, uint32_t> m_clipUsers;
+		static constexpr size_t RigsPerJob = 1;
 	public:
+		// Componentes leidas y escritas por UpdateAllRigs, usadas por World para agendar etapas concurrentes
+		using ReadComponents = ComponentTypeList<StaticMeshComponent, CameraComponent>;
+		using WriteComponents = ComponentTypeList<TransformComponent, SkeletalMeshComponent, IKNavigationComponent>;
 		IKNavigationSystem() = default;
+		/*
+		* Actualiza todos los rigs repartiendolos entre los hilos de jobSystem. Cada rig tiene su propio estado temporal
+		* (descenso de gradiente, corrector de pasos e indice de terrenos) y solo escribe su propio transform, por lo que
+		* los terrenos compartidos se consultan en modo de solo lectura. El nivel de detalle de cada rig se elige segun su
+		* distancia a la camara principal (cameraHandle).
+		* Solo los rigs cuyos clips no usa ningun otro rig corren en paralelo, ya que la IK escribe las rotaciones del clip.
+		* Los que comparten algun clip se actualizan todos en serie en el hilo principal, y como AnimationClipManager entrega
+		* el mismo clip a todos los que cargan una animacion, una multitud con las mismas animaciones no se reparte entre
+		* los hilos.
+		*/
 		void UpdateAllRigs(ComponentManager<IKNavigationComponent>& ikNavigationManager,
 			ComponentManager<TransformComponent>& transformManager,
 			ComponentManager<StaticMeshComponent>& staticMeshManager,
-			ComponentManager<SkeletalMeshComponent>& skeletalMeshManager, float timeStep);
+			ComponentManager<SkeletalMeshComponent>& skeletalMeshManager,
+			ComponentManager<CameraComponent>& cameraManager,
+			const InnerComponentHandle& cameraHandle, float timeStep,
+			JobSystem& jobSystem);
 		std::vector<IKRigController*> getControllersDebug() { return m_controllersDebug; }
 	};
 }
@@ -93,6 +93,7 @@ namespace Mona {
 		}
 		MONA_ASSERT(chainBaseIndex != -1, "IKRig: base joint and end effector were not on the same chain!");
 		ikChain.m_parentJoint = topology[chainBaseIndex];
+		ikChain.m_solverType = chainEnds.solverType;
 		return ikChain;
 	}
 
@@ -18,6 +18,7 @@ namespace Mona{
         friend class AnimationValidator;
         friend class IKNavigationComponent;
         friend class DebugDrawingSystem_ikNav;
+        friend class MonaTest;
         public:
             IKRig() = default;
             IKRig(std::shared_ptr<Skeleton> skeleton, RigData rigData, InnerComponentHandle transformHandle);
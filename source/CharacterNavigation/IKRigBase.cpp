@@ -27,7 +27,7 @@ namespace Mona{
 		}
 		m_variableJointRotations = m_originalJointRotations[0];
 		m_forwardKinematics = forwardKinematics;
-		m_savedAngles = std::vector<LIC<1>>(totalJointNum);
+		m_savedAngles = std::vector<AngleHistory>(totalJointNum);
 		
 	}
 	void IKAnimation::setVariableJointRotations(FrameIndex frame) {
@@ -41,12 +41,19 @@ namespace Mona{
 		float nextFrameRepTime = getReproductionTime(getNextFrameIndex(), repCountOffset_next);
 		float currFrameBaseAngle = m_originalJointRotations[getCurrentFrameIndex()][jointIndex].getRotationAngle();
 		float nextFrameBaseAngle = m_originalJointRotations[getNextFrameIndex()][jointIndex].getRotationAngle();
-		m_savedAngles[jointIndex] = LIC<1>({ glm::vec1(currFrameBaseAngle), glm::vec1(nextFrameBaseAngle) }, { currentFrameRepTime, nextFrameRepTime });
+		m_savedAngles[jointIndex].clear();
+		m_savedAngles[jointIndex].insertPoint(glm::vec1(currFrameBaseAngle), currentFrameRepTime);
+		m_savedAngles[jointIndex].insertPoint(glm::vec1(nextFrameBaseAngle), nextFrameRepTime);
 	}
 
-	std::vector<glm::mat4> IKAnimation::getEEListModelSpaceVariableTransforms(std::vector<JointIndex> eeList, std::vector<glm::mat4>* outJointSpaceTransforms) {
+	std::vector<glm::mat4> IKAnimation::getEEListModelSpaceVariableTransforms(const std::vector<JointIndex>& eeList, std::vector<glm::mat4>* outJointSpaceTransforms) {
 		return m_forwardKinematics->EEListCustomSpaceVariableTransforms(eeList, glm::identity<glm::mat4>(), this, outJointSpaceTransforms);
 	}
+	void IKAnimation::getEEListModelSpaceVariableTransforms(const std::vector<JointIndex>& eeList, std::vector<glm::mat4>& outModelSpaceTransforms,
+		std::vector<glm::mat4>* outJointSpaceTransforms, ForwardKinematicsScratch& scratch) {
+		m_forwardKinematics->EEListCustomSpaceVariableTransforms(eeList, glm::identity<glm::mat4>(), this, outModelSpaceTransforms,
+			outJointSpaceTransforms, scratch);
+	}
 	std::vector<glm::mat4> IKAnimation::getEEListCustomSpaceTransforms(std::vector<JointIndex> eeList, glm::mat4 baseTransform, float reproductionTime, std::vector<glm::mat4>* outJointSpaceTransforms) {
 		return m_forwardKinematics->EEListCustomSpaceTransforms(eeList, baseTransform, this, reproductionTime, outJointSpaceTransforms);
 	}
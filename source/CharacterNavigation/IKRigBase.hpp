@@ -10,7 +10,11 @@ namespace Mona {
     typedef int JointIndex;
     typedef int FrameIndex;
     typedef int ChainIndex;
+    // Historial de angulos de una articulacion. Se recorta a los ultimos frames en cada actualizacion, por lo que
+    // la capacidad solo acota el caso en que no se recorta.
+    typedef RingLIC<1, 32> AngleHistory;
     class ForwardKinematics;
+    struct ForwardKinematicsScratch;
     class AnimationClip;    
 
     class JointRotation {
@@ -43,6 +47,7 @@ namespace Mona {
         friend class AnimationValidator;
         friend class DebugDrawingSystem_ikNav;
         friend class TrajectoryGenerator;
+        friend class MonaTest;
     private:
         AnimationIndex m_animationIndex = -1;
         // Indica si la animacion asociada esta activa
@@ -56,7 +61,7 @@ namespace Mona {
         // Rotacion modificable por cada joint
         std::vector<JointRotation> m_variableJointRotations;
         // Historial de angulos variables para cada joint
-        std::vector<LIC<1>> m_savedAngles;
+        std::vector<AngleHistory> m_savedAngles;
         ForwardKinematics* m_forwardKinematics;
         // Data de trayectoria para cada ikChain (mantiene orden del arreglo original de cadenas)
         std::vector<EEGlobalTrajectoryData> m_eeTrajectoryData;
@@ -94,7 +99,10 @@ namespace Mona {
         float getCurrentReproductionTime() const { return m_currentReproductionTime; }
         FrameIndex getNextFrameIndex() const { return (m_currentFrameIndex + 1) % (getTimeStamps().size());}
         FrameIndex getCurrentFrameIndex() const { return m_currentFrameIndex; }
-        std::vector<glm::mat4> getEEListModelSpaceVariableTransforms(std::vector<JointIndex> eeList, std::vector<glm::mat4>* outJointSpaceTransforms = nullptr);
+        std::vector<glm::mat4> getEEListModelSpaceVariableTransforms(const std::vector<JointIndex>& eeList, std::vector<glm::mat4>* outJointSpaceTransforms = nullptr);
+        // variante que reutiliza los arreglos entregados, usada en cada paso del descenso de gradiente
+        void getEEListModelSpaceVariableTransforms(const std::vector<JointIndex>& eeList, std::vector<glm::mat4>& outModelSpaceTransforms,
+            std::vector<glm::mat4>* outJointSpaceTransforms, ForwardKinematicsScratch& scratch);
         std::vector<glm::mat4> getEEListCustomSpaceTransforms(std::vector<JointIndex> eeList, glm::mat4 baseTransform, float reproductionTime, std::vector<glm::mat4>* outJointSpaceTransforms = nullptr);
         EEGlobalTrajectoryData* getEETrajectoryData(ChainIndex chainIndex) { return &(m_eeTrajectoryData[chainIndex]); }
         HipGlobalTrajectoryData* getHipTrajectoryData() { return &m_hipTrajectoryData; }
@@ -106,19 +114,29 @@ namespace Mona {
         bool isActive() { return m_active; }
         bool isMovementFixed();
         FrameIndex getFixedMovementFrame() { return m_fixedMovementFrame; }
-        LIC<1>const& getSavedAngles(JointIndex jointIndex) { return m_savedAngles[jointIndex]; }
+        AngleHistory const& getSavedAngles(JointIndex jointIndex) { return m_savedAngles[jointIndex]; }
         void setVariableJointRotations(FrameIndex frame);
         void refresh();
     };
+    enum class IKSolverType {
+        // Descenso de gradiente sobre los angulos de todas las articulaciones de la cadena
+        GRADIENT_DESCENT,
+        // Solucion cerrada para cadenas de dos huesos (cadera, rodilla y tobillo). Si la cadena tiene otro largo o los ejes
+        // de rotacion de la animacion no permiten alcanzar el objetivo se usa el descenso de gradiente.
+        TWO_BONE
+    };
     struct ChainEnds {
         // Nombre de la articulacion base de la cadena
         std::string baseJointName;
         // Nombre de la articulacion final de la cadena
         std::string endEffectorName;
+        // Metodo usado para resolver la cadena
+        IKSolverType solverType = IKSolverType::GRADIENT_DESCENT;
     };
     class IKChain {
         friend class IKRig;
         friend class IKRigController;
+        friend class MonaTest;
         // Nombre de la cadena
         std::string m_name;
         // Articulaciones que conforman la cadena, desde su origen hasta el ee
@@ -129,6 +147,8 @@ namespace Mona {
         std::vector<glm::vec3> m_currentEETargets;
         // Cadena opuesta a la actual (ej: pierna izquierda a pierna derecha). Para ajustar posiciones relativas.
         ChainIndex m_opposite;
+        // Metodo usado para resolver la cadena
+        IKSolverType m_solverType = IKSolverType::GRADIENT_DESCENT;
     public:
         IKChain() = default;
         const std::string& getName() const { return m_name; };
@@ -138,6 +158,7 @@ namespace Mona {
         glm::vec3 getCurrentEETarget(AnimationIndex animIndex) const { return m_currentEETargets[animIndex]; };
         void setCurrentEETarget(AnimationIndex animIndex, glm::vec3 currentEETarget) { m_currentEETargets[animIndex] = currentEETarget; }
         ChainIndex getOpposite() { return m_opposite; }
+        IKSolverType getSolverType() const { return m_solverType; }
     };
 
     struct RigData {
@@ -2,6 +2,8 @@
 #include "../Core/FuncUtils.hpp"
 #include "../Core/GlmUtils.hpp"
 #include "glm/gtx/rotate_vector.hpp"
+#include <array>
+#include <limits>
 
 namespace Mona {
 
@@ -25,8 +27,9 @@ namespace Mona {
 		m_animationValidator = AnimationValidator(&m_ikRig);
 	}
 
-	void IKRigController::validateTerrains(ComponentManager<StaticMeshComponent>& staticMeshManager) {
-		m_ikRig.m_trajectoryGenerator.m_environmentData.validateTerrains(staticMeshManager);
+	void IKRigController::validateTerrains(ComponentManager<TransformComponent>& transformManager,
+		ComponentManager<StaticMeshComponent>& staticMeshManager) {
+		m_ikRig.m_trajectoryGenerator.m_environmentData.validateTerrains(transformManager, staticMeshManager);
 	}
 
 	void IKRigController::addAnimation(std::shared_ptr<AnimationClip> animationClip, glm::vec3 originalUpVector, 
@@ -330,6 +333,48 @@ namespace Mona {
 	}
 
 
+	void IKRigController::updateGlobalTransformWithoutIK(float animationTimeStep, ComponentManager<TransformComponent>& transformManager,
+		ComponentManager<StaticMeshComponent>& staticMeshManager) {
+		TransformComponent* transform = transformManager.GetComponentPointer(m_ikRig.getTransformHandle());
+		glm::fquat updatedRotation = glm::angleAxis(m_ikRig.m_rotationAngle, m_ikRig.getUpVector());
+		transform->SetRotation(updatedRotation);
+
+		// velocidad media en el plano de la cadera en las animaciones activas, segun su trayectoria original
+		glm::vec2 hipVelocity(0);
+		int activeConfigs = 0;
+		for (AnimationIndex i = 0; i < m_ikRig.m_ikAnimations.size(); i++) {
+			IKAnimation& ikAnim = m_ikRig.m_ikAnimations[i];
+			if (ikAnim.isActive()) {
+				if (ikAnim.getAnimationType() == AnimationType::WALKING) {
+					LIC<3>& originalPositions = ikAnim.getHipTrajectoryData()->m_originalPositions;
+					float originalDuration = originalPositions.getTRange()[1] - originalPositions.getTRange()[0];
+					glm::vec2 originalDisplacement = glm::vec2(originalPositions.getEnd() - originalPositions.getStart());
+					hipVelocity += glm::rotate(originalDisplacement / originalDuration, m_ikRig.m_rotationAngle);
+				}
+				activeConfigs += 1;
+			}
+		}
+		if (activeConfigs == 0) {
+			return;
+		}
+		hipVelocity /= activeConfigs;
+		glm::vec3 newGlobalPosition = transform->GetLocalTranslation() + glm::vec3(hipVelocity * animationTimeStep, 0);
+
+		// en HIP_ONLY la cadera sigue la altura del terreno, en ANIMATION_ONLY no se consulta
+		if (m_lod == IKNavigationLOD::HIP_ONLY) {
+			float terrainHeight = m_ikRig.m_trajectoryGenerator.m_environmentData.getTerrainHeight(glm::vec2(newGlobalPosition),
+				staticMeshManager);
+			if (terrainHeight != std::numeric_limits<float>::lowest()) {
+				if (!m_validHipTerrainOffset) {
+					m_hipTerrainOffset = newGlobalPosition[2] - terrainHeight;
+					m_validHipTerrainOffset = true;
+				}
+				newGlobalPosition[2] = terrainHeight + m_hipTerrainOffset;
+			}
+		}
+		transform->SetTranslation(newGlobalPosition);
+	}
+
 	void IKRigController::updateAnimation(AnimationIndex animIndex) {
 		IKAnimation& ikAnim = m_ikRig.m_ikAnimations[animIndex];
 		if (ikAnim.m_onNewFrame) {
@@ -350,7 +395,7 @@ namespace Mona {
 						float tVal = ikAnim.m_savedAngles[jIndex].getTValue(k);
 						float minVal = ikAnim.m_savedAngles[jIndex].getTRange()[1] - avgFrameDuration*6;
 						if (tVal < minVal) {
-							ikAnim.m_savedAngles[jIndex] = ikAnim.m_savedAngles[jIndex].sample(tVal, ikAnim.m_savedAngles[jIndex].getTRange()[1]);
+							ikAnim.m_savedAngles[jIndex].removeFrontPoints(k);
 							break;
 						}
 					}
@@ -417,7 +462,7 @@ namespace Mona {
 
 	void IKRigController::updateIKRig(float timeStep, ComponentManager<TransformComponent>& transformManager,
 		ComponentManager<StaticMeshComponent>& staticMeshManager, ComponentManager<SkeletalMeshComponent>& skeletalMeshManager) {
-		validateTerrains(staticMeshManager);
+		validateTerrains(transformManager, staticMeshManager);
 		AnimationController& animController = skeletalMeshManager.GetComponentPointer(m_skeletalMeshHandle)->GetAnimationController();
 		float animTimeStep = timeStep * animController.GetPlayRate();
 		m_reproductionTime += animTimeStep;
@@ -439,27 +484,33 @@ namespace Mona {
 			}
 		}
 		m_transitioning = activeAnimations == 2;
-		for (AnimationIndex i = 0; i < m_ikRig.m_ikAnimations.size(); i++) {
-			if (m_ikRig.m_ikAnimations[i].isActive()) {
-				updateTrajectories(i, transformManager, staticMeshManager);			
-			}
+		if (IKNavigationLOD::HIP_ONLY <= m_lod) {
+			// sin trayectorias ni IK, el rig reproduce la animacion original
+			updateGlobalTransformWithoutIK(animTimeStep, transformManager, staticMeshManager);
 		}
-		updateGlobalTransform(transformManager);
-		if (m_ikEnabled) {
+		else {
 			for (AnimationIndex i = 0; i < m_ikRig.m_ikAnimations.size(); i++) {
-				IKAnimation& ikAnim = m_ikRig.m_ikAnimations[i];
-				if (ikAnim.isActive()) {
-					if (ikAnim.getAnimationType() == AnimationType::WALKING) {
-						if (!ikAnim.isMovementFixed()) {
+				if (m_ikRig.m_ikAnimations[i].isActive()) {
+					updateTrajectories(i, transformManager, staticMeshManager);
+				}
+			}
+			updateGlobalTransform(transformManager);
+			if (m_ikEnabled) {
+				for (AnimationIndex i = 0; i < m_ikRig.m_ikAnimations.size(); i++) {
+					IKAnimation& ikAnim = m_ikRig.m_ikAnimations[i];
+					if (ikAnim.isActive()) {
+						if (ikAnim.getAnimationType() == AnimationType::WALKING) {
+							if (!ikAnim.isMovementFixed()) {
+								updateAnimation(i);
+							}
+						}
+						else if (ikAnim.getAnimationType() == AnimationType::IDLE) {
 							updateAnimation(i);
 						}
 					}
-					else if (ikAnim.getAnimationType() == AnimationType::IDLE) {
-						updateAnimation(i);
-					}
 				}
 			}
-		}		
+		}
 
 		for (AnimationIndex i = 0; i < m_ikRig.m_ikAnimations.size(); i++) {
 			IKAnimation& ikAnim = m_ikRig.m_ikAnimations[i];
@@ -477,6 +528,62 @@ namespace Mona {
 		m_ikEnabled = enableIK;		
 	}
 
+	void IKRigController::setLODSettings(IKNavigationLODSettings lodSettings) {
+		MONA_ASSERT(0 <= lodSettings.hysteresis && lodSettings.hysteresis < 1,
+			"IKRigController: LOD hysteresis must be in [0, 1).");
+		MONA_ASSERT(0 < lodSettings.reducedIterationFactor && lodSettings.reducedIterationFactor <= 1,
+			"IKRigController: LOD iteration factor must be in (0, 1].");
+		m_lodSettings = lodSettings;
+	}
+
+	IKNavigationLOD IKRigController::selectLOD(const IKNavigationLODSettings& lodSettings, IKNavigationLOD currentLOD,
+		float cameraDistance) {
+		std::array<float, 3> thresholds = { lodSettings.reducedDistance, lodSettings.hipOnlyDistance,
+			lodSettings.animationOnlyDistance };
+		// nivel que corresponde a la distancia, y el que corresponde restando el margen de histeresis a los umbrales
+		int farLevel = 0;
+		int nearLevel = 0;
+		for (int i = 0; i < thresholds.size(); i++) {
+			if (thresholds[i] <= cameraDistance) {
+				farLevel = i + 1;
+			}
+			if (thresholds[i] * (1 - lodSettings.hysteresis) <= cameraDistance) {
+				nearLevel = i + 1;
+			}
+		}
+		int currentLevel = (int)currentLOD;
+		if (currentLevel < farLevel) {
+			return (IKNavigationLOD)farLevel;
+		}
+		if (nearLevel < currentLevel) {
+			return (IKNavigationLOD)nearLevel;
+		}
+		return currentLOD;
+	}
+
+	void IKRigController::updateLOD(float cameraDistance) {
+		IKNavigationLOD newLOD = selectLOD(m_lodSettings, m_lod, cameraDistance);
+		if (newLOD == m_lod) {
+			return;
+		}
+		bool wasUsingIK = m_lod < IKNavigationLOD::HIP_ONLY;
+		bool usesIK = newLOD < IKNavigationLOD::HIP_ONLY;
+		if (wasUsingIK != usesIK) {
+			// se descartan trayectorias y angulos guardados, que se regeneran desde el transform actual al volver a la IK,
+			// y se restauran las rotaciones originales de los clips
+			for (AnimationIndex i = 0; i < m_ikRig.m_ikAnimations.size(); i++) {
+				refreshIKAnimation(i);
+			}
+		}
+		if (newLOD == IKNavigationLOD::HIP_ONLY) {
+			m_validHipTerrainOffset = false;
+		}
+		m_lod = newLOD;
+		bool reduced = m_lod == IKNavigationLOD::REDUCED;
+		m_ikRig.m_inverseKinematics.setMaxIterationsFactor(reduced ? m_lodSettings.reducedIterationFactor : 1.0f);
+		m_ikRig.m_trajectoryGenerator.suspendStrideCorrection(reduced);
+	}
+
 
 
 
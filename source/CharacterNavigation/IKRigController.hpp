@@ -4,6 +4,7 @@
 
 #include "IKRig.hpp"
 #include "AnimationValidator.hpp"
+#include "IKNavigationLOD.hpp"
 #include "../World/ComponentManager.hpp"
 #include "../Animation/SkeletalMeshComponent.hpp"
 
@@ -19,14 +20,25 @@ namespace Mona {
 		float m_reproductionTime = 0;
 		bool m_ikEnabled;
 		bool m_transitioning;
+		IKNavigationLODSettings m_lodSettings;
+		IKNavigationLOD m_lod = IKNavigationLOD::FULL;
+		// diferencia de altura entre el rig y el terreno al entrar en HIP_ONLY, que se mantiene mientras dure ese nivel
+		float m_hipTerrainOffset = 0;
+		bool m_validHipTerrainOffset = false;
+		void updateGlobalTransformWithoutIK(float animationTimeStep, ComponentManager<TransformComponent>& transformManager,
+			ComponentManager<StaticMeshComponent>& staticMeshManager);
 	public:
 		IKRigController() = default;
 		IKRigController(std::shared_ptr<Skeleton> skeleton, RigData rigData, InnerComponentHandle transformHandle,
 			InnerComponentHandle skeletalMeshHandle, ComponentManager<TransformComponent>* transformManagerPtr);
-		void validateTerrains(ComponentManager<StaticMeshComponent>& staticMeshManager);
+		void validateTerrains(ComponentManager<TransformComponent>& transformManager,
+			ComponentManager<StaticMeshComponent>& staticMeshManager);
 		void addAnimation(std::shared_ptr<AnimationClip> animationClip, glm::vec3 originalUpVector,
 			glm::vec3 originalFrontVector, AnimationType animationType, float supportFrameDistanceFactor);
 		void setAngularSpeed(float angularSpeed) { m_ikRig.setAngularSpeed(angularSpeed); }
+		InnerComponentHandle getTransformHandle() { return m_ikRig.getTransformHandle(); }
+		int getAnimationNum() const { return m_ikRig.m_ikAnimations.size(); }
+		const AnimationClip* getAnimationClip(AnimationIndex animIndex) const { return m_ikRig.m_ikAnimations[animIndex].m_animationClip.get(); }
 		AnimationIndex removeAnimation(std::shared_ptr<AnimationClip> animationClip);
 		void updateIKAnimationTime(float animationTimeStep, AnimationIndex animIndex, AnimationController& animController);
 		void updateTrajectories(AnimationIndex animIndex, ComponentManager<TransformComponent>& transformManager,
@@ -38,6 +50,12 @@ namespace Mona {
 		void updateMovementDirection(float timeStep);
 		void refreshIKAnimation(AnimationIndex animIndex);
 		void enableIK(bool enableIK);
+		void setLODSettings(IKNavigationLODSettings lodSettings);
+		const IKNavigationLODSettings& getLODSettings() const { return m_lodSettings; }
+		IKNavigationLOD getLOD() const { return m_lod; }
+		// elige el nivel de detalle segun la distancia a la camara principal, aplicando la histeresis de m_lodSettings
+		void updateLOD(float cameraDistance);
+		static IKNavigationLOD selectLOD(const IKNavigationLODSettings& lodSettings, IKNavigationLOD currentLOD, float cameraDistance);
 		void init();
 	};
 
@@ -2,6 +2,7 @@
 #include "../Core/GlmUtils.hpp"
 #include "../Core/FuncUtils.hpp"
 #include <glm/gtx/matrix_decompose.hpp>
+#include <algorithm>
 #include "IKRig.hpp"
 
 
@@ -24,27 +25,23 @@ namespace Mona {
 	// terminos para el descenso de gradiente
 	
 	// termino 1 (seguir la curva deseada para el end effector)
-	std::function<float(const std::vector<float>&, IKData*)> term1Function =
-		[](const std::vector<float>& varAngles, IKData* dataPtr)->float {
+	float IKEETargetTerm::calcTerm(std::span<const float> varAngles, IKData* dataPtr) {
 		float result = 0;
 		int eeIndex;
 		glm::vec4 baseVec(0, 0, 0, 1);
 		glm::vec3 eePos;
-		std::vector<JointIndex> endEffectors;
-		for (int c = 0; c < dataPtr->ikChains.size(); c++) {
-			endEffectors.push_back(dataPtr->ikChains[c]->getEndEffector());
-		}
-		std::vector<glm::mat4> forwardModelSpaceTransforms = dataPtr->ikAnimation->getEEListModelSpaceVariableTransforms(endEffectors);
+		const std::vector<JointIndex>& endEffectors = dataPtr->endEffectors;
+		std::vector<glm::mat4>& forwardModelSpaceTransforms = dataPtr->eeTermModelSpaceTransforms;
+		dataPtr->ikAnimation->getEEListModelSpaceVariableTransforms(endEffectors, forwardModelSpaceTransforms, nullptr, dataPtr->fkScratch);
 		for (int c = 0; c < dataPtr->ikChains.size(); c++) {
 			eeIndex = endEffectors[c];
 			eePos = glm::vec3(forwardModelSpaceTransforms[eeIndex] * baseVec);
 			result += glm::length2(eePos - dataPtr->ikChains[c]->getCurrentEETarget(dataPtr->ikAnimation->getAnimationIndex()));
 		}
 		return result;
-	};
+	}
 
-	std::function<float(const std::vector<float>&, int, IKData*)> term1PartialDerivativeFunction =
-		[](const std::vector<float>& varAngles, int varIndex, IKData* dataPtr)->float {
+	float IKEETargetTerm::calcTermPartialDerivative(std::span<const float> varAngles, int varIndex, IKData* dataPtr) {
 		float result = 0;
 		glm::mat4 TA; glm::mat4 TB; glm::vec3 TvarScl; glm::fquat TvarQuat;	glm::vec3 TvarTr;
 		glm::vec3 skew;	glm::vec4 perspective;
@@ -90,49 +87,43 @@ namespace Mona {
 			
 		}
 		return 2 * result;
-	};
+	}
 
 	// termino 2 (acercar la animacion creada a la animacion original)
-	std::function<float(const std::vector<float>&, IKData*)> term2Function =
-		[](const std::vector<float>& varAngles, IKData* dataPtr)->float {
+	float IKBaseAnglesTerm::calcTerm(std::span<const float> varAngles, IKData* dataPtr) {
 		float result = 0;
 		for (int i = 0; i < varAngles.size(); i++) {
 			result += pow(varAngles[i] - dataPtr->baseAngles[i], 2);
 		}
 		return result;
-	};
+	}
 
-	std::function<float(const std::vector<float>&, int, IKData*)> term2PartialDerivativeFunction =
-		[](const std::vector<float>& varAngles, int varIndex, IKData* dataPtr)->float {
+	float IKBaseAnglesTerm::calcTermPartialDerivative(std::span<const float> varAngles, int varIndex, IKData* dataPtr) {
 		return 2 * (varAngles[varIndex] - dataPtr->baseAngles[varIndex]);
-	};
+	}
 
 	
 
 	// termino 3 (acercar los valores actuales a los del frame anterior)
-	std::function<float(const std::vector<float>&, IKData*)> term3Function =
-		[](const std::vector<float>& varAngles, IKData* dataPtr)->float {
+	float IKPreviousAnglesTerm::calcTerm(std::span<const float> varAngles, IKData* dataPtr) {
 		float result = 0;
 		for (int i = 0; i < varAngles.size(); i++) {
 			result += pow(varAngles[i] - dataPtr->previousAngles[i], 2);
 		}
 		return result;
-	};
+	}
 
-	std::function<float(const std::vector<float>&, int, IKData*)> term3PartialDerivativeFunction =
-		[](const std::vector<float>& varAngles, int varIndex, IKData* dataPtr)->float {
+	float IKPreviousAnglesTerm::calcTermPartialDerivative(std::span<const float> varAngles, int varIndex, IKData* dataPtr) {
 		return 2 * (varAngles[varIndex] - dataPtr->previousAngles[varIndex]);
-	};
+	}
 
 	void setDescentTransformArrays(IKData* dataPtr) {
-		std::vector<JointIndex> endEffectors;
-		for (int i = 0; i < dataPtr->ikChains.size(); i++) {
-			endEffectors.push_back(dataPtr->ikChains[i]->getEndEffector());
-		}
 		// multiplicacion en cadena desde la raiz hasta el joint i
-		dataPtr->forwardModelSpaceTransforms = dataPtr->ikAnimation->getEEListModelSpaceVariableTransforms(endEffectors, &(dataPtr->jointSpaceTransforms));
+		dataPtr->ikAnimation->getEEListModelSpaceVariableTransforms(dataPtr->endEffectors, dataPtr->forwardModelSpaceTransforms,
+			&(dataPtr->jointSpaceTransforms), dataPtr->fkScratch);
 		// multiplicacion en cadena desde el ee de la cadena hasta el joint i
-		dataPtr->backwardModelSpaceTransformsPerChain = std::vector<std::vector<glm::mat4>>(dataPtr->ikChains.size());
+		// (los arreglos se reutilizan entre pasos, la asignacion solo copia sobre la memoria ya reservada)
+		dataPtr->backwardModelSpaceTransformsPerChain.resize(dataPtr->ikChains.size());
 		std::vector<glm::mat4>* bt;
 		for (int i = 0; i < dataPtr->ikChains.size(); i++) {
 			std::vector<JointIndex>const& joints = dataPtr->ikChains[i]->getJoints();
@@ -145,8 +136,7 @@ namespace Mona {
 
 	}
 
-	std::function<void(std::vector<float>&, IKData*, std::vector<float>&)>  postDescentStepCustomBehaviour =
-		[](std::vector<float>& args, IKData* dataPtr, std::vector<float>& argsRawDelta)->void {
+	void IKPostDescentStep::operator()(std::span<float> args, IKData* dataPtr, std::span<float> argsRawDelta) {
 		// setear nuevos angulos
 		std::vector<JointRotation>* varRots = dataPtr->ikAnimation->getVariableJointRotations();
 		for (int i = 0; i < args.size(); i++) {
@@ -155,34 +145,51 @@ namespace Mona {
 		}
 		// setear arreglos de transformaciones
 		setDescentTransformArrays(dataPtr);
-	};
+	}
 
 	InverseKinematics::InverseKinematics(IKRig* ikRig) {
 		m_ikRig = ikRig;
 	}
 
 	void InverseKinematics::init() {
-		FunctionTerm<IKData> term1(term1Function, term1PartialDerivativeFunction);
-		FunctionTerm<IKData> term2(term2Function, term2PartialDerivativeFunction);
-		FunctionTerm<IKData> term3(term3Function, term3PartialDerivativeFunction);
-		auto terms = std::vector<FunctionTerm<IKData>>({ term1,term2, term3 });
-		m_gradientDescent = GradientDescent<IKData>(terms, 0, &m_ikData, postDescentStepCustomBehaviour);
+		m_gradientDescent = decltype(m_gradientDescent)(&m_ikData, 0);
 		m_ikData.descentRate = 0.01f;
 		m_ikData.maxIterations = 300;
+		m_baseMaxIterations = m_ikData.maxIterations;
 		m_ikData.targetAngleDelta = 1 / pow(10, 3);
 		float avgDeltaDist = m_ikRig->getRigHeight() / 200;
 		m_gradientDescent.setTermWeight(0, 1 / (avgDeltaDist*m_ikRig->getRigHeight()));
 		m_gradientDescent.setTermWeight(1, 2);		
 		m_gradientDescent.setTermWeight(2, 4);
+		m_twoBoneMaxError = avgDeltaDist * 2;
 		setIKChains();
 	}
 
+	void InverseKinematics::setMaxIterationsFactor(float factor) {
+		m_ikData.maxIterations = std::max(1, (int)(m_baseMaxIterations * factor));
+	}
+
 	void InverseKinematics::setIKChains() {
-		std::vector<IKChain*> chainPtrs(m_ikRig->getChainNum());
+		m_rigChains.resize(m_ikRig->getChainNum());
 		for (int i = 0; i < m_ikRig->getChainNum(); i++) {
-			chainPtrs[i] = m_ikRig->getIKChain(i);
+			m_rigChains[i] = m_ikRig->getIKChain(i);
+		}
+		m_descentChainMask = std::vector<bool>(m_rigChains.size(), true);
+		setDescentChains();
+	}
+
+	void InverseKinematics::setDescentChains() {
+		std::vector<IKChain*> chainPtrs;
+		for (int c = 0; c < m_rigChains.size(); c++) {
+			if (m_descentChainMask[c]) {
+				chainPtrs.push_back(m_rigChains[c]);
+			}
 		}
 		m_ikData.ikChains = chainPtrs;
+		m_ikData.endEffectors.resize(chainPtrs.size());
+		for (int c = 0; c < chainPtrs.size(); c++) {
+			m_ikData.endEffectors[c] = chainPtrs[c]->getEndEffector();
+		}
 		m_ikData.jointIndexes = {};
 		std::vector<JointIndex> jointIndexes;
 		for (int c = 0; c < chainPtrs.size(); c++) {
@@ -196,6 +203,97 @@ namespace Mona {
 		m_ikData.baseAngles.resize(m_ikData.jointIndexes.size());
 	}
 
+	// angulo equivalente a angle (modulo 2pi) mas cercano a referenceAngle
+	float closestEquivalentAngle(float angle, float referenceAngle) {
+		return referenceAngle + std::remainder(angle - referenceAngle, 2 * glm::pi<float>());
+	}
+
+	bool InverseKinematics::solveTwoBoneChain(IKChain* chain, IKAnimation* ikAnimation, FrameIndex targetFrame,
+		std::vector<std::pair<JointIndex, float>>& outAngles) {
+		std::vector<JointIndex>const& joints = chain->getJoints();
+		if (joints.size() != 3) {
+			return false;
+		}
+		JointIndex baseJoint = joints[0];
+		JointIndex middleJoint = joints[1];
+		JointIndex eeJoint = joints[2];
+		// cada articulacion solo puede girar en torno al eje que tiene en la animacion original
+		std::vector<JointRotation>const& baseRotations = ikAnimation->getOriginalJointRotations(targetFrame);
+		glm::vec3 baseAxis = baseRotations[baseJoint].getRotationAxis();
+		glm::vec3 middleAxis = baseRotations[middleJoint].getRotationAxis();
+		float baseJointAngle = baseRotations[baseJoint].getRotationAngle();
+		float middleJointAngle = baseRotations[middleJoint].getRotationAngle();
+
+		// transformacion de la base de la cadena sin su rotacion ni escala (no depende de los angulos de la cadena)
+		JointIndex chainParent = chain->getParentJoint();
+		glm::mat4 chainBaseTransform = chainParent == -1 ? glm::identity<glm::mat4>() :
+			ikAnimation->getEEListModelSpaceVariableTransforms({ chainParent })[chainParent];
+		glm::mat4 baseFrame = chainBaseTransform * glmUtils::translationToMat4(ikAnimation->getJointPosition(baseJoint));
+		glm::vec3 baseScale = ikAnimation->getJointScale(baseJoint);
+		// se asume escala uniforme en la base
+		float frameScale = glm::length(glm::vec3(baseFrame[0])) * baseScale[0];
+		glm::vec3 basePos = glm::vec3(baseFrame[3]);
+
+		// en el espacio de la base, la articulacion media esta en p y el ee en p + R(middleAngle)*s
+		glm::vec3 p = ikAnimation->getJointPosition(middleJoint);
+		glm::vec3 s = ikAnimation->getJointScale(middleJoint) * ikAnimation->getJointPosition(eeJoint);
+
+		// el objetivo se acerca o aleja de la base hasta quedar al alcance de la cadena
+		glm::vec3 eeTarget = chain->getCurrentEETarget(ikAnimation->getAnimationIndex());
+		glm::vec3 toTarget = eeTarget - basePos;
+		float targetDistModel = glm::length(toTarget);
+		if (targetDistModel < std::numeric_limits<float>::epsilon()) {
+			return false;
+		}
+		float minReach = std::abs(glm::length(p) - glm::length(s)) * 1.001f;
+		float maxReach = (glm::length(p) + glm::length(s)) * 0.999f;
+		float targetDist = glm::clamp(targetDistModel / frameScale, minReach, maxReach);
+		eeTarget = basePos + toTarget * (targetDist * frameScale / targetDistModel);
+
+		// angulo de la articulacion media: |p + R(a)*s|^2 = targetDist^2 se reduce a A*cos(a) + B*sin(a) = K
+		glm::vec3 sParallel = glm::dot(middleAxis, s) * middleAxis;
+		glm::vec3 sPerpendicular = s - sParallel;
+		float A = glm::dot(p, sPerpendicular);
+		float B = glm::dot(p, glm::cross(middleAxis, sPerpendicular));
+		float K = (targetDist * targetDist - glm::dot(p, p) - glm::dot(s, s)) / 2 - glm::dot(p, sParallel);
+		float amplitude = std::sqrt(A * A + B * B);
+		if (amplitude < std::numeric_limits<float>::epsilon() * glm::dot(p, p)) {
+			// el eje de la articulacion media no permite doblar la cadena
+			return false;
+		}
+		float phase = std::atan2(B, A);
+		float offset = std::acos(glm::clamp(K / amplitude, -1.0f, 1.0f));
+		// de las dos soluciones se usa la mas cercana a la animacion, asi la rodilla mantiene la direccion original
+		float middleAngle = closestEquivalentAngle(phase + offset, middleJointAngle);
+		float middleAngleAlt = closestEquivalentAngle(phase - offset, middleJointAngle);
+		if (std::abs(middleAngleAlt - middleJointAngle) < std::abs(middleAngle - middleJointAngle)) {
+			middleAngle = middleAngleAlt;
+		}
+
+		// angulo de la base: giro en torno a su eje que mas acerca el ee al objetivo
+		glm::vec3 eeBaseSpace = baseScale * (p + glm::angleAxis(middleAngle, middleAxis) * s);
+		glm::vec3 targetBaseSpace = glm::vec3(glm::inverse(baseFrame) * glm::vec4(eeTarget, 1));
+		glm::vec3 eePerpendicular = eeBaseSpace - glm::dot(baseAxis, eeBaseSpace) * baseAxis;
+		A = glm::dot(targetBaseSpace, eePerpendicular);
+		B = glm::dot(targetBaseSpace, glm::cross(baseAxis, eePerpendicular));
+		if (A * A + B * B < std::numeric_limits<float>::epsilon()) {
+			return false;
+		}
+		float baseAngle = closestEquivalentAngle(std::atan2(B, A), baseJointAngle);
+
+		// las restricciones de eje pueden impedir llegar al objetivo, en ese caso se usa el descenso de gradiente
+		glm::vec3 eePos = glm::vec3(baseFrame * glm::vec4(glm::angleAxis(baseAngle, baseAxis) * eeBaseSpace, 1));
+		if (m_twoBoneMaxError < glm::distance(eePos, eeTarget)) {
+			return false;
+		}
+		std::vector<JointRotation>* variableRotations = ikAnimation->getVariableJointRotations();
+		(*variableRotations)[baseJoint].setRotationAngle(baseAngle);
+		(*variableRotations)[middleJoint].setRotationAngle(middleAngle);
+		outAngles.push_back({ baseJoint, baseAngle });
+		outAngles.push_back({ middleJoint, middleAngle });
+		return true;
+	}
+
 	std::vector<std::pair<JointIndex, float>> InverseKinematics::solveIKChains(AnimationIndex animationIndex) {
 
 		m_ikData.ikAnimation = m_ikRig->getIKAnimation(animationIndex);
@@ -203,37 +301,58 @@ namespace Mona {
 		FrameIndex currentFrame = m_ikData.ikAnimation->getCurrentFrameIndex();
 		float currentFrameRepTime = m_ikData.ikAnimation->getReproductionTime(currentFrame);
 
+		// setear rotaciones variables a los valores base de frame objetivo
+		m_ikData.ikAnimation->setVariableJointRotations(nextFrame);
+		std::vector<std::pair<JointIndex, float>> result;
+
+		// primero las cadenas con solucion analitica, las que no la admiten pasan al descenso de gradiente
+		bool descentChainsChanged = false;
+		bool descentRequired = false;
+		for (int c = 0; c < m_rigChains.size(); c++) {
+			bool descentChain = m_rigChains[c]->getSolverType() != IKSolverType::TWO_BONE ||
+				!solveTwoBoneChain(m_rigChains[c], m_ikData.ikAnimation, nextFrame, result);
+			descentChainsChanged = descentChainsChanged || descentChain != m_descentChainMask[c];
+			descentRequired = descentRequired || descentChain;
+			m_descentChainMask[c] = descentChain;
+		}
+		if (descentChainsChanged) {
+			setDescentChains();
+		}
+		if (!descentRequired) {
+			return result;
+		}
+
 		// recuperamos los angulos previamente usados de la animacion
 		m_ikData.previousAngles.resize(m_ikData.jointIndexes.size());
 		for (int i = 0; i < m_ikData.jointIndexes.size(); i++) {
 			JointIndex jIndex = m_ikData.jointIndexes[i];
 			m_ikData.previousAngles[i] = m_ikData.ikAnimation->getSavedAngles(jIndex).evalCurve(currentFrameRepTime)[0];
 		}
-		std::vector<float> initialArgs = m_ikData.previousAngles;
+		// los angulos iniciales se reemplazan por los calculados
+		std::vector<float>& computedAngles = m_ikData.computedAngles;
+		computedAngles = m_ikData.previousAngles;
 
 		std::vector<JointRotation>const& baseRotations_target = m_ikData.ikAnimation->getOriginalJointRotations(nextFrame);
 		for (int i = 0; i < m_ikData.jointIndexes.size(); i++) {
 			m_ikData.rotationAxes[i] = baseRotations_target[m_ikData.jointIndexes[i]].getRotationAxis();
 			m_ikData.baseAngles[i] = baseRotations_target[m_ikData.jointIndexes[i]].getRotationAngle();
 		}
-		// setear rotaciones variables a los valores base de frame objetivo
-		m_ikData.ikAnimation->setVariableJointRotations(nextFrame);
 		// ajustamos las rotaciones varaibles a los argumentos iniciales
 		std::vector<JointRotation>* variableRotations = m_ikData.ikAnimation->getVariableJointRotations();
 		for (int i = 0; i < m_ikData.jointIndexes.size(); i++) {
 			JointIndex jIndex = m_ikData.jointIndexes[i];
-			(*variableRotations)[jIndex].setRotationAngle(initialArgs[i]);
+			(*variableRotations)[jIndex].setRotationAngle(computedAngles[i]);
 		}
 		// setear arreglos de transformaciones
 		setDescentTransformArrays(&m_ikData);
-		std::vector<float> computedAngles = m_gradientDescent.computeArgsMin(m_ikData.descentRate, 
-			m_ikData.maxIterations, m_ikData.targetAngleDelta, initialArgs);
-		std::vector<std::pair<JointIndex, float>> result(computedAngles.size());
+		m_gradientDescent.computeArgsMin(m_ikData.descentRate,
+			m_ikData.maxIterations, m_ikData.targetAngleDelta, computedAngles);
+		result.reserve(result.size() + computedAngles.size());
 		
 		for (int i = 0; i < m_ikData.jointIndexes.size(); i++) {
 			JointIndex jIndex = m_ikData.jointIndexes[i];
 			(*variableRotations)[jIndex].setRotationAngle(computedAngles[i]);
-			result[i] = { jIndex, computedAngles[i]};
+			result.push_back({ jIndex, computedAngles[i]});
 		}
 		return result;		
 	}
@@ -276,39 +395,46 @@ namespace Mona {
 		return eeListCustomSpaceTr;
 
 	}
-	std::vector<glm::mat4> ForwardKinematics::EEListCustomSpaceVariableTransforms(std::vector<JointIndex> eeList, glm::mat4 baseTransform, IKAnimation* ikAnim,
+	std::vector<glm::mat4> ForwardKinematics::EEListCustomSpaceVariableTransforms(const std::vector<JointIndex>& eeList, const glm::mat4& baseTransform, IKAnimation* ikAnim,
 		std::vector<glm::mat4>* outEEListJointSpaceTransforms) {
-		std::vector<glm::mat4> eeListCustomSpaceTr(m_ikRig->getTopology().size(), glm::identity<glm::mat4>());
+		std::vector<glm::mat4> eeListCustomSpaceTr;
+		ForwardKinematicsScratch scratch;
+		EEListCustomSpaceVariableTransforms(eeList, baseTransform, ikAnim, eeListCustomSpaceTr, outEEListJointSpaceTransforms, scratch);
+		return eeListCustomSpaceTr;
+	}
+
+	void ForwardKinematics::EEListCustomSpaceVariableTransforms(const std::vector<JointIndex>& eeList, const glm::mat4& baseTransform, IKAnimation* ikAnim,
+		std::vector<glm::mat4>& outEEListCustomSpaceTransforms, std::vector<glm::mat4>* outEEListJointSpaceTransforms,
+		ForwardKinematicsScratch& scratch) {
+		std::vector<JointIndex>const& topology = m_ikRig->getTopology();
+		// assign no reserva memoria si los arreglos ya tienen la capacidad necesaria
+		outEEListCustomSpaceTransforms.assign(topology.size(), glm::identity<glm::mat4>());
 		if (outEEListJointSpaceTransforms != nullptr) {
-			(*outEEListJointSpaceTransforms) = std::vector<glm::mat4>(m_ikRig->getTopology().size(), glm::identity<glm::mat4>());
+			outEEListJointSpaceTransforms->assign(topology.size(), glm::identity<glm::mat4>());
 		}
-		funcUtils::sortUnique(eeList);
-		std::vector<JointIndex> calcJoints;
-		while (0 < eeList.size()) {
-			JointIndex currJoint = eeList.back();
-			eeList.pop_back();
-			if (funcUtils::findIndex(calcJoints, currJoint) == -1) {
-				std::vector<JointIndex> currJointHierarchy;
-				glm::mat4 customSpaceTr = glm::identity<glm::mat4>();
-				// recolectar jointSpaceTransforms
-				while (currJoint != -1) {
-					eeListCustomSpaceTr[currJoint] = JointSpaceVariableTransform(ikAnim, currJoint);
-					if (outEEListJointSpaceTransforms != nullptr) {
-						(*outEEListJointSpaceTransforms)[currJoint] = eeListCustomSpaceTr[currJoint];
-					}
-					currJointHierarchy.insert(currJointHierarchy.begin(), currJoint);
-					currJoint = m_ikRig->getTopology()[currJoint];
-				}
-				// calcular customSpaceTransforms
-				for (int i = 0; i < currJointHierarchy.size(); i++) {
-					glm::mat4 _baseTransform = i == 0 ? baseTransform : eeListCustomSpaceTr[currJointHierarchy[i - 1]];
-					eeListCustomSpaceTr[currJointHierarchy[i]] = _baseTransform * eeListCustomSpaceTr[currJointHierarchy[i]];
-					calcJoints.push_back(currJointHierarchy[i]);
+		scratch.calculatedJoints.assign(topology.size(), false);
+		std::vector<JointIndex>& currJointHierarchy = scratch.jointHierarchy;
+		for (JointIndex ee : eeList) {
+			// recolectar jointSpaceTransforms hasta la raiz o hasta una articulacion ya calculada
+			currJointHierarchy.clear();
+			JointIndex currJoint = ee;
+			while (currJoint != -1 && !scratch.calculatedJoints[currJoint]) {
+				outEEListCustomSpaceTransforms[currJoint] = JointSpaceVariableTransform(ikAnim, currJoint);
+				if (outEEListJointSpaceTransforms != nullptr) {
+					(*outEEListJointSpaceTransforms)[currJoint] = outEEListCustomSpaceTransforms[currJoint];
 				}
+				scratch.calculatedJoints[currJoint] = true;
+				currJointHierarchy.push_back(currJoint);
+				currJoint = topology[currJoint];
+			}
+			// calcular customSpaceTransforms desde la articulacion mas cercana a la raiz
+			glm::mat4 _baseTransform = currJoint == -1 ? baseTransform : outEEListCustomSpaceTransforms[currJoint];
+			for (int i = currJointHierarchy.size() - 1; 0 <= i; i--) {
+				glm::mat4& customSpaceTr = outEEListCustomSpaceTransforms[currJointHierarchy[i]];
+				customSpaceTr = _baseTransform * customSpaceTr;
+				_baseTransform = customSpaceTr;
 			}
 		}
-		return eeListCustomSpaceTr;
-
 	}
 
 	glm::mat4 ForwardKinematics::JointSpaceTransform(IKAnimation* ikAnim, JointIndex jointIndex, float reproductionTime) {
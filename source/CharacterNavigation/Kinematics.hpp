@@ -3,6 +3,7 @@
 #define KINEMATICS_HPP
 
 #include <vector>
+#include <span>
 #include <functional>
 #include "GradientDescent.hpp"
 #include "glm/glm.hpp"
@@ -17,6 +18,12 @@ namespace Mona {
 	class IKChain;
 	class IKAnimation;
 
+	// memoria de trabajo de ForwardKinematics, reutilizada entre llamados para no reservar memoria en cada uno
+	struct ForwardKinematicsScratch {
+		std::vector<bool> calculatedJoints;
+		std::vector<JointIndex> jointHierarchy;
+	};
+
 	class ForwardKinematics {
 		IKRig* m_ikRig;
 	public:
@@ -24,8 +31,12 @@ namespace Mona {
 		ForwardKinematics() = default;
 		std::vector<glm::mat4> EEListCustomSpaceTransforms(std::vector<JointIndex> eeList, glm::mat4 baseTransform, IKAnimation* ikAnim,
 			float reproductionTime, std::vector<glm::mat4>* outEEListJointSpaceTransforms = nullptr);
-		std::vector<glm::mat4> EEListCustomSpaceVariableTransforms(std::vector<JointIndex> eeList, glm::mat4 baseTransform, IKAnimation* ikAnim,
+		std::vector<glm::mat4> EEListCustomSpaceVariableTransforms(const std::vector<JointIndex>& eeList, const glm::mat4& baseTransform, IKAnimation* ikAnim,
 			std::vector<glm::mat4>* outEEListJointSpaceTransforms = nullptr);
+		// escribe el resultado en outEEListCustomSpaceTransforms, que solo reserva memoria si aun no tiene el tamano de la topologia
+		void EEListCustomSpaceVariableTransforms(const std::vector<JointIndex>& eeList, const glm::mat4& baseTransform, IKAnimation* ikAnim,
+			std::vector<glm::mat4>& outEEListCustomSpaceTransforms, std::vector<glm::mat4>* outEEListJointSpaceTransforms,
+			ForwardKinematicsScratch& scratch);
 		glm::mat4 JointSpaceTransform(IKAnimation* ikAnim, JointIndex jointIndex, float reproductionTime);
 		glm::mat4 JointSpaceVariableTransform(IKAnimation* ikAnim, JointIndex jointIndex);
 
@@ -51,18 +62,54 @@ namespace Mona {
 		float descentRate;
 		float targetAngleDelta;
 		int maxIterations;
+		// end effectors de las cadenas y angulos calculados, guardados para no reservar memoria en cada resolucion
+		std::vector<JointIndex> endEffectors;
+		std::vector<float> computedAngles;
+		// transformaciones y memoria de trabajo de FK usadas por IKEETargetTerm::calcTerm, reutilizadas entre llamados
+		std::vector<glm::mat4> eeTermModelSpaceTransforms;
+		ForwardKinematicsScratch fkScratch;
+	};
+
+	// terminos de la funcion objetivo del descenso de gradiente de IK
+	struct IKEETargetTerm { // seguir la curva deseada para el end effector
+		float calcTerm(std::span<const float> varAngles, IKData* dataPtr);
+		float calcTermPartialDerivative(std::span<const float> varAngles, int varIndex, IKData* dataPtr);
+	};
+	struct IKBaseAnglesTerm { // acercar la animacion creada a la animacion original
+		float calcTerm(std::span<const float> varAngles, IKData* dataPtr);
+		float calcTermPartialDerivative(std::span<const float> varAngles, int varIndex, IKData* dataPtr);
+	};
+	struct IKPreviousAnglesTerm { // acercar los valores actuales a los del frame anterior
+		float calcTerm(std::span<const float> varAngles, IKData* dataPtr);
+		float calcTermPartialDerivative(std::span<const float> varAngles, int varIndex, IKData* dataPtr);
+	};
+	struct IKPostDescentStep { // aplica los nuevos angulos y recalcula las transformaciones
+		void operator()(std::span<float> args, IKData* dataPtr, std::span<float> argsRawDelta);
 	};
 
 	class InverseKinematics {
+		friend class MonaTest;
 		IKRig* m_ikRig;
-		GradientDescent<IKData> m_gradientDescent;
+		GradientDescent<IKData, IKPostDescentStep, IKEETargetTerm, IKBaseAnglesTerm, IKPreviousAnglesTerm> m_gradientDescent;
 		IKData m_ikData;
+		// todas las cadenas del rig, y cuales de ellas se resolvieron con descenso de gradiente en el ultimo llamado
+		std::vector<IKChain*> m_rigChains;
+		std::vector<bool> m_descentChainMask;
+		// distancia maxima (model space) entre el end effector y su objetivo para aceptar la solucion analitica
+		float m_twoBoneMaxError;
+		// limite de iteraciones del descenso de gradiente fijado en init, sin reducciones por nivel de detalle
+		int m_baseMaxIterations;
 		void setIKChains();
+		void setDescentChains();
+		bool solveTwoBoneChain(IKChain* chain, IKAnimation* ikAnimation, FrameIndex targetFrame,
+			std::vector<std::pair<JointIndex, float>>& outAngles);
 	public:
 		InverseKinematics() = default;
 		InverseKinematics(IKRig* ikRig);
 		void init();
 		std::vector<std::pair<JointIndex, float>> solveIKChains(AnimationIndex animationIndex);
+		// escala el limite de iteraciones del descenso de gradiente (1 restaura el valor base)
+		void setMaxIterationsFactor(float factor);
 	};
 
 	
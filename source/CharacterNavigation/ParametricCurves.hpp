@@ -6,6 +6,9 @@
 #include <glm/gtx/quaternion.hpp>
 #include "glm/gtx/vector_angle.hpp"
 #include <vector>
+#include <array>
+#include <algorithm>
+#include <limits>
 #include "../Core/Log.hpp"
 #include "../Core/FuncUtils.hpp"
 #include "../Core/GlmUtils.hpp"
@@ -25,6 +28,22 @@ namespace Mona{
         // dimension de los puntos
         int m_dimension = 0;
         float m_tEpsilon;
+        // ultimo segmento encontrado por findSegment, se prueba primero ya que las consultas suelen ser monotonas
+        mutable int m_segmentHint = 0;
+
+        // indice i del segmento [m_tValues[i], m_tValues[i+1]] que contiene t, acotado a los segmentos de la curva
+        int findSegment(float t) const {
+            int lastSegment = m_tValues.size() - 2;
+            for (int i = m_segmentHint; i <= m_segmentHint + 1 && i <= lastSegment; i++) {
+                if (m_tValues[i] <= t && t <= m_tValues[i + 1]) {
+                    m_segmentHint = i;
+                    return i;
+                }
+            }
+            int segment = std::upper_bound(m_tValues.begin(), m_tValues.end(), t) - m_tValues.begin() - 1;
+            m_segmentHint = std::clamp(segment, 0, lastSegment);
+            return m_segmentHint;
+        }
 
         bool tValuesAreValid() {
 			for (int i = 1; i < m_tValues.size(); i++) {
@@ -79,18 +98,18 @@ namespace Mona{
 
         glm::vec<D, float> evalCurve(float t)  const {
             MONA_ASSERT(inTRange(t), "LIC: t must be a value between {0} and {1}.", m_tValues[0], m_tValues.back());
-            // si estamos en el entorno de un punto
-            for (int i = 0; i < m_tValues.size(); i++) {
-                if (abs(t - m_tValues[i]) <= m_tEpsilon) {
-                    return m_curvePoints[i];
-                }
+            int i = findSegment(t);
+            // si estamos en el entorno de un punto (solo pueden estarlo los extremos del segmento)
+            if (abs(t - m_tValues[i]) <= m_tEpsilon) {
+                return m_curvePoints[i];
+            }
+            if (abs(t - m_tValues[i + 1]) <= m_tEpsilon) {
+                return m_curvePoints[i + 1];
             }
             // si no
-            for (int i = 0; i < m_tValues.size() - 1; i++) {
-                if (m_tValues[i] <= t && t <= m_tValues[i + 1]) {
-                    float fraction = funcUtils::getFraction(m_tValues[i], m_tValues[i + 1], t);
-                    return funcUtils::lerp(m_curvePoints[i], m_curvePoints[i + 1], fraction);
-                }
+            if (m_tValues[i] <= t && t <= m_tValues[i + 1]) {
+                float fraction = funcUtils::getFraction(m_tValues[i], m_tValues[i + 1], t);
+                return funcUtils::lerp(m_curvePoints[i], m_curvePoints[i + 1], fraction);
             }
             return glm::vec<D, float>(0);
         }
@@ -101,29 +120,17 @@ namespace Mona{
         }
 
         void insertPoint(glm::vec<D, float> point, float tValue) {
+            // primer punto con t mayor o igual a tValue, solo el y su anterior pueden estar cerca de tValue
+            int i = std::lower_bound(m_tValues.begin(), m_tValues.end(), tValue) - m_tValues.begin();
             // si ya hay un punto en un tValue similar retornamos
-            for (int i = 0; i < m_tValues.size(); i++) {
-                if (abs(m_tValues[i] - tValue) < 2 * m_tEpsilon) {
-                    return;
-                }
+            if (i < m_tValues.size() && abs(m_tValues[i] - tValue) < 2 * m_tEpsilon) {
+                return;
             }
-            if (tValue < m_tValues[0]) {
-                m_tValues.insert(m_tValues.begin(), tValue);
-                m_curvePoints.insert(m_curvePoints.begin(), point);
-            }
-            else if (m_tValues.back() < tValue) {
-                m_tValues.push_back(tValue);
-                m_curvePoints.push_back(point);
-            }
-            else {
-                for (int i = 0; i < m_tValues.size()-1; i++) {
-                    if (m_tValues[i] < tValue && tValue < m_tValues[i + 1]) {
-                        m_tValues.insert(m_tValues.begin() + i + 1, tValue);
-                        m_curvePoints.insert(m_curvePoints.begin() + i + 1, point);
-                        return;
-                    }
-                }
+            if (0 < i && abs(m_tValues[i - 1] - tValue) < 2 * m_tEpsilon) {
+                return;
             }
+            m_tValues.insert(m_tValues.begin() + i, tValue);
+            m_curvePoints.insert(m_curvePoints.begin() + i, point);
         }
 
         LIC<D> sample(float minT, float maxT) {
@@ -301,16 +308,15 @@ namespace Mona{
 
 
         int getClosestPointIndex(float tValue) const {
-            float minDist = std::numeric_limits<float>::max();
-            int selectedIndex = 0;
-            for (int i = 0; i < m_tValues.size(); i++) {
-                float currDist = abs(m_tValues[i] - tValue);
-                if (currDist < minDist) {
-                    minDist = currDist;
-                    selectedIndex = i;
-                }
+            int i = std::lower_bound(m_tValues.begin(), m_tValues.end(), tValue) - m_tValues.begin();
+            if (i == 0) {
+                return 0;
             }
-            return selectedIndex;
+            if (i == m_tValues.size()) {
+                return i - 1;
+            }
+            // en caso de empate se elige el punto anterior
+            return tValue - m_tValues[i - 1] <= m_tValues[i] - tValue ? i - 1 : i;
         }
 
         // Se conectan dos curvas en el espacio. Se desplazan los valores de t de tal forma que una empiece donde la otra termina.
@@ -379,6 +385,149 @@ namespace Mona{
 			translate(-getStart() + newStart);
 		}
     };
+
+    /*
+    * Curva linealmente interpolada con capacidad fija de N puntos, guardados en un buffer circular. Pensada para
+    * historiales a los que casi siempre se agregan puntos al final y se descartan los mas antiguos: ninguna de esas dos
+    * operaciones desplaza elementos ni reserva memoria. Si el buffer esta lleno, al agregar un punto se descarta el mas
+    * antiguo. A diferencia de LIC puede estar vacia, en cuyo caso ningun t esta en su rango.
+    */
+    template <int D, int N>
+    class RingLIC {
+        static_assert(1 < N, "RingLIC: capacity must be at least two points.");
+    private:
+        // puntos de la curva y valores de t, el punto de indice i esta en la posicion (m_head + i) % N
+        std::array<glm::vec<D, float>, N> m_curvePoints;
+        std::array<float, N> m_tValues;
+        int m_head = 0;
+        int m_size = 0;
+        float m_tEpsilon = 0.0001;
+        // ultimo segmento encontrado por findSegment, se prueba primero ya que las consultas suelen ser monotonas
+        mutable int m_segmentHint = 0;
+
+        int bufferIndex(int pointIndex) const { return (m_head + pointIndex) % N; }
+        float tValueAt(int pointIndex) const { return m_tValues[bufferIndex(pointIndex)]; }
+        const glm::vec<D, float>& pointAt(int pointIndex) const { return m_curvePoints[bufferIndex(pointIndex)]; }
+
+        // numero de puntos con t menor a tValue (o menor o igual si inclusive es true)
+        int countPointsBefore(float tValue, bool inclusive) const {
+            int low = 0;
+            int high = m_size;
+            while (low < high) {
+                int mid = (low + high) / 2;
+                if (tValueAt(mid) < tValue || (inclusive && tValueAt(mid) == tValue)) {
+                    low = mid + 1;
+                }
+                else {
+                    high = mid;
+                }
+            }
+            return low;
+        }
+
+        // indice i del segmento [t_i, t_i+1] que contiene t, acotado a los segmentos de la curva
+        int findSegment(float t) const {
+            int lastSegment = m_size - 2;
+            for (int i = m_segmentHint; i <= m_segmentHint + 1 && i <= lastSegment; i++) {
+                if (tValueAt(i) <= t && t <= tValueAt(i + 1)) {
+                    m_segmentHint = i;
+                    return i;
+                }
+            }
+            m_segmentHint = std::clamp(countPointsBefore(t, true) - 1, 0, lastSegment);
+            return m_segmentHint;
+        }
+
+    public:
+        RingLIC() = default;
+        static constexpr int getCapacity() { return N; }
+        glm::vec2 getTRange() const {
+            if (m_size == 0) {
+                return glm::vec2(1, 0);
+            }
+            return glm::vec2(tValueAt(0), tValueAt(m_size - 1));
+        }
+        bool inTRange(float t) const { return 0 < m_size && tValueAt(0) - m_tEpsilon <= t && t <= tValueAt(m_size - 1) + m_tEpsilon; }
+        int getNumberOfPoints() const { return m_size; }
+        float getTEpsilon() const { return m_tEpsilon; }
+        glm::vec<D, float> getStart() const { return getCurvePoint(0); }
+        glm::vec<D, float> getEnd() const { return getCurvePoint(m_size - 1); }
+
+        float getTValue(int pointIndex) const {
+            MONA_ASSERT(0 <= pointIndex && pointIndex < m_size, "RingLIC: input index must be within bounds.");
+            return tValueAt(pointIndex);
+        }
+
+        glm::vec<D, float> getCurvePoint(int pointIndex) const {
+            MONA_ASSERT(0 <= pointIndex && pointIndex < m_size, "RingLIC: input index must be within bounds.");
+            return pointAt(pointIndex);
+        }
+
+        glm::vec<D, float> evalCurve(float t) const {
+            MONA_ASSERT(inTRange(t), "RingLIC: t must be a value between {0} and {1}.", getTRange()[0], getTRange()[1]);
+            if (m_size == 1) {
+                return pointAt(0);
+            }
+            int i = findSegment(t);
+            // si estamos en el entorno de un punto (solo pueden estarlo los extremos del segmento)
+            if (abs(t - tValueAt(i)) <= m_tEpsilon) {
+                return pointAt(i);
+            }
+            if (abs(t - tValueAt(i + 1)) <= m_tEpsilon) {
+                return pointAt(i + 1);
+            }
+            // si no
+            if (tValueAt(i) <= t && t <= tValueAt(i + 1)) {
+                float fraction = funcUtils::getFraction(tValueAt(i), tValueAt(i + 1), t);
+                return funcUtils::lerp(pointAt(i), pointAt(i + 1), fraction);
+            }
+            return glm::vec<D, float>(0);
+        }
+
+        void insertPoint(glm::vec<D, float> point, float tValue) {
+            int i = countPointsBefore(tValue, false);
+            // si ya hay un punto en un tValue similar retornamos
+            if (i < m_size && abs(tValueAt(i) - tValue) < 2 * m_tEpsilon) {
+                return;
+            }
+            if (0 < i && abs(tValueAt(i - 1) - tValue) < 2 * m_tEpsilon) {
+                return;
+            }
+            if (m_size == N) {
+                // el nuevo punto seria el mas antiguo y se descartaria de inmediato
+                if (i == 0) {
+                    return;
+                }
+                removeFrontPoints(1);
+                i -= 1;
+            }
+            if (i == 0) {
+                m_head = (m_head + N - 1) % N;
+            }
+            else {
+                // insercion intermedia, se desplazan los puntos posteriores. No ocurre al agregar al final.
+                for (int j = m_size; i < j; j--) {
+                    m_tValues[bufferIndex(j)] = tValueAt(j - 1);
+                    m_curvePoints[bufferIndex(j)] = pointAt(j - 1);
+                }
+            }
+            m_size += 1;
+            m_tValues[bufferIndex(i)] = tValue;
+            m_curvePoints[bufferIndex(i)] = point;
+        }
+
+        // descarta los pointNum puntos mas antiguos
+        void removeFrontPoints(int pointNum) {
+            MONA_ASSERT(0 <= pointNum && pointNum <= m_size, "RingLIC: cannot remove more points than the curve has.");
+            m_head = (m_head + pointNum) % N;
+            m_size -= pointNum;
+        }
+
+        void clear() {
+            m_head = 0;
+            m_size = 0;
+        }
+    };
     
 }
 
@@ -7,6 +7,7 @@
 #include "../World/ComponentManager.hpp"
 #include "../Animation/AnimationClip.hpp"
 #include <algorithm>
+#include <array>
 
 namespace Mona{
 
@@ -77,7 +78,7 @@ namespace Mona{
         ComponentManager<TransformComponent>& transformManager,
         ComponentManager<StaticMeshComponent>& staticMeshManager) {
 		IKAnimation* ikAnim = trData->m_ikAnim;
-        float calcHeight = m_environmentData.getTerrainHeight(glm::vec2(basePos), transformManager, staticMeshManager);
+        float calcHeight = m_environmentData.getTerrainHeight(glm::vec2(basePos), staticMeshManager);
         glm::vec3 fixedPos(basePos, calcHeight + supportHeight);
         LIC<3> fixedCurve({ fixedPos, fixedPos }, { timeRange[0], timeRange[1] });
         trData->setTargetTrajectory(fixedCurve, trData->getSubTrajectoryByID(baseCurveID).m_trajectoryType, baseCurveID);
@@ -181,7 +182,7 @@ namespace Mona{
 		}
         baseCurve.fitEnds(initialPos, finalPos, m_ikRig->getUpVector());
 
-		if (m_strideCorrectionEnabled && originalTrajectory.isDynamic() && !trData->isTargetFixed()) {
+		if (m_strideCorrectionEnabled && !m_strideCorrectionSuspended && originalTrajectory.isDynamic() && !trData->isTargetFixed()) {
 			m_strideCorrector.correctStride(baseCurve, originalTrajectory.getEECurve(),
 				m_environmentData, transformManager, staticMeshManager);
 		}
@@ -346,18 +347,22 @@ namespace Mona{
 		glm::vec2 targetDirection, glm::vec3& outStrideStartPoint,
 		ComponentManager<TransformComponent>& transformManager,
 		ComponentManager<StaticMeshComponent>& staticMeshManager) {
-		int stepNum = 20;
+		constexpr int stepNum = 20;
+		// se consultan en un solo llamado las alturas de los puntos de prueba y del punto de referencia (ultimo)
+		std::array<glm::vec2, stepNum + 1> testPoints;
+		std::array<float, stepNum + 1> testHeights;
+		for (int i = 1; i <= stepNum; i++) {
+			testPoints[i - 1] = xyReferencePoint - targetDirection * targetDistance * ((float)i / stepNum);
+		}
+		testPoints[stepNum] = xyReferencePoint;
+		m_environmentData.getTerrainHeights(testPoints, testHeights, staticMeshManager);
 		std::vector<glm::vec3> collectedPoints;
 		collectedPoints.reserve(stepNum);
-		for (int i = 1; i <= stepNum; i++) {
-			glm::vec2 testPoint = xyReferencePoint - targetDirection * targetDistance * ((float)i / stepNum);
-			float calcHeight = m_environmentData.getTerrainHeight(testPoint,
-				transformManager, staticMeshManager);
-			collectedPoints.push_back(glm::vec3(testPoint, calcHeight));
+		for (int i = 0; i < stepNum; i++) {
+			collectedPoints.push_back(glm::vec3(testPoints[i], testHeights[i]));
 		}
 		float minDistDiff = std::numeric_limits<float>::max();
-		glm::vec3 floorReferencePoint = glm::vec3(xyReferencePoint, m_environmentData.getTerrainHeight(xyReferencePoint,
-			transformManager, staticMeshManager));
+		glm::vec3 floorReferencePoint = glm::vec3(xyReferencePoint, testHeights[stepNum]);
 		glm::vec3 selectedStartPoint(std::numeric_limits<float>::max());
 		for (int i = 0; i < collectedPoints.size(); i++) {
 			float distDiff = std::abs(glm::distance(floorReferencePoint, collectedPoints[i]) - targetDistance);
@@ -377,17 +382,22 @@ namespace Mona{
 		glm::vec2 targetDirection, glm::vec3& outStrideFinalPoint,
 		ComponentManager<TransformComponent>& transformManager,
 		ComponentManager<StaticMeshComponent>& staticMeshManager) {
-		int stepNum = 20;
+		constexpr int stepNum = 20;
 		EETrajectory baseEETr = baseTrajectoryData->getSubTrajectoryByID(baseTrajecoryID);
 		float supportHeightStart = baseEETr.getEECurve().getStart()[2];
 		float supportHeightEnd = baseEETr.getEECurve().getEnd()[2];
+		std::array<glm::vec2, stepNum> testPoints;
+		std::array<float, stepNum> testHeights;
+		for (int i = 1; i <= stepNum; i++) {
+			testPoints[i - 1] = glm::vec2(startingPoint) + targetDirection * targetDistance * ((float)i / stepNum);
+		}
+		m_environmentData.getTerrainHeights(testPoints, testHeights, staticMeshManager);
 		std::vector<glm::vec3> collectedPoints;
 		collectedPoints.reserve(stepNum);
 		for (int i = 1; i <= stepNum; i++) {
-			glm::vec2 testPoint = glm::vec2(startingPoint) + targetDirection * targetDistance * ((float)i / stepNum);
 			float supportHeight = funcUtils::lerp(supportHeightStart, supportHeightEnd, (float)i / stepNum);
-			float calcHeight = supportHeight + m_environmentData.getTerrainHeight(testPoint, transformManager, staticMeshManager);
-			collectedPoints.push_back(glm::vec3(testPoint, calcHeight));
+			float calcHeight = supportHeight + testHeights[i - 1];
+			collectedPoints.push_back(glm::vec3(testPoints[i - 1], calcHeight));
 		}
 		float minDistDiff = std::numeric_limits<float>::max();
 		glm::vec3 selectedFinalPoint(std::numeric_limits<float>::max());
@@ -21,6 +21,8 @@ namespace Mona{
         StrideCorrector m_strideCorrector;
         bool m_strideValidationEnabled;
         bool m_strideCorrectionEnabled;
+        // suspension temporal de la correccion de pasos por nivel de detalle, sin alterar la configuracion del usuario
+        bool m_strideCorrectionSuspended = false;
         void generateEETrajectory(ChainIndex ikChain, IKAnimation* ikAnim,
             ComponentManager<TransformComponent>& transformManager,
             ComponentManager<StaticMeshComponent>& staticMeshManager);
@@ -60,6 +62,7 @@ namespace Mona{
             ComponentManager<StaticMeshComponent>& staticMeshManager);
         void enableStrideValidation(bool enableStrideValidation) { m_strideValidationEnabled = enableStrideValidation; }
         void enableStrideCorrection(bool enableStrideCorrection) { m_strideCorrectionEnabled = enableStrideCorrection; }
+        void suspendStrideCorrection(bool suspendStrideCorrection) { m_strideCorrectionSuspended = suspendStrideCorrection; }
     };
 
     
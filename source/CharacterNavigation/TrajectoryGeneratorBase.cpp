@@ -100,8 +100,7 @@ namespace Mona{
 
 
 	// primer termino: acercar los modulos de las velocidades
-	std::function<float(const std::vector<float>&, TGData*)> term1Function =
-		[](const std::vector<float>& varPCoord, TGData* dataPtr)->float {
+	float TGVelocityTerm::calcTerm(std::span<const float> varPCoord, TGData* dataPtr) {
 		float result = 0;
 		for (int i = 0; i < dataPtr->pointIndexes.size(); i++) {
 			int pIndex = dataPtr->pointIndexes[i];
@@ -109,10 +108,9 @@ namespace Mona{
 			result += glm::distance2(dataPtr->varCurve->getPointVelocity(pIndex, true), dataPtr->baseCurve.getPointVelocity(pIndex, true));
 		}
 		return result;
-	};
+	}
 
-	std::function<float(const std::vector<float>&, int, TGData*)> term1PartialDerivativeFunction =
-		[](const std::vector<float>& varPCoord, int varIndex, TGData* dataPtr)->float {
+	float TGVelocityTerm::calcTermPartialDerivative(std::span<const float> varPCoord, int varIndex, TGData* dataPtr) {
 		int D = 3;
 		int pIndex = dataPtr->pointIndexes[varIndex / D];
 		int coordIndex = varIndex % D;
@@ -127,10 +125,9 @@ namespace Mona{
 		result += 2 * (lVel[coordIndex] - baseLVel[coordIndex]) * (1 / (t_kCurr - t_kPrev));
 		result += 2 * (rVel[coordIndex] - baseRVel[coordIndex]) * (-1 / (t_kNext - t_kCurr));
 		return result;
-	};
+	}
 
-	std::function<void(std::vector<float>&, TGData*, std::vector<float>&)>  postDescentStepCustomBehaviour =
-		[](std::vector<float>& varPCoord, TGData* dataPtr, std::vector<float>& argsRawDelta)->void {
+	void TGPostDescentStep::operator()(std::span<float> varPCoord, TGData* dataPtr, std::span<float> argsRawDelta) {
 		glm::vec3 newPos;
 		int D = 3;
 		for (int i = 0; i < dataPtr->pointIndexes.size(); i++) {
@@ -144,12 +141,11 @@ namespace Mona{
 			int pIndex = dataPtr->pointIndexes[i];
 			dataPtr->varCurve->setCurvePoint(pIndex, newPos);
 		}
-	};
+	}
 
 
 	void StrideCorrector::init(float rigGlobalHeight) {
-		FunctionTerm<TGData> term1(term1Function, term1PartialDerivativeFunction);
-		m_gradientDescent = GradientDescent<TGData>({ term1 }, 0, &m_tgData, postDescentStepCustomBehaviour);
+		m_gradientDescent = decltype(m_gradientDescent)(&m_tgData, 0);
 		m_tgData.descentRate = 1 / pow(10, 3);
 		m_tgData.maxIterations = 600;
 		m_tgData.targetPosDelta = rigGlobalHeight / pow(10, 5);
@@ -168,10 +164,19 @@ namespace Mona{
 
 		LIC<3> baseCurve = targetCurve;
 
+		// alturas del terreno bajo todos los puntos de la curva salvo el inicial, en una sola consulta
+		int pointNum = targetCurve.getNumberOfPoints();
+		m_queryPoints.resize(pointNum - 1);
+		m_queryHeights.resize(pointNum - 1);
+		for (int i = 1; i < pointNum; i++) {
+			m_queryPoints[i - 1] = glm::vec2(targetCurve.getCurvePoint(i));
+		}
+		environmentData.getTerrainHeights(m_queryPoints, m_queryHeights, staticMeshManager);
+
 		// reajuste de altura del final de la curva para corregir posibles errores de posicionamiento
 		// se guarda la curva sin modificar en baseCurve, ya que es importante preservar su forma
 		glm::vec2 xyEndPoint = targetCurve.getEnd();
-		float terrainHeightEndPoint = environmentData.getTerrainHeight(xyEndPoint, transformManager, staticMeshManager);
+		float terrainHeightEndPoint = m_queryHeights[pointNum - 2];
 		glm::vec3 adjustedEndPoint = glm::vec3(xyEndPoint, terrainHeightEndPoint + endSupportHeight);
 		targetCurve.setCurvePoint(targetCurve.getNumberOfPoints() - 1, adjustedEndPoint);
 
@@ -180,17 +185,17 @@ namespace Mona{
 		m_tgData.minValues.clear();
 		for (int i = 1; i < targetCurve.getNumberOfPoints() - 1; i++) {
 			m_tgData.pointIndexes.push_back(i);
-			glm::vec3 currPoint = targetCurve.getCurvePoint(i);
 			float fraction = funcUtils::getFraction(0, targetCurve.getNumberOfPoints() - 1, i);
 			float currSupportHeight = funcUtils::lerp(startSupportHeight, endSupportHeight, fraction);
-			float minZ = environmentData.getTerrainHeight(glm::vec2(currPoint), transformManager, staticMeshManager) + currSupportHeight;
+			float minZ = m_queryHeights[i - 1] + currSupportHeight;
 			m_tgData.minValues.push_back(std::numeric_limits<float>::lowest());
 			m_tgData.minValues.push_back(std::numeric_limits<float>::lowest());
 			m_tgData.minValues.push_back(minZ);
 		}
 
 		// valores iniciales y curva base
-		std::vector<float> initialArgs(m_tgData.pointIndexes.size() * 3);
+		std::vector<float>& initialArgs = m_tgData.args;
+		initialArgs.resize(m_tgData.pointIndexes.size() * 3);
 		for (int i = 0; i < m_tgData.pointIndexes.size(); i++) {
 			int pIndex = m_tgData.pointIndexes[i];
 			for (int j = 0; j < 3; j++) {
@@ -100,10 +100,24 @@ namespace Mona{
         float descentRate;
         float targetPosDelta;
         int maxIterations;
+        // argumentos del descenso, reutilizados entre correcciones
+        std::vector<float> args;
+    };
+    // primer termino: acercar los modulos de las velocidades
+    struct TGVelocityTerm {
+        float calcTerm(std::span<const float> varPCoord, TGData* dataPtr);
+        float calcTermPartialDerivative(std::span<const float> varPCoord, int varIndex, TGData* dataPtr);
+    };
+    // mantiene los puntos sobre su altura minima y los aplica a la curva
+    struct TGPostDescentStep {
+        void operator()(std::span<float> varPCoord, TGData* dataPtr, std::span<float> argsRawDelta);
     };
     class StrideCorrector {
-        GradientDescent<TGData> m_gradientDescent;
+        GradientDescent<TGData, TGPostDescentStep, TGVelocityTerm> m_gradientDescent;
         TGData m_tgData;
+        // puntos y alturas de la consulta de terreno de cada paso, reutilizados entre llamados
+        std::vector<glm::vec2> m_queryPoints;
+        std::vector<float> m_queryHeights;
     public:
         StrideCorrector() = default;
         void init(float rigGlobalHeight);
@@ -0,0 +1,215 @@
+#include "AssetCache.hpp"
+#include "Log.hpp"
+#include <fstream>
+#include <cstdio>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+namespace Mona {
+
+	namespace {
+		constexpr char CacheMagic[4] = { 'M', 'O', 'N', 'A' };
+		struct CacheHeader {
+			char magic[4];
+			uint32_t formatVersion;
+			uint32_t assetType;
+			uint32_t importFlags;
+			uint64_t sourceHash;
+			uint64_t dependencyHash;
+		};
+		constexpr uint64_t HashPrime = 1099511628211ull;
+		//Tamano de los bloques con que se lee un archivo para calcular su hash, debe ser multiplo de 8
+		constexpr size_t HashChunkSize = 1 << 20;
+	}
+
+	std::string AssetCache::GetCachePath(const std::string& sourcePath, AssetType type) noexcept {
+		switch (type)
+		{
+		case AssetType::Mesh:
+			return sourcePath + ".mesh.monacache";
+		case AssetType::SkinnedMesh:
+			return sourcePath + ".skinned.monacache";
+		case AssetType::Skeleton:
+			return sourcePath + ".skeleton.monacache";
+		case AssetType::AnimationClip:
+			return sourcePath + ".animation.monacache";
+		default:
+			return sourcePath + ".monacache";
+		}
+	}
+
+	uint64_t AssetCache::HashBytes(const void* data, size_t size, uint64_t seed) noexcept {
+		//Variante de FNV-1a que consume palabras de 8 bytes, mucho mas rapida que la original byte a byte
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		uint64_t hash = seed;
+		size_t i = 0;
+		for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+			uint64_t word;
+			std::memcpy(&word, bytes + i, sizeof(uint64_t));
+			hash = (hash ^ word) * HashPrime;
+		}
+		for (; i < size; i++) {
+			hash = (hash ^ bytes[i]) * HashPrime;
+		}
+		return hash;
+	}
+
+	uint64_t AssetCache::HashFile(const std::string& filePath) noexcept {
+		std::ifstream file(filePath, std::ios::binary);
+		if (!file)
+			return 0;
+		std::vector<char> chunk(HashChunkSize);
+		uint64_t hash = 14695981039346656037ull;
+		uint64_t totalSize = 0;
+		while (file) {
+			file.read(chunk.data(), chunk.size());
+			const std::streamsize readCount = file.gcount();
+			if (readCount <= 0)
+				break;
+			hash = HashBytes(chunk.data(), static_cast<size_t>(readCount), hash);
+			totalSize += static_cast<uint64_t>(readCount);
+		}
+		//Se mezcla el tamano para distinguir archivos que solo difieren en ceros finales
+		hash = HashBytes(&totalSize, sizeof(totalSize), hash);
+		return hash == 0 ? 1 : hash;
+	}
+
+	AssetCacheWriter::AssetCacheWriter(const AssetCache::Key& key) noexcept {
+		CacheHeader header;
+		std::memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+		header.formatVersion = AssetCache::FormatVersion;
+		header.assetType = static_cast<uint32_t>(key.type);
+		header.importFlags = key.importFlags;
+		header.sourceHash = key.sourceHash;
+		header.dependencyHash = key.dependencyHash;
+		Write(header);
+	}
+
+	void AssetCacheWriter::Append(const void* data, size_t size) noexcept {
+		const char* bytes = static_cast<const char*>(data);
+		m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+	}
+
+	void AssetCacheWriter::Align() noexcept {
+		const size_t remainder = m_buffer.size() % ArrayAlignment;
+		if (remainder != 0)
+			m_buffer.resize(m_buffer.size() + ArrayAlignment - remainder, 0);
+	}
+
+	bool AssetCacheWriter::Save(const std::string& cachePath) const noexcept {
+		//Se escribe primero a un archivo temporal para que una escritura interrumpida nunca deje una cache corrupta
+		const std::string temporaryPath = cachePath + ".tmp";
+		{
+			std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+			if (!file)
+				return false;
+			file.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+			if (!file)
+				return false;
+		}
+		std::remove(cachePath.c_str());
+		return std::rename(temporaryPath.c_str(), cachePath.c_str()) == 0;
+	}
+
+	AssetCacheReader::AssetCacheReader(const std::string& cachePath, const AssetCache::Key& key) noexcept {
+#ifdef _WIN32
+		HANDLE file = CreateFileA(cachePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return;
+		m_fileHandle = file;
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(CacheHeader))) {
+			Unmap();
+			return;
+		}
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping) {
+			Unmap();
+			return;
+		}
+		m_mappingHandle = mapping;
+		m_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+		const int file = open(cachePath.c_str(), O_RDONLY);
+		if (file < 0)
+			return;
+		struct stat fileStat;
+		if (fstat(file, &fileStat) != 0 || fileStat.st_size < static_cast<off_t>(sizeof(CacheHeader))) {
+			close(file);
+			return;
+		}
+		void* mapped = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		close(file);
+		if (mapped == MAP_FAILED)
+			return;
+		m_data = static_cast<const char*>(mapped);
+		m_size = static_cast<size_t>(fileStat.st_size);
+#endif
+		if (!m_data) {
+			Unmap();
+			return;
+		}
+		m_valid = true;
+		CacheHeader header;
+		Read(header);
+		const bool matches = std::memcmp(header.magic, CacheMagic, sizeof(CacheMagic)) == 0 &&
+			header.formatVersion == AssetCache::FormatVersion &&
+			header.assetType == static_cast<uint32_t>(key.type) &&
+			header.importFlags == key.importFlags &&
+			header.sourceHash == key.sourceHash &&
+			header.dependencyHash == key.dependencyHash;
+		if (!matches) {
+			m_valid = false;
+			Unmap();
+		}
+	}
+
+	AssetCacheReader::~AssetCacheReader() {
+		Unmap();
+	}
+
+	void AssetCacheReader::Unmap() noexcept {
+#ifdef _WIN32
+		if (m_data)
+			UnmapViewOfFile(m_data);
+		if (m_mappingHandle)
+			CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+		if (m_fileHandle)
+			CloseHandle(static_cast<HANDLE>(m_fileHandle));
+		m_mappingHandle = nullptr;
+		m_fileHandle = nullptr;
+#else
+		if (m_data)
+			munmap(const_cast<char*>(m_data), m_size);
+#endif
+		m_data = nullptr;
+		m_size = 0;
+		m_offset = 0;
+	}
+
+	const char* AssetCacheReader::Consume(size_t size) noexcept {
+		if (!m_valid || size > m_size - m_offset) {
+			m_valid = false;
+			return nullptr;
+		}
+		const char* data = m_data + m_offset;
+		m_offset += size;
+		return data;
+	}
+
+	void AssetCacheReader::Align() noexcept {
+		const size_t remainder = m_offset % AssetCacheWriter::ArrayAlignment;
+		if (remainder != 0)
+			m_offset += AssetCacheWriter::ArrayAlignment - remainder;
+		if (m_offset > m_size)
+			m_valid = false;
+	}
+}
@@ -0,0 +1,165 @@
+#pragma once
+#ifndef ASSETCACHE_HPP
+#define ASSETCACHE_HPP
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <type_traits>
+namespace Mona {
+	class World;
+
+	/*
+	* Cache binaria de los recursos importados con assimp (mallas, mallas con piel y esqueletos). La primera carga de un
+	* archivo escribe junto a el un archivo <archivo>.<tipo>.monacache con los datos ya procesados, y las cargas siguientes
+	* mapean ese archivo a memoria y suben su contenido directamente, sin pasar por assimp. Cada archivo de cache guarda en
+	* su cabecera la version del formato, el hash del contenido del archivo fuente, las opciones de importacion y un hash
+	* de dependencias (por ejemplo el esqueleto de una malla con piel), de modo que cualquier cambio invalida la cache.
+	*/
+	class AssetCache {
+	public:
+		static constexpr uint32_t FormatVersion = 2;
+		enum class AssetType : uint32_t {
+			Mesh = 1,
+			SkinnedMesh = 2,
+			Skeleton = 3,
+			AnimationClip = 4
+		};
+		struct Key {
+			AssetType type;
+			uint32_t importFlags = 0;
+			uint64_t sourceHash = 0;
+			uint64_t dependencyHash = 0;
+		};
+
+		static bool IsEnabled() noexcept { return s_enabled; }
+		//Ruta del archivo de cache asociado a un recurso fuente y un tipo
+		static std::string GetCachePath(const std::string& sourcePath, AssetType type) noexcept;
+		//Hash del contenido completo de un archivo, retorna 0 si este no pudo abrirse
+		static uint64_t HashFile(const std::string& filePath) noexcept;
+		static uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 14695981039346656037ull) noexcept;
+		static uint64_t HashString(const std::string& value, uint64_t seed = 14695981039346656037ull) noexcept {
+			return HashBytes(value.data(), value.size(), seed);
+		}
+	private:
+		friend class World;
+		static void SetEnabled(bool value) noexcept { s_enabled = value; }
+		inline static bool s_enabled = true;
+	};
+
+	/*
+	* Construye en memoria el contenido de un archivo de cache y lo escribe a disco. Los arreglos se alinean a
+	* ArrayAlignment bytes para que el lector pueda entregar punteros directos a la memoria mapeada.
+	*/
+	class AssetCacheWriter {
+	public:
+		static constexpr size_t ArrayAlignment = 16;
+		AssetCacheWriter(const AssetCache::Key& key) noexcept;
+
+		template <typename T>
+		void Write(const T& value) noexcept {
+			static_assert(std::is_trivially_copyable_v<T>, "AssetCache Error: Only trivially copyable types can be cached");
+			Append(&value, sizeof(T));
+		}
+
+		template <typename T>
+		void WriteArray(const T* values, uint64_t count) noexcept {
+			static_assert(std::is_trivially_copyable_v<T>, "AssetCache Error: Only trivially copyable types can be cached");
+			Write(count);
+			Align();
+			Append(values, sizeof(T) * count);
+		}
+
+		template <typename T>
+		void WriteArray(const std::vector<T>& values) noexcept { WriteArray(values.data(), values.size()); }
+
+		void WriteString(const std::string& value) noexcept {
+			Write(static_cast<uint64_t>(value.size()));
+			Append(value.data(), value.size());
+		}
+
+		//Escribe el archivo completo, retorna false si este no pudo crearse
+		bool Save(const std::string& cachePath) const noexcept;
+	private:
+		void Append(const void* data, size_t size) noexcept;
+		void Align() noexcept;
+		std::vector<char> m_buffer;
+	};
+
+	/*
+	* Mapea un archivo de cache a memoria y valida su cabecera contra la llave esperada. Los punteros entregados por
+	* ReadArray apuntan a la memoria mapeada y son validos mientras el lector exista.
+	*/
+	class AssetCacheReader {
+	public:
+		AssetCacheReader(const std::string& cachePath, const AssetCache::Key& key) noexcept;
+		~AssetCacheReader();
+		AssetCacheReader(const AssetCacheReader&) = delete;
+		AssetCacheReader& operator=(const AssetCacheReader&) = delete;
+
+		//Indica si el archivo existe, coincide con la llave y todas las lecturas hasta ahora han sido validas
+		bool IsValid() const noexcept { return m_valid; }
+
+		template <typename T>
+		bool Read(T& value) noexcept {
+			static_assert(std::is_trivially_copyable_v<T>, "AssetCache Error: Only trivially copyable types can be cached");
+			const char* data = Consume(sizeof(T));
+			if (data)
+				std::memcpy(&value, data, sizeof(T));
+			return data != nullptr;
+		}
+
+		template <typename T>
+		const T* ReadArray(uint64_t& count) noexcept {
+			static_assert(std::is_trivially_copyable_v<T>, "AssetCache Error: Only trivially copyable types can be cached");
+			count = 0;
+			uint64_t storedCount = 0;
+			if (!Read(storedCount))
+				return nullptr;
+			Align();
+			if (!m_valid || storedCount > (m_size - m_offset) / sizeof(T)) {
+				m_valid = false;
+				return nullptr;
+			}
+			const char* data = Consume(sizeof(T) * storedCount);
+			if (!data)
+				return nullptr;
+			count = storedCount;
+			return reinterpret_cast<const T*>(data);
+		}
+
+		template <typename T>
+		bool ReadArray(std::vector<T>& values) noexcept {
+			uint64_t count = 0;
+			const T* data = ReadArray<T>(count);
+			if (!m_valid)
+				return false;
+			values.assign(data, data + count);
+			return true;
+		}
+
+		bool ReadString(std::string& value) noexcept {
+			uint64_t size = 0;
+			if (!Read(size) || size > m_size - m_offset) {
+				m_valid = false;
+				return false;
+			}
+			const char* data = Consume(size);
+			value.assign(data, size);
+			return true;
+		}
+	private:
+		const char* Consume(size_t size) noexcept;
+		void Align() noexcept;
+		void Unmap() noexcept;
+		const char* m_data = nullptr;
+		size_t m_size = 0;
+		size_t m_offset = 0;
+		bool m_valid = false;
+#ifdef _WIN32
+		void* m_fileHandle = nullptr;
+		void* m_mappingHandle = nullptr;
+#endif
+	};
+}
+#endif
@@ -0,0 +1,65 @@
+#pragma once
+#ifndef ASSETFUTURE_HPP
+#define ASSETFUTURE_HPP
+#include <atomic>
+#include <memory>
+#include "AsyncAssetLoader.hpp"
+namespace Mona {
+	template <typename T>
+	class AssetPromise;
+
+	/*
+	* Manejador de un recurso cargado de forma asincrona. El recurso queda disponible una vez que su trabajo en los hilos
+	* de carga y su subida en el hilo principal terminan. Las copias comparten el mismo estado.
+	*/
+	template <typename T>
+	class AssetFuture {
+	public:
+		AssetFuture() = default;
+		//Futuro ya resuelto, usado cuando el recurso se encontraba cargado
+		explicit AssetFuture(std::shared_ptr<T> value) : m_state(std::make_shared<SharedState>()) {
+			m_state->value = std::move(value);
+			m_state->ready.store(true, std::memory_order_release);
+		}
+		bool IsValid() const noexcept { return m_state != nullptr; }
+		bool IsReady() const noexcept { return m_state && m_state->ready.load(std::memory_order_acquire); }
+		//Retorna el recurso si ya esta disponible y nullptr en caso contrario
+		std::shared_ptr<T> Get() const noexcept { return IsReady() ? m_state->value : nullptr; }
+		/*
+		* Bloquea hasta que el recurso este disponible. Solo puede llamarse desde el hilo principal, que mientras espera
+		* ejecuta las subidas pendientes.
+		*/
+		std::shared_ptr<T> Wait() const noexcept {
+			if (!m_state)
+				return nullptr;
+			AsyncAssetLoader::GetInstance().WaitUntil([this]() { return IsReady(); });
+			return m_state->value;
+		}
+	private:
+		friend class AssetPromise<T>;
+		struct SharedState {
+			std::atomic<bool> ready = false;
+			std::shared_ptr<T> value;
+		};
+		std::shared_ptr<SharedState> m_state;
+	};
+
+	/*
+	* Extremo productor de un AssetFuture, usado por los managers de recursos para resolverlo.
+	*/
+	template <typename T>
+	class AssetPromise {
+	public:
+		AssetPromise() {
+			m_future.m_state = std::make_shared<typename AssetFuture<T>::SharedState>();
+		}
+		const AssetFuture<T>& GetFuture() const noexcept { return m_future; }
+		void SetValue(std::shared_ptr<T> value) const noexcept {
+			m_future.m_state->value = std::move(value);
+			m_future.m_state->ready.store(true, std::memory_order_release);
+		}
+	private:
+		AssetFuture<T> m_future;
+	};
+}
+#endif
@@ -0,0 +1,72 @@
+#include "AsyncAssetLoader.hpp"
+#include "Log.hpp"
+#include <chrono>
+namespace Mona {
+
+	void AsyncAssetLoader::StartUp(int loaderThreadCount) noexcept {
+		MONA_ASSERT(!m_started, "AsyncAssetLoader Error: StartUp called twice");
+		m_mainThreadID = std::this_thread::get_id();
+		//Sin hilos de carga los trabajos solo avanzarian dentro de WaitUntil, por lo que siempre se usa al menos uno
+		m_loaderJobSystem.StartUp(loaderThreadCount > 0 ? loaderThreadCount : 1);
+		m_started = true;
+	}
+
+	void AsyncAssetLoader::ShutDown() noexcept {
+		if (!m_started)
+			return;
+		m_loaderJobSystem.Wait(m_loadGroup);
+		while (ExecuteMainThreadTask()) {}
+		m_loaderJobSystem.ShutDown();
+		m_started = false;
+	}
+
+	void AsyncAssetLoader::RunOnLoaderThread(Task task) noexcept {
+		m_pendingLoads.fetch_add(1, std::memory_order_relaxed);
+		m_loaderJobSystem.Run(m_loadGroup, [this, task = std::move(task)]() {
+			task();
+			m_pendingLoads.fetch_sub(1, std::memory_order_release);
+		});
+	}
+
+	void AsyncAssetLoader::RunOnMainThread(Task task) noexcept {
+		std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+		m_mainThreadTasks.push_back(std::move(task));
+	}
+
+	size_t AsyncAssetLoader::GetPendingMainThreadTaskCount() const noexcept {
+		std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+		return m_mainThreadTasks.size();
+	}
+
+	bool AsyncAssetLoader::ExecuteMainThreadTask() noexcept {
+		Task task;
+		{
+			std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+			if (m_mainThreadTasks.empty())
+				return false;
+			task = std::move(m_mainThreadTasks.front());
+			m_mainThreadTasks.pop_front();
+		}
+		//La tarea se ejecuta fuera del lock ya que puede encolar nuevas tareas
+		task();
+		return true;
+	}
+
+	void AsyncAssetLoader::ProcessMainThreadTasks(float timeBudget) noexcept {
+		const auto startTime = std::chrono::steady_clock::now();
+		while (ExecuteMainThreadTask()) {
+			const float elapsedTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+			if (elapsedTime >= timeBudget)
+				break;
+		}
+	}
+
+	void AsyncAssetLoader::WaitUntil(const std::function<bool()>& isReady) noexcept {
+		MONA_ASSERT(!m_started || std::this_thread::get_id() == m_mainThreadID,
+			"AsyncAssetLoader Error: Only the main thread can wait for an asset");
+		while (!isReady()) {
+			if (!ExecuteMainThreadTask())
+				std::this_thread::yield();
+		}
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+#ifndef ASYNCASSETLOADER_HPP
+#define ASYNCASSETLOADER_HPP
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "JobSystem.hpp"
+namespace Mona {
+	class World;
+
+	/*
+	* Coordina la carga asincrona de recursos. La lectura de archivos, decodificacion y parseo (assimp, stb_image, dr_wav)
+	* se ejecutan en un pool de hilos de carga propio, separado del JobSystem del frame para que una carga larga nunca
+	* retrase las etapas de World. Las subidas a OpenGL/OpenAL, que solo pueden hacerse desde el hilo principal, se encolan
+	* con RunOnMainThread y World las ejecuta al inicio de cada frame sin superar un presupuesto de tiempo.
+	*/
+	class AsyncAssetLoader {
+	public:
+		using Task = std::function<void()>;
+		AsyncAssetLoader(const AsyncAssetLoader&) = delete;
+		AsyncAssetLoader& operator=(const AsyncAssetLoader&) = delete;
+		static AsyncAssetLoader& GetInstance() noexcept {
+			static AsyncAssetLoader instance;
+			return instance;
+		}
+		/*
+		* Encola trabajo de CPU en un hilo de carga. Sin StartUp el trabajo se ejecuta inmediatamente en el hilo llamador.
+		*/
+		void RunOnLoaderThread(Task task) noexcept;
+		/*
+		* Encola trabajo que requiere los contextos de OpenGL u OpenAL. Puede llamarse desde cualquier hilo.
+		*/
+		void RunOnMainThread(Task task) noexcept;
+		/*
+		* Ejecuta tareas encoladas para el hilo principal hasta vaciar la cola o superar timeBudget segundos. Siempre se
+		* ejecuta al menos una tarea para garantizar progreso aun con presupuestos muy pequenos.
+		*/
+		void ProcessMainThreadTasks(float timeBudget) noexcept;
+		/*
+		* Bloquea el hilo principal hasta que isReady retorne true, ejecutando mientras tanto las tareas del hilo principal
+		* de las que puede depender la condicion.
+		*/
+		void WaitUntil(const std::function<bool()>& isReady) noexcept;
+		//Cantidad de cargas cuyo trabajo en hilos de carga aun no termina
+		uint32_t GetPendingLoadCount() const noexcept { return m_pendingLoads.load(std::memory_order_acquire); }
+		size_t GetPendingMainThreadTaskCount() const noexcept;
+	private:
+		friend class World;
+		AsyncAssetLoader() = default;
+		/*
+		* Inicia loaderThreadCount hilos de carga (al menos uno) y registra al hilo llamador como hilo principal.
+		*/
+		void StartUp(int loaderThreadCount) noexcept;
+		/*
+		* Espera a que terminen todas las cargas pendientes y ejecuta sus tareas del hilo principal, de modo que los
+		* managers de recursos puedan liberar todo lo cargado.
+		*/
+		void ShutDown() noexcept;
+		bool ExecuteMainThreadTask() noexcept;
+
+		JobSystem m_loaderJobSystem;
+		JobSystem::JobGroup m_loadGroup;
+		std::atomic<uint32_t> m_pendingLoads = 0;
+		mutable std::mutex m_mainThreadMutex;
+		std::deque<Task> m_mainThreadTasks;
+		std::thread::id m_mainThreadID;
+		bool m_started = false;
+	};
+}
+#endif
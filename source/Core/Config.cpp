@@ -19,6 +19,23 @@ namespace Mona
 
 		// Game Object Settings
 		m_configurations["expected_number_of_gameobjects"] = "1200";
+
+		// Headless Settings
+		m_configurations["headless"] = "0";
+		m_configurations["headless_time_step"] = "0.0166667";
+
+		// Job System Settings
+		m_configurations["worker_thread_count"] = "-1";
+
+		// Rendering Settings
+		m_configurations["instancing_min_batch_size"] = "2";
+
+		// Asset Cache Settings
+		m_configurations["asset_cache"] = "1";
+
+		// Async Asset Loading Settings
+		m_configurations["asset_loader_thread_count"] = "2";
+		m_configurations["asset_upload_time_budget_ms"] = "2";
 	}
 
 	void Config::readFile(const std::string& path)
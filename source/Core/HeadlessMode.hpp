@@ -0,0 +1,20 @@
+#pragma once
+#ifndef HEADLESSMODE_HPP
+#define HEADLESSMODE_HPP
+namespace Mona {
+	class World;
+	/*
+	* Indica si el motor corre sin ventana, contexto OpenGL ni dispositivo OpenAL. El modo es fijado por World durante su
+	* construccion y a partir de ese momento Window, Input, el Renderer y el AudioSystem funcionan como backends nulos,
+	* mientras que los recursos (mallas, texturas y clips de audio) conservan solo sus datos de CPU.
+	*/
+	class HeadlessMode {
+	public:
+		static bool IsEnabled() noexcept { return s_enabled; }
+	private:
+		friend class World;
+		static void SetEnabled(bool value) noexcept { s_enabled = value; }
+		inline static bool s_enabled = false;
+	};
+}
+#endif
@@ -0,0 +1,111 @@
+#include "JobSystem.hpp"
+#include "Log.hpp"
+namespace Mona {
+
+	thread_local unsigned int JobSystem::s_threadIndex = 0;
+
+	void JobSystem::StartUp(int workerThreadCount) noexcept {
+		MONA_ASSERT(!m_running, "JobSystem Error: StartUp called twice");
+		if (workerThreadCount < 0) {
+			const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+			workerThreadCount = hardwareThreads > 1 ? static_cast<int>(hardwareThreads) - 1 : 0;
+		}
+		//La cola 0 pertenece al hilo principal
+		m_queues.reserve(workerThreadCount + 1);
+		for (int i = 0; i < workerThreadCount + 1; i++)
+			m_queues.emplace_back(new WorkQueue());
+		m_running = true;
+		m_workers.reserve(workerThreadCount);
+		for (int i = 0; i < workerThreadCount; i++)
+			m_workers.emplace_back(&JobSystem::WorkerLoop, this, static_cast<unsigned int>(i + 1));
+		MONA_LOG_INFO("JobSystem: Started with {0} worker threads", workerThreadCount);
+	}
+
+	void JobSystem::ShutDown() noexcept {
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			m_running = false;
+		}
+		m_wakeCondition.notify_all();
+		for (auto& worker : m_workers)
+			worker.join();
+		m_workers.clear();
+		m_queues.clear();
+		m_queuedJobs = 0;
+	}
+
+	void JobSystem::Run(JobGroup& group, Job job) noexcept {
+		group.m_pendingJobs.fetch_add(1, std::memory_order_relaxed);
+		if (m_queues.empty()) {
+			//Sin StartUp los trabajos se ejecutan inmediatamente
+			job();
+			group.m_pendingJobs.fetch_sub(1, std::memory_order_release);
+			return;
+		}
+		//Hilos externos al pool (indice 0) comparten la cola del hilo principal
+		WorkQueue& queue = *m_queues[s_threadIndex < m_queues.size() ? s_threadIndex : 0];
+		//El contador se incrementa antes de publicar el trabajo, de lo contrario otro hilo podria tomarlo y decrementar
+		//el contador antes del incremento, haciendolo pasar por debajo de cero
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			m_queuedJobs.fetch_add(1, std::memory_order_relaxed);
+		}
+		{
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.jobs.push_back({ std::move(job), &group });
+		}
+		m_wakeCondition.notify_one();
+	}
+
+	void JobSystem::Wait(JobGroup& group) noexcept {
+		while (!group.IsDone()) {
+			if (!TryExecuteJob(s_threadIndex < m_queues.size() ? s_threadIndex : 0))
+				std::this_thread::yield();
+		}
+	}
+
+	bool JobSystem::TryExecuteJob(unsigned int threadIndex) noexcept {
+		if (m_queues.empty())
+			return false;
+		JobEntry entry;
+		bool found = false;
+		//Primero se busca trabajo en la cola propia (LIFO, mejor localidad de cache)
+		{
+			WorkQueue& ownQueue = *m_queues[threadIndex];
+			std::lock_guard<std::mutex> lock(ownQueue.mutex);
+			if (!ownQueue.jobs.empty()) {
+				entry = std::move(ownQueue.jobs.back());
+				ownQueue.jobs.pop_back();
+				found = true;
+			}
+		}
+		//Si no hay, se roba desde el inicio de la cola de otro hilo (FIFO)
+		const unsigned int queueCount = static_cast<unsigned int>(m_queues.size());
+		for (unsigned int offset = 1; !found && offset < queueCount; offset++) {
+			WorkQueue& victimQueue = *m_queues[(threadIndex + offset) % queueCount];
+			std::lock_guard<std::mutex> lock(victimQueue.mutex);
+			if (!victimQueue.jobs.empty()) {
+				entry = std::move(victimQueue.jobs.front());
+				victimQueue.jobs.pop_front();
+				found = true;
+			}
+		}
+		if (!found)
+			return false;
+		m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+		entry.job();
+		entry.group->m_pendingJobs.fetch_sub(1, std::memory_order_release);
+		return true;
+	}
+
+	void JobSystem::WorkerLoop(unsigned int threadIndex) noexcept {
+		s_threadIndex = threadIndex;
+		while (m_running) {
+			if (TryExecuteJob(threadIndex))
+				continue;
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			m_wakeCondition.wait(lock, [this]() { return !m_running || m_queuedJobs.load(std::memory_order_relaxed) > 0; });
+		}
+	}
+
+}
@@ -0,0 +1,109 @@
+#pragma once
+#ifndef JOBSYSTEM_HPP
+#define JOBSYSTEM_HPP
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+namespace Mona {
+	/*
+	* Pool de hilos con robo de trabajo (work stealing). Cada hilo (incluido el hilo principal, indice 0) posee su propia cola:
+	* el hilo duenio saca trabajos desde el final de su cola mientras que los demas hilos roban desde el inicio.
+	* Los trabajos se agrupan en JobGroups, Wait(group) implementa el join y mientras espera el hilo llamador ejecuta
+	* trabajos pendientes en vez de bloquearse.
+	*/
+	class JobSystem {
+	public:
+		using Job = std::function<void()>;
+		class JobGroup {
+		public:
+			JobGroup() = default;
+			JobGroup(const JobGroup&) = delete;
+			JobGroup& operator=(const JobGroup&) = delete;
+			bool IsDone() const noexcept { return m_pendingJobs.load(std::memory_order_acquire) == 0; }
+		private:
+			friend class JobSystem;
+			std::atomic<uint32_t> m_pendingJobs = 0;
+		};
+
+		JobSystem() = default;
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+		/*
+		* Inicia workerThreadCount hilos ademas del hilo principal. Un valor negativo usa hardware_concurrency - 1 hilos
+		* y cero hace que todo trabajo se ejecute en el hilo que llama a Wait.
+		*/
+		void StartUp(int workerThreadCount) noexcept;
+		void ShutDown() noexcept;
+		/*
+		* Cantidad total de hilos que pueden ejecutar trabajos (workers + hilo principal). Util para dimensionar
+		* buffers temporales por hilo indexados con GetCurrentThreadIndex.
+		*/
+		unsigned int GetThreadCount() const noexcept { return static_cast<unsigned int>(m_queues.size()); }
+		/*
+		* Indice del hilo actual dentro del pool, el hilo principal (o cualquier hilo externo) retorna 0.
+		*/
+		static unsigned int GetCurrentThreadIndex() noexcept { return s_threadIndex; }
+		/*
+		* Encola un trabajo asociado a group (fork).
+		*/
+		void Run(JobGroup& group, Job job) noexcept;
+		/*
+		* Espera a que todos los trabajos de group terminen (join), ejecutando trabajos pendientes mientras tanto.
+		*/
+		void Wait(JobGroup& group) noexcept;
+		/*
+		* Ejecuta func(i) para todo i en [0, count) repartiendo el rango en bloques de a lo mas grainSize elementos.
+		* Retorna una vez procesados todos los elementos.
+		*/
+		template <typename Func>
+		void ParallelFor(size_t count, size_t grainSize, Func&& func) noexcept;
+	private:
+		struct JobEntry {
+			Job job;
+			JobGroup* group;
+		};
+		struct WorkQueue {
+			std::mutex mutex;
+			std::deque<JobEntry> jobs;
+		};
+		bool TryExecuteJob(unsigned int threadIndex) noexcept;
+		void WorkerLoop(unsigned int threadIndex) noexcept;
+
+		static thread_local unsigned int s_threadIndex;
+		std::vector<std::unique_ptr<WorkQueue>> m_queues;
+		std::vector<std::thread> m_workers;
+		std::mutex m_sleepMutex;
+		std::condition_variable m_wakeCondition;
+		std::atomic<uint32_t> m_queuedJobs = 0;
+		std::atomic<bool> m_running = false;
+	};
+
+	template <typename Func>
+	void JobSystem::ParallelFor(size_t count, size_t grainSize, Func&& func) noexcept {
+		if (count == 0)
+			return;
+		grainSize = grainSize == 0 ? 1 : grainSize;
+		//Si no hay workers o el rango cabe en un solo bloque no vale la pena encolar trabajos
+		if (m_workers.empty() || count <= grainSize) {
+			for (size_t i = 0; i < count; i++)
+				func(i);
+			return;
+		}
+		JobGroup group;
+		for (size_t begin = 0; begin < count; begin += grainSize) {
+			const size_t end = begin + grainSize < count ? begin + grainSize : count;
+			Run(group, [&func, begin, end]() {
+				for (size_t i = begin; i < end; i++)
+					func(i);
+			});
+		}
+		Wait(group);
+	}
+}
+#endif
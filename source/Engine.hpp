@@ -9,14 +9,20 @@ namespace Mona {
 	{
 	public:
 		Engine(Application& app) : m_world(app) {}
+		/*
+		* Permite forzar el modo headless (sin ventana, OpenGL ni OpenAL) sin importar lo indicado en config.cfg.
+		*/
+		Engine(Application& app, bool headless) : m_world(app, headless) {}
 		~Engine() = default;
 		Engine(const Engine&) = delete;
 		Engine& operator=(const Engine&) = delete;
 		/*
 		* Funci�n que comienza el main loop del motor.
+		* Si frameCount es distinto de cero el loop termina tras esa cantidad de frames, en otro caso corre hasta que se cierre la
+		* ventana o se llame a World::EndApplication (que puede invocarse desde otro hilo).
 		*/
-		void StartMainLoop() noexcept {
-			m_world.StartMainLoop();
+		void StartMainLoop(uint64_t frameCount = 0) noexcept {
+			m_world.StartMainLoop(frameCount);
 		}
 	private:
 		World m_world;
@@ -12,6 +12,9 @@ namespace Mona {
 	class EventManager;
 	class PhysicsCollisionSystem {
 	public:
+		//Componentes leidas y escritas por StepSimulation (CustomMotionState escribe las transformaciones)
+		using ReadComponents = ComponentTypeList<>;
+		using WriteComponents = ComponentTypeList<TransformComponent, RigidBodyComponent>;
 		PhysicsCollisionSystem() {
 			m_collisionConfigurationPtr = new btDefaultCollisionConfiguration();
 			m_dispatcherPtr = new btCollisionDispatcher(m_collisionConfigurationPtr);
@@ -1,6 +1,7 @@
 #include "Input.hpp"
 #include "../Core/Common.hpp"
 #include "../Core/Log.hpp"
+#include "../Core/HeadlessMode.hpp"
 #include "../Event/EventManager.hpp"
 #include "../Event/Events.hpp"
 #define GLFW_INCLUDE_NONE
@@ -13,9 +14,12 @@ namespace Mona
 		InputImplementation(const InputImplementation& input) = delete;
 		InputImplementation& operator=(const InputImplementation& input) = delete;
 		void StartUp(EventManager& eventManager) noexcept {
+			eventManager.Subscribe(m_mouseScrollSubscription, this, &Input::InputImplementation::OnMouseScroll);
+			//En modo headless no hay ventana, todas las consultas reportan dispositivos en reposo
+			if (HeadlessMode::IsEnabled())
+				return;
 			m_windowHandle = glfwGetCurrentContext();
 			MONA_ASSERT(m_windowHandle != NULL, "GLFW Error: Unable to find window");
-			eventManager.Subscribe(m_mouseScrollSubscription, this, &Input::InputImplementation::OnMouseScroll);
 		}
 
 		void ShutDown(EventManager& eventManager) noexcept {
@@ -24,7 +28,8 @@ namespace Mona
 		void Update() noexcept {
 			m_mouseWheelOffset.x = 0.0;
 			m_mouseWheelOffset.y = 0.0;
-			glfwPollEvents();
+			if (m_windowHandle != nullptr)
+				glfwPollEvents();
 		}
 		void OnMouseScroll(const MouseScrollEvent& e)
 		{
@@ -32,12 +37,18 @@ namespace Mona
 		}
 		inline bool IsKeyPressed(int keycode) const noexcept
 		{
+			if (m_windowHandle == nullptr)
+				return false;
 			return glfwGetKey(m_windowHandle, keycode) == GLFW_PRESS;
 		}
 		inline bool IsMouseButtonPressed(int button) const noexcept {
+			if (m_windowHandle == nullptr)
+				return false;
 			return glfwGetMouseButton(m_windowHandle, button) == GLFW_PRESS;
 		}
 		inline glm::dvec2 GetMousePosition() const noexcept {
+			if (m_windowHandle == nullptr)
+				return glm::dvec2(0.0, 0.0);
 			double x, y;
 			glfwGetCursorPos(m_windowHandle, &x, &y);
 			return glm::dvec2(x, y);
@@ -47,6 +58,8 @@ namespace Mona
 		}
 		void SetCursorType(CursorType type) noexcept
 		{
+			if (m_windowHandle == nullptr)
+				return;
 			switch (type)
 			{
 				case CursorType::Disabled: 
@@ -69,12 +82,16 @@ namespace Mona
 		}
 		inline bool IsGamepadButtonPressed(int joystickId, int code) const noexcept
 		{
+			if (m_windowHandle == nullptr)
+				return false;
 			GLFWgamepadstate state;
 			glfwGetGamepadState(joystickId, &state);
 			return state.buttons[code];
 		}
 		float GetGamepadAxisValue(int joystickId, int code) const noexcept
 		{
+			if (m_windowHandle == nullptr)
+				return 0.0f;
 			GLFWgamepadstate state;
 			glfwGetGamepadState(joystickId, &state);
 			return state.axes[code];
@@ -1,6 +1,7 @@
 #include "Window.hpp"
 #include "../Core/Config.hpp"
 #include "../Core/Common.hpp"
+#include "../Core/HeadlessMode.hpp"
 #include "../Event/Events.hpp"
 #include "../Event/EventManager.hpp"
 #include <glad/glad.h>
@@ -23,10 +24,17 @@ namespace Mona {
 		void StartUp(EventManager& eventManager) noexcept
 		{
 			MONA_ASSERT(m_windowHandle == nullptr, "Calling Window::StartUp for the second time!!!.");
+			Mona::Config& config = Config::GetInstance();
+			m_data.eventManager = &eventManager;
+			if (HeadlessMode::IsEnabled()) {
+				//Sin ventana real solo se recuerdan las dimensiones configuradas, GLFW nunca se inicializa
+				m_headlessDimensions = glm::ivec2(config.getValueOrDefault<int>("windowWidth", 1440),
+					config.getValueOrDefault<int>("windowHeight", 810));
+				return;
+			}
 			const int success = glfwInit();
 			MONA_ASSERT(success, "Could not initialize GLFW!");
 			glfwSetErrorCallback(GLFWErrorCallback);
-			Mona::Config& config = Config::GetInstance(); 
 			const int glVersionMajor = config.getValueOrDefault<int>("OpenGL_major_version", 4);
 			const int glVersionMinor = config.getValueOrDefault<int>("OpenGL_minor_version", 5);
 			auto windowTitle = config.getValueOrDefault<std::string>("windowTitle", "Default Title");
@@ -46,7 +54,6 @@ namespace Mona {
 			m_windowHandle = glfwCreateWindow(windowWidth, windowHeight, windowTitle.c_str(), fullScreen? monitor : NULL, NULL);
 			glfwMakeContextCurrent(m_windowHandle);
 			glfwGetWindowPos(m_windowHandle, &m_oldWindowPos[0], &m_oldWindowPos[1]);
-			m_data.eventManager = &eventManager;
 			glfwSetWindowUserPointer(m_windowHandle, &m_data);
 			
 			//
@@ -73,21 +80,27 @@ namespace Mona {
 		}
 		void ShutDown() noexcept
 		{
+			if (HeadlessMode::IsEnabled())
+				return;
 			MONA_ASSERT(m_windowHandle != nullptr, "Calling Window::ShutDown for the second time or without calling Window::Startup first.");
 			glfwDestroyWindow(m_windowHandle);
 			//glfwTerminate();
 		}
 		void Update() noexcept
 		{
+			if (HeadlessMode::IsEnabled())
+				return;
 			glfwSwapBuffers(m_windowHandle);		
 		}
 		bool IsFullScreen() const noexcept
 		{
+			if (HeadlessMode::IsEnabled())
+				return false;
 			return glfwGetWindowMonitor(m_windowHandle) != NULL;
 		}
 		void SetFullScreen(bool value) noexcept
 		{
-			if (value == IsFullScreen())
+			if (HeadlessMode::IsEnabled() || value == IsFullScreen())
 				return;
 			if (value)
 			{
@@ -107,26 +120,38 @@ namespace Mona {
 		}
 		bool ShouldClose() const noexcept
 		{
+			if (HeadlessMode::IsEnabled())
+				return false;
 			return glfwWindowShouldClose(m_windowHandle);
 		}
 		void SetSwapInterval(int interval) noexcept
 		{
+			if (HeadlessMode::IsEnabled())
+				return;
 			glfwSwapInterval(interval);
 		}
 		glm::ivec2 GetWindowDimensions() const noexcept
 		{
+			if (HeadlessMode::IsEnabled())
+				return m_headlessDimensions;
 			int width, height;
 			glfwGetWindowSize(m_windowHandle, &width, &height);
 			return glm::ivec2(width,height);
 		}
 		glm::ivec2 GetWindowFrameBufferSize() const noexcept
 		{
+			if (HeadlessMode::IsEnabled())
+				return m_headlessDimensions;
 			int width, height;
 			glfwGetFramebufferSize(m_windowHandle, &width, &height);
 			return glm::ivec2(width, height);
 		}
 		void SetWindowDimensions(const glm::ivec2 &dimensions) noexcept
 		{
+			if (HeadlessMode::IsEnabled()) {
+				m_headlessDimensions = dimensions;
+				return;
+			}
 			glfwSetWindowSize(m_windowHandle, dimensions.x, dimensions.y);
 		}
 		GLFWwindow* GetHandle() const {
@@ -139,6 +164,7 @@ namespace Mona {
 		GLFWwindow* m_windowHandle = nullptr;
 		WindowData m_data;
 		glm::ivec2 m_oldWindowPos = glm::vec2(0,0);
+		glm::ivec2 m_headlessDimensions = glm::ivec2(0, 0);
 	};
 
 	Window::Window() : p_Impl(std::make_unique<WindowImplementation>()) {}
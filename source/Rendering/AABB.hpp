@@ -0,0 +1,50 @@
+#pragma once
+#ifndef AABB_HPP
+#define AABB_HPP
+#include <limits>
+#include <glm/glm.hpp>
+namespace Mona {
+	/*
+	* Caja alineada a los ejes. Una caja recien construida esta vacia (min > max), por lo que puede extenderse
+	* directamente con Expand.
+	*/
+	struct AABB {
+		glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 max = glm::vec3(-std::numeric_limits<float>::max());
+		AABB() = default;
+		AABB(const glm::vec3& minPoint, const glm::vec3& maxPoint) : min(minPoint), max(maxPoint) {}
+
+		bool IsValid() const noexcept {
+			return min.x <= max.x && min.y <= max.y && min.z <= max.z;
+		}
+		glm::vec3 GetCenter() const noexcept { return 0.5f * (min + max); }
+		glm::vec3 GetExtents() const noexcept { return 0.5f * (max - min); }
+		float GetSurfaceArea() const noexcept {
+			const glm::vec3 d = max - min;
+			return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+		}
+		void Expand(const glm::vec3& point) noexcept {
+			min = glm::min(min, point);
+			max = glm::max(max, point);
+		}
+		bool Contains(const AABB& other) const noexcept {
+			return glm::all(glm::lessThanEqual(min, other.min)) && glm::all(glm::greaterThanEqual(max, other.max));
+		}
+		static AABB Merge(const AABB& a, const AABB& b) noexcept {
+			return AABB(glm::min(a.min, b.min), glm::max(a.max, b.max));
+		}
+		/*
+		* Caja que contiene a esta luego de ser transformada por una matriz afin. Se transforma el centro y se proyectan
+		* las extensiones sobre los valores absolutos de la parte lineal de la matriz, evitando transformar las ocho esquinas.
+		*/
+		AABB Transform(const glm::mat4& matrix) const noexcept {
+			const glm::vec3 center = glm::vec3(matrix * glm::vec4(GetCenter(), 1.0f));
+			const glm::vec3 extents = GetExtents();
+			const glm::vec3 newExtents = glm::abs(glm::vec3(matrix[0])) * extents.x +
+				glm::abs(glm::vec3(matrix[1])) * extents.y +
+				glm::abs(glm::vec3(matrix[2])) * extents.z;
+			return AABB(center - newExtents, center + newExtents);
+		}
+	};
+}
+#endif
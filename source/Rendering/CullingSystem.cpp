@@ -0,0 +1,120 @@
+#include "CullingSystem.hpp"
+#include "StaticMeshComponent.hpp"
+#include "../Animation/SkeletalMeshComponent.hpp"
+#include "../World/GameObject.hpp"
+namespace Mona {
+
+	void StaticMeshLifetimePolicy::OnAddComponent(GameObject* gameObjectPtr, StaticMeshComponent& staticMesh, const InnerComponentHandle& handle) noexcept {
+		if (m_cullingSystemPtr == nullptr)
+			return;
+		const InnerComponentHandle transformHandle = gameObjectPtr->GetInnerComponentHandle<TransformComponent>();
+		m_cullingSystemPtr->AddRenderable(CullingSystem::RenderableType::StaticMesh, handle, transformHandle,
+			*m_transformDataManagerPtr->GetComponentPointer(transformHandle), staticMesh.GetLocalBoundingBox());
+	}
+
+	void StaticMeshLifetimePolicy::OnRemoveComponent(GameObject* gameObjectPtr, StaticMeshComponent& staticMesh, const InnerComponentHandle& handle) noexcept {
+		if (m_cullingSystemPtr != nullptr)
+			m_cullingSystemPtr->RemoveRenderable(CullingSystem::RenderableType::StaticMesh, handle);
+	}
+
+	void SkeletalMeshLifetimePolicy::OnAddComponent(GameObject* gameObjectPtr, SkeletalMeshComponent& skeletalMesh, const InnerComponentHandle& handle) noexcept {
+		if (m_cullingSystemPtr == nullptr)
+			return;
+		const InnerComponentHandle transformHandle = gameObjectPtr->GetInnerComponentHandle<TransformComponent>();
+		m_cullingSystemPtr->AddRenderable(CullingSystem::RenderableType::SkeletalMesh, handle, transformHandle,
+			*m_transformDataManagerPtr->GetComponentPointer(transformHandle), skeletalMesh.GetLocalBoundingBox());
+	}
+
+	void SkeletalMeshLifetimePolicy::OnRemoveComponent(GameObject* gameObjectPtr, SkeletalMeshComponent& skeletalMesh, const InnerComponentHandle& handle) noexcept {
+		if (m_cullingSystemPtr != nullptr)
+			m_cullingSystemPtr->RemoveRenderable(CullingSystem::RenderableType::SkeletalMesh, handle);
+	}
+
+	void CullingSystem::AddRenderable(RenderableType type, const InnerComponentHandle& renderableHandle,
+		const InnerComponentHandle& transformHandle, const TransformComponent& transform, const AABB& localBox) noexcept
+	{
+		uint32_t entryIndex;
+		if (m_freeEntries.empty()) {
+			entryIndex = static_cast<uint32_t>(m_entries.size());
+			m_entries.emplace_back();
+		}
+		else {
+			entryIndex = m_freeEntries.back();
+			m_freeEntries.pop_back();
+		}
+		Entry& entry = m_entries[entryIndex];
+		entry.renderableHandle = renderableHandle;
+		entry.transformHandle = transformHandle;
+		entry.localBox = localBox;
+		entry.transformVersion = transform.GetVersion();
+		entry.boxVersion = 0;
+		entry.type = type;
+		entry.proxyId = m_tree.CreateProxy(localBox.Transform(transform.GetModelMatrix()), entryIndex);
+		auto& entryIndices = GetEntryIndices(type);
+		if (entryIndices.size() <= renderableHandle.m_index)
+			entryIndices.resize(renderableHandle.m_index + 1, INVALID_INDEX);
+		entryIndices[renderableHandle.m_index] = entryIndex;
+	}
+
+	void CullingSystem::RemoveRenderable(RenderableType type, const InnerComponentHandle& renderableHandle) noexcept {
+		auto& entryIndices = GetEntryIndices(type);
+		if (renderableHandle.m_index >= entryIndices.size() || entryIndices[renderableHandle.m_index] == INVALID_INDEX)
+			return;
+		const uint32_t entryIndex = entryIndices[renderableHandle.m_index];
+		entryIndices[renderableHandle.m_index] = INVALID_INDEX;
+		Entry& entry = m_entries[entryIndex];
+		m_tree.DestroyProxy(entry.proxyId);
+		entry.proxyId = DynamicAABBTree::NullNode;
+		m_freeEntries.push_back(entryIndex);
+	}
+
+	void CullingSystem::UpdateBounds(const ComponentManager<TransformComponent>& transformDataManager,
+		const ComponentManager<SkeletalMeshComponent>& skeletalMeshDataManager) noexcept
+	{
+		for (Entry& entry : m_entries) {
+			if (entry.proxyId == DynamicAABBTree::NullNode)
+				continue;
+			bool boxChanged = false;
+			if (entry.type == RenderableType::SkeletalMesh) {
+				//La caja de una malla con piel sigue a su pose, recalculada por AnimationSystem
+				const SkeletalMeshComponent* skeletalMesh = skeletalMeshDataManager.GetComponentPointer(entry.renderableHandle);
+				if (skeletalMesh->GetBoundingBoxVersion() != entry.boxVersion) {
+					entry.boxVersion = skeletalMesh->GetBoundingBoxVersion();
+					entry.localBox = skeletalMesh->GetLocalBoundingBox();
+					boxChanged = true;
+				}
+			}
+			const TransformComponent* transform = transformDataManager.GetComponentPointer(entry.transformHandle);
+			if (!boxChanged && transform->GetVersion() == entry.transformVersion)
+				continue;
+			entry.transformVersion = transform->GetVersion();
+			m_tree.MoveProxy(entry.proxyId, entry.localBox.Transform(transform->GetModelMatrix()));
+		}
+	}
+
+	void CullingSystem::Cull(const glm::mat4& viewProjection,
+		std::vector<InnerComponentHandle>& outStaticMeshes,
+		std::vector<InnerComponentHandle>& outSkeletalMeshes) const noexcept
+	{
+		outStaticMeshes.clear();
+		outSkeletalMeshes.clear();
+		m_visibleEntries.clear();
+		m_tree.Query(Frustum(viewProjection), m_visibleEntries);
+		for (uint32_t entryIndex : m_visibleEntries) {
+			const Entry& entry = m_entries[entryIndex];
+			if (entry.type == RenderableType::StaticMesh)
+				outStaticMeshes.push_back(entry.renderableHandle);
+			else
+				outSkeletalMeshes.push_back(entry.renderableHandle);
+		}
+	}
+
+	void CullingSystem::Clear() noexcept {
+		m_tree.Clear();
+		m_entries.clear();
+		m_freeEntries.clear();
+		for (auto& entryIndices : m_entryIndicesByHandle)
+			entryIndices.clear();
+	}
+
+}
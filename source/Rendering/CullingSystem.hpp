@@ -0,0 +1,68 @@
+#pragma once
+#ifndef CULLINGSYSTEM_HPP
+#define CULLINGSYSTEM_HPP
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../World/GameObjectTypes.hpp"
+#include "../World/ComponentManager.hpp"
+#include "../World/TransformComponent.hpp"
+#include "../Animation/SkeletalMeshComponent.hpp"
+#include "AABB.hpp"
+#include "Frustum.hpp"
+#include "DynamicAABBTree.hpp"
+namespace Mona {
+	/*
+	* Mantiene un DynamicAABBTree con las cajas en espacio mundo de todas las StaticMeshComponent y SkeletalMeshComponent.
+	* Las entradas se agregan y remueven desde las polizas de vida de dichas componentes, y cada frame solo se recalcula la
+	* caja de aquellas cuya transformacion, o en el caso de las SkeletalMeshComponent su pose, cambio desde la ultima
+	* actualizacion.
+	*/
+	class CullingSystem {
+	public:
+		enum class RenderableType : uint8_t {
+			StaticMesh,
+			SkeletalMesh,
+			RenderableTypeCount
+		};
+		CullingSystem() = default;
+		CullingSystem(const CullingSystem&) = delete;
+		CullingSystem& operator=(const CullingSystem&) = delete;
+		void AddRenderable(RenderableType type, const InnerComponentHandle& renderableHandle,
+			const InnerComponentHandle& transformHandle, const TransformComponent& transform, const AABB& localBox) noexcept;
+		void RemoveRenderable(RenderableType type, const InnerComponentHandle& renderableHandle) noexcept;
+		//Recalcula las cajas de las entradas cuya transformacion o caja local cambio
+		void UpdateBounds(const ComponentManager<TransformComponent>& transformDataManager,
+			const ComponentManager<SkeletalMeshComponent>& skeletalMeshDataManager) noexcept;
+		/*
+		* Llena outStaticMeshes y outSkeletalMeshes con los handles de las componentes cuya caja intersecta el frustum
+		* definido por viewProjection (proyeccion * vista).
+		*/
+		void Cull(const glm::mat4& viewProjection,
+			std::vector<InnerComponentHandle>& outStaticMeshes,
+			std::vector<InnerComponentHandle>& outSkeletalMeshes) const noexcept;
+		uint32_t GetRenderableCount() const noexcept { return m_tree.GetProxyCount(); }
+		void Clear() noexcept;
+	private:
+		struct Entry {
+			InnerComponentHandle renderableHandle;
+			InnerComponentHandle transformHandle;
+			AABB localBox;
+			int32_t proxyId = DynamicAABBTree::NullNode;
+			uint32_t transformVersion = 0;
+			//Version de la caja local, solo usada por las SkeletalMeshComponent
+			uint32_t boxVersion = 0;
+			RenderableType type = RenderableType::StaticMesh;
+		};
+		std::vector<uint32_t>& GetEntryIndices(RenderableType type) noexcept {
+			return m_entryIndicesByHandle[static_cast<size_t>(type)];
+		}
+		DynamicAABBTree m_tree;
+		std::vector<Entry> m_entries;
+		std::vector<uint32_t> m_freeEntries;
+		//Indice de la entrada asociada a cada handle de componente, indexado por InnerComponentHandle::m_index
+		std::vector<uint32_t> m_entryIndicesByHandle[static_cast<size_t>(RenderableType::RenderableTypeCount)];
+		mutable std::vector<uint32_t> m_visibleEntries;
+	};
+}
+#endif
@@ -3,6 +3,7 @@
 #define DIFFUSETEXTUREDMATERIAL_HPP
 #include <memory>
 #include "../Core/Log.hpp"
+#include "../Core/HeadlessMode.hpp"
 #include "Texture.hpp"
 #include "Material.hpp"
 #include <glm/glm.hpp>
@@ -12,6 +13,9 @@ namespace Mona {
 	public:
 
 		DiffuseTexturedMaterial(const ShaderProgram& shaderProgram, bool isForSkinning) : Material(shaderProgram, isForSkinning), m_diffuseTexture(nullptr), m_materialTint(glm::vec3(1.0f)) {
+			//Sin contexto OpenGL el programa es nulo y no hay uniforms que configurar
+			if (HeadlessMode::IsEnabled())
+				return;
 			//Dado que las ubicaiones de las texturas nunca cambian solo se configura al momento de construccin
 			glUseProgram(m_shaderID);
 			glUniform1i(ShaderProgram::DiffuseTextureSamplerShaderLocation, ShaderProgram::DiffuseTextureUnit);
@@ -0,0 +1,238 @@
+#include "DynamicAABBTree.hpp"
+#include <algorithm>
+#include "../Core/Log.hpp"
+namespace Mona {
+
+	DynamicAABBTree::DynamicAABBTree(float margin) noexcept : m_margin(margin) {}
+
+	int32_t DynamicAABBTree::AllocateNode() noexcept {
+		if (m_freeList == NullNode) {
+			m_nodes.emplace_back();
+			m_nodes.back().height = 0;
+			return static_cast<int32_t>(m_nodes.size() - 1);
+		}
+		const int32_t nodeId = m_freeList;
+		m_freeList = m_nodes[nodeId].parent;
+		m_nodes[nodeId] = Node();
+		m_nodes[nodeId].height = 0;
+		return nodeId;
+	}
+
+	void DynamicAABBTree::FreeNode(int32_t nodeId) noexcept {
+		m_nodes[nodeId].parent = m_freeList;
+		m_nodes[nodeId].height = -1;
+		m_freeList = nodeId;
+	}
+
+	int32_t DynamicAABBTree::CreateProxy(const AABB& box, uint32_t userData) noexcept {
+		const int32_t proxyId = AllocateNode();
+		const glm::vec3 margin(m_margin);
+		m_nodes[proxyId].box = AABB(box.min - margin, box.max + margin);
+		m_nodes[proxyId].userData = userData;
+		InsertLeaf(proxyId);
+		m_proxyCount++;
+		return proxyId;
+	}
+
+	void DynamicAABBTree::DestroyProxy(int32_t proxyId) noexcept {
+		MONA_ASSERT(proxyId >= 0 && proxyId < static_cast<int32_t>(m_nodes.size()) && m_nodes[proxyId].IsLeaf(),
+			"DynamicAABBTree Error: Invalid proxy id");
+		RemoveLeaf(proxyId);
+		FreeNode(proxyId);
+		m_proxyCount--;
+	}
+
+	bool DynamicAABBTree::MoveProxy(int32_t proxyId, const AABB& box) noexcept {
+		MONA_ASSERT(proxyId >= 0 && proxyId < static_cast<int32_t>(m_nodes.size()) && m_nodes[proxyId].IsLeaf(),
+			"DynamicAABBTree Error: Invalid proxy id");
+		if (m_nodes[proxyId].box.Contains(box))
+			return false;
+		RemoveLeaf(proxyId);
+		const glm::vec3 margin(m_margin);
+		m_nodes[proxyId].box = AABB(box.min - margin, box.max + margin);
+		InsertLeaf(proxyId);
+		return true;
+	}
+
+	void DynamicAABBTree::InsertLeaf(int32_t leaf) noexcept {
+		if (m_root == NullNode) {
+			m_root = leaf;
+			m_nodes[m_root].parent = NullNode;
+			return;
+		}
+		//Se desciende por el arbol eligiendo el hijo cuyo costo (incremento de area) sea menor
+		const AABB leafBox = m_nodes[leaf].box;
+		int32_t index = m_root;
+		while (!m_nodes[index].IsLeaf()) {
+			const Node& node = m_nodes[index];
+			const float area = node.box.GetSurfaceArea();
+			const float combinedArea = AABB::Merge(node.box, leafBox).GetSurfaceArea();
+			//Costo de crear un nuevo padre para este nodo y la hoja
+			const float cost = 2.0f * combinedArea;
+			//Costo minimo de empujar la hoja mas abajo en el arbol
+			const float inheritanceCost = 2.0f * (combinedArea - area);
+			auto descendCost = [&](int32_t child) {
+				const AABB merged = AABB::Merge(leafBox, m_nodes[child].box);
+				if (m_nodes[child].IsLeaf())
+					return merged.GetSurfaceArea() + inheritanceCost;
+				return merged.GetSurfaceArea() - m_nodes[child].box.GetSurfaceArea() + inheritanceCost;
+			};
+			const float leftCost = descendCost(node.left);
+			const float rightCost = descendCost(node.right);
+			if (cost < leftCost && cost < rightCost)
+				break;
+			index = leftCost < rightCost ? node.left : node.right;
+		}
+
+		const int32_t sibling = index;
+		const int32_t oldParent = m_nodes[sibling].parent;
+		const int32_t newParent = AllocateNode();
+		m_nodes[newParent].parent = oldParent;
+		m_nodes[newParent].box = AABB::Merge(leafBox, m_nodes[sibling].box);
+		m_nodes[newParent].height = m_nodes[sibling].height + 1;
+		m_nodes[newParent].left = sibling;
+		m_nodes[newParent].right = leaf;
+		m_nodes[sibling].parent = newParent;
+		m_nodes[leaf].parent = newParent;
+		if (oldParent == NullNode)
+			m_root = newParent;
+		else if (m_nodes[oldParent].left == sibling)
+			m_nodes[oldParent].left = newParent;
+		else
+			m_nodes[oldParent].right = newParent;
+
+		//Se recorren los ancestros balanceando y actualizando alturas y cajas
+		index = m_nodes[leaf].parent;
+		while (index != NullNode) {
+			index = Balance(index);
+			Node& node = m_nodes[index];
+			node.height = 1 + std::max(m_nodes[node.left].height, m_nodes[node.right].height);
+			node.box = AABB::Merge(m_nodes[node.left].box, m_nodes[node.right].box);
+			index = node.parent;
+		}
+	}
+
+	void DynamicAABBTree::RemoveLeaf(int32_t leaf) noexcept {
+		if (leaf == m_root) {
+			m_root = NullNode;
+			return;
+		}
+		const int32_t parent = m_nodes[leaf].parent;
+		const int32_t grandParent = m_nodes[parent].parent;
+		const int32_t sibling = m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+		if (grandParent == NullNode) {
+			m_root = sibling;
+			m_nodes[sibling].parent = NullNode;
+			FreeNode(parent);
+			return;
+		}
+		//El hermano toma el lugar del padre
+		if (m_nodes[grandParent].left == parent)
+			m_nodes[grandParent].left = sibling;
+		else
+			m_nodes[grandParent].right = sibling;
+		m_nodes[sibling].parent = grandParent;
+		FreeNode(parent);
+
+		int32_t index = grandParent;
+		while (index != NullNode) {
+			index = Balance(index);
+			Node& node = m_nodes[index];
+			node.height = 1 + std::max(m_nodes[node.left].height, m_nodes[node.right].height);
+			node.box = AABB::Merge(m_nodes[node.left].box, m_nodes[node.right].box);
+			index = node.parent;
+		}
+	}
+
+	int32_t DynamicAABBTree::Balance(int32_t a) noexcept {
+		//Si el subarbol de a esta desbalanceado se rota el hijo mas alto hacia arriba, retorna la nueva raiz del subarbol
+		Node& nodeA = m_nodes[a];
+		if (nodeA.IsLeaf() || nodeA.height < 2)
+			return a;
+		const int32_t b = nodeA.left;
+		const int32_t c = nodeA.right;
+		const int32_t balance = m_nodes[c].height - m_nodes[b].height;
+		if (balance > 1 || balance < -1) {
+			//up es el hijo que sube, down el que se mantiene como hijo de a
+			const int32_t up = balance > 1 ? c : b;
+			const int32_t down = balance > 1 ? b : c;
+			Node& nodeUp = m_nodes[up];
+			const int32_t f = nodeUp.left;
+			const int32_t g = nodeUp.right;
+			//up reemplaza a a en el arbol
+			nodeUp.left = a;
+			nodeUp.parent = nodeA.parent;
+			nodeA.parent = up;
+			if (nodeUp.parent == NullNode)
+				m_root = up;
+			else if (m_nodes[nodeUp.parent].left == a)
+				m_nodes[nodeUp.parent].left = up;
+			else
+				m_nodes[nodeUp.parent].right = up;
+			//El nieto mas alto queda como hijo de up y el otro pasa a a
+			const bool keepF = m_nodes[f].height > m_nodes[g].height;
+			const int32_t kept = keepF ? f : g;
+			const int32_t moved = keepF ? g : f;
+			nodeUp.right = kept;
+			if (balance > 1) {
+				nodeA.left = down;
+				nodeA.right = moved;
+			}
+			else {
+				nodeA.left = moved;
+				nodeA.right = down;
+			}
+			m_nodes[moved].parent = a;
+			nodeA.box = AABB::Merge(m_nodes[nodeA.left].box, m_nodes[nodeA.right].box);
+			nodeA.height = 1 + std::max(m_nodes[nodeA.left].height, m_nodes[nodeA.right].height);
+			nodeUp.box = AABB::Merge(nodeA.box, m_nodes[kept].box);
+			nodeUp.height = 1 + std::max(nodeA.height, m_nodes[kept].height);
+			return up;
+		}
+		return a;
+	}
+
+	void DynamicAABBTree::CollectLeaves(int32_t nodeId, std::vector<uint32_t>& outUserData) const noexcept {
+		const Node& node = m_nodes[nodeId];
+		if (node.IsLeaf()) {
+			outUserData.push_back(node.userData);
+			return;
+		}
+		CollectLeaves(node.left, outUserData);
+		CollectLeaves(node.right, outUserData);
+	}
+
+	void DynamicAABBTree::Query(const Frustum& frustum, std::vector<uint32_t>& outUserData) const noexcept {
+		if (m_root == NullNode)
+			return;
+		std::vector<int32_t>& stack = m_queryStack;
+		stack.clear();
+		stack.push_back(m_root);
+		while (!stack.empty()) {
+			const int32_t nodeId = stack.back();
+			stack.pop_back();
+			const Node& node = m_nodes[nodeId];
+			if (!frustum.Intersects(node.box))
+				continue;
+			if (node.IsLeaf()) {
+				outUserData.push_back(node.userData);
+			}
+			else if (frustum.Contains(node.box)) {
+				//Todo el subarbol es visible, no es necesario seguir probando contra los planos
+				CollectLeaves(nodeId, outUserData);
+			}
+			else {
+				stack.push_back(node.left);
+				stack.push_back(node.right);
+			}
+		}
+	}
+
+	void DynamicAABBTree::Clear() noexcept {
+		m_nodes.clear();
+		m_root = NullNode;
+		m_freeList = NullNode;
+		m_proxyCount = 0;
+	}
+
+}
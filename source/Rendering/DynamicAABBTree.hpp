@@ -0,0 +1,58 @@
+#pragma once
+#ifndef DYNAMICAABBTREE_HPP
+#define DYNAMICAABBTREE_HPP
+#include <cstdint>
+#include <vector>
+#include "AABB.hpp"
+#include "Frustum.hpp"
+namespace Mona {
+	/*
+	* Arbol dinamico de cajas alineadas a los ejes (BVH incremental). Cada hoja guarda una caja engordada por un margen,
+	* de modo que mientras el objeto se mueva dentro de ella no es necesario modificar el arbol. Las inserciones eligen el
+	* hermano que minimiza el incremento de area y el arbol se mantiene balanceado con rotaciones.
+	* Es codigo exclusivamente de CPU, por lo que puede usarse sin contexto OpenGL.
+	*/
+	class DynamicAABBTree {
+	public:
+		static constexpr int32_t NullNode = -1;
+		DynamicAABBTree(float margin = 0.1f) noexcept;
+		//Agrega una hoja y retorna su id, el cual se mantiene estable hasta que la hoja sea destruida
+		int32_t CreateProxy(const AABB& box, uint32_t userData) noexcept;
+		void DestroyProxy(int32_t proxyId) noexcept;
+		//Actualiza la caja de una hoja, retorna verdadero si fue necesario reinsertarla
+		bool MoveProxy(int32_t proxyId, const AABB& box) noexcept;
+		uint32_t GetUserData(int32_t proxyId) const noexcept { return m_nodes[proxyId].userData; }
+		const AABB& GetFatAABB(int32_t proxyId) const noexcept { return m_nodes[proxyId].box; }
+		//Agrega a outUserData los datos de todas las hojas cuya caja intersecta el frustum
+		void Query(const Frustum& frustum, std::vector<uint32_t>& outUserData) const noexcept;
+		void Clear() noexcept;
+		uint32_t GetProxyCount() const noexcept { return m_proxyCount; }
+		int32_t GetHeight() const noexcept { return m_root == NullNode ? 0 : m_nodes[m_root].height; }
+	private:
+		struct Node {
+			AABB box;
+			int32_t parent = NullNode;
+			int32_t left = NullNode;
+			int32_t right = NullNode;
+			//Altura del subarbol, -1 indica un nodo libre. En nodos libres parent se usa como siguiente nodo libre
+			int32_t height = -1;
+			uint32_t userData = 0;
+			bool IsLeaf() const noexcept { return left == NullNode; }
+		};
+		int32_t AllocateNode() noexcept;
+		void FreeNode(int32_t nodeId) noexcept;
+		void InsertLeaf(int32_t leaf) noexcept;
+		void RemoveLeaf(int32_t leaf) noexcept;
+		int32_t Balance(int32_t nodeId) noexcept;
+		void CollectLeaves(int32_t nodeId, std::vector<uint32_t>& outUserData) const noexcept;
+
+		std::vector<Node> m_nodes;
+		//Pila reutilizada entre consultas para no reservar memoria cada frame
+		mutable std::vector<int32_t> m_queryStack;
+		int32_t m_root = NullNode;
+		int32_t m_freeList = NullNode;
+		uint32_t m_proxyCount = 0;
+		float m_margin;
+	};
+}
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+#ifndef FRUSTUM_HPP
+#define FRUSTUM_HPP
+#include <array>
+#include <glm/glm.hpp>
+#include "AABB.hpp"
+namespace Mona {
+	/*
+	* Frustum de vision representado por seis planos con normales apuntando hacia el interior. Los planos se extraen
+	* directamente de las filas de la matriz proyeccion * vista (metodo de Gribb y Hartmann), con clip space de OpenGL.
+	*/
+	class Frustum {
+	public:
+		Frustum() = default;
+		Frustum(const glm::mat4& viewProjection) noexcept {
+			//glm guarda las matrices por columnas, row(i) es la fila i de viewProjection
+			auto row = [&viewProjection](int i) {
+				return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+			};
+			m_planes[0] = row(3) + row(0); //Izquierdo
+			m_planes[1] = row(3) - row(0); //Derecho
+			m_planes[2] = row(3) + row(1); //Inferior
+			m_planes[3] = row(3) - row(1); //Superior
+			m_planes[4] = row(3) + row(2); //Cercano
+			m_planes[5] = row(3) - row(2); //Lejano
+			for (auto& plane : m_planes)
+				plane /= glm::length(glm::vec3(plane));
+		}
+		/*
+		* Test conservador: retorna falso solo si la caja esta completamente detras de alguno de los planos.
+		*/
+		bool Intersects(const AABB& box) const noexcept {
+			const glm::vec3 center = box.GetCenter();
+			const glm::vec3 extents = box.GetExtents();
+			for (const auto& plane : m_planes) {
+				const glm::vec3 normal = glm::vec3(plane);
+				const float radius = glm::dot(extents, glm::abs(normal));
+				if (glm::dot(normal, center) + plane.w < -radius)
+					return false;
+			}
+			return true;
+		}
+		//Retorna verdadero si la caja esta completamente dentro del frustum
+		bool Contains(const AABB& box) const noexcept {
+			const glm::vec3 center = box.GetCenter();
+			const glm::vec3 extents = box.GetExtents();
+			for (const auto& plane : m_planes) {
+				const glm::vec3 normal = glm::vec3(plane);
+				const float radius = glm::dot(extents, glm::abs(normal));
+				if (glm::dot(normal, center) + plane.w < radius)
+					return false;
+			}
+			return true;
+		}
+	private:
+		std::array<glm::vec4, 6> m_planes;
+	};
+}
+#endif
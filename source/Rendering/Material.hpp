@@ -27,16 +27,24 @@ namespace Mona {
 
 			//Se Configura la informacin compartida por todos los materiales (Matrices y posicion camara).
 			glUseProgram(m_shaderID);
-			const glm::mat4 mvpMatrix = perspectiveMatrix * viewMatrix * modelMatrix;
+			SetMatrixUniforms(perspectiveMatrix * viewMatrix, modelMatrix);
+			//Llamado a funcin virtual que implemental los materiales.
+			SetMaterialUniforms(cameraPosition);
+		}
+		/*
+		* Configura solo las matrices de un objeto, asume que el programa de este material ya esta en uso.
+		* Usado por el Renderer para no repetir glUseProgram ni las uniformes del material entre objetos que las comparten.
+		*/
+		void SetMatrixUniforms(const glm::mat4& viewProjectionMatrix, const glm::mat4& modelMatrix) {
+			const glm::mat4 mvpMatrix = viewProjectionMatrix * modelMatrix;
 			const glm::mat4 modelInverseTransposeMatrix = glm::transpose(glm::inverse(modelMatrix));
 			glUniformMatrix4fv(ShaderProgram::MvpMatrixShaderLocation, 1, GL_FALSE, glm::value_ptr(mvpMatrix));
 			glUniformMatrix4fv(ShaderProgram::ModelMatrixShaderLocation, 1, GL_FALSE, glm::value_ptr(modelMatrix));
 			glUniformMatrix4fv(ShaderProgram::ModelInverseTransposeMatrixShaderLocation, 1, GL_FALSE, glm::value_ptr(modelInverseTransposeMatrix));
-			//Llamado a funcin virtual que implemental los materiales.
-			SetMaterialUniforms(cameraPosition);
 		}
 		virtual void SetMaterialUniforms(const glm::vec3& cameraPosition) = 0;
 		bool IsForSkinning() const { return m_isForSkinning; }
+		uint32_t GetShaderID() const { return m_shaderID; }
 	protected:
 		bool m_isForSkinning;
 		uint32_t m_shaderID;
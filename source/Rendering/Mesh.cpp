@@ -1,7 +1,9 @@
 #include "Mesh.hpp"
 
 #include "../Core/Log.hpp"
+#include "../Core/HeadlessMode.hpp"
 #include "../Core/AssimpTransformations.hpp"
+#include "../Core/AssetCache.hpp"
 #include <glm/glm.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
@@ -24,6 +26,8 @@ namespace Mona {
 			ClearData();
 	}
 	void Mesh::ClearData() noexcept {
+		if (HeadlessMode::IsEnabled())
+			return;
 		MONA_ASSERT(m_vertexArrayID, "Mesh Error: Trying to delete already deleted mesh");
 		MONA_ASSERT(m_vertexBufferID, "Mesh Error: Trying to delete already deleted mesh");
 		MONA_ASSERT(m_indexBufferID, "Mesh Error: Trying to delete already deleted mesh");
@@ -33,27 +37,83 @@ namespace Mona {
 		m_vertexArrayID = 0;
 	}
 
+	struct Mesh::ImportedData {
+		std::vector<MeshVertex> vertices;
+		std::vector<unsigned int> faces;
+		AABB boundingBox;
+	};
+
 	Mesh::Mesh(const std::string& filePath, bool flipUVs) :
 		m_vertexArrayID(0),
 		m_vertexBufferID(0),
 		m_indexBufferID(0),
 		m_indexBufferCount(0)
 	{
-		Assimp::Importer importer;
+		//Si existe una cache valida para este archivo y estas opciones de importacion se evita por completo a assimp
+		const AssetCache::Key cacheKey = GetCacheKey(filePath, flipUVs);
+		const std::string cachePath = AssetCache::GetCachePath(filePath, AssetCache::AssetType::Mesh);
+		if (cacheKey.sourceHash != 0 && LoadFromCache(cachePath, cacheKey))
+			return;
+		ImportedData data;
+		if (!ImportWithAssimp(filePath, cacheKey, data))
+			return;
+		m_boundingBox = data.boundingBox;
+		SetUpBuffers(data.vertices.data(), data.vertices.size(), data.faces.data(), data.faces.size());
+	}
+
+	Mesh::Mesh(const ImportedData* data) :
+		m_vertexArrayID(0),
+		m_vertexBufferID(0),
+		m_indexBufferID(0),
+		m_indexBufferCount(0)
+	{
+		if (!data)
+			return;
+		m_boundingBox = data->boundingBox;
+		SetUpBuffers(data->vertices.data(), data->vertices.size(), data->faces.data(), data->faces.size());
+	}
+
+	AssetCache::Key Mesh::GetCacheKey(const std::string& filePath, bool flipUVs) noexcept {
 		unsigned int postProcessFlags = flipUVs ? aiProcess_FlipUVs : 0;
 		postProcessFlags |= aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_GenUVCoords | aiProcess_CalcTangentSpace;
-		const aiScene* scene = importer.ReadFile(filePath, postProcessFlags);
+		AssetCache::Key cacheKey = { AssetCache::AssetType::Mesh, postProcessFlags };
+		//Un hash nulo indica que la cache no debe usarse
+		if (AssetCache::IsEnabled())
+			cacheKey.sourceHash = AssetCache::HashFile(filePath);
+		return cacheKey;
+	}
+
+	std::shared_ptr<Mesh::ImportedData> Mesh::Import(const std::string& filePath, bool flipUVs) noexcept {
+		const AssetCache::Key cacheKey = GetCacheKey(filePath, flipUVs);
+		std::shared_ptr<ImportedData> data = std::make_shared<ImportedData>();
+		if (cacheKey.sourceHash != 0) {
+			AssetCacheReader reader(AssetCache::GetCachePath(filePath, AssetCache::AssetType::Mesh), cacheKey);
+			reader.Read(data->boundingBox);
+			reader.ReadArray(data->vertices);
+			reader.ReadArray(data->faces);
+			if (reader.IsValid())
+				return data;
+			*data = ImportedData();
+		}
+		if (!ImportWithAssimp(filePath, cacheKey, *data))
+			return nullptr;
+		return data;
+	}
+
+	bool Mesh::ImportWithAssimp(const std::string& filePath, const AssetCache::Key& cacheKey, ImportedData& outData) noexcept {
+		Assimp::Importer importer;
+		const aiScene* scene = importer.ReadFile(filePath, cacheKey.importFlags);
 
 
 
 		if (!scene) {
 			//En caso de fallar la carga se envia un mensaje de error.
 			MONA_LOG_ERROR("Mesh Error: Failed to open file with path {0}", filePath);
-			return;
+			return false;
 		}
 
-		std::vector<MeshVertex> vertices;
-		std::vector<unsigned int> faces;
+		std::vector<MeshVertex>& vertices = outData.vertices;
+		std::vector<unsigned int>& faces = outData.faces;
 		size_t numVertices = 0;
 		size_t numFaces = 0;
 		//El primer paso consiste en contar el numero de vertices y caras totales
@@ -98,6 +158,7 @@ namespace Mona {
 
 					MeshVertex vertex;
 					vertex.position = AssimpToGlmVec3(position);
+					outData.boundingBox.Expand(vertex.position);
 					vertex.normal = AssimpToGlmVec3(normal);
 					vertex.tangent = AssimpToGlmVec3(tangent);
 					vertex.bitangent = AssimpToGlmVec3(bitangent);
@@ -131,17 +192,48 @@ namespace Mona {
 			}
 		}
 
+		if (cacheKey.sourceHash != 0) {
+			const std::string cachePath = AssetCache::GetCachePath(filePath, AssetCache::AssetType::Mesh);
+			AssetCacheWriter writer(cacheKey);
+			writer.Write(outData.boundingBox);
+			writer.WriteArray(vertices);
+			writer.WriteArray(faces);
+			if (!writer.Save(cachePath))
+				MONA_LOG_WARNING("Mesh Warning: Failed to write cache file {0}", cachePath);
+		}
+		return true;
+	}
+
+	bool Mesh::LoadFromCache(const std::string& cachePath, const AssetCache::Key& key) noexcept {
+		AssetCacheReader reader(cachePath, key);
+		AABB boundingBox;
+		uint64_t vertexCount = 0;
+		uint64_t indexCount = 0;
+		reader.Read(boundingBox);
+		const MeshVertex* vertices = reader.ReadArray<MeshVertex>(vertexCount);
+		const unsigned int* indices = reader.ReadArray<unsigned int>(indexCount);
+		if (!reader.IsValid())
+			return false;
+		m_boundingBox = boundingBox;
+		//Los datos se suben directamente desde la memoria mapeada, sin copias intermedias
+		SetUpBuffers(vertices, vertexCount, indices, indexCount);
+		return true;
+	}
+
+	void Mesh::SetUpBuffers(const MeshVertex* vertices, uint64_t vertexCount, const unsigned int* indices, uint64_t indexCount) noexcept {
 		//Comienza el paso de los datos en CPU a GPU usando OpenGL
-		m_indexBufferCount = static_cast<uint32_t>(faces.size());
+		m_indexBufferCount = static_cast<uint32_t>(indexCount);
+		if (HeadlessMode::IsEnabled())
+			return;
 		glGenVertexArrays(1, &m_vertexArrayID);
 		glBindVertexArray(m_vertexArrayID);
 
 		glGenBuffers(1, &m_vertexBufferID);
 		glGenBuffers(1, &m_indexBufferID);
 		glBindBuffer(GL_ARRAY_BUFFER, m_vertexBufferID);
-		glBufferData(GL_ARRAY_BUFFER, static_cast<unsigned int>(vertices.size()) * sizeof(MeshVertex), vertices.data(), GL_STATIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, static_cast<unsigned int>(vertexCount) * sizeof(MeshVertex), vertices, GL_STATIC_DRAW);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBufferID);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<unsigned int>(faces.size()) * sizeof(unsigned int), faces.data(), GL_STATIC_DRAW);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<unsigned int>(indexCount) * sizeof(unsigned int), indices, GL_STATIC_DRAW);
 		//Un vertice de la malla se ve como
 		// v = {pos_x, pos_y, pos_z, normal_x, normal_y, normal_z, uv_u, uv_v, tangent_x, tangent_y, tangent_z}
 		glEnableVertexAttribArray(0);
@@ -163,6 +255,12 @@ namespace Mona {
 		m_indexBufferID(0),
 		m_indexBufferCount(0)
 	{
+		//Todas las primitivas estan contenidas en el cubo [-1, 1]^3 (el plano tiene z = 0)
+		m_boundingBox = type == PrimitiveType::Plane ?
+			AABB(glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec3(1.0f, 1.0f, 0.0f)) : AABB(glm::vec3(-1.0f), glm::vec3(1.0f));
+		//Las primitivas no tienen datos relevantes en CPU, sin contexto OpenGL la malla queda vacia
+		if (HeadlessMode::IsEnabled())
+			return;
 		switch (type)
 		{
 		case Mona::Mesh::PrimitiveType::Plane:
@@ -242,13 +340,15 @@ namespace Mona {
 		size_t numVertices = 0;
 		size_t numFaces = 0;
 
-		float stepX = (maxXY[0] - minXY[0]) / (numInnerVerticesWidth + 1);
-		float stepY = (maxXY[1] - minXY[1]) / (numInnerVerticesHeight + 1);
+		//El mapa de alturas evalua heightFunc una vez por vertice y la malla usa esos mismos valores
+		m_heightMap = HeightMap({ minXY[0], minXY[1] }, { maxXY[0], maxXY[1] },
+			numInnerVerticesWidth + 2, numInnerVerticesHeight + 2, heightFunc);
 		for (int i = 0; i < numInnerVerticesWidth + 2; i++) {
-			float x = minXY[0] + stepX * i;
 			for (int j = 0; j < numInnerVerticesHeight + 2; j++) {
-				float y = minXY[1] + stepY * j;
-				float z = heightFunc(x, y);
+				glm::vec2 xy = m_heightMap.getVertexXY(i, j);
+				float x = xy[0];
+				float y = xy[1];
+				float z = m_heightMap.getVertexHeight(i, j);
 				numVertices += 1;
 				vertices.insert(vertices.end(), { x, y, z, 0, 0, 0, 0, 0, 0, 0, 0 }); // falta rellenar valores
 			}
@@ -282,6 +382,7 @@ namespace Mona {
 		for (int i = 0; i < vertices.size(); i += 11) {
 			glm::vec3 v(vertices[i], vertices[i + 1], vertices[i + 2]);
 			vertexPositions.push_back(v);
+			m_boundingBox.Expand(v);
 		}
 		for (int i = 0; i < faces.size(); i += 3) {
 			glm::vec3 v1 = vertexPositions[faces[i]];
@@ -330,10 +431,10 @@ namespace Mona {
 			vertices[i + 10] = tangent[2];
 		}
 
-		m_heightMap = HeightMap({ minXY[0], minXY[1] }, { maxXY[0], maxXY[1] }, heightFunc);
-
 		//Comienza el paso de los datos en CPU a GPU usando OpenGL
 		m_indexBufferCount = static_cast<uint32_t>(faces.size());
+		if (HeadlessMode::IsEnabled())
+			return;
 		glGenVertexArrays(1, &m_vertexArrayID);
 		glBindVertexArray(m_vertexArrayID);
 
@@ -3,10 +3,14 @@
 #define MESH_HPP
 #include <cstdint>
 #include <string>
+#include <memory>
 #include <glm/glm.hpp>
 #include "../CharacterNavigation/HeightMap.hpp"
+#include "AABB.hpp"
+#include "../Core/AssetCache.hpp"
 
 namespace Mona {
+	struct MeshVertex;
 	class Mesh {
 		friend class MeshManager;
 
@@ -23,13 +27,28 @@ namespace Mona {
 		HeightMap* GetHeightMap() {
 			return &m_heightMap;
 		}
+		//Caja en espacio local que contiene todos los vertices de la malla
+		const AABB& GetBoundingBox() const noexcept { return m_boundingBox; }
 	private:
+		struct ImportedData;
 		Mesh(const std::string& filePath, bool flipUVs = false);
+		//Sube a la GPU datos obtenidos con Import, un puntero nulo construye una malla vacia
+		Mesh(const ImportedData* data);
 		Mesh(PrimitiveType type);
 		Mesh(const glm::vec2& minXY, const glm::vec2& maxXY, int numInnerVerticesWidth, int numInnerVerticesHeight,
 			float (*heightFunc)(float, float));
 
 		void ClearData() noexcept;
+		/*
+		* Lee el archivo (desde la cache o con assimp) y procesa sus vertices sin usar OpenGL, por lo que puede llamarse
+		* desde un hilo de carga. Retorna nullptr si el archivo no pudo importarse.
+		*/
+		static std::shared_ptr<ImportedData> Import(const std::string& filePath, bool flipUVs) noexcept;
+		static AssetCache::Key GetCacheKey(const std::string& filePath, bool flipUVs) noexcept;
+		static bool ImportWithAssimp(const std::string& filePath, const AssetCache::Key& cacheKey, ImportedData& outData) noexcept;
+		//Carga los vertices, indices y caja de la malla desde un archivo de cache, retorna false si este no es valido
+		bool LoadFromCache(const std::string& cachePath, const AssetCache::Key& key) noexcept;
+		void SetUpBuffers(const MeshVertex* vertices, uint64_t vertexCount, const unsigned int* indices, uint64_t indexCount) noexcept;
 		void CreateSphere() noexcept;
 		void CreateCube() noexcept;
 		void CreatePlane() noexcept;
@@ -39,6 +58,7 @@ namespace Mona {
 		uint32_t m_indexBufferID;
 		uint32_t m_indexBufferCount;
 		HeightMap m_heightMap;
+		AABB m_boundingBox;
 	};
 }
 #endif
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "MeshManager.hpp"
 #include "../Animation/SkinnedMesh.hpp"
+#include "../Core/Log.hpp"
 namespace Mona {
 	
 	std::string PrimitiveEnumToString(Mesh::PrimitiveType type) {
@@ -55,6 +56,12 @@ namespace Mona {
 		if (it != m_meshMap.end()) {
 			return it->second;
 		}
+		//Si la malla esta siendo cargada de forma asincrona se espera a que termine en vez de importarla de nuevo
+		auto pendingIt = m_pendingMeshMap.find(stringPath);
+		if (pendingIt != m_pendingMeshMap.end()) {
+			AssetFuture<Mesh> future = pendingIt->second;
+			return future.Wait();
+		}
 		Mesh* meshPtr = new Mesh(stringPath, flipUVs);
 		std::shared_ptr<Mesh> sharedPtr = std::shared_ptr<Mesh>(meshPtr);
 		//Antes de retornar la malla recien cargada, insertamos esta al mapa para que cargas futuras sean mucho mas rapidas.
@@ -116,6 +123,11 @@ namespace Mona {
 		if (it != m_skinnedMeshMap.end()) {
 			return it->second;
 		}
+		auto pendingIt = m_pendingSkinnedMeshMap.find(stringPath);
+		if (pendingIt != m_pendingSkinnedMeshMap.end()) {
+			AssetFuture<SkinnedMesh> future = pendingIt->second;
+			return future.Wait();
+		}
 		SkinnedMesh* meshPtr = new SkinnedMesh(skeleton, stringPath, flipUVs);
 		std::shared_ptr<SkinnedMesh> sharedPtr = std::shared_ptr<SkinnedMesh>(meshPtr);
 		//Antes de retornar la malla recien cargada, insertamos esta al mapa para que cargas futuras sean mucho mas rapidas.
@@ -123,4 +135,59 @@ namespace Mona {
 		return sharedPtr;
 
 	}
+
+	AssetFuture<Mesh> MeshManager::LoadMeshAsync(const std::filesystem::path& filePath, bool flipUVs) noexcept {
+		const std::string stringPath = filePath.string();
+		auto it = m_meshMap.find(stringPath);
+		if (it != m_meshMap.end()) {
+			return AssetFuture<Mesh>(it->second);
+		}
+		auto pendingIt = m_pendingMeshMap.find(stringPath);
+		if (pendingIt != m_pendingMeshMap.end()) {
+			return pendingIt->second;
+		}
+		AssetPromise<Mesh> promise;
+		m_pendingMeshMap.insert({ stringPath, promise.GetFuture() });
+		AsyncAssetLoader& loader = AsyncAssetLoader::GetInstance();
+		loader.RunOnLoaderThread([this, &loader, stringPath, flipUVs, promise]() {
+			std::shared_ptr<Mesh::ImportedData> data = Mesh::Import(stringPath, flipUVs);
+			//Los mapas del manager solo se modifican desde el hilo principal
+			loader.RunOnMainThread([this, stringPath, data, promise]() {
+				std::shared_ptr<Mesh> sharedPtr = std::shared_ptr<Mesh>(new Mesh(data.get()));
+				m_meshMap.insert({ stringPath, sharedPtr });
+				m_pendingMeshMap.erase(stringPath);
+				promise.SetValue(sharedPtr);
+			});
+		});
+		return promise.GetFuture();
+	}
+
+	AssetFuture<SkinnedMesh> MeshManager::LoadSkinnedMeshAsync(std::shared_ptr<Skeleton> skeleton,
+		const std::filesystem::path& filePath,
+		bool flipUVs) noexcept
+	{
+		MONA_ASSERT(skeleton != nullptr, "MeshManager Error: Skeleton cannot be null");
+		const std::string stringPath = filePath.string();
+		auto it = m_skinnedMeshMap.find(stringPath);
+		if (it != m_skinnedMeshMap.end()) {
+			return AssetFuture<SkinnedMesh>(it->second);
+		}
+		auto pendingIt = m_pendingSkinnedMeshMap.find(stringPath);
+		if (pendingIt != m_pendingSkinnedMeshMap.end()) {
+			return pendingIt->second;
+		}
+		AssetPromise<SkinnedMesh> promise;
+		m_pendingSkinnedMeshMap.insert({ stringPath, promise.GetFuture() });
+		AsyncAssetLoader& loader = AsyncAssetLoader::GetInstance();
+		loader.RunOnLoaderThread([this, &loader, skeleton, stringPath, flipUVs, promise]() {
+			std::shared_ptr<SkinnedMesh::ImportedData> data = SkinnedMesh::Import(*skeleton, stringPath, flipUVs);
+			loader.RunOnMainThread([this, skeleton, stringPath, data, promise]() {
+				std::shared_ptr<SkinnedMesh> sharedPtr = std::shared_ptr<SkinnedMesh>(new SkinnedMesh(skeleton, data.get()));
+				m_skinnedMeshMap.insert({ stringPath, sharedPtr });
+				m_pendingSkinnedMeshMap.erase(stringPath);
+				promise.SetValue(sharedPtr);
+			});
+		});
+		return promise.GetFuture();
+	}
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <filesystem>
 #include <unordered_map>
 #include "Mesh.hpp"
+#include "../Core/AssetFuture.hpp"
 namespace Mona {
 
 	class SkinnedMesh;
@@ -23,6 +24,15 @@ namespace Mona {
 		std::shared_ptr<SkinnedMesh> LoadSkinnedMesh(std::shared_ptr<Skeleton> skeleton,
 			const std::filesystem::path& filePath,
 			bool flipUVs = false) noexcept;
+		/*
+		* Variantes asincronas de LoadMesh y LoadSkinnedMesh. La importacion se realiza en un hilo de carga y la subida a la
+		* GPU en el hilo principal al inicio de algun frame posterior. Cargas repetidas de un mismo archivo comparten el
+		* mismo futuro, y una llamada sincrona sobre un archivo en carga espera a que esta termine.
+		*/
+		AssetFuture<Mesh> LoadMeshAsync(const std::filesystem::path& filePath, bool flipUVs = false) noexcept;
+		AssetFuture<SkinnedMesh> LoadSkinnedMeshAsync(std::shared_ptr<Skeleton> skeleton,
+			const std::filesystem::path& filePath,
+			bool flipUVs = false) noexcept;
 		void CleanUnusedMeshes() noexcept;
 		static MeshManager& GetInstance() noexcept{
 			static MeshManager instance;
@@ -33,6 +43,8 @@ namespace Mona {
 		void ShutDown() noexcept;
 		MeshMap m_meshMap;
 		SkinnedMeshMap m_skinnedMeshMap;
+		std::unordered_map<std::string, AssetFuture<Mesh>> m_pendingMeshMap;
+		std::unordered_map<std::string, AssetFuture<SkinnedMesh>> m_pendingSkinnedMeshMap;
 
 	};
 }
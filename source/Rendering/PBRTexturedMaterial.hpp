@@ -5,6 +5,7 @@
 #include "Texture.hpp"
 #include "Material.hpp"
 #include "../Core/Log.hpp"
+#include "../Core/HeadlessMode.hpp"
 #include <glm/glm.hpp>
 
 namespace Mona {
@@ -18,6 +19,9 @@ namespace Mona {
 			m_roughnessTexture(nullptr),
 			m_ambientOcclusionTexture(nullptr),
 			m_materialTint(glm::vec3(1.0f)) {
+			//Sin contexto OpenGL el programa es nulo y no hay uniforms que configurar
+			if (HeadlessMode::IsEnabled())
+				return;
 			//Dado que las ubicaiones de las texturas nunca cambian solo se configura al momento de construccin
 			glUseProgram(m_shaderID);
 			glUniform1i(ShaderProgram::AlbedoTextureSamplerShaderLocation, ShaderProgram::AlbedoTextureUnit);
@@ -0,0 +1,135 @@
+#include "RenderQueue.hpp"
+#include <algorithm>
+#include <array>
+namespace Mona {
+
+	void RenderQueue::Begin(float maxDepth) noexcept {
+		m_items.clear();
+		m_sortedEntries.clear();
+		m_batches.clear();
+		m_instanceData.clear();
+		m_maxDepth = maxDepth > 0.0f ? maxDepth : 1.0f;
+		m_frame++;
+		ReleaseUnusedIDs(m_programIDs);
+		ReleaseUnusedIDs(m_materialIDs);
+		ReleaseUnusedIDs(m_vertexArrayIDs);
+	}
+
+	void RenderQueue::ReleaseUnusedIDs(DenseIDMap& map) noexcept {
+		//Solo se conservan los valores usados en el frame anterior, los identificadores del resto se reciclan
+		for (auto it = map.ids.begin(); it != map.ids.end();) {
+			if (it->second.frame + 1 < m_frame) {
+				map.freeIDs.push_back(it->second.id);
+				it = map.ids.erase(it);
+			}
+			else
+				++it;
+		}
+	}
+
+	uint32_t RenderQueue::GetDenseID(DenseIDMap& map, uint64_t value, int bits) noexcept {
+		auto it = map.ids.find(value);
+		if (it != map.ids.end()) {
+			it->second.frame = m_frame;
+			return it->second.id;
+		}
+		//El ultimo identificador se reserva para los valores que no alcanzan a recibir uno propio en este frame
+		const uint32_t overflowID = (1u << bits) - 1;
+		uint32_t id;
+		if (!map.freeIDs.empty()) {
+			id = map.freeIDs.back();
+			map.freeIDs.pop_back();
+		}
+		else if (map.nextID < overflowID)
+			id = map.nextID++;
+		else
+			return overflowID;
+		map.ids.emplace(value, DenseID{ id, m_frame });
+		return id;
+	}
+
+	uint64_t RenderQueue::ComputeKey(const Item& item, float depth) noexcept {
+		const uint64_t type = static_cast<uint64_t>(item.type);
+		const uint64_t program = GetDenseID(m_programIDs, item.programID, ProgramBits);
+		const uint64_t material = GetDenseID(m_materialIDs, reinterpret_cast<uint64_t>(item.material), MaterialBits);
+		const uint64_t vertexArray = GetDenseID(m_vertexArrayIDs, item.vertexArrayID, VertexArrayBits);
+		//Dentro de un mismo grupo de estado se dibuja de adelante hacia atras para aprovechar el test de profundidad
+		const float normalizedDepth = std::clamp(depth / m_maxDepth, 0.0f, 1.0f);
+		const uint64_t quantizedDepth = static_cast<uint64_t>(normalizedDepth * static_cast<float>((1u << DepthBits) - 1));
+		uint64_t key = type;
+		key = (key << ProgramBits) | program;
+		key = (key << MaterialBits) | material;
+		key = (key << VertexArrayBits) | vertexArray;
+		key = (key << DepthBits) | quantizedDepth;
+		return key;
+	}
+
+	void RenderQueue::Push(const Item& item, float depth) noexcept {
+		m_sortedEntries.push_back({ ComputeKey(item, depth), static_cast<uint32_t>(m_items.size()) });
+		m_items.push_back(item);
+	}
+
+	void RenderQueue::Sort() noexcept {
+		//Radix sort LSD de 8 bits por pasada, las pasadas en que todas las llaves comparten el mismo byte se omiten
+		const size_t count = m_sortedEntries.size();
+		if (count < 2)
+			return;
+		m_sortBuffer.resize(count);
+		std::vector<Entry>* source = &m_sortedEntries;
+		std::vector<Entry>* destination = &m_sortBuffer;
+		for (int shift = 0; shift < 64; shift += 8) {
+			std::array<uint32_t, 256> histogram = {};
+			for (const Entry& entry : *source)
+				histogram[(entry.key >> shift) & 0xFF]++;
+			if (histogram[((*source)[0].key >> shift) & 0xFF] == count)
+				continue;
+			uint32_t offset = 0;
+			for (uint32_t& bucket : histogram) {
+				const uint32_t bucketCount = bucket;
+				bucket = offset;
+				offset += bucketCount;
+			}
+			for (const Entry& entry : *source)
+				(*destination)[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+			std::swap(source, destination);
+		}
+		if (source != &m_sortedEntries)
+			m_sortedEntries.swap(m_sortBuffer);
+	}
+
+	void RenderQueue::BuildBatches(uint32_t minInstanceCount) noexcept {
+		m_batches.clear();
+		m_instanceData.clear();
+		const uint32_t count = GetCount();
+		uint32_t first = 0;
+		while (first < count) {
+			const Item& firstItem = GetSortedItem(first);
+			uint32_t last = first + 1;
+			if (firstItem.type == ItemType::StaticMesh) {
+				while (last < count) {
+					const Item& item = GetSortedItem(last);
+					if (item.type != ItemType::StaticMesh || item.material != firstItem.material ||
+						item.vertexArrayID != firstItem.vertexArrayID || item.indexCount != firstItem.indexCount)
+						break;
+					last++;
+				}
+			}
+			const uint32_t batchCount = last - first;
+			//Solo los StaticMesh tienen un programa instanciado, un SkeletalMesh siempre se dibuja solo
+			if (firstItem.type == ItemType::StaticMesh && minInstanceCount > 0 && batchCount >= minInstanceCount) {
+				m_batches.push_back({ first, batchCount, static_cast<uint32_t>(m_instanceData.size()), true });
+				for (uint32_t i = first; i < last; i++) {
+					const glm::mat4& modelMatrix = GetSortedItem(i).modelMatrix;
+					m_instanceData.push_back({ modelMatrix, glm::transpose(glm::inverse(modelMatrix)) });
+				}
+			}
+			else {
+				//Los elementos que no alcanzan el minimo se dibujan de a uno
+				for (uint32_t i = first; i < last; i++)
+					m_batches.push_back({ i, 1, 0, false });
+			}
+			first = last;
+		}
+	}
+
+}
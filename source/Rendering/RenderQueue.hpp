@@ -0,0 +1,116 @@
+#pragma once
+#ifndef RENDERQUEUE_HPP
+#define RENDERQUEUE_HPP
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <glm/glm.hpp>
+namespace Mona {
+	class Material;
+	/*
+	* Cola de dibujo construida cada frame. Cada elemento recibe una llave de 64 bits que agrupa, de mas a menos
+	* significativo, el tipo de malla, el programa de shaders (y con ello el tipo de material), la instancia de material,
+	* el VAO y la profundidad, de modo que al ordenar las llaves los elementos que comparten estado de OpenGL quedan
+	* contiguos y el Renderer solo cambia estado en los limites entre grupos.
+	* Construir y ordenar la cola no realiza llamados a OpenGL.
+	*/
+	class RenderQueue {
+	public:
+		enum class ItemType : uint8_t {
+			StaticMesh = 0,
+			SkeletalMesh = 1
+		};
+		struct Item {
+			glm::mat4 modelMatrix;
+			Material* material;
+			uint32_t programID;
+			uint32_t vertexArrayID;
+			uint32_t indexCount;
+			//Indice de la componente dentro de su ComponentManager
+			uint32_t componentIndex;
+			ItemType type;
+		};
+		//Distribucion de los bits de la llave
+		static constexpr int TypeBits = 4;
+		static constexpr int ProgramBits = 8;
+		static constexpr int MaterialBits = 16;
+		static constexpr int VertexArrayBits = 20;
+		static constexpr int DepthBits = 16;
+		static_assert(TypeBits + ProgramBits + MaterialBits + VertexArrayBits + DepthBits == 64, "RenderQueue Error: Sort key must use 64 bits");
+		//Datos por instancia que se copian al buffer de instancias, en el mismo orden que los atributos del shader
+		struct InstanceData {
+			glm::mat4 modelMatrix;
+			glm::mat4 modelInverseTransposeMatrix;
+		};
+		//Rango contiguo del orden resultante que comparte malla y material
+		struct Batch {
+			uint32_t first;
+			uint32_t count;
+			//Posicion de la primera instancia dentro de GetInstanceData, solo valida si instanced es verdadero
+			uint32_t instanceOffset;
+			bool instanced;
+		};
+
+		RenderQueue() = default;
+		RenderQueue(const RenderQueue&) = delete;
+		RenderQueue& operator=(const RenderQueue&) = delete;
+		/*
+		* Vacia la cola, maxDepth es la distancia usada para normalizar la profundidad (por ejemplo el plano lejano de la
+		* camara). Ademas libera los identificadores de los valores que no aparecieron en el frame anterior, como materiales
+		* o mallas destruidas, para que puedan ser reutilizados.
+		*/
+		void Begin(float maxDepth) noexcept;
+		//Agrega un elemento, depth es la distancia a la camara a lo largo de su direccion de vista
+		void Push(const Item& item, float depth) noexcept;
+		//Ordena los elementos por llave usando radix sort
+		void Sort() noexcept;
+		uint32_t GetCount() const noexcept { return static_cast<uint32_t>(m_items.size()); }
+		//Elemento en la posicion i del orden resultante de Sort
+		const Item& GetSortedItem(uint32_t i) const noexcept { return m_items[m_sortedEntries[i].itemIndex]; }
+		uint64_t GetSortedKey(uint32_t i) const noexcept { return m_sortedEntries[i].key; }
+		uint64_t ComputeKey(const Item& item, float depth) noexcept;
+		/*
+		* Agrupa los elementos ordenados en lotes. Los StaticMesh consecutivos con el mismo material y VAO forman un lote
+		* instanciado si son al menos minInstanceCount, y sus matrices se escriben contiguas en GetInstanceData.
+		* minInstanceCount igual a 0 desactiva el instancing.
+		*/
+		void BuildBatches(uint32_t minInstanceCount) noexcept;
+		const std::vector<Batch>& GetBatches() const noexcept { return m_batches; }
+		const std::vector<InstanceData>& GetInstanceData() const noexcept { return m_instanceData; }
+	private:
+		struct Entry {
+			uint64_t key;
+			uint32_t itemIndex;
+		};
+		struct DenseID {
+			uint32_t id;
+			//Ultimo frame en que se uso el identificador
+			uint32_t frame;
+		};
+		struct DenseIDMap {
+			std::unordered_map<uint64_t, DenseID> ids;
+			std::vector<uint32_t> freeIDs;
+			uint32_t nextID = 0;
+		};
+		/*
+		* Asigna identificadores densos a valores arbitrarios (punteros, nombres de OpenGL) para que quepan en la llave.
+		* Si se agotan los identificadores durante un frame, los valores restantes comparten el ultimo identificador hasta
+		* que Begin libere los que ya no se usan.
+		*/
+		uint32_t GetDenseID(DenseIDMap& map, uint64_t value, int bits) noexcept;
+		void ReleaseUnusedIDs(DenseIDMap& map) noexcept;
+		std::vector<Item> m_items;
+		std::vector<Entry> m_sortedEntries;
+		std::vector<Entry> m_sortBuffer;
+		std::vector<Batch> m_batches;
+		std::vector<InstanceData> m_instanceData;
+		//Los identificadores se conservan entre frames. Una colision de identificadores solo empeora el agrupamiento y nunca
+		//la correccion, ya que el Renderer compara el estado real antes de cambiarlo
+		DenseIDMap m_programIDs;
+		DenseIDMap m_materialIDs;
+		DenseIDMap m_vertexArrayIDs;
+		uint32_t m_frame = 0;
+		float m_maxDepth = 1.0f;
+	};
+}
+#endif
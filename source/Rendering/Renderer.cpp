@@ -4,10 +4,13 @@
 #include "examples/imgui_impl_opengl3.h"
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cstddef>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include "../Core/Log.hpp"
 #include "../Core/Config.hpp"
+#include "../Core/HeadlessMode.hpp"
 #include "../DebugDrawing/DebugDrawingSystem.hpp"
 #include "Mesh.hpp"
 #include "../Animation/SkinnedMesh.hpp"
@@ -31,6 +34,10 @@ namespace Mona{
 
 	void Renderer::StartUp(EventManager& eventManager, DebugDrawingSystem* debugDrawingSystemPtr) noexcept
 	{
+		m_debugDrawingSystemPtr = debugDrawingSystemPtr;
+		//Sin contexto OpenGL no se compilan shaders y Render no hace nada, los materiales se crean con programas nulos
+		if (HeadlessMode::IsEnabled())
+			return;
 		auto& config = Mona::Config::GetInstance();
 		constexpr unsigned int offset = static_cast<unsigned int>(MaterialType::MaterialTypeCount);
 		//Construcción de todos los shaders que soporta el motor.
@@ -50,8 +57,6 @@ namespace Mona{
 		//El sistema de rendering debe subscribirse al cambio de resoluci�n de la ventana para actulizar la resoluci�n
 		//del framebuffer al que OpenGL renderiza.
 		eventManager.Subscribe(m_onWindowResizeSubscription, this, &Renderer::OnWindowResizeEvent);
-		m_debugDrawingSystemPtr = debugDrawingSystemPtr;
-		m_currentMatrixPalette.resize(NUM_MAX_BONES, glm::mat4(1.0f));
 		glEnable(GL_DEPTH_TEST);
 
 		//Se genera el buffer que contendra toda la información lumínica de la escena
@@ -60,10 +65,37 @@ namespace Mona{
 		glBufferData(GL_UNIFORM_BUFFER, sizeof(Lights), NULL, GL_DYNAMIC_DRAW);
 		glBindBuffer(GL_UNIFORM_BUFFER, 0);
 		glBindBufferBase(GL_UNIFORM_BUFFER, 0, m_lightDataUBO);
+
+		//Variantes con instancing de los shaders de mallas estaticas y el buffer que contiene las matrices de cada instancia
+		const std::vector<std::string> instancedDefines = { "INSTANCED" };
+		m_instancedShaders[static_cast<unsigned int>(MaterialType::UnlitFlat)]       = ShaderProgram(config.getPathOfEngineAsset("Shaders/UnlitFlat.vs")       , config.getPathOfEngineAsset("Shaders/UnlitFlat.ps")      , instancedDefines);
+		m_instancedShaders[static_cast<unsigned int>(MaterialType::UnlitTextured)]   = ShaderProgram(config.getPathOfEngineAsset("Shaders/UnlitTextured.vs")   , config.getPathOfEngineAsset("Shaders/UnlitTextured.ps")  , instancedDefines);
+		m_instancedShaders[static_cast<unsigned int>(MaterialType::DiffuseFlat)]     = ShaderProgram(config.getPathOfEngineAsset("Shaders/DiffuseFlat.vs")     , config.getPathOfEngineAsset("Shaders/DiffuseFlat.ps")    , instancedDefines);
+		m_instancedShaders[static_cast<unsigned int>(MaterialType::DiffuseTextured)] = ShaderProgram(config.getPathOfEngineAsset("Shaders/DiffuseTextured.vs") , config.getPathOfEngineAsset("Shaders/DiffuseTextured.ps"), instancedDefines);
+		m_instancedShaders[static_cast<unsigned int>(MaterialType::PBRFlat)]         = ShaderProgram(config.getPathOfEngineAsset("Shaders/PBRFlat.vs")         , config.getPathOfEngineAsset("Shaders/PBRFlat.ps")        , instancedDefines);
+		m_instancedShaders[static_cast<unsigned int>(MaterialType::PBRTextured)]     = ShaderProgram(config.getPathOfEngineAsset("Shaders/PBRTextured.vs")     , config.getPathOfEngineAsset("Shaders/PBRTextured.ps")    , instancedDefines);
+		//Los materiales configuran las unidades de textura de sus samplers solo en su propio programa, por lo que se repite
+		//la configuracion en las variantes con instancing que los reemplazan al dibujar
+		glUseProgram(m_instancedShaders[static_cast<unsigned int>(MaterialType::UnlitTextured)].GetProgramID());
+		glUniform1i(ShaderProgram::UnlitColorTextureSamplerShaderLocation, ShaderProgram::UnlitColorTextureUnit);
+		glUseProgram(m_instancedShaders[static_cast<unsigned int>(MaterialType::DiffuseTextured)].GetProgramID());
+		glUniform1i(ShaderProgram::DiffuseTextureSamplerShaderLocation, ShaderProgram::DiffuseTextureUnit);
+		glUseProgram(m_instancedShaders[static_cast<unsigned int>(MaterialType::PBRTextured)].GetProgramID());
+		glUniform1i(ShaderProgram::AlbedoTextureSamplerShaderLocation, ShaderProgram::AlbedoTextureUnit);
+		glUniform1i(ShaderProgram::NormalMapSamplerShaderLocation, ShaderProgram::NormalMapTextureUnit);
+		glUniform1i(ShaderProgram::MetallicSamplerShaderLocation, ShaderProgram::MetallicTextureUnit);
+		glUniform1i(ShaderProgram::RoughnessSamplerShaderLocation, ShaderProgram::RoughnessTextureUnit);
+		glUniform1i(ShaderProgram::AmbientOcclusionSamplerShaderLocation, ShaderProgram::AmbientOcclusionTextureUnit);
+		glUseProgram(0);
+		m_minInstanceCount = static_cast<uint32_t>(std::max(config.getValueOrDefault<int>("instancing_min_batch_size", 2), 0));
+		glGenBuffers(1, &m_instanceBufferID);
 	}
 	void Renderer::ShutDown(EventManager& eventManager) noexcept {
+		if (HeadlessMode::IsEnabled())
+			return;
 		eventManager.Unsubscribe(m_onWindowResizeSubscription);
 		glDeleteBuffers(1, &m_lightDataUBO);
+		glDeleteBuffers(1, &m_instanceBufferID);
 	}
 	void Renderer::OnWindowResizeEvent(const WindowResizeEvent& event) {
 		if (event.width == 0 || event.height == 0)
@@ -82,11 +114,14 @@ namespace Mona{
 		ComponentManager<SpotLightComponent>& spotLightDataManager,
 		ComponentManager<PointLightComponent>& pointLightDataManager) noexcept
 	{
+		if (HeadlessMode::IsEnabled())
+			return;
 		glClearColor(m_backgroundColor[0], m_backgroundColor[1], m_backgroundColor[2], m_backgroundColor[3]);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 		glm::mat4 viewMatrix;
 		glm::mat4 projectionMatrix;
 		glm::vec3 cameraPosition = glm::vec3(0.0f);
+		float farPlane = 100.0f;
 		if (cameraDataManager.IsValid(cameraHandle)) {
 			//Si el usuario configuro la camara principal configuramos apartir de esta la matriz de vista y projecci�n
 			//viewMatrix y projectionMatrix respectivamente
@@ -95,7 +130,8 @@ namespace Mona{
 			TransformComponent* cameraTransform = transformDataManager.GetComponentPointer(cameraOwner->GetInnerComponentHandle<TransformComponent>());
 			viewMatrix = cameraTransform->GetViewMatrixFromTransform();
 			projectionMatrix = camera->GetProjectionMatrix();
-			cameraPosition = cameraTransform->GetLocalTranslation();
+			farPlane = camera->GetZFarPlane();
+			cameraPosition = cameraTransform->GetWorldTranslation();
 		}
 		else {
 			//En caso de que el usuario no haya configurado una cama principal usamos valores predeterminados para ambas matrices
@@ -104,6 +140,9 @@ namespace Mona{
 			projectionMatrix = glm::perspective(glm::radians(50.0f), 16.0f / 9.0f, 0.1f, 100.0f);
 		}
 
+		//Antes de cualquier llamado de dibujo se descartan las mallas cuya caja queda fuera del frustum de la camara
+		m_cullingSystem.UpdateBounds(transformDataManager, skeletalMeshDataManager);
+		m_cullingSystem.Cull(projectionMatrix * viewMatrix, m_visibleStaticMeshes, m_visibleSkeletalMeshes);
 
 
 		//Comienza carga en CPU de la informaci�n lum�nica de la escena
@@ -119,7 +158,7 @@ namespace Mona{
 			GameObject* dirLightOwner = directionalLightDataManager.GetOwnerByIndex(i);
 			TransformComponent* lightTransform = transformDataManager.GetComponentPointer(dirLightOwner->GetInnerComponentHandle<TransformComponent>());
 			lights.directionalLights[i].colorIntensity = dirLight.GetLightColor();
-			lights.directionalLights[i].direction = glm::rotate(dirLight.GetLightDirection(), lightTransform->GetFrontVector());
+			lights.directionalLights[i].direction = glm::rotate(dirLight.GetLightDirection(), lightTransform->GetWorldFrontVector());
 		}
 
 		//Lo mismo para spotlights
@@ -130,8 +169,8 @@ namespace Mona{
 			GameObject* spotLightOwner = spotLightDataManager.GetOwnerByIndex(i);
 			TransformComponent* lightTransform = transformDataManager.GetComponentPointer(spotLightOwner->GetInnerComponentHandle<TransformComponent>());
 			lights.spotLights[i].colorIntensity = spotLight.GetLightColor();
-			lights.spotLights[i].direction = glm::rotate(spotLight.GetLightDirection(), lightTransform->GetFrontVector());
-			lights.spotLights[i].position = lightTransform->GetLocalTranslation();
+			lights.spotLights[i].direction = glm::rotate(spotLight.GetLightDirection(), lightTransform->GetWorldFrontVector());
+			lights.spotLights[i].position = lightTransform->GetWorldTranslation();
 			lights.spotLights[i].cosPenumbraAngle = glm::cos(spotLight.GetPenumbraAngle());
 			lights.spotLights[i].cosUmbraAngle = glm::cos(spotLight.GetUmbraAngle());
 			lights.spotLights[i].maxRadius = spotLight.GetMaxRadius();
@@ -145,7 +184,7 @@ namespace Mona{
 			GameObject* pointLightOwner = pointLightDataManager.GetOwnerByIndex(i);
 			TransformComponent* lightTransform = transformDataManager.GetComponentPointer(pointLightOwner->GetInnerComponentHandle<TransformComponent>());
 			lights.pointLights[i].colorIntensity = pointLight.GetLightColor();
-			lights.pointLights[i].position = lightTransform->GetLocalTranslation();
+			lights.pointLights[i].position = lightTransform->GetWorldTranslation();
 			lights.pointLights[i].maxRadius = pointLight.GetMaxRadius();
 		}
 
@@ -153,43 +192,138 @@ namespace Mona{
 		glBindBuffer(GL_UNIFORM_BUFFER, m_lightDataUBO);
 		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Lights), &lights);
 		glBindBuffer(GL_UNIFORM_BUFFER, 0);
-		//Iteraci�n sobre todas las instancias de StaticMeshComponent
-		for (decltype(staticMeshDataManager.GetCount()) i = 0;
-			i < staticMeshDataManager.GetCount();
-			i++)
+		//Se arma y ordena la cola de dibujo con las mallas visibles para luego emitir solo los cambios de estado necesarios
+		BuildRenderQueue(viewMatrix, farPlane, staticMeshDataManager, skeletalMeshDataManager, transformDataManager);
+		SubmitRenderQueue(projectionMatrix * viewMatrix, cameraPosition, skeletalMeshDataManager);
+		//En no Debub build este llamado es vacio, en caso contrario se renderiza informaci�n de debug
+		m_debugDrawingSystemPtr->Draw(eventManager, viewMatrix, projectionMatrix);
+		
+	}
+
+	void Renderer::BuildRenderQueue(const glm::mat4& viewMatrix,
+		float farPlane,
+		ComponentManager<StaticMeshComponent>& staticMeshDataManager,
+		ComponentManager<SkeletalMeshComponent>& skeletalMeshDataManager,
+		ComponentManager<TransformComponent>& transformDataManager) noexcept
+	{
+		m_renderQueue.Begin(farPlane);
+		for (const InnerComponentHandle& staticMeshHandle : m_visibleStaticMeshes)
 		{
+			const auto i = staticMeshDataManager.GetComponentIndex(staticMeshHandle);
 			StaticMeshComponent& staticMesh = staticMeshDataManager[i];
 			GameObject* owner = staticMeshDataManager.GetOwnerByIndex(i);
-			//Se obtiene la informaci�n espacial para configurar la matriz de modelo dentro del shader.
+			//TransformComponent ya pertenece al grupo de mallas esqueletales, por lo que las estaticas pasan por el handle
 			TransformComponent* transform = transformDataManager.GetComponentPointer(owner->GetInnerComponentHandle<TransformComponent>());
-			//Configuraci�n de la malla a ser renderizada y las uniformes asociadas a su material.
-			glBindVertexArray(staticMesh.GetMeshVAOID());
-			staticMesh.m_materialPtr->SetUniforms(projectionMatrix, viewMatrix, transform->GetModelMatrix(), cameraPosition);
-			glDrawElements(GL_TRIANGLES, staticMesh.GetMeshIndexCount(), GL_UNSIGNED_INT, 0);
-			
+			RenderQueue::Item item;
+			item.modelMatrix = transform->GetModelMatrix();
+			item.material = staticMesh.m_materialPtr.get();
+			item.programID = item.material->GetShaderID();
+			item.vertexArrayID = staticMesh.GetMeshVAOID();
+			item.indexCount = staticMesh.GetMeshIndexCount();
+			item.componentIndex = i;
+			item.type = RenderQueue::ItemType::StaticMesh;
+			m_renderQueue.Push(item, -(viewMatrix * item.modelMatrix[3]).z);
 		}
-		
-		//Iteracion sobre todas las instancias de SkeletalMeshComponent
-		for (decltype(skeletalMeshDataManager.GetCount()) i = 0;
-			i < skeletalMeshDataManager.GetCount();
-			i++)
+		for (const InnerComponentHandle& skeletalMeshHandle : m_visibleSkeletalMeshes)
 		{
+			const auto i = skeletalMeshDataManager.GetComponentIndex(skeletalMeshHandle);
 			SkeletalMeshComponent& skeletalMesh = skeletalMeshDataManager[i];
 			GameObject* owner = skeletalMeshDataManager.GetOwnerByIndex(i);
-			TransformComponent* transform = transformDataManager.GetComponentPointer(owner->GetInnerComponentHandle<TransformComponent>());
-			auto skinnedMesh = skeletalMesh.m_skinnedMeshPtr;
-			glBindVertexArray(skinnedMesh->GetVertexArrayID());
-			//A diferencias de StaticMeshes, SkeletalMeshComponent necesita configurar las paletas de matrices de animacion
-			//estas se le solicitan al animationController
-			auto &animController = skeletalMesh.GetAnimationController();
-			skeletalMesh.m_materialPtr->SetUniforms(projectionMatrix, viewMatrix, transform->GetModelMatrix(), cameraPosition);
-			animController.GetMatrixPalette(m_currentMatrixPalette);
-			glUniformMatrix4fv(ShaderProgram::BoneTransformShaderLocation, skeletalMesh.GetSkeleton()->JointCount(), GL_FALSE, (GLfloat*) m_currentMatrixPalette.data());
-			glDrawElements(GL_TRIANGLES, skinnedMesh->GetIndexBufferCount(), GL_UNSIGNED_INT, 0);
+			//Si ambas componentes estan empaquetadas por el grupo de World se evita pasar por el handle.
+			TransformComponent* transform = (i < transformDataManager.GetCount() && transformDataManager.GetOwnerByIndex(i) == owner) ?
+				&transformDataManager[i] : transformDataManager.GetComponentPointer(owner->GetInnerComponentHandle<TransformComponent>());
+			RenderQueue::Item item;
+			item.modelMatrix = transform->GetModelMatrix();
+			item.material = skeletalMesh.m_materialPtr.get();
+			item.programID = item.material->GetShaderID();
+			item.vertexArrayID = skeletalMesh.m_skinnedMeshPtr->GetVertexArrayID();
+			item.indexCount = skeletalMesh.m_skinnedMeshPtr->GetIndexBufferCount();
+			item.componentIndex = i;
+			item.type = RenderQueue::ItemType::SkeletalMesh;
+			m_renderQueue.Push(item, -(viewMatrix * item.modelMatrix[3]).z);
+		}
+		m_renderQueue.Sort();
+		m_renderQueue.BuildBatches(m_minInstanceCount);
+	}
+
+	uint32_t Renderer::GetInstancedProgramID(uint32_t programID) const noexcept {
+		for (unsigned int i = 0; i < static_cast<unsigned int>(MaterialType::MaterialTypeCount); i++) {
+			if (m_shaders[i].GetProgramID() == programID)
+				return m_instancedShaders[i].GetProgramID();
+		}
+		return 0;
+	}
+
+	void Renderer::BindInstanceAttributes(uint32_t instanceOffset) noexcept {
+		//Cada mat4 ocupa cuatro locations consecutivas, con divisor 1 avanzan una vez por instancia
+		glBindBuffer(GL_ARRAY_BUFFER, m_instanceBufferID);
+		const size_t baseOffset = instanceOffset * sizeof(RenderQueue::InstanceData);
+		for (int column = 0; column < 4; column++) {
+			const int modelLocation = ShaderProgram::InstanceModelMatrixAttributeLocation + column;
+			const int inverseTransposeLocation = ShaderProgram::InstanceModelInverseTransposeMatrixAttributeLocation + column;
+			glEnableVertexAttribArray(modelLocation);
+			glVertexAttribPointer(modelLocation, 4, GL_FLOAT, GL_FALSE, sizeof(RenderQueue::InstanceData),
+				(void*)(baseOffset + offsetof(RenderQueue::InstanceData, modelMatrix) + column * sizeof(glm::vec4)));
+			glVertexAttribDivisor(modelLocation, 1);
+			glEnableVertexAttribArray(inverseTransposeLocation);
+			glVertexAttribPointer(inverseTransposeLocation, 4, GL_FLOAT, GL_FALSE, sizeof(RenderQueue::InstanceData),
+				(void*)(baseOffset + offsetof(RenderQueue::InstanceData, modelInverseTransposeMatrix) + column * sizeof(glm::vec4)));
+			glVertexAttribDivisor(inverseTransposeLocation, 1);
+		}
+	}
+
+	void Renderer::SubmitRenderQueue(const glm::mat4& viewProjectionMatrix,
+		const glm::vec3& cameraPosition,
+		ComponentManager<SkeletalMeshComponent>& skeletalMeshDataManager) noexcept
+	{
+		//Las matrices de todos los lotes instanciados se suben con un unico llamado
+		const auto& instanceData = m_renderQueue.GetInstanceData();
+		if (!instanceData.empty()) {
+			glBindBuffer(GL_ARRAY_BUFFER, m_instanceBufferID);
+			glBufferData(GL_ARRAY_BUFFER, instanceData.size() * sizeof(RenderQueue::InstanceData), instanceData.data(), GL_STREAM_DRAW);
+		}
+		uint32_t currentProgram = 0;
+		uint32_t currentVertexArray = 0;
+		Material* currentMaterial = nullptr;
+		for (const RenderQueue::Batch& batch : m_renderQueue.GetBatches()) {
+			const RenderQueue::Item& item = m_renderQueue.GetSortedItem(batch.first);
+			const uint32_t instancedProgram = batch.instanced ? GetInstancedProgramID(item.programID) : 0;
+			const uint32_t program = instancedProgram != 0 ? instancedProgram : item.programID;
+			if (program != currentProgram) {
+				glUseProgram(program);
+				currentProgram = program;
+				//Las uniformes del material pertenecen al programa, al cambiarlo deben configurarse nuevamente
+				currentMaterial = nullptr;
+				if (instancedProgram != 0)
+					glUniformMatrix4fv(ShaderProgram::ViewProjectionMatrixShaderLocation, 1, GL_FALSE, glm::value_ptr(viewProjectionMatrix));
+			}
+			if (item.material != currentMaterial) {
+				item.material->SetMaterialUniforms(cameraPosition);
+				currentMaterial = item.material;
+			}
+			if (item.vertexArrayID != currentVertexArray) {
+				glBindVertexArray(item.vertexArrayID);
+				currentVertexArray = item.vertexArrayID;
+			}
+			if (instancedProgram != 0) {
+				BindInstanceAttributes(batch.instanceOffset);
+				glDrawElementsInstanced(GL_TRIANGLES, item.indexCount, GL_UNSIGNED_INT, 0, batch.count);
+				continue;
+			}
+			//Sin variante instanciada el lote se dibuja objeto por objeto
+			for (uint32_t i = batch.first; i < batch.first + batch.count; i++) {
+				const RenderQueue::Item& batchItem = m_renderQueue.GetSortedItem(i);
+				batchItem.material->SetMatrixUniforms(viewProjectionMatrix, batchItem.modelMatrix);
+				if (batchItem.type == RenderQueue::ItemType::SkeletalMesh) {
+					//A diferencias de StaticMeshes, SkeletalMeshComponent necesita configurar las paletas de matrices de animacion
+					//estas ya fueron calculadas por el AnimationSystem al actualizar las poses
+					SkeletalMeshComponent& skeletalMesh = skeletalMeshDataManager[batchItem.componentIndex];
+					const auto& matrixPalette = skeletalMesh.GetAnimationController().GetCurrentMatrixPalette();
+					glUniformMatrix4fv(ShaderProgram::BoneTransformShaderLocation, skeletalMesh.GetSkeleton()->JointCount(), GL_FALSE, (GLfloat*)matrixPalette.data());
+				}
+				glDrawElements(GL_TRIANGLES, batchItem.indexCount, GL_UNSIGNED_INT, 0);
+			}
 		}
-		//En no Debub build este llamado es vacio, en caso contrario se renderiza informaci�n de debug
-		m_debugDrawingSystemPtr->Draw(eventManager, viewMatrix, projectionMatrix);
-		
 	}
 
 	std::shared_ptr<Material> Renderer::CreateMaterial(MaterialType type, bool isForSkinning) {
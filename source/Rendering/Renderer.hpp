@@ -15,6 +15,8 @@
 #include "SpotLightComponent.hpp"
 #include "PointLightComponent.hpp"
 #include "Material.hpp"
+#include "CullingSystem.hpp"
+#include "RenderQueue.hpp"
 #include "../DebugDrawing/DebugDrawingSystem.hpp"
 
 
@@ -28,6 +30,10 @@ namespace Mona {
 		static constexpr int NUM_HALF_MAX_POINT_LIGHTS = 3;
 		static constexpr int NUM_HALF_MAX_SPOT_LIGHTS = 3;
 		static constexpr int NUM_MAX_BONES = 70;
+		//Componentes leidas por Render (incluye IKNavigationComponent por el dibujo de debug), no escribe ninguna
+		using ReadComponents = ComponentTypeList<TransformComponent, StaticMeshComponent, SkeletalMeshComponent, CameraComponent,
+			DirectionalLightComponent, SpotLightComponent, PointLightComponent, IKNavigationComponent>;
+		using WriteComponents = ComponentTypeList<>;
 		Renderer() = default;
 		void StartUp(EventManager& eventManager, DebugDrawingSystem* debugDrawingSystemPtr) noexcept;
 		void Render(EventManager& eventManager,
@@ -44,7 +50,18 @@ namespace Mona {
 		void OnWindowResizeEvent(const WindowResizeEvent& event);
 		std::shared_ptr<Material> CreateMaterial(MaterialType type, bool isForSkinning);
 		void SetBackgroundColor(float r, float g, float b, float alpha = 0.0f);
+		CullingSystem& GetCullingSystem() noexcept { return m_cullingSystem; }
 	private:
+		//Llena m_renderQueue con las mallas visibles y la ordena, no realiza llamados a OpenGL
+		void BuildRenderQueue(const glm::mat4& viewMatrix,
+			float farPlane,
+			ComponentManager<StaticMeshComponent>& staticMeshDataManager,
+			ComponentManager<SkeletalMeshComponent>& skeletalMeshDataManager,
+			ComponentManager<TransformComponent>& transformDataManager) noexcept;
+		//Recorre la cola ordenada emitiendo cambios de programa, material y VAO solo en los limites entre grupos
+		void SubmitRenderQueue(const glm::mat4& viewProjectionMatrix,
+			const glm::vec3& cameraPosition,
+			ComponentManager<SkeletalMeshComponent>& skeletalMeshDataManager) noexcept;
 		struct DirectionalLight
 		{
 			glm::vec3 colorIntensity; //12
@@ -78,11 +95,22 @@ namespace Mona {
 			int pointLightsCount; 
 			int directionalLightsCount; 
 		};
+		//Retorna la variante con instancing del programa de un material estatico, o 0 si no existe
+		uint32_t GetInstancedProgramID(uint32_t programID) const noexcept;
+		void BindInstanceAttributes(uint32_t instanceOffset) noexcept;
 		std::array<ShaderProgram, 2 * static_cast<unsigned int>(MaterialType::MaterialTypeCount)> m_shaders;
-		std::vector<glm::mat4> m_currentMatrixPalette;
+		//Variantes de los shaders de mallas estaticas compiladas con el define INSTANCED
+		std::array<ShaderProgram, static_cast<unsigned int>(MaterialType::MaterialTypeCount)> m_instancedShaders;
+		CullingSystem m_cullingSystem;
+		std::vector<InnerComponentHandle> m_visibleStaticMeshes;
+		std::vector<InnerComponentHandle> m_visibleSkeletalMeshes;
+		RenderQueue m_renderQueue;
 		SubscriptionHandle m_onWindowResizeSubscription;
 		DebugDrawingSystem* m_debugDrawingSystemPtr = nullptr;
 		unsigned int m_lightDataUBO = 0;
+		unsigned int m_instanceBufferID = 0;
+		//Cantidad minima de mallas estaticas iguales para dibujarlas con un unico llamado instanciado (0 lo desactiva)
+		uint32_t m_minInstanceCount = 2;
 		glm::vec4 m_backgroundColor = { 0.0f, 0.0f, 0.0f, 0.0f };
 
 	};
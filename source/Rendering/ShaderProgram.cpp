@@ -10,7 +10,8 @@ namespace Mona {
 
 
 
-	ShaderProgram::ShaderProgram(const std::filesystem::path& vertexShaderPath, const std::filesystem::path& pixelShaderPath) noexcept
+	ShaderProgram::ShaderProgram(const std::filesystem::path& vertexShaderPath, const std::filesystem::path& pixelShaderPath,
+		const std::vector<std::string>& defines) noexcept
 	{
 		
 		m_programID = 0;
@@ -19,8 +20,8 @@ namespace Mona {
 		std::string pixelShaderCode = LoadCode(pixelShaderPath);
 
 		//Remplazo de constantes
-		PreProcessCode(vertexShaderCode);
-		PreProcessCode(pixelShaderCode);
+		PreProcessCode(vertexShaderCode, defines);
+		PreProcessCode(pixelShaderCode, defines);
 
 		if (vertexShaderCode.length() == 0 || pixelShaderCode.length() == 0)
 			return;
@@ -126,8 +127,20 @@ namespace Mona {
 		m_programID = program;
 	}
 
-	void ShaderProgram::PreProcessCode(std::string& code)
+	void ShaderProgram::PreProcessCode(std::string& code, const std::vector<std::string>& defines)
 	{
+		//Los defines deben ir despues de la directiva #version, que debe ser la primera del shader
+		if (!defines.empty() && !code.empty()) {
+			const size_t versionPos = code.find("#version");
+			const size_t lineEnd = versionPos == std::string::npos ? std::string::npos : code.find('\n', versionPos);
+			std::string defineLines;
+			for (const std::string& define : defines)
+				defineLines += "#define " + define + "\n";
+			if (lineEnd == std::string::npos)
+				code.insert(0, defineLines);
+			else
+				code.insert(lineEnd + 1, defineLines);
+		}
 		struct ShaderConstant {
 			std::string key;
 			std::string value;
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <filesystem>
 #include <string>
+#include <vector>
 #include <glm/glm.hpp>
 namespace Mona {
 	class ShaderProgram {
@@ -37,8 +38,14 @@ namespace Mona {
 		static constexpr int BoneTransformShaderLocation = 10;
 
 
+		static constexpr int InstanceModelMatrixAttributeLocation = 5;
+		static constexpr int InstanceModelInverseTransposeMatrixAttributeLocation = 9;
+		static constexpr int ViewProjectionMatrixShaderLocation = 0;
+
+		//defines se agregan como #define al inicio de ambos shaders, por ejemplo INSTANCED para las variantes con instancing
 		ShaderProgram(const std::filesystem::path& vertexShaderPath,
-			const std::filesystem::path& pixelShaderPath) noexcept;
+			const std::filesystem::path& pixelShaderPath,
+			const std::vector<std::string>& defines = {}) noexcept;
 		ShaderProgram() : m_programID(0) {}
 		ShaderProgram& operator=(ShaderProgram const &program) = delete;
 		ShaderProgram(ShaderProgram const& program) = delete;
@@ -51,7 +58,7 @@ namespace Mona {
 		std::string LoadCode(const std::filesystem::path& shaderPath) const noexcept;
 		unsigned int CompileShader(const std::string& code, const std::filesystem::path& shaderPath, unsigned int type) const noexcept;
 		void LinkProgram(unsigned int vertex, unsigned int pixel) noexcept;
-		void PreProcessCode(std::string& code);
+		void PreProcessCode(std::string& code, const std::vector<std::string>& defines);
 		uint32_t m_programID;
 	};
 }
@@ -3,15 +3,21 @@
 #define STATICMESHCOMPONENT_HPP
 #include "../Core/Log.hpp"
 #include "../World/ComponentTypes.hpp"
+#include "../World/GameObjectTypes.hpp"
 #include "Mesh.hpp"
 #include "Material.hpp"
 namespace Mona {
 	class TransformComponent;
+	class GameObject;
+	class CullingSystem;
+	class StaticMeshLifetimePolicy;
+	template <typename ComponentType>
+	class ComponentManager;
 	class StaticMeshComponent
 	{
 	public:
 		friend class Renderer;
-		using LifetimePolicyType = DefaultLifetimePolicy<StaticMeshComponent>;
+		using LifetimePolicyType = StaticMeshLifetimePolicy;
 		using dependencies = DependencyList<TransformComponent>;
 		static constexpr std::string_view componentName = "StaticMeshComponent";
 		static constexpr uint8_t componentIndex = GetComponentIndex(EComponentType::StaticMeshComponent);
@@ -38,6 +44,10 @@ namespace Mona {
 			return m_meshPtr->GetHeightMap();
 		}
 
+		const AABB& GetLocalBoundingBox() const noexcept {
+			return m_meshPtr->GetBoundingBox();
+		}
+
 		void SetMaterial(std::shared_ptr<Material> material) noexcept {
 			if (material != nullptr)
 			{
@@ -51,5 +61,20 @@ namespace Mona {
 		std::shared_ptr<Mesh> m_meshPtr;
 		std::shared_ptr<Material> m_materialPtr;
 	};
+
+	/*
+	* Registra cada StaticMeshComponent en el CullingSystem del Renderer al ser agregada y la remueve de este al ser removida.
+	*/
+	class StaticMeshLifetimePolicy {
+	public:
+		StaticMeshLifetimePolicy() = default;
+		StaticMeshLifetimePolicy(ComponentManager<TransformComponent>* transformDataManagerPtr, CullingSystem* cullingSystemPtr) :
+			m_transformDataManagerPtr(transformDataManagerPtr), m_cullingSystemPtr(cullingSystemPtr) {}
+		void OnAddComponent(GameObject* gameObjectPtr, StaticMeshComponent& staticMesh, const InnerComponentHandle& handle) noexcept;
+		void OnRemoveComponent(GameObject* gameObjectPtr, StaticMeshComponent& staticMesh, const InnerComponentHandle& handle) noexcept;
+	private:
+		ComponentManager<TransformComponent>* m_transformDataManagerPtr = nullptr;
+		CullingSystem* m_cullingSystemPtr = nullptr;
+	};
 }
 #endif
\ No newline at end of file
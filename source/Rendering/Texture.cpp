@@ -2,6 +2,7 @@
 
 #include <stb_image.h>
 #include "../Core/Log.hpp"
+#include "../Core/HeadlessMode.hpp"
 #include <glad/glad.h>
 namespace Mona {
 
@@ -65,19 +66,27 @@ namespace Mona {
 	}
 	
 	void Texture::SetSWrapMode(WrapMode wrapMode) noexcept{
+		if (HeadlessMode::IsEnabled())
+			return;
 		glTextureParameteri(m_ID,GL_TEXTURE_WRAP_S, WrapEnumToOpenGLEnum(wrapMode));
 	}
 
 	void Texture::SetTWrapMode(WrapMode wrapMode) noexcept {
+		if (HeadlessMode::IsEnabled())
+			return;
 		glTextureParameteri(m_ID, GL_TEXTURE_WRAP_T, WrapEnumToOpenGLEnum(wrapMode));
 	}
 
 	void Texture::SetMagnificationFilter(TextureMagnificationFilter magFilter) noexcept {
+		if (HeadlessMode::IsEnabled())
+			return;
 		glTextureParameteri(m_ID, GL_TEXTURE_MAG_FILTER, MagnificationFilterEnumToOpenGLEnum(magFilter));
 		
 	}
 
 	void Texture::SetMinificationFilter(TextureMinificationFilter minFilter) noexcept {
+		if (HeadlessMode::IsEnabled())
+			return;
 		glTextureParameteri(m_ID, GL_TEXTURE_MIN_FILTER, MinificationFilterEnumToOpenGLEnum(minFilter));
 	}
 
@@ -87,12 +96,50 @@ namespace Mona {
 	}
 
 	void Texture::ClearData() noexcept {
+		if (HeadlessMode::IsEnabled())
+			return;
 		MONA_ASSERT(m_ID, "Texture Error: Trying to clear data from already freed texture.");
 		glDeleteTextures(1, &m_ID);
 		m_ID = 0;
 	}
 
+	struct Texture::ImportedData {
+		stbi_uc* pixels = nullptr;
+		int width = 0;
+		int height = 0;
+		int channels = 0;
+		~ImportedData() {
+			if (pixels)
+				stbi_image_free(pixels);
+		}
+	};
+
+	std::shared_ptr<Texture::ImportedData> Texture::Import(const std::string& stringFilePath) noexcept {
+		std::shared_ptr<ImportedData> data = std::make_shared<ImportedData>();
+		//Se carga los datos de la imagen usando stb
+		data->pixels = stbi_load(stringFilePath.c_str(), &data->width, &data->height, &data->channels, 0);
+		if (!data->pixels) {
+			MONA_LOG_ERROR("Texture Error: Failed to load texture from {0} file.", stringFilePath);
+			return nullptr;
+		}
+		if (data->channels != 1 && data->channels != 3 && data->channels != 4) {
+			MONA_LOG_ERROR("Texture Error: Texture format not supported.", stringFilePath);
+			return nullptr;
+		}
+		return data;
+	}
+
 	Texture::Texture(const std::string& stringFilePath,
+		TextureMagnificationFilter magFilter,
+		TextureMinificationFilter minFilter,
+		WrapMode sWrapMode,
+		WrapMode tWrapMode,
+		bool genMipmaps) :
+		Texture(Import(stringFilePath).get(), magFilter, minFilter, sWrapMode, tWrapMode, genMipmaps)
+	{
+	}
+
+	Texture::Texture(const ImportedData* data,
 		TextureMagnificationFilter magFilter,
 		TextureMinificationFilter minFilter,
 		WrapMode sWrapMode,
@@ -103,54 +150,42 @@ namespace Mona {
 		m_height(0),
 		m_channels(0)
 	{
-
-		int width, height, channels;
-		//Se carga los datos de la imagen usando stb
-		stbi_uc* data = stbi_load(stringFilePath.c_str(), &width, &height, &channels, 0);
-		if (!data) {
-			MONA_LOG_ERROR("Texture Error: Failed to load texture from {0} file.", stringFilePath);
-			stbi_image_free(data);
+		if (!data)
 			return;
-		}
 		GLenum internalFormat = 0;
 		GLenum dataFormat = 0;
-		if (channels == 1)
+		if (data->channels == 1)
 		{
 			internalFormat = GL_R8;
 			dataFormat = GL_RED;
 		}
-		else if (channels == 4)
+		else if (data->channels == 4)
 		{
 			internalFormat = GL_RGBA8;
 			dataFormat = GL_RGBA;
 		}
-		else if (channels == 3)
+		else if (data->channels == 3)
 		{
 			internalFormat = GL_RGB8;
 			dataFormat = GL_RGB;
 		}
 
-		if (!(internalFormat & dataFormat)) {
-			MONA_LOG_ERROR("Texture Error: Texture format not supported.", stringFilePath);
-			stbi_image_free(data);
+		m_channels = data->channels;
+		m_width = data->width;
+		m_height = data->height;
+		if (HeadlessMode::IsEnabled())
 			return;
-		}
-
 		//Se pasa los datos de CPU a GPU usando OpenGL
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_ID);
-		glTextureStorage2D(m_ID, 1, internalFormat, width, height);
+		glTextureStorage2D(m_ID, 1, internalFormat, data->width, data->height);
 		glTextureParameteri(m_ID, GL_TEXTURE_WRAP_S, WrapEnumToOpenGLEnum(sWrapMode));
 		glTextureParameteri(m_ID, GL_TEXTURE_WRAP_T, WrapEnumToOpenGLEnum(tWrapMode));
 		glTextureParameteri(m_ID, GL_TEXTURE_MAG_FILTER, MagnificationFilterEnumToOpenGLEnum(magFilter));
 		glTextureParameteri(m_ID, GL_TEXTURE_MIN_FILTER, MinificationFilterEnumToOpenGLEnum(minFilter));
-		glTextureSubImage2D(m_ID, 0, 0, 0, width, height, dataFormat, GL_UNSIGNED_BYTE, data);
+		glTextureSubImage2D(m_ID, 0, 0, 0, data->width, data->height, dataFormat, GL_UNSIGNED_BYTE, data->pixels);
 		if (genMipmaps) {
 			glGenerateTextureMipmap(m_ID);
 		}
-		m_channels = channels;
-		m_width = width;
-		m_height = height;
-		stbi_image_free(data);
 	}
 
 }
\ No newline at end of file
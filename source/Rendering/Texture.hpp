@@ -3,6 +3,7 @@
 #define TEXTURE_HPP
 #include <cstdint>
 #include <string>
+#include <memory>
 namespace Mona {
 	enum class TextureMagnificationFilter {
 		Nearest,
@@ -41,6 +42,19 @@ namespace Mona {
 			WrapMode sWrapMode = WrapMode::Repeat,
 			WrapMode tWrapMode = WrapMode::Repeat,
 			bool genMipmaps = false);
+		struct ImportedData;
+		//Sube a la GPU una imagen obtenida con Import, un puntero nulo construye una textura vacia
+		Texture(const ImportedData* data,
+			TextureMagnificationFilter magFilter,
+			TextureMinificationFilter minFilter,
+			WrapMode sWrapMode,
+			WrapMode tWrapMode,
+			bool genMipmaps);
+		/*
+		* Decodifica la imagen sin usar OpenGL, por lo que puede llamarse desde un hilo de carga. Retorna nullptr si el
+		* archivo no pudo leerse o su formato no es soportado.
+		*/
+		static std::shared_ptr<ImportedData> Import(const std::string& stringFilePath) noexcept;
 		void ClearData() noexcept;
 		uint32_t m_ID;
 		uint32_t m_width;
@@ -12,6 +12,12 @@ namespace Mona {
 		//Solo pasar a crear la textura si no existe una entrada en el mapa con el mismo path
 		if (it != m_textureMap.end())
 			return it->second;
+		//Si la textura esta siendo cargada de forma asincrona se espera a que termine en vez de decodificarla de nuevo
+		auto pendingIt = m_pendingTextureMap.find(stringPath);
+		if (pendingIt != m_pendingTextureMap.end()) {
+			AssetFuture<Texture> future = pendingIt->second;
+			return future.Wait();
+		}
 		Texture* texturePtr = new Texture(stringPath, magFilter, minFilter, sWrapMode, tWrapMode, genMipmaps);
 		std::shared_ptr<Texture> textureSharedPtr = std::shared_ptr<Texture>(texturePtr);
 		//Antes de retornar la texture se inserta una entrada al mapa 
@@ -19,6 +25,37 @@ namespace Mona {
 		return textureSharedPtr;
 	}
 
+	AssetFuture<Texture> TextureManager::LoadTextureAsync(const std::filesystem::path& filePath,
+		TextureMagnificationFilter magFilter,
+		TextureMinificationFilter minFilter,
+		WrapMode sWrapMode,
+		WrapMode tWrapMode,
+		bool genMipmaps) noexcept
+	{
+		const std::string stringPath = filePath.string();
+		auto it = m_textureMap.find(stringPath);
+		if (it != m_textureMap.end())
+			return AssetFuture<Texture>(it->second);
+		auto pendingIt = m_pendingTextureMap.find(stringPath);
+		if (pendingIt != m_pendingTextureMap.end())
+			return pendingIt->second;
+		AssetPromise<Texture> promise;
+		m_pendingTextureMap.insert({ stringPath, promise.GetFuture() });
+		AsyncAssetLoader& loader = AsyncAssetLoader::GetInstance();
+		loader.RunOnLoaderThread([=, this, &loader]() {
+			std::shared_ptr<Texture::ImportedData> data = Texture::Import(stringPath);
+			//Los mapas del manager solo se modifican desde el hilo principal
+			loader.RunOnMainThread([=, this]() {
+				std::shared_ptr<Texture> textureSharedPtr = std::shared_ptr<Texture>(
+					new Texture(data.get(), magFilter, minFilter, sWrapMode, tWrapMode, genMipmaps));
+				m_textureMap.insert({ stringPath, textureSharedPtr });
+				m_pendingTextureMap.erase(stringPath);
+				promise.SetValue(textureSharedPtr);
+			});
+		});
+		return promise.GetFuture();
+	}
+
 	void TextureManager::CleanUnusedTextures() noexcept
 	{
 		for (auto i = m_textureMap.begin(), last = m_textureMap.end(); i != last;) {
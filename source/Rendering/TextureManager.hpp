@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <filesystem>
 #include "Texture.hpp"
+#include "../Core/AssetFuture.hpp"
 namespace Mona {
 	class TextureManager {
 	public:
@@ -18,6 +19,16 @@ namespace Mona {
 			WrapMode sWrapMode = WrapMode::Repeat,
 			WrapMode tWrapMode = WrapMode::Repeat,
 			bool genMipmaps = false) noexcept;
+		/*
+		* Variante asincrona de LoadTexture, la imagen se decodifica en un hilo de carga y se sube a la GPU en el hilo
+		* principal al inicio de algun frame posterior.
+		*/
+		AssetFuture<Texture> LoadTextureAsync(const std::filesystem::path& filePath,
+			TextureMagnificationFilter magFilter = TextureMagnificationFilter::Linear,
+			TextureMinificationFilter minFilter = TextureMinificationFilter::LinearMipmapLinear,
+			WrapMode sWrapMode = WrapMode::Repeat,
+			WrapMode tWrapMode = WrapMode::Repeat,
+			bool genMipmaps = false) noexcept;
 		void CleanUnusedTextures() noexcept;
 		static TextureManager& GetInstance() noexcept {
 			static TextureManager instance;
@@ -27,6 +38,7 @@ namespace Mona {
 		void ShutDown() noexcept;
 		TextureManager() = default;
 		TextureMap m_textureMap;
+		std::unordered_map<std::string, AssetFuture<Texture>> m_pendingTextureMap;
 	};
 }
 #endif
\ No newline at end of file
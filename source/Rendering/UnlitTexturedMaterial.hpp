@@ -5,11 +5,15 @@
 #include <memory>
 #include "Texture.hpp"
 #include "../Core/Log.hpp"
+#include "../Core/HeadlessMode.hpp"
 namespace Mona {
 	class UnlitTexturedMaterial : public Material {
 	public:
  
 		UnlitTexturedMaterial(const ShaderProgram& shaderProgram, bool isForSkinning) : Material(shaderProgram, isForSkinning), m_unlitColorTexture(nullptr) {
+			//Sin contexto OpenGL el programa es nulo y no hay uniforms que configurar
+			if (HeadlessMode::IsEnabled())
+				return;
 			glUseProgram(m_shaderID);
 			//Dado que las ubicaiones de las texturas nunca cambian solo se configura al momento de construccin
 			glUniform1i(ShaderProgram::UnlitColorTextureSamplerShaderLocation, ShaderProgram::UnlitColorTextureUnit);
@@ -0,0 +1,55 @@
+#pragma once
+#ifndef COMPONENTGROUP_HPP
+#define COMPONENTGROUP_HPP
+#include "GameObjectTypes.hpp"
+#include "ComponentTypes.hpp"
+#include "ComponentManager.hpp"
+#include <tuple>
+namespace Mona {
+	class GameObject;
+
+	//Un grupo de componentes empaqueta al inicio de cada ComponentManager involucrado a todos los GameObjects que poseen
+	//el conjunto completo de componentes del grupo (su arquetipo). Dentro del rango [0, GetCount()) el i-esimo elemento
+	//de cada manager pertenece al mismo GameObject, por lo que iterar varias componentes a la vez es lineal y no requiere
+	//pasar por los handles. Los InnerComponentHandle siguen siendo validos ya que el empaquetado usa SwapComponents.
+	//Un manager solo puede pertenecer a un grupo y no debe ser reordenado por otros sistemas
+	//(AudioSystem reordena AudioSourceComponent segun prioridad, por lo que no debe agruparse).
+	class BaseComponentGroup {
+	public:
+		using size_type = BaseComponentManager::size_type;
+		BaseComponentGroup() = default;
+		virtual ~BaseComponentGroup() = default;
+		BaseComponentGroup(const BaseComponentGroup&) = delete;
+		BaseComponentGroup& operator=(const BaseComponentGroup&) = delete;
+		//Debe llamarse despues de registrar el nuevo handle en el GameObject
+		virtual void OnComponentAdded(const GameObject& gameObject) noexcept = 0;
+		//Debe llamarse antes de remover la componente de su manager
+		virtual void OnComponentRemoved(const GameObject& gameObject) noexcept = 0;
+		size_type GetCount() const noexcept { return m_count; }
+	protected:
+		size_type m_count = 0;
+	};
+
+	template <typename ...ComponentTypes>
+	class ComponentGroup : public BaseComponentGroup {
+		static_assert(sizeof...(ComponentTypes) > 1, "A component group needs at least two component types");
+		static_assert((is_component<ComponentTypes> && ...), "Template parameter is not a component");
+	public:
+		ComponentGroup(ComponentManager<ComponentTypes>& ... managers) noexcept;
+		virtual void OnComponentAdded(const GameObject& gameObject) noexcept override;
+		virtual void OnComponentRemoved(const GameObject& gameObject) noexcept override;
+		bool IsMember(const GameObject& gameObject) const noexcept;
+		GameObject* GetOwnerByIndex(size_type i) noexcept;
+		template <typename ComponentType>
+		ComponentType& Get(size_type i) noexcept;
+		template <typename Func>
+		void ForEach(Func&& func) noexcept;
+	private:
+		template <typename ComponentType>
+		ComponentManager<ComponentType>& GetManager() const noexcept { return *std::get<ComponentManager<ComponentType>*>(m_managers); }
+		std::tuple<ComponentManager<ComponentTypes>*...> m_managers;
+	};
+
+}
+#include "Detail/ComponentGroup_Implementation.hpp"
+#endif
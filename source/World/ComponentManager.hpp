@@ -9,6 +9,7 @@
 namespace Mona {
 	class GameObject;
 	class EventManager;
+	class BaseComponentGroup;
 	class BaseComponentManager {
 	public:
 		using size_type = typename InnerComponentHandle::size_type;
@@ -21,6 +22,11 @@ namespace Mona {
 		virtual void RemoveComponent(const InnerComponentHandle& handle) = 0;
 		BaseComponentManager(const BaseComponentManager&) = delete;
 		BaseComponentManager& operator=(const BaseComponentManager&) = delete;
+		BaseComponentGroup* GetOwningGroup() const noexcept { return m_owningGroup; }
+		void SetOwningGroup(BaseComponentGroup* group) noexcept { m_owningGroup = group; }
+	private:
+		//Grupo que mantiene empaquetadas las componentes de este manager (nullptr si no hay)
+		BaseComponentGroup* m_owningGroup = nullptr;
 	};
 
 	template <typename ComponentType>
@@ -48,6 +54,7 @@ namespace Mona {
 		size_type GetCount() const noexcept;
 		GameObject* GetOwner(const InnerComponentHandle& handle) const noexcept;
 		GameObject* GetOwnerByIndex(size_type i) noexcept;
+		size_type GetComponentIndex(const InnerComponentHandle& handle) const noexcept;
 		ComponentType& operator[](size_type index) noexcept;
 		const ComponentType& operator[](size_type index) const noexcept;
 		bool IsValid(const InnerComponentHandle& handle) const noexcept;
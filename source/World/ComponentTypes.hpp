@@ -26,6 +26,24 @@ namespace Mona {
 		return static_cast<uint8_t>(EComponentType::ComponentTypeCount);
 	}
 	template <typename ...ComponentTypes> struct DependencyList {};
+	template <typename ...ComponentTypes> struct ComponentTypeList {};
+
+	//Mascara de bits con un bit por tipo de componente (indexado por componentIndex)
+	using ComponentMask = uint32_t;
+	static_assert(GetComponentTypeCount() <= sizeof(ComponentMask) * 8, "ComponentMask is too small for the number of component types");
+	template <typename ...ComponentTypes>
+	constexpr ComponentMask GetComponentMask() {
+		return ((ComponentMask(1) << ComponentTypes::componentIndex) | ... | ComponentMask(0));
+	}
+	template <typename ...ComponentTypes>
+	constexpr ComponentMask GetDependencyMask(DependencyList<ComponentTypes...>) {
+		return GetComponentMask<ComponentTypes...>();
+	}
+	template <typename ...ComponentTypes>
+	constexpr ComponentMask GetComponentMask(ComponentTypeList<ComponentTypes...>) {
+		return GetComponentMask<ComponentTypes...>();
+	}
+	constexpr ComponentMask AllComponentsMask = (ComponentMask(1) << GetComponentTypeCount()) - 1;
 
 	class TransformComponent;
 	class StaticMeshComponent;
@@ -44,6 +62,17 @@ namespace Mona {
 	template <typename ComponentType>
 		class ComponentManager;
 
+	using AllComponentTypes = ComponentTypeList<TransformComponent,
+		CameraComponent,
+		StaticMeshComponent,
+		RigidBodyComponent,
+		AudioSourceComponent,
+		DirectionalLightComponent,
+		SpotLightComponent,
+		PointLightComponent,
+		SkeletalMeshComponent,
+		IKNavigationComponent>;
+
 	template <typename ComponentType>
 	inline constexpr bool is_component = is_any<ComponentType,
 		TransformComponent,
@@ -0,0 +1,78 @@
+#pragma once
+#ifndef COMPONENTGROUP_IMPLEMENTATION_HPP
+#define COMPONENTGROUP_IMPLEMENTATION_HPP
+#include "../../Core/Log.hpp"
+#include "../GameObject.hpp"
+namespace Mona {
+
+	template <typename ...ComponentTypes>
+	ComponentGroup<ComponentTypes...>::ComponentGroup(ComponentManager<ComponentTypes>& ... managers) noexcept :
+		BaseComponentGroup(),
+		m_managers(&managers...)
+	{
+		MONA_ASSERT(((managers.GetOwningGroup() == nullptr) && ...),
+			"ComponentGroup Error: A component manager can only be owned by one group");
+		(managers.SetOwningGroup(this), ...);
+		//Se empaquetan los GameObjects que ya poseen todas las componentes del grupo
+		using FirstType = std::tuple_element_t<0, std::tuple<ComponentTypes...>>;
+		auto& firstManager = GetManager<FirstType>();
+		for (size_type i = 0; i < firstManager.GetCount(); i++) {
+			OnComponentAdded(*firstManager.GetOwnerByIndex(i));
+		}
+	}
+
+	template <typename ...ComponentTypes>
+	bool ComponentGroup<ComponentTypes...>::IsMember(const GameObject& gameObject) const noexcept {
+		if (!(gameObject.HasComponent<ComponentTypes>() && ...))
+			return false;
+		//Todos los miembros ocupan el rango [0, m_count) de cada manager, basta revisar uno de ellos
+		using FirstType = std::tuple_element_t<0, std::tuple<ComponentTypes...>>;
+		return GetManager<FirstType>().GetComponentIndex(gameObject.GetInnerComponentHandle<FirstType>()) < m_count;
+	}
+
+	template <typename ...ComponentTypes>
+	void ComponentGroup<ComponentTypes...>::OnComponentAdded(const GameObject& gameObject) noexcept {
+		if (!(gameObject.HasComponent<ComponentTypes>() && ...) || IsMember(gameObject))
+			return;
+		//Se mueve cada componente del GameObject a la primera posicion libre del grupo
+		(GetManager<ComponentTypes>().SwapComponents(
+			GetManager<ComponentTypes>().GetComponentIndex(gameObject.GetInnerComponentHandle<ComponentTypes>()), m_count), ...);
+		++m_count;
+	}
+
+	template <typename ...ComponentTypes>
+	void ComponentGroup<ComponentTypes...>::OnComponentRemoved(const GameObject& gameObject) noexcept {
+		if (!IsMember(gameObject))
+			return;
+		//Se mueve cada componente a la ultima posicion del grupo y luego se achica el rango empaquetado
+		const size_type last = m_count - 1;
+		(GetManager<ComponentTypes>().SwapComponents(
+			GetManager<ComponentTypes>().GetComponentIndex(gameObject.GetInnerComponentHandle<ComponentTypes>()), last), ...);
+		--m_count;
+	}
+
+	template <typename ...ComponentTypes>
+	GameObject* ComponentGroup<ComponentTypes...>::GetOwnerByIndex(size_type i) noexcept {
+		MONA_ASSERT(i < m_count, "ComponentGroup Error: index out of range");
+		using FirstType = std::tuple_element_t<0, std::tuple<ComponentTypes...>>;
+		return GetManager<FirstType>().GetOwnerByIndex(i);
+	}
+
+	template <typename ...ComponentTypes>
+	template <typename ComponentType>
+	ComponentType& ComponentGroup<ComponentTypes...>::Get(size_type i) noexcept {
+		static_assert(is_any<ComponentType, ComponentTypes...>, "ComponentType is not part of the group");
+		MONA_ASSERT(i < m_count, "ComponentGroup Error: index out of range");
+		return GetManager<ComponentType>()[i];
+	}
+
+	template <typename ...ComponentTypes>
+	template <typename Func>
+	void ComponentGroup<ComponentTypes...>::ForEach(Func&& func) noexcept {
+		for (size_type i = 0; i < m_count; i++) {
+			func(*GetOwnerByIndex(i), GetManager<ComponentTypes>()[i]...);
+		}
+	}
+
+}
+#endif
@@ -161,6 +161,16 @@ namespace Mona {
 		MONA_ASSERT(i < m_componentOwners.size(), "ComponentManager Error: owner index out of range");
 		return m_componentOwners[i];
 	}
+	template <typename ComponentType>
+	typename ComponentManager<ComponentType>::size_type ComponentManager<ComponentType>::GetComponentIndex(const InnerComponentHandle& handle) const noexcept
+	{
+		auto index = handle.m_index;
+		MONA_ASSERT(index < m_handleEntries.size(), "ComponentManager Error: handle index out of range");
+		MONA_ASSERT(m_handleEntries[index].active == true, "ComponentManager Error: Trying to access inactive handle");
+		MONA_ASSERT(m_handleEntries[index].generation == handle.m_generation, "ComponentManager Error: handle with incorrect generation");
+		return m_handleEntries[index].index;
+	}
+
 	template <typename ComponentType>
 	ComponentType& ComponentManager<ComponentType>::operator[](ComponentManager<ComponentType>::size_type index) noexcept
 	{
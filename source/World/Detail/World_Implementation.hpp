@@ -24,6 +24,8 @@ namespace Mona {
 		auto managerPtr = static_cast<ComponentManager<ComponentType>*>(m_componentManagers[ComponentType::componentIndex].get());
 		InnerComponentHandle componentHandle = managerPtr->AddComponent(&gameObject, std::forward<Args>(args)...);
 		gameObject.AddInnerComponentHandle(ComponentType::componentIndex, componentHandle);
+		if (managerPtr->GetOwningGroup() != nullptr)
+			managerPtr->GetOwningGroup()->OnComponentAdded(gameObject);
 		return ComponentHandle<ComponentType>(componentHandle, managerPtr);
 
 	}
@@ -31,7 +33,10 @@ namespace Mona {
 	void World::RemoveComponent(const ComponentHandle<ComponentType>& handle) noexcept {
 		static_assert(is_component<ComponentType>, "Template parameter is not a component");
 		auto managerPtr = static_cast<ComponentManager<ComponentType>*>(m_componentManagers[ComponentType::componentIndex].get());
-		auto objectPtr = m_objectManager.GetGameObjectPointer(managerPtr->GetOwner(handle.GetInnerHandle()));
+		GameObject* objectPtr = managerPtr->GetOwner(handle.GetInnerHandle());
+		MONA_ASSERT(CheckDependents<ComponentType>(*objectPtr, AllComponentTypes()), "World Error: Trying to remove component other components depend on");
+		if (managerPtr->GetOwningGroup() != nullptr)
+			managerPtr->GetOwningGroup()->OnComponentRemoved(*objectPtr);
 		managerPtr->RemoveComponent(handle.GetInnerHandle());
 		objectPtr->RemoveInnerComponentHandle(ComponentType::componentIndex);
 	}
@@ -78,6 +83,22 @@ namespace Mona {
 		return BaseGameObjectHandle(gameObject->GetInnerObjectHandle(), gameObject);
 	}
 
+	template <typename ...ComponentTypes>
+	ComponentGroup<ComponentTypes...>* World::CreateComponentGroup() noexcept {
+		using FirstType = std::tuple_element_t<0, std::tuple<ComponentTypes...>>;
+		if (((GetComponentManager<ComponentTypes>().GetOwningGroup() != nullptr) || ...)) {
+			//Un grupo con el mismo conjunto de componentes se comparte, cualquier otro solapamiento es un error
+			auto existingGroup = dynamic_cast<ComponentGroup<ComponentTypes...>*>(GetComponentManager<FirstType>().GetOwningGroup());
+			if (existingGroup != nullptr)
+				return existingGroup;
+			MONA_LOG_ERROR("World Error: A component manager can only be owned by one group, the group was not created");
+			return nullptr;
+		}
+		auto groupPtr = new ComponentGroup<ComponentTypes...>(GetComponentManager<ComponentTypes>()...);
+		m_componentGroups.emplace_back(groupPtr);
+		return groupPtr;
+	}
+
 	template <typename ComponentType>
 	auto& World::GetComponentManager() noexcept {
 		static_assert(is_component<ComponentType>, "Template parameter is not a component");
@@ -86,11 +107,29 @@ namespace Mona {
 
 	template <typename ComponentType, typename ... ComponentTypes>
 	bool World::CheckDependencies(const GameObject& gameObject, DependencyList<ComponentTypes...> dl) const {
-		return ((gameObject.HasComponent<ComponentTypes>() ? 
-			true : 
-			(Log::GetLogger()->error("World Error: Component {0} depends on {1}, please add it first", ComponentType::componentName, ComponentTypes::componentName), false) ) 
-			&& ...);
-	
+		constexpr ComponentMask dependencyMask = GetComponentMask<ComponentTypes...>();
+		if ((gameObject.GetComponentMask() & dependencyMask) == dependencyMask)
+			return true;
+		//Solo en caso de error se recorren las dependencias para reportar las que faltan
+		((gameObject.HasComponent<ComponentTypes>() ?
+			void() :
+			Log::GetLogger()->error("World Error: Component {0} depends on {1}, please add it first", ComponentType::componentName, ComponentTypes::componentName))
+			, ...);
+		return false;
+	}
+
+	template <typename ComponentType, typename ... ComponentTypes>
+	bool World::CheckDependents(const GameObject& gameObject, ComponentTypeList<ComponentTypes...> cl) const {
+		//Mascara de todos los tipos de componentes que dependen de ComponentType
+		constexpr ComponentMask dependentsMask = (((GetDependencyMask(typename ComponentTypes::dependencies()) & GetComponentMask<ComponentType>()) != 0 ?
+			GetComponentMask<ComponentTypes>() : ComponentMask(0)) | ... | ComponentMask(0));
+		if ((gameObject.GetComponentMask() & dependentsMask) == 0)
+			return true;
+		((gameObject.HasComponent<ComponentTypes>() && (dependentsMask & GetComponentMask<ComponentTypes>()) != 0 ?
+			Log::GetLogger()->error("World Error: Component {0} depends on {1}, please remove it first", ComponentTypes::componentName, ComponentType::componentName) :
+			void())
+			, ...);
+		return false;
 	}
 
 
@@ -2,7 +2,7 @@
 #ifndef GAMEOBJECT_HPP
 #define GAMEOBJECT_HPP
 #include <limits>
-#include <unordered_map>
+#include <array>
 #include "GameObjectTypes.hpp"
 #include "ComponentTypes.hpp"
 namespace Mona {
@@ -36,17 +36,15 @@ namespace Mona {
 		template <typename ComponentType>
 		bool HasComponent() const {
 			static_assert(is_component<ComponentType>, "Template parameter is not a component");
-			auto it = m_componentHandles.find(ComponentType::componentIndex);
-			return it != m_componentHandles.end();
+			return (m_componentMask & Mona::GetComponentMask<ComponentType>()) != 0;
 		}
+		ComponentMask GetComponentMask() const noexcept { return m_componentMask; }
 		InnerGameObjectHandle GetInnerObjectHandle() const noexcept { return m_objectHandle; }
 		template <typename ComponentType>
 		InnerComponentHandle GetInnerComponentHandle() const {
 			static_assert(is_component<ComponentType>, "Template parameter is not a component");
-			auto it = m_componentHandles.find(ComponentType::componentIndex);
-			if (it != m_componentHandles.end())
-				return it->second;
-			else return InnerComponentHandle();
+			//Las entradas de componentes ausentes contienen un handle invalido
+			return m_componentHandles[ComponentType::componentIndex];
 		}
 	protected:
 		GameObject(const GameObject&) = delete;
@@ -66,15 +64,18 @@ namespace Mona {
 		}
 
 		void RemoveInnerComponentHandle(decltype(GetComponentTypeCount()) componentIndex){
-			m_componentHandles.erase(componentIndex);
+			m_componentHandles[componentIndex] = InnerComponentHandle();
+			m_componentMask &= ~(ComponentMask(1) << componentIndex);
 		}
 
 		void AddInnerComponentHandle(decltype(GetComponentTypeCount()) componentIndex, InnerComponentHandle componentHandle) {
 			m_componentHandles[componentIndex] = componentHandle;
+			m_componentMask |= ComponentMask(1) << componentIndex;
 		}
 		InnerGameObjectHandle m_objectHandle;
 		EState m_state;
-		std::unordered_map<decltype(GetComponentTypeCount()), InnerComponentHandle> m_componentHandles;
+		std::array<InnerComponentHandle, GetComponentTypeCount()> m_componentHandles;
+		ComponentMask m_componentMask = 0;
 	};
 }
 #endif
\ No newline at end of file
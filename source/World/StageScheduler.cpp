@@ -0,0 +1,51 @@
+#include "StageScheduler.hpp"
+#include "../Core/JobSystem.hpp"
+namespace Mona {
+
+	void StageScheduler::AddStage(SystemStage stage) noexcept {
+		m_stages.push_back(std::move(stage));
+		m_wavesDirty = true;
+	}
+
+	void StageScheduler::BuildWaves() noexcept {
+		m_waveStarts.clear();
+		size_t waveStart = 0;
+		for (size_t i = 0; i < m_stages.size(); i++) {
+			bool conflict = false;
+			for (size_t j = waveStart; j < i && !conflict; j++) {
+				conflict = m_stages[i].ConflictsWith(m_stages[j]);
+			}
+			if (i == 0 || conflict) {
+				waveStart = i;
+				m_waveStarts.push_back(i);
+			}
+		}
+		m_wavesDirty = false;
+	}
+
+	void StageScheduler::Run(JobSystem& jobSystem, float timeStep) noexcept {
+		if (m_wavesDirty)
+			BuildWaves();
+		for (size_t w = 0; w < m_waveStarts.size(); w++) {
+			const size_t begin = m_waveStarts[w];
+			const size_t end = w + 1 < m_waveStarts.size() ? m_waveStarts[w + 1] : m_stages.size();
+			if (end - begin == 1) {
+				m_stages[begin].update(timeStep);
+				continue;
+			}
+			JobSystem::JobGroup group;
+			for (size_t i = begin; i < end; i++) {
+				if (!m_stages[i].mainThreadOnly) {
+					SystemStage* stage = &m_stages[i];
+					jobSystem.Run(group, [stage, timeStep]() { stage->update(timeStep); });
+				}
+			}
+			for (size_t i = begin; i < end; i++) {
+				if (m_stages[i].mainThreadOnly)
+					m_stages[i].update(timeStep);
+			}
+			jobSystem.Wait(group);
+		}
+	}
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+#ifndef STAGESCHEDULER_HPP
+#define STAGESCHEDULER_HPP
+#include <functional>
+#include <vector>
+#include "ComponentTypes.hpp"
+namespace Mona {
+	class JobSystem;
+	/*
+	* Etapa de la actualizacion de World. Cada etapa declara que tipos de componentes lee y escribe, de modo que etapas
+	* consecutivas sin conflictos de acceso puedan ejecutarse concurrentemente. Las etapas que deben correr en el hilo
+	* principal (GL, GLFW, callbacks de usuario) se marcan con mainThreadOnly.
+	*/
+	struct SystemStage {
+		const char* name;
+		ComponentMask readMask;
+		ComponentMask writeMask;
+		bool mainThreadOnly;
+		std::function<void(float)> update;
+		bool ConflictsWith(const SystemStage& other) const noexcept {
+			return (writeMask & (other.readMask | other.writeMask)) != 0 || (other.writeMask & readMask) != 0;
+		}
+	};
+
+	class StageScheduler {
+	public:
+		StageScheduler() = default;
+		StageScheduler(const StageScheduler&) = delete;
+		StageScheduler& operator=(const StageScheduler&) = delete;
+		void AddStage(SystemStage stage) noexcept;
+		/*
+		* Ejecuta todas las etapas en el orden en que fueron agregadas. Etapas consecutivas que no tienen conflictos entre si
+		* forman una ola: las que no requieren el hilo principal se encolan en jobSystem y el resto se ejecuta en orden en el
+		* hilo llamador, la siguiente ola comienza cuando todas terminan.
+		*/
+		void Run(JobSystem& jobSystem, float timeStep) noexcept;
+	private:
+		void BuildWaves() noexcept;
+		std::vector<SystemStage> m_stages;
+		//Indice de la primera etapa de cada ola, las olas son rangos contiguos de m_stages
+		std::vector<size_t> m_waveStarts;
+		bool m_wavesDirty = true;
+	};
+}
+#endif
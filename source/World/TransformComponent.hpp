@@ -2,13 +2,25 @@
 #ifndef TRANSFORMCOMPONENT_HPP
 #define TRANSFORMCOMPONENT_HPP
 #include <string_view>
+#include <vector>
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include "ComponentTypes.hpp"
+#include "GameObjectTypes.hpp"
 namespace Mona {
+	class GameObject;
+	class TransformHierarchy;
+	class TransformLifetimePolicy;
+	/*
+	* Las transformaciones pueden organizarse en una jerarquia (ver World::SetParent), en cuyo caso los valores locales son relativos
+	* al padre. La matriz local se recalcula en cada modificacion, por lo que los getters son de solo lectura y pueden llamarse desde
+	* varios hilos a la vez, mientras que la matriz local-a-mundo de las transformaciones con padre es propagada por
+	* TransformHierarchy una vez por frame.
+	*/
 	class TransformComponent {
 	public:
-		using LifetimePolicyType = DefaultLifetimePolicy<TransformComponent>;
+		friend class TransformHierarchy;
+		using LifetimePolicyType = TransformLifetimePolicy;
 		using dependencies = DependencyList<>;
 		static constexpr std::string_view componentName = "TransformComponent";
 		static constexpr uint8_t componentIndex = GetComponentIndex(EComponentType::TransformComponent);
@@ -18,7 +30,10 @@ namespace Mona {
 			const glm::vec3& scale = glm::vec3(1.0f)) :
 			localTranslation(translation),
 			localRotation(rotation),
-			localScale(scale) {}
+			localScale(scale)
+		{
+			UpdateLocalMatrix();
+		}
 
 		const glm::vec3& GetLocalTranslation() const {
 			return localTranslation;
@@ -29,40 +44,69 @@ namespace Mona {
 		const glm::vec3& GetLocalScale() const {
 			return localScale;
 		}
-		glm::mat4 GetModelMatrix() const {
-			const glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), localTranslation);
-			const glm::mat4 rotationMatrix = glm::toMat4(localRotation);
-			const glm::mat4 scaleMatrix = glm::scale(glm::mat4(1.0f), localScale);
-
-			return translationMatrix * rotationMatrix * scaleMatrix;
+		const glm::mat4& GetLocalMatrix() const {
+			return m_localMatrix;
+		}
+		/*
+		* Matriz local-a-mundo. Para transformaciones con padre corresponde al valor de la ultima propagacion de la jerarquia,
+		* realizada por World despues de la actualizacion de la aplicacion y antes del rendering.
+		*/
+		const glm::mat4& GetModelMatrix() const {
+			return HasParent() ? m_worldMatrix : GetLocalMatrix();
+		}
+		glm::vec3 GetWorldTranslation() const {
+			return HasParent() ? glm::vec3(m_worldMatrix[3]) : localTranslation;
+		}
+		const glm::fquat& GetWorldRotation() const {
+			return HasParent() ? m_worldRotation : localRotation;
 		}
 		glm::mat4 GetViewMatrixFromTransform() const {
-			const glm::vec3 up = GetUpVector();
-			const glm::vec3 front = GetFrontVector();
-			return glm::lookAt(localTranslation, localTranslation + front, up);
+			const glm::vec3 up = GetWorldUpVector();
+			const glm::vec3 front = GetWorldFrontVector();
+			const glm::vec3 position = GetWorldTranslation();
+			return glm::lookAt(position, position + front, up);
+		}
+		bool HasParent() const {
+			return m_parentHandle.m_index != INVALID_INDEX;
+		}
+		const InnerComponentHandle& GetParentHandle() const {
+			return m_parentHandle;
+		}
+		const std::vector<InnerComponentHandle>& GetChildrenHandles() const {
+			return m_childrenHandles;
+		}
+		//Contador que aumenta cada vez que cambia la matriz local-a-mundo, permite a otros sistemas detectar cambios
+		uint32_t GetVersion() const {
+			return m_version;
 		}
 		void Translate(glm::vec3 translation) {
 			localTranslation += translation;
+			SetDirty();
 		}
 
 		void SetTranslation(const glm::vec3 translation) {
 			localTranslation = translation;
+			SetDirty();
 		}
 
 		void Scale(glm::vec3 scale){
 			localScale *= scale;
+			SetDirty();
 		}
 
 		void SetScale(const glm::vec3& scale) {
 			localScale = scale;
+			SetDirty();
 		}
 		
 		void Rotate(glm::vec3 axis, float angle){
 			localRotation = glm::rotate(localRotation, angle, axis);
+			SetDirty();
 		}
 
 		void SetRotation(const glm::fquat& rotation) {
 			localRotation = rotation;
+			SetDirty();
 		}
 
 		glm::vec3 GetUpVector() const {
@@ -77,10 +121,55 @@ namespace Mona {
 			return glm::rotate(localRotation, glm::vec3(0.0f, 1.0f, 0.0f));
 		}
 
+		glm::vec3 GetWorldUpVector() const {
+			return glm::rotate(GetWorldRotation(), glm::vec3(0.0f, 0.0f, 1.0f));
+		}
+
+		glm::vec3 GetWorldRightVector() const {
+			return glm::rotate(GetWorldRotation(), glm::vec3(1.0f, 0.0f, 0.0f));
+		}
+
+		glm::vec3 GetWorldFrontVector() const {
+			return glm::rotate(GetWorldRotation(), glm::vec3(0.0f, 1.0f, 0.0f));
+		}
+
 	private:
+		void SetDirty() {
+			UpdateLocalMatrix();
+			m_worldDirty = true;
+			m_version++;
+		}
+		void UpdateLocalMatrix() {
+			const glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), localTranslation);
+			const glm::mat4 rotationMatrix = glm::toMat4(localRotation);
+			const glm::mat4 scaleMatrix = glm::scale(glm::mat4(1.0f), localScale);
+			m_localMatrix = translationMatrix * rotationMatrix * scaleMatrix;
+		}
 		glm::vec3 localTranslation;
 		glm::fquat localRotation;
 		glm::vec3 localScale;
+		InnerComponentHandle m_parentHandle;
+		std::vector<InnerComponentHandle> m_childrenHandles;
+		glm::mat4 m_localMatrix = glm::mat4(1.0f);
+		glm::mat4 m_worldMatrix = glm::mat4(1.0f);
+		glm::fquat m_worldRotation = glm::fquat(1.0f, 0.0f, 0.0f, 0.0f);
+		//Indica a la propagacion que los descendientes deben actualizarse
+		bool m_worldDirty = true;
+		uint32_t m_version = 0;
+	};
+
+	/*
+	* Al remover una TransformComponent sus hijos pasan a ser raices (conservando sus valores locales) y esta se elimina de la
+	* lista de hijos de su padre.
+	*/
+	class TransformLifetimePolicy {
+	public:
+		TransformLifetimePolicy() = default;
+		TransformLifetimePolicy(TransformHierarchy* hierarchyPtr) : m_hierarchyPtr(hierarchyPtr) {}
+		void OnAddComponent(GameObject* gameObjectPtr, TransformComponent& transform, const InnerComponentHandle& handle) noexcept {}
+		void OnRemoveComponent(GameObject* gameObjectPtr, TransformComponent& transform, const InnerComponentHandle& handle) noexcept;
+	private:
+		TransformHierarchy* m_hierarchyPtr = nullptr;
 	};
 
 
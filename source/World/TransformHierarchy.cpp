@@ -0,0 +1,110 @@
+#include "TransformHierarchy.hpp"
+#include <algorithm>
+#include "../Core/Log.hpp"
+namespace Mona {
+
+	void TransformLifetimePolicy::OnRemoveComponent(GameObject* gameObjectPtr, TransformComponent& transform, const InnerComponentHandle& handle) noexcept {
+		if (m_hierarchyPtr != nullptr)
+			m_hierarchyPtr->OnTransformRemoved(transform, handle);
+	}
+
+	void TransformHierarchy::StartUp(ComponentManager<TransformComponent>* transformManagerPtr) noexcept {
+		m_transformManagerPtr = transformManagerPtr;
+		m_order.clear();
+		m_orderDirty = false;
+	}
+
+	void TransformHierarchy::SetParent(const InnerComponentHandle& child, const InnerComponentHandle& parent) noexcept {
+		auto& transformManager = *m_transformManagerPtr;
+		MONA_ASSERT(transformManager.IsValid(child) && transformManager.IsValid(parent), "TransformHierarchy Error: Invalid transform handle");
+		//Recorremos los ancestros del nuevo padre para evitar ciclos
+		InnerComponentHandle ancestor = parent;
+		while (ancestor.m_index != INVALID_INDEX) {
+			MONA_ASSERT(ancestor.m_index != child.m_index || ancestor.m_generation != child.m_generation,
+				"TransformHierarchy Error: A transform can't be parented to itself or to one of its descendants");
+			ancestor = transformManager.GetComponentPointer(ancestor)->m_parentHandle;
+		}
+		TransformComponent* childPtr = transformManager.GetComponentPointer(child);
+		if (childPtr->HasParent())
+			Detach(*childPtr, child);
+		childPtr->m_parentHandle = parent;
+		childPtr->m_worldDirty = true;
+		childPtr->m_version++;
+		transformManager.GetComponentPointer(parent)->m_childrenHandles.push_back(child);
+		m_orderDirty = true;
+	}
+
+	void TransformHierarchy::RemoveParent(const InnerComponentHandle& child) noexcept {
+		auto& transformManager = *m_transformManagerPtr;
+		MONA_ASSERT(transformManager.IsValid(child), "TransformHierarchy Error: Invalid transform handle");
+		TransformComponent* childPtr = transformManager.GetComponentPointer(child);
+		if (childPtr->HasParent())
+			Detach(*childPtr, child);
+	}
+
+	void TransformHierarchy::OnTransformRemoved(TransformComponent& transform, const InnerComponentHandle& handle) noexcept {
+		if (transform.HasParent())
+			Detach(transform, handle);
+		if (transform.m_childrenHandles.empty())
+			return;
+		//Los hijos pasan a ser raices conservando sus valores locales
+		for (auto& childHandle : transform.m_childrenHandles) {
+			TransformComponent* childPtr = m_transformManagerPtr->GetComponentPointer(childHandle);
+			childPtr->m_parentHandle = InnerComponentHandle();
+			childPtr->m_worldDirty = true;
+			childPtr->m_version++;
+		}
+		transform.m_childrenHandles.clear();
+		m_orderDirty = true;
+	}
+
+	void TransformHierarchy::Detach(TransformComponent& child, const InnerComponentHandle& childHandle) noexcept {
+		auto& siblings = m_transformManagerPtr->GetComponentPointer(child.m_parentHandle)->m_childrenHandles;
+		auto it = std::find_if(siblings.begin(), siblings.end(), [&childHandle](const InnerComponentHandle& sibling) {
+			return sibling.m_index == childHandle.m_index && sibling.m_generation == childHandle.m_generation; });
+		if (it != siblings.end())
+			siblings.erase(it);
+		child.m_parentHandle = InnerComponentHandle();
+		child.m_worldDirty = true;
+		child.m_version++;
+		m_orderDirty = true;
+	}
+
+	void TransformHierarchy::RebuildOrder() noexcept {
+		auto& transformManager = *m_transformManagerPtr;
+		m_order.clear();
+		for (decltype(transformManager.GetCount()) i = 0; i < transformManager.GetCount(); i++) {
+			const TransformComponent& transform = transformManager[i];
+			if (transform.HasParent() || transform.m_childrenHandles.empty())
+				continue;
+			m_order.insert(m_order.end(), transform.m_childrenHandles.begin(), transform.m_childrenHandles.end());
+		}
+		//Recorrido en anchura: los hijos de cada transformacion se agregan al final de m_order a medida que se visita
+		for (size_t i = 0; i < m_order.size(); i++) {
+			const auto& children = transformManager.GetComponentPointer(m_order[i])->m_childrenHandles;
+			m_order.insert(m_order.end(), children.begin(), children.end());
+		}
+		m_orderDirty = false;
+	}
+
+	void TransformHierarchy::UpdateWorldMatrices() noexcept {
+		auto& transformManager = *m_transformManagerPtr;
+		if (m_orderDirty)
+			RebuildOrder();
+		for (const InnerComponentHandle& handle : m_order) {
+			TransformComponent& child = *transformManager.GetComponentPointer(handle);
+			const TransformComponent& parent = *transformManager.GetComponentPointer(child.m_parentHandle);
+			if (!parent.m_worldDirty && !child.m_worldDirty)
+				continue;
+			child.m_worldMatrix = parent.GetModelMatrix() * child.GetLocalMatrix();
+			child.m_worldRotation = parent.GetWorldRotation() * child.localRotation;
+			child.m_worldDirty = true;
+			child.m_version++;
+		}
+		//Se limpian las marcas para el siguiente frame
+		for (decltype(transformManager.GetCount()) i = 0; i < transformManager.GetCount(); i++) {
+			transformManager[i].m_worldDirty = false;
+		}
+	}
+
+}
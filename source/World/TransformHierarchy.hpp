@@ -0,0 +1,34 @@
+#pragma once
+#ifndef TRANSFORMHIERARCHY_HPP
+#define TRANSFORMHIERARCHY_HPP
+#include <vector>
+#include "GameObjectTypes.hpp"
+#include "ComponentManager.hpp"
+#include "TransformComponent.hpp"
+namespace Mona {
+	/*
+	* Mantiene las relaciones padre-hijo entre TransformComponents y propaga sus matrices local-a-mundo.
+	* Las transformaciones con padre se recorren en anchura desde las raices, de modo que cada padre se procesa antes que
+	* sus hijos y basta una unica pasada lineal para actualizar toda la jerarquia. El orden solo se reconstruye cuando
+	* cambia la estructura de la jerarquia.
+	*/
+	class TransformHierarchy {
+	public:
+		TransformHierarchy() = default;
+		TransformHierarchy(const TransformHierarchy&) = delete;
+		TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+		void StartUp(ComponentManager<TransformComponent>* transformManagerPtr) noexcept;
+		void SetParent(const InnerComponentHandle& child, const InnerComponentHandle& parent) noexcept;
+		void RemoveParent(const InnerComponentHandle& child) noexcept;
+		void OnTransformRemoved(TransformComponent& transform, const InnerComponentHandle& handle) noexcept;
+		void UpdateWorldMatrices() noexcept;
+	private:
+		void Detach(TransformComponent& child, const InnerComponentHandle& childHandle) noexcept;
+		void RebuildOrder() noexcept;
+		ComponentManager<TransformComponent>* m_transformManagerPtr = nullptr;
+		//Transformaciones con padre, ordenadas de modo que cada una aparece despues que su padre
+		std::vector<InnerComponentHandle> m_order;
+		bool m_orderDirty = false;
+	};
+}
+#endif
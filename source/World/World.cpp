@@ -1,5 +1,7 @@
 #include "World.hpp"
 #include "../Core/Config.hpp"
+#include "../Core/AssetCache.hpp"
+#include "../Core/AsyncAssetLoader.hpp"
 #include "../Event/Events.hpp"
 #include "../DebugDrawing/DebugDrawingSystem.hpp"
 #include "../Audio/AudioClipManager.hpp"
@@ -13,7 +15,9 @@
 #include <chrono>
 namespace Mona {
 	
-	World::World(Application& app) : 
+	World::World(Application& app) : World(app, Config::GetInstance().getValueOrDefault<bool>("headless", false)) {}
+
+	World::World(Application& app, bool headless) : 
 		m_objectManager(),
 		m_eventManager(), 
 		m_window(), 
@@ -24,6 +28,9 @@ namespace Mona {
 		m_ambientLight(glm::vec3(0.1f))
 	{
 		auto& config = Config::GetInstance();
+		//Debe fijarse antes de iniciar cualquier subsistema, Window, Input, Renderer y AudioSystem lo consultan en su StartUp
+		HeadlessMode::SetEnabled(headless);
+		AssetCache::SetEnabled(config.getValueOrDefault<bool>("asset_cache", true));
 
 		m_componentManagers[TransformComponent::componentIndex].reset(new ComponentManager<TransformComponent>());
 		m_componentManagers[CameraComponent::componentIndex].reset(new ComponentManager<CameraComponent>());
@@ -46,6 +53,13 @@ namespace Mona {
 		auto& ikNavigationDataManager = GetComponentManager<IKNavigationComponent>();
 
 		const GameObjectID expectedObjects = config.getValueOrDefault<int>("expected_number_of_gameobjects", 1000);
+		m_jobSystem.StartUp(config.getValueOrDefault<int>("worker_thread_count", -1));
+		AsyncAssetLoader::GetInstance().StartUp(config.getValueOrDefault<int>("asset_loader_thread_count", 2));
+		m_assetUploadTimeBudget = config.getValueOrDefault<float>("asset_upload_time_budget_ms", 2.0f) / 1000.0f;
+		transformDataManager.SetLifetimePolicy(TransformLifetimePolicy(&m_transformHierarchy));
+		staticMeshDataManager.SetLifetimePolicy(StaticMeshLifetimePolicy(&transformDataManager, &m_renderer.GetCullingSystem()));
+		skeletalMeshDataManager.SetLifetimePolicy(SkeletalMeshLifetimePolicy(&transformDataManager, &m_renderer.GetCullingSystem()));
+		m_transformHierarchy.StartUp(&transformDataManager);
 		rigidBodyDataManager.SetLifetimePolicy(RigidBodyLifetimePolicy(&transformDataManager, &m_physicsCollisionSystem));
 		audioSourceDataManager.SetLifetimePolicy(AudioSourceComponentLifetimePolicy(&m_audioSystem));
 		ikNavigationDataManager.SetLifetimePolicy(IKNavigationLifetimePolicy(&transformDataManager, 
@@ -55,18 +69,24 @@ namespace Mona {
 		m_objectManager.StartUp(expectedObjects);
 		for (auto& componentManager : m_componentManagers)
 			componentManager->StartUp(m_eventManager, expectedObjects);
+		m_skeletalMeshGroup = CreateComponentGroup<SkeletalMeshComponent, TransformComponent>();
 		m_application = std::move(app);
 		m_renderer.StartUp(m_eventManager, m_debugDrawingSystemIKNav.get());
 		//m_renderer.StartUp(m_eventManager, m_debugDrawingSystemPhysics.get());
 		m_audioSystem.StartUp();
-		m_debugDrawingSystemIKNav->StartUp(&m_ikNavigationSystyem);
+		if (!headless)
+			m_debugDrawingSystemIKNav->StartUp(&m_ikNavigationSystyem);
 		//m_debugDrawingSystemPhysics->StartUp(&m_physicsCollisionSystem);
+		RegisterStages();
 		m_application.StartUp(*this);
 	
 	}
 	
 	World::~World() {
 		m_application.UserShutDown(*this);
+		m_jobSystem.ShutDown();
+		//Las cargas pendientes deben terminar antes de que los managers liberen sus recursos
+		AsyncAssetLoader::GetInstance().ShutDown();
 		m_objectManager.ShutDown(*this);
 		for (auto& componentManager : m_componentManagers)
 			componentManager->ShutDown(m_eventManager);
@@ -79,7 +99,8 @@ namespace Mona {
 		SkeletonManager::GetInstance().ShutDown();
 		AnimationClipManager::GetInstance().ShutDown();
 		m_renderer.ShutDown(m_eventManager);
-		m_debugDrawingSystemIKNav->ShutDown();
+		if (!HeadlessMode::IsEnabled())
+			m_debugDrawingSystemIKNav->ShutDown();
 		//m_debugDrawingSystemPhysics->ShutDown();
 		m_window.ShutDown();
 		m_input.ShutDown(m_eventManager);
@@ -92,12 +113,20 @@ namespace Mona {
 	}
 
 	void World::DestroyGameObject(GameObject& gameObject) noexcept {
-		auto& innerComponentHandles = gameObject.m_componentHandles;
+		const ComponentMask componentMask = gameObject.GetComponentMask();
+		//Los grupos deben sacar al GameObject mientras todos sus handles siguen siendo validos
+		for (uint8_t i = 0; i < GetComponentTypeCount(); i++) {
+			BaseComponentGroup* group = m_componentManagers[i]->GetOwningGroup();
+			if ((componentMask & (ComponentMask(1) << i)) != 0 && group != nullptr)
+				group->OnComponentRemoved(gameObject);
+		}
 		//Es necesario remover primero todas las componentes antes de destruir el GameObject
-		for (auto& it : innerComponentHandles) {
-			m_componentManagers[it.first]->RemoveComponent(it.second);
+		for (uint8_t i = 0; i < GetComponentTypeCount(); i++) {
+			if ((componentMask & (ComponentMask(1) << i)) == 0)
+				continue;
+			m_componentManagers[i]->RemoveComponent(gameObject.m_componentHandles[i]);
+			gameObject.RemoveInnerComponentHandle(i);
 		}
-		innerComponentHandles.clear();
 		m_objectManager.DestroyGameObject(gameObject.GetInnerObjectHandle());
 	}
 
@@ -120,15 +149,31 @@ namespace Mona {
 		return m_window;
 	}
 
+	JobSystem& World::GetJobSystem() noexcept {
+		return m_jobSystem;
+	}
+
+	AnimationSystem& World::GetAnimationSystem() noexcept {
+		return m_animationSystem;
+	}
+
 	void World::EndApplication() noexcept {
 		m_shouldClose = true;
 	}
 
-	void World::StartMainLoop() noexcept {
+	void World::StartMainLoop(uint64_t frameCount) noexcept {
 		std::chrono::time_point<std::chrono::steady_clock> startTime = std::chrono::steady_clock::now();
 		float averageTimeStep = 1.0f/20.0f;
-		while (!m_window.ShouldClose() && !m_shouldClose)
+		//Sin ventana no hay sincronizacion vertical que regule el loop, se simula con un paso de tiempo fijo para que las
+		//ejecuciones sean reproducibles. Un valor no positivo usa el tiempo real transcurrido.
+		const float headlessTimeStep = HeadlessMode::IsEnabled() ?
+			Config::GetInstance().getValueOrDefault<float>("headless_time_step", 1.0f / 60.0f) : 0.0f;
+		for (uint64_t frame = 0; (frameCount == 0 || frame < frameCount) && !m_window.ShouldClose() && !m_shouldClose; frame++)
 		{
+			if (headlessTimeStep > 0.0f) {
+				Update(headlessTimeStep);
+				continue;
+			}
 			std::chrono::time_point<std::chrono::steady_clock> newTime = std::chrono::steady_clock::now();
 			const auto frameTime = newTime - startTime;
 			startTime = newTime;
@@ -149,43 +194,77 @@ namespace Mona {
 
 	void World::Update(float timeStep) noexcept
 	{
-		auto &transformDataManager = GetComponentManager<TransformComponent>();
-		auto &staticMeshDataManager = GetComponentManager<StaticMeshComponent>();
-		auto &cameraDataManager = GetComponentManager<CameraComponent>();
-		auto& rigidBodyDataManager = GetComponentManager<RigidBodyComponent>();
-		auto& audioSourceDataManager = GetComponentManager<AudioSourceComponent>();
-		auto& directionalLightDataManager = GetComponentManager<DirectionalLightComponent>();
-		auto& spotLightDataManager = GetComponentManager<SpotLightComponent>();
-		auto& pointLightDataManager = GetComponentManager<PointLightComponent>();
-		auto& skeletalMeshDataManager = GetComponentManager<SkeletalMeshComponent>();
-		auto& ikNavigationDataManager = GetComponentManager<IKNavigationComponent>();
-		m_input.Update();
-		m_physicsCollisionSystem.StepSimulation(timeStep);
-		m_physicsCollisionSystem.SubmitCollisionEvents(*this, m_eventManager, rigidBodyDataManager);
-		m_ikNavigationSystyem.UpdateAllRigs(ikNavigationDataManager, 
-			transformDataManager, 
-			staticMeshDataManager, 
-			skeletalMeshDataManager, 
-			timeStep);
-		m_animationSystem.UpdateAllPoses(skeletalMeshDataManager, timeStep);
-		m_objectManager.UpdateGameObjects(*this, m_eventManager, timeStep);
-		m_application.UserUpdate(*this, timeStep);
-		m_audioSystem.Update(m_audoListenerTransformHandle,
-			m_audioListenerOffsetRotation,
-			timeStep,
-			transformDataManager,
-			audioSourceDataManager);
-		m_renderer.Render(m_eventManager,
-			m_cameraHandle,
-			m_ambientLight,
-			staticMeshDataManager,
-			skeletalMeshDataManager,
-			transformDataManager,
-			cameraDataManager,
-			directionalLightDataManager,
-			spotLightDataManager,
-			pointLightDataManager);
-		m_window.Update();
+		//Subidas a GPU y OpenAL de recursos cargados de forma asincrona, acotadas para no provocar saltos en el frame
+		AsyncAssetLoader::GetInstance().ProcessMainThreadTasks(m_assetUploadTimeBudget);
+		m_stageScheduler.Run(m_jobSystem, timeStep);
+	}
+
+	void World::RegisterStages() noexcept
+	{
+		//Las etapas se ejecutan en este orden. Etapas consecutivas sin conflictos de acceso a componentes corren en paralelo,
+		//las que invocan callbacks de usuario declaran acceso a todas las componentes para quedar serializadas.
+		m_stageScheduler.AddStage({ "Input", AllComponentsMask, AllComponentsMask, true,
+			[this](float timeStep) { m_input.Update(); } });
+		m_stageScheduler.AddStage({ "Physics",
+			GetComponentMask(PhysicsCollisionSystem::ReadComponents()),
+			GetComponentMask(PhysicsCollisionSystem::WriteComponents()), false,
+			[this](float timeStep) { m_physicsCollisionSystem.StepSimulation(timeStep); } });
+		m_stageScheduler.AddStage({ "CollisionEvents", AllComponentsMask, AllComponentsMask, true,
+			[this](float timeStep) {
+				m_physicsCollisionSystem.SubmitCollisionEvents(*this, m_eventManager, GetComponentManager<RigidBodyComponent>()); } });
+		m_stageScheduler.AddStage({ "IKNavigation",
+			GetComponentMask(IKNavigationSystem::ReadComponents()),
+			GetComponentMask(IKNavigationSystem::WriteComponents()), false,
+			[this](float timeStep) {
+				m_ikNavigationSystyem.UpdateAllRigs(GetComponentManager<IKNavigationComponent>(),
+					GetComponentManager<TransformComponent>(),
+					GetComponentManager<StaticMeshComponent>(),
+					GetComponentManager<SkeletalMeshComponent>(),
+					GetComponentManager<CameraComponent>(),
+					m_cameraHandle,
+					timeStep,
+					m_jobSystem); } });
+		m_stageScheduler.AddStage({ "Animation",
+			GetComponentMask(AnimationSystem::ReadComponents()),
+			GetComponentMask(AnimationSystem::WriteComponents()), false,
+			[this](float timeStep) {
+				m_animationSystem.UpdateAllPoses(*m_skeletalMeshGroup,
+					GetComponentManager<TransformComponent>(),
+					GetComponentManager<CameraComponent>(),
+					m_cameraHandle,
+					timeStep,
+					m_jobSystem); } });
+		m_stageScheduler.AddStage({ "GameObjects", AllComponentsMask, AllComponentsMask, true,
+			[this](float timeStep) { m_objectManager.UpdateGameObjects(*this, m_eventManager, timeStep); } });
+		m_stageScheduler.AddStage({ "Application", AllComponentsMask, AllComponentsMask, true,
+			[this](float timeStep) { m_application.UserUpdate(*this, timeStep); } });
+		m_stageScheduler.AddStage({ "TransformHierarchy", 0, GetComponentMask(ComponentTypeList<TransformComponent>()), false,
+			[this](float timeStep) { m_transformHierarchy.UpdateWorldMatrices(); } });
+		m_stageScheduler.AddStage({ "Audio",
+			GetComponentMask(AudioSystem::ReadComponents()),
+			GetComponentMask(AudioSystem::WriteComponents()), false,
+			[this](float timeStep) {
+				m_audioSystem.Update(m_audoListenerTransformHandle,
+					m_audioListenerOffsetRotation,
+					timeStep,
+					GetComponentManager<TransformComponent>(),
+					GetComponentManager<AudioSourceComponent>()); } });
+		m_stageScheduler.AddStage({ "Render",
+			GetComponentMask(Renderer::ReadComponents()),
+			GetComponentMask(Renderer::WriteComponents()), true,
+			[this](float timeStep) {
+				m_renderer.Render(m_eventManager,
+					m_cameraHandle,
+					m_ambientLight,
+					GetComponentManager<StaticMeshComponent>(),
+					GetComponentManager<SkeletalMeshComponent>(),
+					GetComponentManager<TransformComponent>(),
+					GetComponentManager<CameraComponent>(),
+					GetComponentManager<DirectionalLightComponent>(),
+					GetComponentManager<SpotLightComponent>(),
+					GetComponentManager<PointLightComponent>()); } });
+		m_stageScheduler.AddStage({ "Window", 0, 0, true,
+			[this](float timeStep) { m_window.Update(); } });
 	}
 
 	void World::SetMainCamera(const ComponentHandle<CameraComponent>& cameraHandle) noexcept {
@@ -200,10 +279,10 @@ namespace Mona {
 		const CameraComponent* camera = cameraDataManager.GetComponentPointer(m_cameraHandle);
 		GameObject* cameraOwner = cameraDataManager.GetOwner(m_cameraHandle);
 		TransformComponent* cameraTransform = transformDataManager.GetComponentPointer(cameraOwner->GetInnerComponentHandle<TransformComponent>());
-		glm::vec3 upVector = cameraTransform->GetUpVector();
-		glm::vec3 rightVector = cameraTransform->GetRightVector();
-		glm::vec3 frontVector = cameraTransform->GetFrontVector();
-		const glm::vec3& cameraPosition = cameraTransform->GetLocalTranslation();
+		glm::vec3 upVector = cameraTransform->GetWorldUpVector();
+		glm::vec3 rightVector = cameraTransform->GetWorldRightVector();
+		glm::vec3 frontVector = cameraTransform->GetWorldFrontVector();
+		const glm::vec3 cameraPosition = cameraTransform->GetWorldTranslation();
 		const glm::ivec2 screenResolution = m_window.GetWindowFrameBufferSize();
 		glm::vec2 screenPercentage = glm::vec2((float)screenPos.x / (float)screenResolution.x, (float)screenPos.y / (float)screenResolution.y);
 		screenPercentage = glm::vec2(-1.0f) + 2.0f * screenPercentage;
@@ -225,6 +304,14 @@ namespace Mona {
 		return m_renderer.CreateMaterial(type, isForSkinning);
 	}
 
+	void World::SetParent(const ComponentHandle<TransformComponent>& child, const ComponentHandle<TransformComponent>& parent) noexcept {
+		m_transformHierarchy.SetParent(child.GetInnerHandle(), parent.GetInnerHandle());
+	}
+
+	void World::RemoveParent(const ComponentHandle<TransformComponent>& child) noexcept {
+		m_transformHierarchy.RemoveParent(child.GetInnerHandle());
+	}
+
 	void World::SetAudioListenerTransform(const ComponentHandle<TransformComponent>& transformHandle,
 		const glm::fquat& offsetRotation) noexcept{
 		m_audoListenerTransformHandle = transformHandle.GetInnerHandle();
@@ -281,7 +368,7 @@ namespace Mona {
 
 	JointPose World::GetJointWorldPose(const ComponentHandle<SkeletalMeshComponent>& skeletalMeshHandle, uint32_t jointIndex) noexcept {
 		auto transform = GetSiblingComponentHandle<TransformComponent>(skeletalMeshHandle);
-		JointPose worldPose(transform->GetLocalRotation(), transform->GetLocalTranslation(), transform->GetLocalScale());
+		JointPose worldPose(transform->GetWorldRotation(), transform->GetWorldTranslation(), transform->GetLocalScale());
 		const AnimationController& animController = skeletalMeshHandle->GetAnimationController();
 		return worldPose * animController.GetJointModelPose(jointIndex);
 	}
@@ -6,9 +6,14 @@
 #include "GameObjectManager.hpp"
 #include "ComponentTypes.hpp"
 #include "TransformComponent.hpp"
+#include "TransformHierarchy.hpp"
 #include "ComponentManager.hpp"
+#include "ComponentGroup.hpp"
 #include "ComponentHandle.hpp"
 #include "GameObjectHandle.hpp"
+#include "StageScheduler.hpp"
+#include "../Core/JobSystem.hpp"
+#include "../Core/HeadlessMode.hpp"
 #include "../Event/EventManager.hpp"
 #include "../Platform/Window.hpp"
 #include "../Platform/Input.hpp"
@@ -36,6 +41,7 @@
 #include <array>
 #include <filesystem>
 #include <string>
+#include <atomic>
 
 namespace Mona {
 
@@ -71,11 +77,22 @@ namespace Mona {
 		BaseComponentManager::size_type GetComponentCount() const noexcept;
 		template <typename ComponentType>
 		BaseGameObjectHandle GetOwner(const ComponentHandle<ComponentType>& handle) noexcept;
+		/*
+		* Crea un grupo que empaqueta a los GameObjects con todas las componentes indicadas. Si ya existe un grupo con el
+		* mismo conjunto de componentes se retorna ese. Como cada manager pertenece a lo mas a un grupo, si alguno ya es
+		* parte de otro grupo se retorna nullptr. World agrupa SkeletalMeshComponent con TransformComponent, por lo que
+		* ningun otro grupo puede incluir TransformComponent (las mallas estaticas y los cuerpos rigidos usan los handles).
+		*/
+		template <typename ...ComponentTypes>
+		ComponentGroup<ComponentTypes...>* CreateComponentGroup() noexcept;
 
 		EventManager& GetEventManager() noexcept;
 		Input& GetInput() noexcept;
 		Window& GetWindow() noexcept;
+		JobSystem& GetJobSystem() noexcept;
+		AnimationSystem& GetAnimationSystem() noexcept;
 		void EndApplication() noexcept;
+		bool IsHeadless() const noexcept { return HeadlessMode::IsEnabled(); }
 
 		void SetMainCamera(const ComponentHandle<CameraComponent>& cameraHandle) noexcept;
 		glm::vec3 MainCameraScreenPositionToWorld(const glm::ivec2& screenPos) noexcept;
@@ -91,6 +108,13 @@ namespace Mona {
 		AllHitsRaycastResult AllHitsRayTest(const glm::vec3& rayFrom, const glm::vec3& rayTo);
 
 
+		/*
+		* Hace que los valores locales de child sean relativos a parent. La matriz local-a-mundo de child se actualiza una vez
+		* por frame, despues de la actualizacion de la aplicacion.
+		*/
+		void SetParent(const ComponentHandle<TransformComponent>& child, const ComponentHandle<TransformComponent>& parent) noexcept;
+		void RemoveParent(const ComponentHandle<TransformComponent>& child) noexcept;
+
 		void SetAudioListenerTransform(const ComponentHandle<TransformComponent>& transformHandle,
 			const glm::fquat& offRotation = glm::fquat(1.0f, 0.0f, 0.0f, 0.0f)) noexcept;
 		ComponentHandle<TransformComponent> GetAudioListenerTransform() noexcept;
@@ -114,24 +138,36 @@ namespace Mona {
 
 	private:
 		World(Application& app);
+		World(Application& app, bool headless);
 		~World();
-		void StartMainLoop() noexcept;
+		void StartMainLoop(uint64_t frameCount = 0) noexcept;
 		void Update(float timeStep) noexcept;
+		void RegisterStages() noexcept;
 
 		template <typename ComponentType>
 		auto& GetComponentManager() noexcept;
 
 		template <typename ComponentType, typename ...ComponentTypes>
 		bool CheckDependencies(const GameObject& gameObject, DependencyList<ComponentTypes...> dl) const;
+		template <typename ComponentType, typename ...ComponentTypes>
+		bool CheckDependents(const GameObject& gameObject, ComponentTypeList<ComponentTypes...> cl) const;
 
+		JobSystem m_jobSystem;
+		StageScheduler m_stageScheduler;
+		//Tiempo maximo en segundos dedicado cada frame a subir recursos cargados de forma asincrona
+		float m_assetUploadTimeBudget = 0.002f;
 		EventManager m_eventManager;
 		Input m_input;
 		Window m_window;
 		Application& m_application;
-		bool m_shouldClose;
+		std::atomic<bool> m_shouldClose;
 
 		GameObjectManager m_objectManager;
 		std::array<std::unique_ptr<BaseComponentManager>, GetComponentTypeCount()> m_componentManagers;
+		std::vector<std::unique_ptr<BaseComponentGroup>> m_componentGroups;
+		//Recorrido por AnimationSystem, alinea cada SkeletalMeshComponent con la TransformComponent de su GameObject
+		SkeletalMeshGroup* m_skeletalMeshGroup = nullptr;
+		TransformHierarchy m_transformHierarchy;
 
 		Renderer m_renderer;
 		InnerComponentHandle m_cameraHandle;
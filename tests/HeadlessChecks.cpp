@@ -0,0 +1,1449 @@
+#include "MonaEngine.hpp"
+#include "Core/AssetCache.hpp"
+#include "Core/JobSystem.hpp"
+#include "World/TransformComponent.hpp"
+#include "Rendering/Frustum.hpp"
+#include "Rendering/DynamicAABBTree.hpp"
+#include "Rendering/RenderQueue.hpp"
+#include "Animation/CompressedAnimationClip.hpp"
+#include "Animation/PoseSoA.hpp"
+#include "Animation/SkinnedMesh.hpp"
+#include "CharacterNavigation/EnvironmentData.hpp"
+#include "CharacterNavigation/ParametricCurves.hpp"
+#include "CharacterNavigation/IKRigController.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <random>
+#include <tuple>
+
+namespace Mona {
+	// World, AnimationClip y las clases de IK declaran a MonaTest como friend, lo que permite revisar su estado interno.
+	class MonaTest {
+	public:
+		template <typename ComponentType>
+		static ComponentManager<ComponentType>& GetComponentManager(World& world) {
+			return world.GetComponentManager<ComponentType>();
+		}
+		static SkeletalMeshGroup* GetSkeletalMeshGroup(World& world) {
+			return world.m_skeletalMeshGroup;
+		}
+		static AnimationSystem& GetAnimationSystem(World& world) {
+			return world.m_animationSystem;
+		}
+		static const std::vector<AnimationClip::AnimationTrack>& GetAnimationTracks(const AnimationClip& clip) {
+			return clip.m_animationTracks;
+		}
+		static const std::vector<AnimationClip::JointIndex>& GetTrackJointIndices(const AnimationClip& clip) {
+			return clip.m_trackJointIndices;
+		}
+		// Agrega una IKAnimation al rig como IKRigController::addAnimation, sin trayectorias ni validaciones.
+		static IKAnimation* AddIKAnimation(IKRig& rig, std::shared_ptr<AnimationClip> animationClip) {
+			animationClip->DecompressRotations();
+			AnimationIndex animationIndex = rig.m_ikAnimations.size();
+			rig.m_ikAnimations.push_back(IKAnimation(animationClip, AnimationType::WALKING, animationIndex, &rig.m_forwardKinematics));
+			for (IKChain& chain : rig.m_ikChains)
+				chain.m_currentEETargets.push_back(glm::vec3(0));
+			IKAnimation* ikAnimation = rig.getIKAnimation(animationIndex);
+			ikAnimation->m_animationIndex = animationIndex;
+			ikAnimation->m_currentFrameIndex = 0;
+			ikAnimation->refresh();
+			return ikAnimation;
+		}
+		static ForwardKinematics& GetForwardKinematics(IKRig& rig) {
+			return rig.m_forwardKinematics;
+		}
+		static InverseKinematics& GetInverseKinematics(IKRig& rig) {
+			return rig.m_inverseKinematics;
+		}
+		static bool SolveTwoBoneChain(InverseKinematics& inverseKinematics, IKChain* chain, IKAnimation* ikAnimation, FrameIndex targetFrame,
+			std::vector<std::pair<JointIndex, float>>& outAngles) {
+			return inverseKinematics.solveTwoBoneChain(chain, ikAnimation, targetFrame, outAngles);
+		}
+		static float GetTwoBoneMaxError(const InverseKinematics& inverseKinematics) {
+			return inverseKinematics.m_twoBoneMaxError;
+		}
+		static const std::vector<bool>& GetDescentChainMask(const InverseKinematics& inverseKinematics) {
+			return inverseKinematics.m_descentChainMask;
+		}
+		static std::vector<JointRotation>& GetOriginalJointRotations(IKAnimation& ikAnimation, FrameIndex frame) {
+			return ikAnimation.m_originalJointRotations[frame];
+		}
+	};
+}
+
+/*
+* Chequeos automaticos de los sistemas del motor que no requieren ventana ni contexto OpenGL. Los que necesitan un
+* World corren dentro del motor en modo headless, y los que usan los modelos y animaciones de los ejemplos se omiten si
+* estos no estan disponibles. Cada chequeo fallido se reporta con su archivo y linea, y el programa retorna un codigo
+* distinto de cero si alguno fallo, de modo que CTest lo marque como fallido.
+*/
+static int s_checkCount = 0;
+static int s_failedCheckCount = 0;
+
+#define CHECK(condition) Check((condition), #condition, __FILE__, __LINE__)
+
+void Check(bool passed, const char* expression, const char* file, int line) {
+	s_checkCount++;
+	if (!passed) {
+		s_failedCheckCount++;
+		std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+	}
+}
+
+void RunChecks(const char* name, const std::function<void()>& checks) {
+	const int failedBefore = s_failedCheckCount;
+	checks();
+	std::printf("[%s] %s\n", s_failedCheckCount == failedBefore ? "  OK  " : "FAILED", name);
+}
+
+void SkipChecks(const char* name, const char* reason) {
+	std::printf("[ SKIP ] %s (%s)\n", name, reason);
+}
+
+Mona::AABB RandomBox(std::mt19937& generator, float range, float maxSize) {
+	std::uniform_real_distribution<float> position(-range, range);
+	std::uniform_real_distribution<float> size(0.1f, maxSize);
+	const glm::vec3 minPoint(position(generator), position(generator), position(generator));
+	return Mona::AABB(minPoint, minPoint + glm::vec3(size(generator), size(generator), size(generator)));
+}
+
+// El arbol debe reportar exactamente las hojas cuya caja engordada intersecta el frustum, luego de mover y destruir hojas.
+void CheckDynamicAABBTreeQuery() {
+	constexpr int boxCount = 512;
+	std::mt19937 generator(3);
+	Mona::DynamicAABBTree tree;
+	std::vector<int32_t> proxies(boxCount);
+	std::vector<Mona::AABB> boxes(boxCount);
+	std::vector<bool> alive(boxCount, true);
+	for (int i = 0; i < boxCount; i++) {
+		boxes[i] = RandomBox(generator, 100.0f, 5.0f);
+		proxies[i] = tree.CreateProxy(boxes[i], static_cast<uint32_t>(i));
+	}
+	for (int i = 0; i < boxCount; i += 3) {
+		boxes[i] = RandomBox(generator, 100.0f, 5.0f);
+		tree.MoveProxy(proxies[i], boxes[i]);
+	}
+	for (int i = 1; i < boxCount; i += 7) {
+		tree.DestroyProxy(proxies[i]);
+		alive[i] = false;
+	}
+	CHECK(tree.GetProxyCount() == static_cast<uint32_t>(std::count(alive.begin(), alive.end(), true)));
+
+	const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 80.0f);
+	const glm::vec3 eyes[] = { glm::vec3(0.0f), glm::vec3(-90.0f, 10.0f, 30.0f), glm::vec3(50.0f, -50.0f, 0.0f) };
+	std::vector<uint32_t> visible;
+	for (const glm::vec3& eye : eyes) {
+		const Mona::Frustum frustum(projection * glm::lookAt(eye, glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f)));
+		visible.clear();
+		tree.Query(frustum, visible);
+		std::sort(visible.begin(), visible.end());
+		std::vector<uint32_t> expected;
+		for (int i = 0; i < boxCount; i++) {
+			if (alive[i] && frustum.Intersects(tree.GetFatAABB(proxies[i])))
+				expected.push_back(static_cast<uint32_t>(i));
+			//La caja engordada siempre contiene la caja real, por lo que nunca se descarta un objeto visible
+			if (alive[i])
+				CHECK(tree.GetFatAABB(proxies[i]).Contains(boxes[i]));
+		}
+		CHECK(visible == expected);
+	}
+}
+
+// Las llaves quedan ordenadas, los elementos que comparten estado quedan contiguos y los lotes respetan sus limites.
+void CheckRenderQueue() {
+	constexpr int itemCount = 2048;
+	std::mt19937 generator(5);
+	std::vector<Mona::RenderQueue::Item> items(itemCount);
+	std::vector<float> depths(itemCount);
+	for (int i = 0; i < itemCount; i++) {
+		items[i].modelMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(static_cast<float>(i), 0.0f, 0.0f));
+		//Como en el motor, el programa queda determinado por el material
+		const uint32_t materialIndex = generator() % 16;
+		items[i].programID = 1 + materialIndex % 4;
+		items[i].material = reinterpret_cast<Mona::Material*>(static_cast<uintptr_t>(16 * (1 + materialIndex)));
+		items[i].vertexArrayID = 1 + generator() % 32;
+		items[i].indexCount = 36;
+		items[i].componentIndex = i;
+		items[i].type = generator() % 8 == 0 ? Mona::RenderQueue::ItemType::SkeletalMesh : Mona::RenderQueue::ItemType::StaticMesh;
+		depths[i] = static_cast<float>(generator() % 1000) / 10.0f;
+	}
+	Mona::RenderQueue renderQueue;
+	for (uint32_t minInstanceCount : { 0u, 1u, 4u }) {
+		renderQueue.Begin(100.0f);
+		for (int i = 0; i < itemCount; i++)
+			renderQueue.Push(items[i], depths[i]);
+		renderQueue.Sort();
+		renderQueue.BuildBatches(minInstanceCount);
+		CHECK(renderQueue.GetCount() == itemCount);
+
+		//El orden es una permutacion de los elementos con llaves no decrecientes
+		std::vector<bool> seen(itemCount, false);
+		for (uint32_t i = 0; i < renderQueue.GetCount(); i++) {
+			const uint32_t componentIndex = renderQueue.GetSortedItem(i).componentIndex;
+			CHECK(!seen[componentIndex]);
+			seen[componentIndex] = true;
+			if (0 < i)
+				CHECK(renderQueue.GetSortedKey(i - 1) <= renderQueue.GetSortedKey(i));
+		}
+
+		//Cada combinacion de tipo, programa, material y VAO ocupa un unico rango, ordenado de adelante hacia atras
+		using State = std::tuple<int, uint32_t, Mona::Material*, uint32_t>;
+		auto stateOf = [](const Mona::RenderQueue::Item& item) {
+			return State(static_cast<int>(item.type), item.programID, item.material, item.vertexArrayID);
+		};
+		std::map<State, uint32_t> lastPosition;
+		for (uint32_t i = 0; i < renderQueue.GetCount(); i++) {
+			const Mona::RenderQueue::Item& item = renderQueue.GetSortedItem(i);
+			auto it = lastPosition.find(stateOf(item));
+			if (it != lastPosition.end()) {
+				CHECK(it->second == i - 1);
+				CHECK(depths[renderQueue.GetSortedItem(i - 1).componentIndex] <= depths[item.componentIndex]);
+			}
+			lastPosition[stateOf(item)] = i;
+		}
+
+		//Los lotes cubren el orden completo, y los instanciados son rangos homogeneos de StaticMesh
+		uint32_t nextFirst = 0;
+		uint32_t instanceCount = 0;
+		const auto& instanceData = renderQueue.GetInstanceData();
+		for (const Mona::RenderQueue::Batch& batch : renderQueue.GetBatches()) {
+			CHECK(batch.first == nextFirst);
+			CHECK(batch.count > 0);
+			nextFirst = batch.first + batch.count;
+			if (!batch.instanced) {
+				CHECK(batch.count == 1);
+				continue;
+			}
+			CHECK(minInstanceCount > 0 && batch.count >= minInstanceCount);
+			CHECK(batch.instanceOffset == instanceCount);
+			const Mona::RenderQueue::Item& firstItem = renderQueue.GetSortedItem(batch.first);
+			for (uint32_t i = 0; i < batch.count; i++) {
+				const Mona::RenderQueue::Item& item = renderQueue.GetSortedItem(batch.first + i);
+				CHECK(item.type == Mona::RenderQueue::ItemType::StaticMesh);
+				CHECK(item.material == firstItem.material && item.vertexArrayID == firstItem.vertexArrayID);
+				CHECK(instanceData[batch.instanceOffset + i].modelMatrix == item.modelMatrix);
+			}
+			//El lote es maximo: el elemento siguiente no podria haberse agregado
+			if (nextFirst < renderQueue.GetCount()) {
+				const Mona::RenderQueue::Item& next = renderQueue.GetSortedItem(nextFirst);
+				CHECK(next.type != Mona::RenderQueue::ItemType::StaticMesh || next.material != firstItem.material ||
+					next.vertexArrayID != firstItem.vertexArrayID);
+			}
+			instanceCount += batch.count;
+		}
+		CHECK(nextFirst == renderQueue.GetCount());
+		CHECK(instanceData.size() == instanceCount);
+	}
+
+	//Materiales creados y destruidos cada frame: sus identificadores se reciclan y nunca se agotan, por lo que cada
+	//material sigue ocupando un unico rango del orden aun despues de pasar por mas materiales de los que caben en la llave
+	constexpr uint32_t materialsPerFrame = 4096;
+	const uint32_t frameCount = 2 * (1u << Mona::RenderQueue::MaterialBits) / materialsPerFrame;
+	for (uint32_t frame = 0; frame < frameCount; frame++) {
+		renderQueue.Begin(100.0f);
+		for (uint32_t i = 0; i < 2 * materialsPerFrame; i++) {
+			Mona::RenderQueue::Item item = items[i % itemCount];
+			item.programID = 1;
+			item.type = Mona::RenderQueue::ItemType::StaticMesh;
+			//El primer material se mantiene vivo durante todos los frames
+			const uintptr_t material = i % materialsPerFrame == 0 ? 0 : frame * materialsPerFrame + i % materialsPerFrame;
+			item.material = reinterpret_cast<Mona::Material*>(16 * (1 + material));
+			item.componentIndex = i;
+			renderQueue.Push(item, depths[i % itemCount]);
+		}
+		renderQueue.Sort();
+		std::map<std::pair<Mona::Material*, uint32_t>, uint32_t> lastPosition;
+		bool grouped = true;
+		for (uint32_t i = 0; i < renderQueue.GetCount(); i++) {
+			const Mona::RenderQueue::Item& item = renderQueue.GetSortedItem(i);
+			const auto state = std::make_pair(item.material, item.vertexArrayID);
+			auto it = lastPosition.find(state);
+			if (it != lastPosition.end() && it->second != i - 1)
+				grouped = false;
+			lastPosition[state] = i;
+		}
+		CHECK(grouped);
+	}
+}
+
+// Un archivo de cache se lee tal como se escribio, y cualquier diferencia en la llave o un archivo truncado lo invalida.
+void CheckAssetCache() {
+	const std::string cachePath = (std::filesystem::temp_directory_path() / "mona_headless_checks.monacache").string();
+	Mona::AssetCache::Key key;
+	key.type = Mona::AssetCache::AssetType::Mesh;
+	key.importFlags = 7;
+	key.sourceHash = Mona::AssetCache::HashString("source");
+	key.dependencyHash = Mona::AssetCache::HashString("dependency");
+	const std::vector<glm::vec3> positions = { glm::vec3(1.0f, 2.0f, 3.0f), glm::vec3(-4.0f, 5.0f, -6.0f), glm::vec3(0.5f) };
+	const std::vector<unsigned int> indices = { 0, 1, 2, 2, 1, 0, 7 };
+	{
+		Mona::AssetCacheWriter writer(key);
+		writer.Write(static_cast<uint32_t>(42));
+		writer.WriteArray(positions);
+		writer.WriteString("mesh name");
+		writer.WriteArray(indices);
+		CHECK(writer.Save(cachePath));
+	}
+	{
+		Mona::AssetCacheReader reader(cachePath, key);
+		CHECK(reader.IsValid());
+		uint32_t value = 0;
+		std::vector<glm::vec3> readPositions;
+		std::string name;
+		uint64_t indexCount = 0;
+		CHECK(reader.Read(value) && value == 42);
+		CHECK(reader.ReadArray(readPositions) && readPositions == positions);
+		CHECK(reader.ReadString(name) && name == "mesh name");
+		const unsigned int* readIndices = reader.ReadArray<unsigned int>(indexCount);
+		CHECK(readIndices != nullptr && indexCount == indices.size());
+		CHECK(readIndices != nullptr && std::equal(indices.begin(), indices.end(), readIndices));
+		CHECK(reinterpret_cast<uintptr_t>(readIndices) % Mona::AssetCacheWriter::ArrayAlignment == 0);
+		//Leer mas alla del final invalida el lector
+		CHECK(!reader.Read(value));
+		CHECK(!reader.IsValid());
+	}
+	auto isValidWith = [&cachePath](const Mona::AssetCache::Key& otherKey) {
+		Mona::AssetCacheReader reader(cachePath, otherKey);
+		return reader.IsValid();
+	};
+	Mona::AssetCache::Key otherKey = key;
+	otherKey.type = Mona::AssetCache::AssetType::SkinnedMesh;
+	CHECK(!isValidWith(otherKey));
+	otherKey = key;
+	otherKey.importFlags = 3;
+	CHECK(!isValidWith(otherKey));
+	otherKey = key;
+	otherKey.sourceHash = Mona::AssetCache::HashString("modified source");
+	CHECK(!isValidWith(otherKey));
+	otherKey = key;
+	otherKey.dependencyHash = Mona::AssetCache::HashString("modified dependency");
+	CHECK(!isValidWith(otherKey));
+
+	//Un archivo truncado a la mitad conserva la cabecera pero sus arreglos ya no caben
+	std::filesystem::resize_file(cachePath, std::filesystem::file_size(cachePath) / 2);
+	{
+		Mona::AssetCacheReader reader(cachePath, key);
+		uint32_t value = 0;
+		std::vector<glm::vec3> readPositions;
+		std::string name;
+		std::vector<unsigned int> readIndices;
+		reader.Read(value);
+		reader.ReadArray(readPositions);
+		reader.ReadString(name);
+		reader.ReadArray(readIndices);
+		CHECK(!reader.IsValid());
+	}
+	std::filesystem::remove(cachePath);
+	CHECK(!isValidWith(key));
+}
+
+// Las poses muestreadas del clip comprimido se mantienen dentro del presupuesto de error de cada canal.
+void CheckCompressedAnimationClip() {
+	constexpr int frameCount = 61;
+	constexpr int trackCount = 4;
+	const float duration = 2.0f;
+	std::vector<std::vector<Mona::JointPose>> frames(frameCount, std::vector<Mona::JointPose>(trackCount));
+	for (int f = 0; f < frameCount; f++) {
+		const float t = duration * f / (frameCount - 1);
+		//El track 0 es constante, los demas animan distintos canales
+		frames[f][0] = Mona::JointPose(glm::angleAxis(0.3f, glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(1.0f));
+		frames[f][1] = Mona::JointPose(glm::angleAxis(2.5f * std::sin(t), glm::normalize(glm::vec3(1.0f, 0.5f, 0.0f))),
+			glm::vec3(0.0f, 0.5f, 0.0f), glm::vec3(1.0f));
+		frames[f][2] = Mona::JointPose(glm::angleAxis(0.1f * t, glm::vec3(0.0f, 0.0f, 1.0f)),
+			glm::vec3(3.0f * std::cos(t), 0.2f * t, -7.0f * std::sin(2.0f * t)), glm::vec3(1.0f));
+		frames[f][3] = Mona::JointPose(glm::fquat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(0.0f),
+			glm::vec3(1.0f + 0.5f * std::sin(3.0f * t)));
+	}
+	const std::vector<int> trackJointIndices = { 3, 0, 2, 1 };
+	Mona::CompressedAnimationClip::Settings settings;
+	Mona::CompressedAnimationClip clip(frames, trackJointIndices, duration, settings);
+	CHECK(clip.GetFrameCount() == frameCount);
+	CHECK(clip.GetTrackCount() == trackCount);
+
+	auto angleBetween = [](const glm::fquat& lhs, const glm::fquat& rhs) {
+		const glm::fquat delta = glm::conjugate(glm::normalize(lhs)) * glm::normalize(rhs);
+		return 2.0f * std::atan2(glm::length(glm::vec3(delta.x, delta.y, delta.z)), std::abs(delta.w));
+	};
+	//Margen por la aritmetica de punto flotante del decodificador
+	const float tolerance = 1e-5f;
+	std::vector<Mona::JointPose> pose(trackCount);
+	for (int f = 0; f < frameCount; f++) {
+		clip.Sample(pose, duration * f / (frameCount - 1));
+		for (int i = 0; i < trackCount; i++) {
+			const Mona::JointPose& expected = frames[f][i];
+			const Mona::JointPose& sampled = pose[trackJointIndices[i]];
+			CHECK(angleBetween(expected.m_rotation, sampled.m_rotation) <= settings.rotationError + tolerance);
+			CHECK(glm::length(expected.m_translation - sampled.m_translation) <= settings.translationError + tolerance);
+			CHECK(glm::length(expected.m_scale - sampled.m_scale) <= settings.scaleError + tolerance);
+		}
+	}
+	//La memoria comprimida debe ser menor que las poses sin comprimir
+	CHECK(clip.GetMemoryUsage() < frameCount * trackCount * sizeof(Mona::JointPose));
+}
+
+bool NearlyEqual(float first, float second, float tolerance) {
+	return std::abs(first - second) <= tolerance * (1.0f + std::max(std::abs(first), std::abs(second)));
+}
+
+bool NearlyEqual(const glm::mat4& first, const glm::mat4& second, float tolerance) {
+	for (int c = 0; c < 4; c++) {
+		for (int r = 0; r < 4; r++) {
+			if (!NearlyEqual(first[c][r], second[c][r], tolerance))
+				return false;
+		}
+	}
+	return true;
+}
+
+Mona::JointPose RandomJointPose(std::mt19937& generator) {
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> scale(0.5f, 1.5f);
+	const glm::fquat rotation = glm::normalize(glm::fquat(unit(generator), unit(generator), unit(generator), unit(generator)));
+	return Mona::JointPose(rotation, 2.0f * glm::vec3(unit(generator), unit(generator), unit(generator)),
+		glm::vec3(scale(generator), scale(generator), scale(generator)));
+}
+
+// Los kernels SoA dan lo mismo que JointPose y JointPoseToMat4, con y sin articulaciones de relleno en el ultimo grupo.
+void CheckPoseSoAKernels() {
+	std::mt19937 generator(11);
+	for (uint32_t jointCount : { 1u, 3u, 5u, 7u, 13u }) {
+		//Jerarquia aleatoria con los padres antes que los hijos y, desde 7 articulaciones, una segunda raiz
+		std::vector<int32_t> parents(jointCount, -1);
+		for (uint32_t i = 1; i < jointCount; i++)
+			parents[i] = (jointCount >= 7 && i == 5) ? -1 : static_cast<int32_t>(generator() % i);
+		std::vector<Mona::JointPose> firstPoses, secondPoses;
+		std::vector<glm::mat4> inverseBindPoses;
+		for (uint32_t i = 0; i < jointCount; i++) {
+			firstPoses.push_back(RandomJointPose(generator));
+			secondPoses.push_back(RandomJointPose(generator));
+			inverseBindPoses.push_back(Mona::JointPoseToMat4(RandomJointPose(generator)));
+		}
+		Mona::SkeletonSoA skeleton;
+		skeleton.Build(parents, inverseBindPoses);
+		Mona::PoseSoA firstPose, secondPose, blendedPose;
+		firstPose.Resize(jointCount);
+		secondPose.Resize(jointCount);
+		blendedPose.Resize(jointCount);
+		firstPose.SetFromJointPoses(firstPoses);
+		secondPose.SetFromJointPoses(secondPoses);
+		CHECK(firstPose.GetPaddedJointCount() % Mona::PoseSoA::LaneCount == 0);
+
+		for (float t : { 0.0f, 0.3f, 1.0f }) {
+			//nlerp por el camino mas corto, que incluye pares de rotaciones en hemisferios opuestos
+			std::vector<Mona::JointPose> expectedPoses(jointCount);
+			for (uint32_t i = 0; i < jointCount; i++) {
+				const glm::fquat& q0 = firstPoses[i].m_rotation;
+				const glm::fquat q1 = glm::dot(q0, secondPoses[i].m_rotation) < 0.0f ? -secondPoses[i].m_rotation : secondPoses[i].m_rotation;
+				expectedPoses[i] = Mona::JointPose(glm::normalize(q0 + t * (q1 - q0)),
+					glm::mix(firstPoses[i].m_translation, secondPoses[i].m_translation, t),
+					glm::mix(firstPoses[i].m_scale, secondPoses[i].m_scale, t));
+			}
+			Mona::BlendPosesSoA(blendedPose, firstPose, secondPose, t);
+			//La salida puede ser una de las entradas
+			Mona::PoseSoA inPlacePose = firstPose;
+			Mona::BlendPosesSoA(inPlacePose, inPlacePose, secondPose, t);
+			for (uint32_t i = 0; i < jointCount; i++) {
+				const glm::mat4 expectedMatrix = Mona::JointPoseToMat4(expectedPoses[i]);
+				CHECK(NearlyEqual(Mona::JointPoseToMat4(blendedPose.GetJointPose(i)), expectedMatrix, 1e-5f));
+				CHECK(NearlyEqual(Mona::JointPoseToMat4(inPlacePose.GetJointPose(i)), expectedMatrix, 1e-5f));
+			}
+
+			//Jerarquia y paleta a partir de la pose interpolada
+			std::vector<Mona::JointPose> modelPoses = expectedPoses;
+			for (uint32_t i = 0; i < jointCount; i++) {
+				if (parents[i] >= 0)
+					modelPoses[i] = modelPoses[parents[i]] * expectedPoses[i];
+			}
+			Mona::LocalToModelSoA(blendedPose, skeleton);
+			std::vector<glm::mat4> palette(jointCount);
+			Mona::BuildMatrixPaletteSoA(blendedPose, skeleton, palette);
+			for (uint32_t i = 0; i < jointCount; i++) {
+				const glm::mat4 expectedMatrix = Mona::JointPoseToMat4(modelPoses[i]);
+				CHECK(NearlyEqual(Mona::JointPoseToMat4(blendedPose.GetJointPose(i)), expectedMatrix, 1e-4f));
+				CHECK(NearlyEqual(palette[i], expectedMatrix * inverseBindPoses[i], 1e-4f));
+			}
+		}
+	}
+}
+
+// El nivel de detalle baja de inmediato al cruzar un umbral, pero solo sube al alejarse del umbral mas que la histeresis.
+void CheckIKNavigationLODHysteresis() {
+	using Mona::IKNavigationLOD;
+	Mona::IKNavigationLODSettings settings;
+	settings.reducedDistance = 10.0f;
+	settings.hipOnlyDistance = 20.0f;
+	settings.animationOnlyDistance = 40.0f;
+	settings.hysteresis = 0.1f;
+	auto select = [&settings](IKNavigationLOD current, float distance) {
+		return Mona::IKRigController::selectLOD(settings, current, distance);
+	};
+	CHECK(select(IKNavigationLOD::FULL, 9.5f) == IKNavigationLOD::FULL);
+	CHECK(select(IKNavigationLOD::FULL, 10.0f) == IKNavigationLOD::REDUCED);
+	CHECK(select(IKNavigationLOD::FULL, 25.0f) == IKNavigationLOD::HIP_ONLY);
+	CHECK(select(IKNavigationLOD::FULL, 50.0f) == IKNavigationLOD::ANIMATION_ONLY);
+	//Dentro del margen se conserva el nivel actual
+	CHECK(select(IKNavigationLOD::REDUCED, 9.5f) == IKNavigationLOD::REDUCED);
+	CHECK(select(IKNavigationLOD::REDUCED, 8.9f) == IKNavigationLOD::FULL);
+	CHECK(select(IKNavigationLOD::HIP_ONLY, 18.5f) == IKNavigationLOD::HIP_ONLY);
+	CHECK(select(IKNavigationLOD::HIP_ONLY, 17.5f) == IKNavigationLOD::REDUCED);
+	CHECK(select(IKNavigationLOD::ANIMATION_ONLY, 37.0f) == IKNavigationLOD::ANIMATION_ONLY);
+	CHECK(select(IKNavigationLOD::ANIMATION_ONLY, 30.0f) == IKNavigationLOD::HIP_ONLY);
+	CHECK(select(IKNavigationLOD::ANIMATION_ONLY, 5.0f) == IKNavigationLOD::FULL);
+	//Un rig que oscila alrededor de un umbral no cambia de nivel en cada frame
+	IKNavigationLOD lod = IKNavigationLOD::FULL;
+	int changes = 0;
+	for (int i = 0; i < 100; i++) {
+		const IKNavigationLOD newLOD = select(lod, i % 2 == 0 ? 10.2f : 9.8f);
+		changes += newLOD != lod ? 1 : 0;
+		lod = newLOD;
+	}
+	CHECK(changes == 1);
+	CHECK(lod == IKNavigationLOD::REDUCED);
+}
+
+// RingLIC conserva los ultimos N puntos y evalua igual que un LIC con esos mismos puntos.
+void CheckRingLIC() {
+	constexpr int capacity = 8;
+	std::mt19937 generator(7);
+	std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> step(0.01f, 0.5f);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	Mona::RingLIC<1, capacity> ring;
+	CHECK(ring.getNumberOfPoints() == 0);
+	CHECK(!ring.inTRange(0.0f));
+	std::vector<glm::vec1> points;
+	std::vector<float> tValues;
+	float t = 0.0f;
+	for (int i = 0; i < 40; i++) {
+		points.push_back(glm::vec1(value(generator)));
+		tValues.push_back(t);
+		ring.insertPoint(points.back(), t);
+		t += step(generator);
+		//Los puntos retenidos son los ultimos insertados, en orden
+		const int expectedCount = std::min(i + 1, capacity);
+		CHECK(ring.getNumberOfPoints() == expectedCount);
+		const int offset = static_cast<int>(tValues.size()) - expectedCount;
+		for (int j = 0; j < expectedCount; j++) {
+			CHECK(ring.getTValue(j) == tValues[offset + j]);
+			CHECK(ring.getCurvePoint(j) == points[offset + j]);
+		}
+		if (expectedCount < 2)
+			continue;
+		const Mona::LIC<1> curve(std::vector<glm::vec1>(points.begin() + offset, points.end()),
+			std::vector<float>(tValues.begin() + offset, tValues.end()));
+		CHECK(ring.getTRange() == curve.getTRange());
+		for (int q = 0; q < 16; q++) {
+			const float queryT = Mona::funcUtils::lerp(curve.getTRange()[0], curve.getTRange()[1], unit(generator));
+			CHECK(ring.evalCurve(queryT) == curve.evalCurve(queryT));
+		}
+	}
+	//Un punto anterior al mas antiguo no se inserta en una curva llena
+	const float oldestT = ring.getTValue(0);
+	ring.insertPoint(glm::vec1(0.0f), oldestT - 1.0f);
+	CHECK(ring.getNumberOfPoints() == capacity);
+	CHECK(ring.getTValue(0) == oldestT);
+	//Una insercion intermedia descarta el punto mas antiguo y conserva el orden
+	const float middleT = 0.5f * (ring.getTValue(3) + ring.getTValue(4));
+	ring.insertPoint(glm::vec1(100.0f), middleT);
+	CHECK(ring.getNumberOfPoints() == capacity);
+	CHECK(ring.getTValue(3) == middleT);
+	CHECK(ring.evalCurve(middleT) == glm::vec1(100.0f));
+	for (int j = 1; j < capacity; j++)
+		CHECK(ring.getTValue(j - 1) < ring.getTValue(j));
+	ring.removeFrontPoints(3);
+	CHECK(ring.getNumberOfPoints() == capacity - 3);
+	CHECK(ring.getTValue(0) == middleT);
+	ring.clear();
+	CHECK(ring.getNumberOfPoints() == 0);
+}
+
+// La caja de una pose contiene cada vertice deformado por las articulaciones que lo influyen.
+void CheckSkinnedPoseBoundingBox() {
+	std::mt19937 generator(7);
+	std::uniform_real_distribution<float> coordinate(-2.0f, 2.0f);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	constexpr int jointCount = 8;
+	//La ultima articulacion no influye a ningun vertice, por lo que su caja queda vacia
+	std::vector<Mona::AABB> jointBoxes(jointCount);
+	for (int j = 0; j < jointCount - 1; j++) {
+		const glm::vec3 center(coordinate(generator), coordinate(generator), coordinate(generator));
+		jointBoxes[j] = Mona::AABB(center - glm::vec3(1.5f), center + glm::vec3(1.5f));
+	}
+	const Mona::AABB fallback(glm::vec3(-1.0f), glm::vec3(1.0f));
+	CHECK(Mona::SkinnedMesh::GetPoseBoundingBox(jointBoxes, {}, fallback).min == fallback.min);
+	std::vector<glm::mat4> palette(jointCount);
+	int skinnedVertexCount = 0;
+	for (int pose = 0; pose < 50; pose++) {
+		for (glm::mat4& matrix : palette) {
+			const glm::vec3 axis = glm::normalize(glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator)) + glm::vec3(0.01f));
+			matrix = glm::translate(glm::mat4(1.0f), glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator))) *
+				glm::rotate(glm::mat4(1.0f), 3.0f * coordinate(generator), axis);
+		}
+		const Mona::AABB box = Mona::SkinnedMesh::GetPoseBoundingBox(jointBoxes, palette, fallback);
+		for (int v = 0; v < 100; v++) {
+			//Un vertice solo puede ser influido por articulaciones cuya caja de enlace lo contiene
+			const glm::vec3 bindPosition(coordinate(generator), coordinate(generator), coordinate(generator));
+			std::vector<int> joints;
+			for (int j = 0; j < jointCount; j++) {
+				if (glm::all(glm::greaterThanEqual(bindPosition, jointBoxes[j].min)) && glm::all(glm::lessThanEqual(bindPosition, jointBoxes[j].max)))
+					joints.push_back(j);
+			}
+			if (joints.empty())
+				continue;
+			std::vector<float> weights(joints.size());
+			float weightSum = 0.0f;
+			for (float& weight : weights) {
+				weight = unit(generator) + 0.01f;
+				weightSum += weight;
+			}
+			glm::vec3 skinnedPosition(0.0f);
+			for (size_t k = 0; k < joints.size(); k++)
+				skinnedPosition += (weights[k] / weightSum) * glm::vec3(palette[joints[k]] * glm::vec4(bindPosition, 1.0f));
+			CHECK(glm::all(glm::greaterThanEqual(skinnedPosition, box.min - glm::vec3(1e-4f))) &&
+				glm::all(glm::lessThanEqual(skinnedPosition, box.max + glm::vec3(1e-4f))));
+			skinnedVertexCount++;
+		}
+	}
+	CHECK(skinnedVertexCount > 1000);
+}
+
+// La matriz local se mantiene al dia con cada modificacion, sin depender de que alguien la pida.
+void CheckTransformLocalMatrix() {
+	auto expectedMatrix = [](const Mona::TransformComponent& transform) {
+		return glm::translate(glm::mat4(1.0f), transform.GetLocalTranslation()) * glm::toMat4(transform.GetLocalRotation()) *
+			glm::scale(glm::mat4(1.0f), transform.GetLocalScale());
+	};
+	auto nearlyEqual = [](const glm::mat4& lhs, const glm::mat4& rhs) {
+		for (int c = 0; c < 4; c++) {
+			if (glm::any(glm::greaterThan(glm::abs(lhs[c] - rhs[c]), glm::vec4(1e-5f))))
+				return false;
+		}
+		return true;
+	};
+	const Mona::TransformComponent constructed(glm::vec3(1.0f, 2.0f, 3.0f), glm::angleAxis(0.5f, glm::vec3(0.0f, 0.0f, 1.0f)), glm::vec3(2.0f));
+	CHECK(nearlyEqual(constructed.GetLocalMatrix(), expectedMatrix(constructed)));
+	Mona::TransformComponent transform;
+	CHECK(transform.GetLocalMatrix() == glm::mat4(1.0f));
+	const uint32_t version = transform.GetVersion();
+	transform.Translate(glm::vec3(4.0f, -1.0f, 0.5f));
+	CHECK(nearlyEqual(transform.GetLocalMatrix(), expectedMatrix(transform)));
+	transform.Rotate(glm::vec3(1.0f, 0.0f, 0.0f), 1.2f);
+	CHECK(nearlyEqual(transform.GetLocalMatrix(), expectedMatrix(transform)));
+	transform.Scale(glm::vec3(0.5f, 2.0f, 1.0f));
+	transform.SetTranslation(glm::vec3(-3.0f));
+	CHECK(nearlyEqual(transform.GetLocalMatrix(), expectedMatrix(transform)));
+	transform.SetRotation(glm::angleAxis(-0.3f, glm::vec3(0.0f, 1.0f, 0.0f)));
+	transform.SetScale(glm::vec3(3.0f));
+	CHECK(nearlyEqual(transform.GetLocalMatrix(), expectedMatrix(transform)));
+	CHECK(&transform.GetModelMatrix() == &transform.GetLocalMatrix());
+	CHECK(transform.GetVersion() == version + 6);
+}
+
+// Todos los trabajos encolados se ejecutan exactamente una vez, tambien cuando se encolan desde otros trabajos.
+void CheckJobSystem() {
+	Mona::JobSystem jobSystem;
+	jobSystem.StartUp(4);
+	constexpr int jobCount = 2000;
+	std::atomic<int> executed = 0;
+	for (int round = 0; round < 10; round++) {
+		Mona::JobSystem::JobGroup group;
+		for (int i = 0; i < jobCount; i++) {
+			jobSystem.Run(group, [&jobSystem, &group, &executed]() {
+				executed.fetch_add(1, std::memory_order_relaxed);
+				jobSystem.Run(group, [&executed]() { executed.fetch_add(1, std::memory_order_relaxed); });
+			});
+		}
+		jobSystem.Wait(group);
+		CHECK(group.IsDone());
+	}
+	CHECK(executed.load() == 10 * 2 * jobCount);
+	std::vector<int> visits(10000, 0);
+	jobSystem.ParallelFor(visits.size(), 64, [&visits](size_t i) { visits[i]++; });
+	CHECK(std::all_of(visits.begin(), visits.end(), [](int count) { return count == 1; }));
+	jobSystem.ShutDown();
+}
+
+// Los miembros de un grupo ocupan el inicio de cada manager alineados por indice, tras agregar, remover y destruir.
+void CheckComponentGroup(Mona::World& world) {
+	using LightGroup = Mona::ComponentGroup<Mona::PointLightComponent, Mona::SpotLightComponent>;
+	//El grupo de World se comparte y ningun otro grupo puede tomar sus managers
+	Mona::SkeletalMeshGroup* skeletalMeshGroup = world.CreateComponentGroup<Mona::SkeletalMeshComponent, Mona::TransformComponent>();
+	CHECK(skeletalMeshGroup != nullptr && skeletalMeshGroup == Mona::MonaTest::GetSkeletalMeshGroup(world));
+	CHECK((world.CreateComponentGroup<Mona::TransformComponent, Mona::PointLightComponent>() == nullptr));
+
+	auto& pointLightManager = Mona::MonaTest::GetComponentManager<Mona::PointLightComponent>(world);
+	auto& spotLightManager = Mona::MonaTest::GetComponentManager<Mona::SpotLightComponent>(world);
+	std::vector<Mona::GameObjectHandle<Mona::GameObject>> objects;
+	for (int i = 0; i < 24; i++) {
+		auto object = world.CreateGameObject<Mona::GameObject>();
+		world.AddComponent<Mona::TransformComponent>(object);
+		if (i % 2 == 0)
+			world.AddComponent<Mona::PointLightComponent>(object);
+		if (i % 3 == 0)
+			world.AddComponent<Mona::SpotLightComponent>(object);
+		objects.push_back(object);
+	}
+	//Los GameObjects que ya tenian ambas componentes se empaquetan al crear el grupo
+	LightGroup* lightGroup = world.CreateComponentGroup<Mona::PointLightComponent, Mona::SpotLightComponent>();
+	CHECK(lightGroup != nullptr);
+	if (lightGroup == nullptr)
+		return;
+	CHECK((world.CreateComponentGroup<Mona::PointLightComponent, Mona::SpotLightComponent>() == lightGroup));
+
+	auto checkGroup = [&]() {
+		uint32_t expectedCount = 0;
+		for (auto& object : objects) {
+			if (world.IsValid(object) && object->HasComponent<Mona::PointLightComponent>() && object->HasComponent<Mona::SpotLightComponent>())
+				expectedCount++;
+		}
+		CHECK(lightGroup->GetCount() == expectedCount);
+		for (uint32_t i = 0; i < lightGroup->GetCount(); i++) {
+			Mona::GameObject* owner = lightGroup->GetOwnerByIndex(i);
+			CHECK(owner == pointLightManager.GetOwnerByIndex(i));
+			CHECK(owner == spotLightManager.GetOwnerByIndex(i));
+			CHECK(&lightGroup->Get<Mona::PointLightComponent>(i) ==
+				pointLightManager.GetComponentPointer(owner->GetInnerComponentHandle<Mona::PointLightComponent>()));
+		}
+		//Fuera del grupo no queda ningun GameObject con ambas componentes
+		for (uint32_t i = lightGroup->GetCount(); i < pointLightManager.GetCount(); i++)
+			CHECK(!lightGroup->IsMember(*pointLightManager.GetOwnerByIndex(i)));
+	};
+	checkGroup();
+	for (int i = 0; i < 24; i++) {
+		if (i % 2 == 1)
+			world.AddComponent<Mona::PointLightComponent>(objects[i]);
+	}
+	checkGroup();
+	for (int i = 0; i < 24; i += 6)
+		world.RemoveComponent(world.GetComponentHandle<Mona::SpotLightComponent>(objects[i]));
+	checkGroup();
+	for (int i = 0; i < 24; i += 5)
+		world.DestroyGameObject(objects[i]);
+	checkGroup();
+	//Los GameObjects destruidos siguen siendo validos hasta el final del frame, por lo que no se destruyen de nuevo
+	for (int i = 0; i < 24; i++) {
+		if (i % 5 != 0)
+			world.DestroyGameObject(objects[i]);
+	}
+	CHECK(lightGroup->GetCount() == 0);
+}
+
+// En modo headless todos los tipos de material se crean, con y sin skinning, sin tocar OpenGL.
+void CheckCreateMaterials(Mona::World& world) {
+	for (int type = 0; type < static_cast<int>(Mona::MaterialType::MaterialTypeCount); type++) {
+		for (bool isForSkinning : { false, true }) {
+			std::shared_ptr<Mona::Material> material = world.CreateMaterial(static_cast<Mona::MaterialType>(type), isForSkinning);
+			CHECK(material != nullptr);
+			if (material != nullptr)
+				CHECK(material->IsForSkinning() == isForSkinning);
+		}
+	}
+}
+
+// Funcion objetivo de la forma sum((args[i] - center[i])^2), separada en dos terminos con centros distintos.
+struct QuadraticDescentData {
+	std::vector<float> firstCenter;
+	std::vector<float> secondCenter;
+	float lowerBound;
+	float upperBound;
+	int postStepCount = 0;
+	int secondTermCalls = 0;
+};
+struct FirstQuadraticTerm {
+	float calcTerm(std::span<const float> args, QuadraticDescentData* dataPtr) {
+		float result = 0.0f;
+		for (size_t i = 0; i < args.size(); i++)
+			result += (args[i] - dataPtr->firstCenter[i]) * (args[i] - dataPtr->firstCenter[i]);
+		return result;
+	}
+	float calcTermPartialDerivative(std::span<const float> args, int varIndex, QuadraticDescentData* dataPtr) {
+		return 2.0f * (args[varIndex] - dataPtr->firstCenter[varIndex]);
+	}
+};
+struct SecondQuadraticTerm {
+	float calcTerm(std::span<const float> args, QuadraticDescentData* dataPtr) {
+		dataPtr->secondTermCalls++;
+		float result = 0.0f;
+		for (size_t i = 0; i < args.size(); i++)
+			result += (args[i] - dataPtr->secondCenter[i]) * (args[i] - dataPtr->secondCenter[i]);
+		return result;
+	}
+	float calcTermPartialDerivative(std::span<const float> args, int varIndex, QuadraticDescentData* dataPtr) {
+		dataPtr->secondTermCalls++;
+		return 2.0f * (args[varIndex] - dataPtr->secondCenter[varIndex]);
+	}
+};
+// Acota los argumentos despues de cada paso, y anula el paso de los acotados para que el descenso pueda terminar.
+struct ClampPostStep {
+	void operator()(std::span<float> args, QuadraticDescentData* dataPtr, std::span<float> argsRawDelta) {
+		dataPtr->postStepCount++;
+		for (size_t i = 0; i < args.size(); i++) {
+			if (args[i] < dataPtr->lowerBound || dataPtr->upperBound < args[i]) {
+				args[i] = std::clamp(args[i], dataPtr->lowerBound, dataPtr->upperBound);
+				argsRawDelta[i] = 0.0f;
+			}
+		}
+	}
+};
+
+// Los descensos REGULAR y MOMENTUM llegan al minimo de una funcion cuadratica ponderada, que el paso posterior acota
+// a un intervalo, y los terminos con peso nulo no se evaluan.
+void CheckGradientDescent() {
+	QuadraticDescentData data;
+	data.firstCenter = { 0.5f, -3.0f, 2.0f, 0.0f };
+	data.secondCenter = { 1.5f, -1.0f, 4.0f, 0.0f };
+	data.lowerBound = -1.0f;
+	data.upperBound = 2.0f;
+	const int argNum = static_cast<int>(data.firstCenter.size());
+	Mona::GradientDescent<QuadraticDescentData, ClampPostStep, FirstQuadraticTerm, SecondQuadraticTerm> gradientDescent(&data, argNum);
+	gradientDescent.setTermWeight(0, 1.0f);
+	gradientDescent.setTermWeight(1, 3.0f);
+	CHECK(gradientDescent.getTermNum() == 2);
+	//Minimo sin cotas en el promedio ponderado de los centros, acotado al intervalo en cada coordenada
+	std::vector<float> expectedArgs(argNum);
+	for (int i = 0; i < argNum; i++)
+		expectedArgs[i] = std::clamp((data.firstCenter[i] + 3.0f * data.secondCenter[i]) / 4.0f, data.lowerBound, data.upperBound);
+
+	std::vector<float> args = { 1.0f, 1.0f, 1.0f, 1.0f };
+	std::vector<float> gradient(argNum);
+	gradientDescent.computeGradient(args, gradient);
+	float expectedValue = 0.0f;
+	for (int i = 0; i < argNum; i++) {
+		CHECK(NearlyEqual(gradient[i], 2.0f * (args[i] - data.firstCenter[i]) + 6.0f * (args[i] - data.secondCenter[i]), 1e-6f));
+		expectedValue += std::pow(args[i] - data.firstCenter[i], 2.0f) + 3.0f * std::pow(args[i] - data.secondCenter[i], 2.0f);
+	}
+	CHECK(NearlyEqual(gradientDescent.computeFunctionValue(args), expectedValue, 1e-6f));
+
+	constexpr int maxIterations = 1000;
+	for (Mona::DescentType descentType : { Mona::DescentType::REGULAR, Mona::DescentType::MOMENTUM }) {
+		args = { 1.0f, 1.0f, 1.0f, 1.0f };
+		data.postStepCount = 0;
+		gradientDescent.computeArgsMin(0.02f, maxIterations, 1e-6f, args, descentType);
+		for (int i = 0; i < argNum; i++)
+			CHECK(std::abs(args[i] - expectedArgs[i]) < 1e-3f);
+		//El paso posterior se aplica tras cada paso, y al anular los pasos acotados el descenso termina antes del limite
+		CHECK(data.postStepCount > 1);
+		CHECK(data.postStepCount < maxIterations + 1);
+	}
+
+	//Con peso nulo el segundo termino no se evalua y el minimo es el centro del primero, acotado
+	gradientDescent.setTermWeight(1, 0.0f);
+	data.secondTermCalls = 0;
+	args = { 1.0f, 1.0f, 1.0f, 1.0f };
+	gradientDescent.computeArgsMin(0.1f, maxIterations, 1e-6f, args);
+	CHECK(data.secondTermCalls == 0);
+	CHECK(gradientDescent.computeFunctionValue(args) >= 0.0f);
+	CHECK(data.secondTermCalls == 0);
+	for (int i = 0; i < argNum; i++)
+		CHECK(std::abs(args[i] - std::clamp(data.firstCenter[i], data.lowerBound, data.upperBound)) < 1e-3f);
+}
+
+// La interpolacion bilineal de la grilla reproduce exactamente una funcion bilineal.
+float BilinearHeight(float x, float y) {
+	return 1.0f + 0.5f * x - 0.25f * y + 0.1f * x * y;
+}
+
+// Un HeightMap precalculado da las mismas alturas que heightFunc para una funcion bilineal, en los vertices, en el centro
+// de las celdas y de sus aristas, y en puntos aleatorios. Sin grilla se evalua heightFunc directamente.
+void CheckHeightMapBaking() {
+	const glm::vec2 minXY(-3.0f, 2.0f);
+	const glm::vec2 maxXY(5.0f, 7.0f);
+	constexpr int numVerticesX = 9;
+	constexpr int numVerticesY = 6;
+	Mona::HeightMap bakedMap(minXY, maxXY, numVerticesX, numVerticesY, BilinearHeight);
+	Mona::HeightMap functionMap(minXY, maxXY, BilinearHeight);
+	CHECK(bakedMap.isBaked());
+	CHECK(!functionMap.isBaked());
+	auto checkPoint = [&](glm::vec2 point) {
+		const float expected = BilinearHeight(point.x, point.y);
+		CHECK(NearlyEqual(bakedMap.getHeight(point.x, point.y), expected, 1e-5f));
+		CHECK(functionMap.getHeight(point.x, point.y) == expected);
+	};
+	for (int i = 0; i < numVerticesX; i++) {
+		for (int j = 0; j < numVerticesY; j++) {
+			const glm::vec2 vertex = bakedMap.getVertexXY(i, j);
+			CHECK(bakedMap.getVertexHeight(i, j) == BilinearHeight(vertex.x, vertex.y));
+			checkPoint(vertex);
+			if (i + 1 < numVerticesX)
+				checkPoint(0.5f * (vertex + bakedMap.getVertexXY(i + 1, j)));
+			if (j + 1 < numVerticesY)
+				checkPoint(0.5f * (vertex + bakedMap.getVertexXY(i, j + 1)));
+			if (i + 1 < numVerticesX && j + 1 < numVerticesY)
+				checkPoint(0.5f * (vertex + bakedMap.getVertexXY(i + 1, j + 1)));
+		}
+	}
+	CHECK(bakedMap.getVertexXY(numVerticesX - 1, numVerticesY - 1) == maxXY);
+	std::mt19937 generator(20);
+	std::uniform_real_distribution<float> x(minXY.x, maxXY.x);
+	std::uniform_real_distribution<float> y(minXY.y, maxXY.y);
+	for (int k = 0; k < 200; k++)
+		checkPoint(glm::vec2(x(generator), y(generator)));
+}
+
+float GridTileHeight(float x, float y) {
+	return std::sin(x * 0.7f) * std::cos(y * 0.4f);
+}
+
+// Altura maxima de los terrenos en xyPoint revisando todos, con la misma transformacion y limites que EnvironmentData.
+float BruteForceTerrainHeight(glm::vec2 xyPoint, const std::vector<Mona::GameObjectHandle<Mona::GameObject>>& terrains, Mona::World& world) {
+	float height = std::numeric_limits<float>::lowest();
+	for (const auto& terrain : terrains) {
+		const glm::mat4& model = world.GetComponentHandle<Mona::TransformComponent>(terrain)->GetModelMatrix();
+		Mona::HeightMap* heightMap = world.GetComponentHandle<Mona::StaticMeshComponent>(terrain)->GetHeightMap();
+		const glm::vec2 minXY = model * glm::vec4(heightMap->getMinXY(), 0, 1);
+		const glm::vec2 maxXY = model * glm::vec4(heightMap->getMaxXY(), 0, 1);
+		if (xyPoint.x < minXY.x || maxXY.x < xyPoint.x || xyPoint.y < minXY.y || maxXY.y < xyPoint.y)
+			continue;
+		const glm::vec2 localPoint = glm::clamp(glm::vec2(glm::inverse(model) * glm::vec4(xyPoint, 0, 1)), heightMap->getMinXY(), heightMap->getMaxXY());
+		const glm::vec4 globalPoint = model * glm::vec4(localPoint, heightMap->getHeight(localPoint.x, localPoint.y), 1);
+		height = std::max(height, globalPoint.z);
+	}
+	return height;
+}
+
+// La grilla de EnvironmentData da las mismas alturas que revisar todos los terrenos, en los bordes de celdas y baldosas,
+// tras remover terrenos y tras mover uno, y un terreno agregado no aparece hasta la siguiente validacion.
+void CheckEnvironmentDataGrid(Mona::World& world) {
+	constexpr int tilesPerSide = 8;
+	constexpr float tileSize = 10.0f;
+	auto tileMesh = Mona::MeshManager::GetInstance().GenerateTerrain(glm::vec2(0.0f), glm::vec2(tileSize), 6, 6, GridTileHeight);
+	auto material = world.CreateMaterial(Mona::MaterialType::DiffuseFlat);
+	auto addTile = [&](const glm::vec3& translation, const glm::vec3& scale) {
+		auto tile = world.CreateGameObject<Mona::GameObject>();
+		world.AddComponent<Mona::TransformComponent>(tile, translation, glm::fquat(1.0f, 0.0f, 0.0f, 0.0f), scale);
+		world.AddComponent<Mona::StaticMeshComponent>(tile, tileMesh, material);
+		return tile;
+	};
+	//Filas de baldosas iguales y adyacentes a distintas alturas, y unas pocas baldosas grandes que quedan fuera de la grilla
+	std::vector<Mona::GameObjectHandle<Mona::GameObject>> terrains;
+	for (int i = 0; i < tilesPerSide; i++) {
+		for (int j = 0; j < tilesPerSide; j++)
+			terrains.push_back(addTile(glm::vec3(i * tileSize, j * tileSize, 0.25f * ((3 * i + j) % 4)), glm::vec3(1.0f)));
+	}
+	terrains.push_back(addTile(glm::vec3(-20.0f, -20.0f, -1.0f), glm::vec3(10.0f, 10.0f, 1.0f)));
+	terrains.push_back(addTile(glm::vec3(5.0f, -10.0f, 0.3f), glm::vec3(9.0f, 12.0f, 1.0f)));
+	terrains.push_back(addTile(glm::vec3(-40.0f, 10.0f, -0.5f), glm::vec3(12.0f, 8.0f, 2.0f)));
+	Mona::EnvironmentData environmentData;
+	for (const auto& terrain : terrains)
+		environmentData.addTerrain(terrain);
+	auto& transformManager = Mona::MonaTest::GetComponentManager<Mona::TransformComponent>(world);
+	auto& staticMeshManager = Mona::MonaTest::GetComponentManager<Mona::StaticMeshComponent>(world);
+	environmentData.validateTerrains(transformManager, staticMeshManager);
+
+	//Puntos aleatorios, las esquinas y bordes de las baldosas (que son tambien los de las celdas, cuyo lado es la mediana
+	// del lado de los terrenos) y las esquinas de las baldosas grandes
+	std::mt19937 generator(23);
+	std::uniform_real_distribution<float> coordinate(-30.0f, 100.0f);
+	std::vector<glm::vec2> points;
+	for (int k = 0; k < 400; k++)
+		points.push_back(glm::vec2(coordinate(generator), coordinate(generator)));
+	for (int i = -2; i <= tilesPerSide + 1; i++) {
+		for (int j = -2; j <= tilesPerSide + 1; j++)
+			points.push_back(glm::vec2(i * tileSize, j * tileSize));
+		points.push_back(glm::vec2(i * tileSize, coordinate(generator)));
+		points.push_back(glm::vec2(coordinate(generator), i * tileSize));
+	}
+	for (size_t t = terrains.size() - 3; t < terrains.size(); t++) {
+		const glm::mat4& model = world.GetComponentHandle<Mona::TransformComponent>(terrains[t])->GetModelMatrix();
+		const glm::vec2 minXY = model * glm::vec4(0.0f, 0.0f, 0, 1);
+		const glm::vec2 maxXY = model * glm::vec4(tileSize, tileSize, 0, 1);
+		points.push_back(minXY);
+		points.push_back(maxXY);
+		points.push_back(glm::vec2(minXY.x, maxXY.y));
+		points.push_back(glm::vec2(maxXY.x, minXY.y));
+	}
+
+	std::vector<float> heights(points.size());
+	auto checkHeights = [&](const std::vector<Mona::GameObjectHandle<Mona::GameObject>>& expectedTerrains) {
+		environmentData.getTerrainHeights(points, heights, staticMeshManager);
+		int coveredPoints = 0;
+		for (size_t k = 0; k < points.size(); k++) {
+			const float expected = BruteForceTerrainHeight(points[k], expectedTerrains, world);
+			if (expected == std::numeric_limits<float>::lowest()) {
+				CHECK(heights[k] == expected);
+				continue;
+			}
+			coveredPoints++;
+			CHECK(std::abs(heights[k] - expected) <= 1e-4f * (1.0f + std::abs(expected)));
+			CHECK(environmentData.getTerrainHeight(points[k], staticMeshManager) == heights[k]);
+		}
+		CHECK(coveredPoints > static_cast<int>(points.size()) / 2);
+	};
+	checkHeights(terrains);
+
+	//Remover saca al terreno de inmediato, tambien a una baldosa grande
+	for (size_t t : { terrains.size() - 2, size_t(20), size_t(5) }) {
+		CHECK(environmentData.removeTerrain(terrains[t]) >= 0);
+		world.DestroyGameObject(terrains[t]);
+		terrains.erase(terrains.begin() + t);
+	}
+	checkHeights(terrains);
+	environmentData.validateTerrains(transformManager, staticMeshManager);
+	checkHeights(terrains);
+
+	//Un terreno movido se reubica en la validacion
+	world.GetComponentHandle<Mona::TransformComponent>(terrains[0])->SetTranslation(glm::vec3(95.0f, -10.0f, 2.0f));
+	world.GetComponentHandle<Mona::TransformComponent>(terrains[9])->SetScale(glm::vec3(2.0f, 3.0f, 1.0f));
+	environmentData.validateTerrains(transformManager, staticMeshManager);
+	checkHeights(terrains);
+
+	//Un terreno agregado solo aparece en las consultas despues de validar
+	auto newTile = addTile(glm::vec3(30.0f, 30.0f, 5.0f), glm::vec3(1.0f));
+	environmentData.addTerrain(newTile);
+	checkHeights(terrains);
+	environmentData.validateTerrains(transformManager, staticMeshManager);
+	terrains.push_back(newTile);
+	checkHeights(terrains);
+
+	for (auto& terrain : terrains)
+		world.DestroyGameObject(terrain);
+}
+
+// Las alturas de un terreno trasladado y escalado coinciden con su funcion de altura, por punto y en lote, y la
+// transformacion guardada se actualiza en la validacion que sigue a SetTranslation y SetScale.
+void CheckTerrainTransformCache(Mona::World& world) {
+	auto terrainMesh = Mona::MeshManager::GetInstance().GenerateTerrain(glm::vec2(-4.0f), glm::vec2(6.0f), 7, 5, BilinearHeight);
+	auto terrain = world.CreateGameObject<Mona::GameObject>();
+	auto transform = world.AddComponent<Mona::TransformComponent>(terrain, glm::vec3(7.0f, -3.0f, 2.0f),
+		glm::fquat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(2.0f, 3.0f, 0.5f));
+	world.AddComponent<Mona::StaticMeshComponent>(terrain, terrainMesh, world.CreateMaterial(Mona::MaterialType::DiffuseFlat));
+	Mona::EnvironmentData environmentData;
+	environmentData.addTerrain(terrain);
+	auto& transformManager = Mona::MonaTest::GetComponentManager<Mona::TransformComponent>(world);
+	auto& staticMeshManager = Mona::MonaTest::GetComponentManager<Mona::StaticMeshComponent>(world);
+	environmentData.validateTerrains(transformManager, staticMeshManager);
+
+	//Puntos dentro y fuera del terreno en su posicion original y en las que toma al moverlo y escalarlo
+	std::mt19937 generator(21);
+	std::uniform_real_distribution<float> coordinate(-25.0f, 35.0f);
+	std::vector<glm::vec2> points(500);
+	for (auto& point : points)
+		point = glm::vec2(coordinate(generator), coordinate(generator));
+	std::vector<float> heights(points.size());
+	auto checkHeights = [&](const glm::vec3& translation, const glm::vec3& scale) {
+		environmentData.getTerrainHeights(points, heights, staticMeshManager);
+		int coveredPoints = 0;
+		for (size_t k = 0; k < points.size(); k++) {
+			CHECK(environmentData.getTerrainHeight(points[k], staticMeshManager) == heights[k]);
+			const glm::vec2 localPoint = (points[k] - glm::vec2(translation)) / glm::vec2(scale);
+			if (glm::any(glm::lessThan(localPoint, glm::vec2(-4.0f))) || glm::any(glm::greaterThan(localPoint, glm::vec2(6.0f)))) {
+				CHECK(heights[k] == std::numeric_limits<float>::lowest());
+				continue;
+			}
+			coveredPoints++;
+			CHECK(NearlyEqual(heights[k], translation.z + scale.z * BilinearHeight(localPoint.x, localPoint.y), 1e-4f));
+		}
+		CHECK(coveredPoints > 0);
+	};
+	checkHeights(glm::vec3(7.0f, -3.0f, 2.0f), glm::vec3(2.0f, 3.0f, 0.5f));
+
+	//Las consultas usan la transformacion de la ultima validacion
+	transform->SetTranslation(glm::vec3(-5.0f, 4.0f, -1.0f));
+	checkHeights(glm::vec3(7.0f, -3.0f, 2.0f), glm::vec3(2.0f, 3.0f, 0.5f));
+	environmentData.validateTerrains(transformManager, staticMeshManager);
+	checkHeights(glm::vec3(-5.0f, 4.0f, -1.0f), glm::vec3(2.0f, 3.0f, 0.5f));
+	transform->SetScale(glm::vec3(1.5f, 0.5f, 3.0f));
+	environmentData.validateTerrains(transformManager, staticMeshManager);
+	checkHeights(glm::vec3(-5.0f, 4.0f, -1.0f), glm::vec3(1.5f, 0.5f, 3.0f));
+
+	world.DestroyGameObject(terrain);
+}
+
+struct CharacterAssets {
+	std::shared_ptr<Mona::Skeleton> skeleton;
+	std::shared_ptr<Mona::SkinnedMesh> skinnedMesh;
+	std::shared_ptr<Mona::AnimationClip> walkingAnimation;
+};
+
+// Mismo personaje usado por los benchmarks cuando akai no esta disponible.
+bool LoadCharacterAssets(CharacterAssets& outAssets) {
+	auto& config = Mona::Config::GetInstance();
+	const auto modelPath = config.getPathOfApplicationAsset("Models/xbot.fbx");
+	const auto animationPath = config.getPathOfApplicationAsset("Animations/xbot/walking0.fbx");
+	if (!std::filesystem::exists(modelPath) || !std::filesystem::exists(animationPath))
+		return false;
+	outAssets.skeleton = Mona::SkeletonManager::GetInstance().LoadSkeleton(modelPath);
+	outAssets.skinnedMesh = Mona::MeshManager::GetInstance().LoadSkinnedMesh(outAssets.skeleton, modelPath, true);
+	outAssets.walkingAnimation = Mona::AnimationClipManager::GetInstance().LoadAnimationClip(animationPath, outAssets.skeleton, false);
+	return true;
+}
+
+// Interpola una muestra buscando linealmente el primer timeStamp mayor a time, como antes de existir el cursor.
+template <typename T, typename Interpolate>
+T LinearScanSample(const std::vector<T>& values, const std::vector<float>& timeStamps, float time, float duration, Interpolate interpolate) {
+	if (values.size() == 1)
+		return values[0];
+	size_t sample = 0;
+	while (sample < timeStamps.size() && timeStamps[sample] <= time)
+		sample++;
+	if (sample == 0)
+		return values[0];
+	const float start = timeStamps[sample - 1];
+	const float end = sample < timeStamps.size() ? timeStamps[sample] : duration;
+	const float fraction = end > start ? (time - start) / (end - start) : 0.0f;
+	return interpolate(values[sample - 1], values[sample % values.size()], fraction);
+}
+
+// El cursor de keyframes y la busqueda binaria dan la misma pose que una busqueda lineal, avanzando, retrocediendo,
+// cruzando el punto de loop, saltando y cambiando de clip.
+void CheckKeyframeCursor(const CharacterAssets& assets) {
+	const auto idlePath = Mona::Config::GetInstance().getPathOfApplicationAsset("Animations/xbot/idle.fbx");
+	auto idleAnimation = Mona::AnimationClipManager::GetInstance().LoadAnimationClip(idlePath, assets.skeleton, false);
+	const uint32_t jointCount = assets.skeleton->JointCount();
+	Mona::AnimationClip::KeyframeCursor cursor;
+	std::vector<Mona::JointPose> cursorPose(jointCount);
+	std::vector<Mona::JointPose> searchPose(jointCount);
+	std::vector<Mona::JointPose> expectedPose(jointCount);
+	auto checkSample = [&](Mona::AnimationClip& clip, float time, bool isLooping) {
+		const float sampledTime = clip.Sample(cursorPose, time, isLooping, &cursor);
+		CHECK(sampledTime == clip.Sample(searchPose, time, isLooping));
+		CHECK(sampledTime == clip.GetSamplingTime(time, isLooping));
+		const auto& tracks = Mona::MonaTest::GetAnimationTracks(clip);
+		const auto& trackJointIndices = Mona::MonaTest::GetTrackJointIndices(clip);
+		const float duration = clip.GetDuration();
+		for (size_t i = 0; i < tracks.size(); i++) {
+			const auto& track = tracks[i];
+			const glm::fquat rotation = LinearScanSample(track.rotations, track.rotationTimeStamps, sampledTime, duration,
+				[](const glm::fquat& first, const glm::fquat& second, float fraction) { return glm::slerp(first, second, fraction); });
+			const glm::vec3 position = LinearScanSample(track.positions, track.positionTimeStamps, sampledTime, duration,
+				[](const glm::vec3& first, const glm::vec3& second, float fraction) { return glm::mix(first, second, fraction); });
+			const glm::vec3 scale = LinearScanSample(track.scales, track.scaleTimeStamps, sampledTime, duration,
+				[](const glm::vec3& first, const glm::vec3& second, float fraction) { return glm::mix(first, second, fraction); });
+			expectedPose[trackJointIndices[i]] = Mona::JointPose(rotation, position, scale);
+		}
+		for (size_t i = 0; i < trackJointIndices.size(); i++) {
+			const Mona::JointIndex joint = trackJointIndices[i];
+			const glm::mat4 expectedMatrix = Mona::JointPoseToMat4(expectedPose[joint]);
+			CHECK(NearlyEqual(Mona::JointPoseToMat4(cursorPose[joint]), expectedMatrix, 1e-5f));
+			CHECK(NearlyEqual(Mona::JointPoseToMat4(searchPose[joint]), expectedMatrix, 1e-5f));
+		}
+	};
+
+	Mona::AnimationClip& walking = *assets.walkingAnimation;
+	const float duration = walking.GetDuration();
+	CHECK(duration > 0.0f);
+	//Hacia adelante a distintas velocidades, cruzando varias veces el punto de loop
+	for (float timeStep : { 1.0f / 120.0f, 1.0f / 30.0f, 0.3f * duration }) {
+		for (float time = 0.0f; time < 2.5f * duration; time += timeStep)
+			checkSample(walking, time, true);
+	}
+	//Hacia atras, y hacia adelante mas alla del final de un clip sin loop
+	for (float time = 1.2f * duration; time >= 0.0f; time -= 1.0f / 60.0f)
+		checkSample(walking, time, true);
+	for (float time = 0.0f; time < 1.5f * duration; time += 1.0f / 60.0f)
+		checkSample(walking, time, false);
+	//Exactamente sobre los timeStamps de las muestras y en los extremos del clip
+	for (float time : Mona::MonaTest::GetAnimationTracks(walking)[0].rotationTimeStamps)
+		checkSample(walking, time, true);
+	for (float time : { 0.0f, duration, -0.5f * duration })
+		checkSample(walking, time, false);
+	//Saltos grandes en ambas direcciones, alternando con el clip idle sobre el mismo cursor
+	std::mt19937 generator(12);
+	std::uniform_real_distribution<float> jump(0.0f, 3.0f * duration);
+	for (int i = 0; i < 200; i++) {
+		checkSample(walking, jump(generator), i % 3 != 0);
+		if (i % 20 == 0)
+			checkSample(*idleAnimation, jump(generator), true);
+	}
+}
+
+// La solucion analitica lleva el end effector de una cadena de tres articulaciones a un objetivo alcanzable, doblando la
+// rodilla hacia el mismo lado que la animacion. Las cadenas mas largas o que no pueden doblarse usan descenso de gradiente.
+void CheckTwoBoneSolver(const CharacterAssets& assets) {
+	//Los rigs descomprimen las rotaciones del clip, por lo que se usa una instancia distinta a la de los demas chequeos
+	const auto animationPath = Mona::Config::GetInstance().getPathOfApplicationAsset("Animations/xbot/walking0.fbx");
+	auto animationClip = Mona::AnimationClipManager::GetInstance().LoadAnimationClip(animationPath, assets.skeleton, true);
+	Mona::RigData rigData;
+	rigData.leftLeg = { "LeftUpLeg", "LeftFoot", Mona::IKSolverType::TWO_BONE };
+	rigData.rightLeg = { "RightUpLeg", "RightFoot", Mona::IKSolverType::TWO_BONE };
+	rigData.hipJointName = "Hips";
+	Mona::IKRig rig(assets.skeleton, rigData, Mona::InnerComponentHandle());
+	rig.init();
+	Mona::IKAnimation* ikAnimation = Mona::MonaTest::AddIKAnimation(rig, animationClip);
+	Mona::InverseKinematics& inverseKinematics = Mona::MonaTest::GetInverseKinematics(rig);
+	const float maxError = Mona::MonaTest::GetTwoBoneMaxError(inverseKinematics);
+	CHECK(maxError > 0.0f);
+	auto& variableRotations = *ikAnimation->getVariableJointRotations();
+	auto modelSpacePosition = [](Mona::IKAnimation* ikAnimation, Mona::JointIndex joint) {
+		return glm::vec3(ikAnimation->getEEListModelSpaceVariableTransforms({ joint })[joint][3]);
+	};
+	//Normal del plano en que se dobla la cadena, su sentido indica hacia que lado se dobla la rodilla
+	auto bendNormal = [&](const Mona::IKChain& chain) {
+		const glm::vec3 base = modelSpacePosition(ikAnimation, chain.getJoints()[0]);
+		const glm::vec3 middle = modelSpacePosition(ikAnimation, chain.getJoints()[1]);
+		const glm::vec3 endEffector = modelSpacePosition(ikAnimation, chain.getJoints()[2]);
+		return glm::cross(middle - base, endEffector - middle);
+	};
+	std::mt19937 generator(19);
+	std::uniform_real_distribution<float> baseDelta(-0.3f, 0.3f);
+	std::uniform_real_distribution<float> middleDeltaMagnitude(0.05f, 0.3f);
+	std::vector<std::pair<Mona::JointIndex, float>> angles;
+	for (Mona::FrameIndex frame = 0; frame < ikAnimation->getFrameNum(); frame += 3) {
+		for (Mona::ChainIndex c = 0; c < rig.getChainNum(); c++) {
+			Mona::IKChain* chain = rig.getIKChain(c);
+			const Mona::JointIndex baseJoint = chain->getJoints()[0];
+			const Mona::JointIndex middleJoint = chain->getJoints()[1];
+			const Mona::JointIndex endEffector = chain->getJoints()[2];
+			ikAnimation->setVariableJointRotations(frame);
+			const float baseAngle = variableRotations[baseJoint].getRotationAngle();
+			const float middleAngle = variableRotations[middleJoint].getRotationAngle();
+			const glm::vec3 animationNormal = bendNormal(*chain);
+			//El objetivo se obtiene girando ambas articulaciones en torno a sus ejes, doblando mas la rodilla
+			auto chainLength = [&](float middleDelta) {
+				variableRotations[middleJoint].setRotationAngle(middleAngle + middleDelta);
+				return glm::distance(modelSpacePosition(ikAnimation, baseJoint), modelSpacePosition(ikAnimation, endEffector));
+			};
+			float middleDelta = middleDeltaMagnitude(generator);
+			if (chainLength(-middleDelta) < chainLength(middleDelta))
+				middleDelta = -middleDelta;
+			variableRotations[baseJoint].setRotationAngle(baseAngle + baseDelta(generator));
+			variableRotations[middleJoint].setRotationAngle(middleAngle + middleDelta);
+			chain->setCurrentEETarget(0, modelSpacePosition(ikAnimation, endEffector));
+
+			ikAnimation->setVariableJointRotations(frame);
+			angles.clear();
+			CHECK(Mona::MonaTest::SolveTwoBoneChain(inverseKinematics, chain, ikAnimation, frame, angles));
+			CHECK(angles.size() == 2);
+			CHECK(glm::distance(modelSpacePosition(ikAnimation, endEffector), chain->getCurrentEETarget(0)) <= maxError);
+			const float solvedMiddleAngle = variableRotations[middleJoint].getRotationAngle();
+			CHECK(std::abs(std::remainder(solvedMiddleAngle - middleAngle - middleDelta, 2 * glm::pi<float>())) < 1e-3f);
+			CHECK(glm::dot(bendNormal(*chain), animationNormal) > 0.0f);
+		}
+	}
+
+	//Resuelve ambas piernas hacia la pose de la animacion, acercando el pie izquierdo a la cadera en la fraccion dada, y
+	// retorna que cadenas quedaron en el descenso de gradiente
+	auto solveIKChains = [&](Mona::IKRig& ikRig, Mona::IKAnimation* ikAnim, float leftLegPull) {
+		const Mona::FrameIndex targetFrame = ikAnim->getNextFrameIndex();
+		ikAnim->setVariableJointRotations(targetFrame);
+		for (Mona::ChainIndex c = 0; c < ikRig.getChainNum(); c++) {
+			Mona::IKChain* chain = ikRig.getIKChain(c);
+			const glm::vec3 base = modelSpacePosition(ikAnim, chain->getJoints()[0]);
+			const glm::vec3 endEffector = modelSpacePosition(ikAnim, chain->getEndEffector());
+			chain->setCurrentEETarget(0, glm::mix(endEffector, base, c == 0 ? leftLegPull : 0.0f));
+		}
+		Mona::InverseKinematics& ik = Mona::MonaTest::GetInverseKinematics(ikRig);
+		auto result = ik.solveIKChains(0);
+		for (Mona::ChainIndex c = 0; c < ikRig.getChainNum(); c++) {
+			for (Mona::JointIndex joint : ikRig.getIKChain(c)->getJoints()) {
+				const bool solved = std::any_of(result.begin(), result.end(), [joint](const auto& angle) { return angle.first == joint; });
+				CHECK(solved == (joint != ikRig.getIKChain(c)->getEndEffector()));
+			}
+		}
+		return Mona::MonaTest::GetDescentChainMask(ik);
+	};
+	CHECK(solveIKChains(rig, ikAnimation, 0.0f) == std::vector<bool>({ false, false }));
+
+	//Cadena de cuatro articulaciones, hasta la punta del pie
+	Mona::RigData longChainRigData = rigData;
+	longChainRigData.leftLeg.endEffectorName = "LeftToeBase";
+	Mona::IKRig longChainRig(assets.skeleton, longChainRigData, Mona::InnerComponentHandle());
+	longChainRig.init();
+	Mona::IKAnimation* longChainAnimation = Mona::MonaTest::AddIKAnimation(longChainRig, animationClip);
+	CHECK(longChainRig.getIKChain(0)->getJoints().size() == 4);
+	angles.clear();
+	CHECK(!Mona::MonaTest::SolveTwoBoneChain(Mona::MonaTest::GetInverseKinematics(longChainRig), longChainRig.getIKChain(0),
+		longChainAnimation, longChainAnimation->getNextFrameIndex(), angles));
+	CHECK(angles.empty());
+	CHECK(solveIKChains(longChainRig, longChainAnimation, 0.0f) == std::vector<bool>({ true, false }));
+
+	//Rodilla que gira en torno al eje de la pierna, con lo que la cadena no puede doblarse para acercar el pie a la cadera
+	Mona::IKChain* leftLeg = rig.getIKChain(0);
+	const Mona::JointIndex knee = leftLeg->getJoints()[1];
+	const Mona::FrameIndex targetFrame = ikAnimation->getNextFrameIndex();
+	const glm::vec3 shin = ikAnimation->getJointScale(knee) * ikAnimation->getJointPosition(leftLeg->getEndEffector());
+	Mona::MonaTest::GetOriginalJointRotations(*ikAnimation, targetFrame)[knee].setRotationAxis(shin);
+	angles.clear();
+	CHECK(solveIKChains(rig, ikAnimation, 0.2f) == std::vector<bool>({ true, false }));
+	angles.clear();
+	CHECK(!Mona::MonaTest::SolveTwoBoneChain(inverseKinematics, leftLeg, ikAnimation, targetFrame, angles));
+	CHECK(angles.empty());
+}
+
+// Las dos variantes de EEListCustomSpaceVariableTransforms dan, para cada end effector y sus ancestros, el producto de
+// las transformaciones locales hasta la raiz, con end effectors repetidos o con ancestros comunes, y al reutilizar los
+// arreglos de salida y la memoria de trabajo con otra lista las articulaciones que ya no se calculan quedan en identidad.
+void CheckForwardKinematicsScratch(const CharacterAssets& assets) {
+	const auto animationPath = Mona::Config::GetInstance().getPathOfApplicationAsset("Animations/xbot/walking0.fbx");
+	auto animationClip = Mona::AnimationClipManager::GetInstance().LoadAnimationClip(animationPath, assets.skeleton, true);
+	Mona::RigData rigData;
+	rigData.leftLeg = { "LeftUpLeg", "LeftFoot" };
+	rigData.rightLeg = { "RightUpLeg", "RightFoot" };
+	rigData.hipJointName = "Hips";
+	Mona::IKRig rig(assets.skeleton, rigData, Mona::InnerComponentHandle());
+	rig.init();
+	Mona::IKAnimation* ikAnimation = Mona::MonaTest::AddIKAnimation(rig, animationClip);
+	Mona::ForwardKinematics& forwardKinematics = Mona::MonaTest::GetForwardKinematics(rig);
+	const std::vector<int>& topology = rig.getTopology();
+	auto joint = [&](const std::string& name) { return static_cast<Mona::JointIndex>(assets.skeleton->GetJointIndex(name)); };
+	const glm::mat4 baseTransform = glm::translate(glm::scale(glm::mat4(1.0f), glm::vec3(0.5f)), glm::vec3(1.0f, -2.0f, 3.0f));
+
+	std::mt19937 generator(18);
+	std::uniform_real_distribution<float> angleDelta(-0.5f, 0.5f);
+	std::vector<glm::mat4> transforms;
+	std::vector<glm::mat4> jointSpaceTransforms;
+	Mona::ForwardKinematicsScratch scratch;
+	auto checkTransforms = [&](const std::vector<Mona::JointIndex>& eeList) {
+		//Referencia: el producto de las transformaciones locales de cada end effector hasta la raiz, sin compartir calculos
+		std::vector<bool> expectedJoints(topology.size(), false);
+		std::vector<glm::mat4> expectedTransforms(topology.size(), glm::mat4(1.0f));
+		for (Mona::JointIndex ee : eeList) {
+			for (Mona::JointIndex j = ee; j != -1; j = topology[j]) {
+				expectedJoints[j] = true;
+				glm::mat4 transform = forwardKinematics.JointSpaceVariableTransform(ikAnimation, j);
+				for (Mona::JointIndex parent = topology[j]; parent != -1; parent = topology[parent])
+					transform = forwardKinematics.JointSpaceVariableTransform(ikAnimation, parent) * transform;
+				expectedTransforms[j] = baseTransform * transform;
+			}
+		}
+		std::vector<glm::mat4> returnedJointSpaceTransforms;
+		const std::vector<glm::mat4> returnedTransforms =
+			forwardKinematics.EEListCustomSpaceVariableTransforms(eeList, baseTransform, ikAnimation, &returnedJointSpaceTransforms);
+		forwardKinematics.EEListCustomSpaceVariableTransforms(eeList, baseTransform, ikAnimation, transforms, &jointSpaceTransforms, scratch);
+		CHECK(returnedTransforms.size() == topology.size());
+		CHECK(transforms.size() == topology.size());
+		CHECK(jointSpaceTransforms.size() == topology.size());
+		for (Mona::JointIndex j = 0; j < static_cast<Mona::JointIndex>(topology.size()); j++) {
+			const glm::mat4 expectedJointSpace = expectedJoints[j] ? forwardKinematics.JointSpaceVariableTransform(ikAnimation, j) : glm::mat4(1.0f);
+			CHECK(NearlyEqual(transforms[j], expectedTransforms[j], 1e-5f));
+			CHECK(NearlyEqual(returnedTransforms[j], expectedTransforms[j], 1e-5f));
+			CHECK(jointSpaceTransforms[j] == expectedJointSpace);
+			CHECK(returnedJointSpaceTransforms[j] == expectedJointSpace);
+		}
+	};
+	for (Mona::FrameIndex frame = 0; frame < ikAnimation->getFrameNum(); frame += 5) {
+		ikAnimation->setVariableJointRotations(frame);
+		auto& variableRotations = *ikAnimation->getVariableJointRotations();
+		for (Mona::JointIndex j : rig.getIKChain(0)->getJoints())
+			variableRotations[j].setRotationAngle(variableRotations[j].getRotationAngle() + angleDelta(generator));
+		//End effector repetido, ancestro listado despues de su descendiente y piernas que comparten la cadera
+		checkTransforms({ joint("LeftFoot"), joint("LeftFoot"), joint("LeftLeg"), joint("RightFoot"), joint("Hips") });
+		//Ancestro listado antes que su descendiente, reutilizando los arreglos con menos articulaciones calculadas
+		checkTransforms({ joint("LeftUpLeg"), joint("LeftToeBase") });
+		checkTransforms({ joint("Hips") });
+	}
+	//Sin salida de transformaciones locales
+	forwardKinematics.EEListCustomSpaceVariableTransforms({ joint("RightFoot") }, baseTransform, ikAnimation, transforms, nullptr, scratch);
+	CHECK(transforms[joint("LeftFoot")] == glm::mat4(1.0f));
+	CHECK(transforms[joint("RightFoot")] != glm::mat4(1.0f));
+}
+
+float MaxPaletteDifference(const std::vector<glm::mat4>& first, const std::vector<glm::mat4>& second) {
+	float maxDifference = 0.0f;
+	for (size_t i = 0; i < first.size(); i++) {
+		for (int c = 0; c < 4; c++)
+			maxDifference = std::max(maxDifference, glm::length(first[i][c] - second[i][c]));
+	}
+	return maxDifference;
+}
+
+// Con el cache de poses activo, cambiar de nivel de detalle a mitad de un intervalo produce las mismas poses que sin cache.
+void CheckPoseCacheLODChanges(Mona::World& world, const CharacterAssets& assets) {
+	constexpr int frameCount = 40;
+	constexpr float timeStep = 1.0f / 60.0f;
+	//Intervalo de actualizacion de los personajes que cambian de nivel, cambiando en frames que caen a mitad de intervalo
+	auto updateInterval = [](int frame) -> uint32_t { return (frame / 5) % 2 == 0 ? 1 : 3; };
+	auto& animationSystem = Mona::MonaTest::GetAnimationSystem(world);
+	auto& transformManager = Mona::MonaTest::GetComponentManager<Mona::TransformComponent>(world);
+	auto& cameraManager = Mona::MonaTest::GetComponentManager<Mona::CameraComponent>(world);
+	const Mona::InnerComponentHandle cameraHandle = world.GetMainCameraComponent().GetInnerHandle();
+	auto material = world.CreateMaterial(Mona::MaterialType::DiffuseFlat, true);
+
+	//El primer personaje que cambia de nivel evalua la llave que comparte con el segundo, y el tercero copia su pose
+	auto simulate = [&](std::vector<std::vector<glm::mat4>>& outPalettes) {
+		std::vector<Mona::GameObjectHandle<Mona::GameObject>> characters;
+		std::vector<Mona::SkeletalMeshHandle> skeletalMeshes;
+		for (int i = 0; i < 3; i++) {
+			auto character = world.CreateGameObject<Mona::GameObject>();
+			world.AddComponent<Mona::TransformComponent>(character);
+			skeletalMeshes.push_back(world.AddComponent<Mona::SkeletalMeshComponent>(character, assets.skinnedMesh, assets.walkingAnimation, material));
+			characters.push_back(character);
+		}
+		for (int frame = 0; frame < frameCount; frame++) {
+			const Mona::AnimationLODLevel lod = { 0.0f, updateInterval(frame), Mona::AnimationLODLevel::AllJoints };
+			skeletalMeshes[0]->SetAnimationLODLevels({ lod });
+			skeletalMeshes[2]->SetAnimationLODLevels({ lod });
+			animationSystem.UpdateAllPoses(*Mona::MonaTest::GetSkeletalMeshGroup(world), transformManager, cameraManager, cameraHandle,
+				timeStep, world.GetJobSystem());
+			for (int i = 0; i < 3; i++)
+				outPalettes.push_back(skeletalMeshes[i]->GetAnimationController().GetCurrentMatrixPalette());
+		}
+		for (auto& character : characters)
+			world.DestroyGameObject(character);
+	};
+	std::vector<std::vector<glm::mat4>> expectedPalettes;
+	simulate(expectedPalettes);
+	//Con un cuanto de tiempo muy fino las poses del cache solo difieren de las exactas por el redondeo del tiempo
+	std::vector<std::vector<glm::mat4>> cachedPalettes;
+	animationSystem.EnablePoseCache(1.0e-5f);
+	animationSystem.ResetPoseCacheStats();
+	simulate(cachedPalettes);
+	CHECK(animationSystem.GetPoseCacheStats().hits > 0);
+	animationSystem.DisablePoseCache();
+
+	//La tolerancia es una fraccion pequena del movimiento de un frame, un frame de adelanto la excede
+	float frameMotion = 0.0f;
+	for (size_t k = 3; k < expectedPalettes.size(); k++)
+		frameMotion = std::max(frameMotion, MaxPaletteDifference(expectedPalettes[k], expectedPalettes[k - 3]));
+	CHECK(frameMotion > 0.0f);
+	CHECK(expectedPalettes.size() == cachedPalettes.size());
+	for (size_t k = 0; k < std::min(expectedPalettes.size(), cachedPalettes.size()); k++)
+		CHECK(MaxPaletteDifference(expectedPalettes[k], cachedPalettes[k]) <= 0.05f * frameMotion);
+}
+
+class HeadlessChecksApplication : public Mona::Application
+{
+public:
+	virtual void UserStartUp(Mona::World& world) noexcept override {
+		RunChecks("World/ComponentGroup", [&world]() { CheckComponentGroup(world); });
+		RunChecks("World/CreateMaterials", [&world]() { CheckCreateMaterials(world); });
+		RunChecks("IKNavigation/EnvironmentDataGrid", [&world]() { CheckEnvironmentDataGrid(world); });
+		RunChecks("IKNavigation/TerrainTransformCache", [&world]() { CheckTerrainTransformCache(world); });
+		CharacterAssets assets;
+		if (LoadCharacterAssets(assets)) {
+			RunChecks("Animation/KeyframeCursor", [&]() { CheckKeyframeCursor(assets); });
+			RunChecks("IKNavigation/TwoBoneSolver", [&]() { CheckTwoBoneSolver(assets); });
+			RunChecks("IKNavigation/ForwardKinematicsScratch", [&]() { CheckForwardKinematicsScratch(assets); });
+			RunChecks("Animation/PoseCacheLODChanges", [&]() { CheckPoseCacheLODChanges(world, assets); });
+		}
+		else {
+			SkipChecks("Animation/KeyframeCursor", "missing character assets");
+			SkipChecks("IKNavigation/TwoBoneSolver", "missing character assets");
+			SkipChecks("IKNavigation/ForwardKinematicsScratch", "missing character assets");
+			SkipChecks("Animation/PoseCacheLODChanges", "missing character assets");
+		}
+		world.EndApplication();
+	}
+	virtual void UserShutDown(Mona::World& world) noexcept override {}
+	virtual void UserUpdate(Mona::World& world, float timeStep) noexcept override {}
+};
+
+int main(int argc, char** argv)
+{
+	RunChecks("DynamicAABBTree/QueryMatchesBruteForce", CheckDynamicAABBTreeQuery);
+	RunChecks("RenderQueue/SortAndBatches", CheckRenderQueue);
+	RunChecks("AssetCache/RoundTripAndInvalidation", CheckAssetCache);
+	RunChecks("CompressedAnimationClip/ErrorBound", CheckCompressedAnimationClip);
+	RunChecks("SkinnedMesh/PoseBoundingBox", CheckSkinnedPoseBoundingBox);
+	//Los kernels se revisan con la version que se haya compilado, SSE2 o la escalar de MONA_DISABLE_SIMD
+	RunChecks(Mona::PoseSoA::IsSimdEnabled() ? "PoseSoA/KernelsMatchAoS/SSE2" : "PoseSoA/KernelsMatchAoS/Scalar", CheckPoseSoAKernels);
+	RunChecks("IKNavigation/LODHysteresis", CheckIKNavigationLODHysteresis);
+	RunChecks("IKNavigation/RingLIC", CheckRingLIC);
+	RunChecks("IKNavigation/HeightMapBaking", CheckHeightMapBaking);
+	RunChecks("IKNavigation/GradientDescent", CheckGradientDescent);
+	RunChecks("Core/JobSystem", CheckJobSystem);
+	RunChecks("World/TransformLocalMatrix", CheckTransformLocalMatrix);
+	{
+		HeadlessChecksApplication app;
+		Mona::Engine engine(app, true);
+		engine.StartMainLoop(1);
+	}
+	std::printf("%d checks, %d failed\n", s_checkCount, s_failedCheckCount);
+	return s_failedCheckCount == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}